@@ -149,6 +149,41 @@ int32_t com_fs_getfail(uint32_t errcode)
 
 }
 
+/* ************************************************************************** */
+/* 
+ * 関数名   拡張監視の警告情報取得
+ * 機能     監視名(設定ファイルのグループ名)で警告情報を取得する．
+ * 引数:    name：[i] 監視名("THERM.CPU-therm"等)
+ * 戻り値:  故障レベル，-1：該当なし
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+int32_t com_fs_getfail_ext(const char *name)
+{
+	static failsafeExt tFsExt;
+	int32_t ret = -1;
+	int32_t tFsShmID;
+
+	tFsShmID = com_shmem_open(DEF_FS_EXT_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(tFsShmID == DEF_COM_SHMEM_FALSE)
+	{
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_FS_EXT_SHMEM_NAME);
+		return ret;
+	}
+	com_shmem_read(tFsShmID, &tFsExt, sizeof(tFsExt));
+	com_shmem_close(tFsShmID);
+
+	for (int32_t cnt = 0; cnt < tFsExt.num && cnt < DEF_FS_EXT_MAX; cnt++)
+	{
+		if (strncmp(tFsExt.entry[cnt].name, name, DEF_FS_EXT_NAME_LEN) == 0)
+		{
+			ret = tFsExt.entry[cnt].level;
+			break;
+		}
+	}
+	return ret;
+}
+
 /* ************************************************************************** */
 /* 
  * 関数名   インデックス番号取得
@@ -0,0 +1,147 @@
+/*============================================================================*/
+/*
+ * @file    com_hb.c
+ * @brief   ハートビート
+ * @note    hjpfから起動された場合のみ有効とし，環境変数HJPF_HEARTBEATで渡された欄を更新する．
+ *          単独で起動した場合(環境変数なし)はcom_hb_beat()を呼び出しても何もしない．
+ *          待機インスタンス(環境変数HJPF_STANDBY)はcom_hb_standby()で停止して切り替えを待つ．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <stddef.h>
+#include <time.h>
+#include "com_hb.h"
+#include "com_shmem.h"
+#include "debug.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static int32_t sHbShmId = DEF_COM_SHMEM_FALSE;	/* 共有メモリID(未オープン:-1) */
+static int32_t sHbSlot = -1;					/* 欄番号(-1:無効) */
+static uint64_t sHbCount = 0;					/* 更新回数 */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+
+/*============================================================================*/
+/*
+ * @brief   ハートビート開始
+ * @note    com_shmem_conf()の後に呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: 0:正常，-1:無効(hjpf以外から起動，共有メモリなし)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_hb_init(void)
+{
+	const char *env;
+	char *end;
+	long slot;
+
+	env = getenv(DEF_HB_ENV);
+	if (env == NULL) {
+		return -1;
+	}
+	slot = strtol(env, &end, 10);
+	if (end == env || *end != '\0' || slot < 0 || slot >= DEF_HB_MAX) {
+		dprintf(WARN, "com_hb_init() invalid %s=%s\n", DEF_HB_ENV, env);
+		return -1;
+	}
+
+	sHbShmId = com_shmem_open(DEF_HB_SHMEM_NAME, SHM_KIND_USER);
+	if (sHbShmId == DEF_COM_SHMEM_FALSE) {
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_HB_SHMEM_NAME);
+		return -1;
+	}
+	sHbSlot = (int32_t)slot;
+	sHbCount = 0;
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ハートビート更新
+ * @note    更新回数と時刻のみ書き込む(pid，deadlineはhjpfが書き込む)．
+ *          処理が進んでいることを確認できる箇所(周期処理の末尾等)で呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: 0:正常，-1:無効・異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_hb_beat(void)
+{
+	struct timespec ts;
+	uint64_t beat[2];
+
+	if (sHbSlot < 0) {
+		return -1;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	beat[0] = ++sHbCount;
+	beat[1] = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+	if (com_shmem_write_part(sHbShmId, (int32_t)offsetof(hbStat, entry[sHbSlot].count), beat,
+		sizeof(beat)) != DEF_COM_SHMEM_TRUE) {
+		return -1;
+	}
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ハートビート終了
+ * @param   引数  : void
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void com_hb_term(void)
+{
+	if (sHbShmId != DEF_COM_SHMEM_FALSE) {
+		com_shmem_close(sHbShmId);
+		sHbShmId = DEF_COM_SHMEM_FALSE;
+	}
+	sHbSlot = -1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   待機インスタンスの切り替え待ち
+ * @note    初期化(ファイル・デバイスのオープン，モデルの読み込み等)を終えた後，
+ *          周期処理の前に呼び出す．standby=1で起動された待機インスタンスの場合は
+ *          SIGSTOPで停止し，稼働中のプロセスが終了してhjpfがSIGCONTを送るまで戻らない．
+ *          hjpfは欄のプロセスIDを切り替えてから再開させるため，ハートビート使用時は
+ *          欄のプロセスIDが自プロセスになるまで停止し直す(他からのSIGCONTでは稼働しない)．
+ *          com_hb_init()の後に呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: 0:待機インスタンスではない，1:切り替えにより稼働開始
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_hb_standby(void)
+{
+	hbStat stat;
+
+	if (getenv(DEF_HB_STANDBY_ENV) == NULL) {
+		return 0;
+	}
+
+	do {
+		raise(SIGSTOP);
+	} while (sHbSlot >= 0 && com_shmem_read(sHbShmId, &stat, sizeof(stat)) == DEF_COM_SHMEM_TRUE &&
+		stat.entry[sHbSlot].pid != getpid());
+
+	// 子プロセスに引き継がない
+	unsetenv(DEF_HB_STANDBY_ENV);
+	sHbCount = 0;
+	return 1;
+}
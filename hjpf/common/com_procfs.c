@@ -0,0 +1,391 @@
+/*============================================================================*/
+/*
+ * @file    com_procfs.c
+ * @brief   procfs/sysfs読み込み
+ * @note    /proc，/sysのファイルをオープンしたまま保持し，周期毎にpread()で
+ *          読み直す．解析は呼び出し元のバッファ上で行い，メモリ確保・stdioを使わない．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/statvfs.h>
+#include "com_procfs.h"
+#include "debug.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int com_procfs_reopen(procfsFile *file);
+
+/*============================================================================*/
+/*
+ * @brief   ファイルオープン
+ * @note    pathがNULLなら静的初期化したパスでオープンする．
+ * @param   引数  : file	ファイル情報
+ * @param   引数  : path	パス名(静的領域の文字列)
+ * @return  戻り値: 0:正常，-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_open(procfsFile *file, const char *path)
+{
+	if (path != NULL) {
+		file->path = path;
+	}
+	file->fd = open(file->path, O_RDONLY | O_CLOEXEC);
+	if (file->fd < 0) {
+		dprintf(WARN, "com_procfs_open(%s) error=%d\n", file->path, errno);
+		return -1;
+	}
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ファイル読み込み
+ * @note    先頭からpread()で読み込み，NUL終端する．未オープンならオープンする．
+ *          読み込みに失敗した場合(ホットプラグ等で消えた場合)は一度だけ開き直す．
+ * @param   引数  : file	ファイル情報
+ * @param   引数  : buf		読み込み先
+ * @param   引数  : size	読み込み先サイズ(NUL終端分を含む)
+ * @return  戻り値: 0以上:読み込みサイズ，-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_read(procfsFile *file, char *buf, int size)
+{
+	ssize_t len;
+	ssize_t total = 0;
+	int retry = 1;
+
+	if (file->fd < 0 && com_procfs_open(file, NULL) != 0) {
+		return -1;
+	}
+
+	// procfsは1回のreadでページ単位までしか返さないことがあるため繰り返す
+	while (total < size - 1) {
+		len = pread(file->fd, buf + total, size - 1 - total, total);
+		if (len < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (total == 0 && retry && com_procfs_reopen(file) == 0) {
+				retry = 0;
+				continue;
+			}
+			dprintf(WARN, "com_procfs_read(%s) error=%d\n", file->path, errno);
+			return -1;
+		}
+		if (len == 0) {
+			break;
+		}
+		total += len;
+	}
+	buf[total] = '\0';
+
+	return (int)total;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ファイルクローズ
+ * @param   引数  : file	ファイル情報
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void com_procfs_close(procfsFile *file)
+{
+	if (file->fd >= 0) {
+		close(file->fd);
+		file->fd = -1;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   数値ファイル読み込み
+ * @note    sysfsの1値ファイル(thermal_zone*\/temp等)を読み込む．
+ * @param   引数  : file	ファイル情報
+ * @param   引数  : value	読み込んだ値
+ * @return  戻り値: 0:正常，-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_read_i64(procfsFile *file, int64_t *value)
+{
+	char buf[32];
+	procfsScan scan;
+	int len;
+
+	len = com_procfs_read(file, buf, sizeof(buf));
+	if (len <= 0) {
+		return -1;
+	}
+	com_procfs_scan_init(&scan, buf, len);
+	return com_procfs_scan_i64(&scan, value);
+}
+
+/*============================================================================*/
+/*
+ * @brief   解析開始
+ * @note    bufの先頭行を現在行とする．
+ * @param   引数  : scan	解析位置
+ * @param   引数  : buf		com_procfs_read()で読み込んだバッファ
+ * @param   引数  : len		読み込みサイズ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void com_procfs_scan_init(procfsScan *scan, const char *buf, int len)
+{
+	scan->pos = buf;
+	scan->end = buf + (len > 0 ? len : 0);
+	scan->eol = memchr(buf, '\n', scan->end - buf);
+	if (scan->eol == NULL) {
+		scan->eol = scan->end;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   次の行へ移動
+ * @param   引数  : scan	解析位置
+ * @return  戻り値: 1:移動した，0:終端
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_scan_line(procfsScan *scan)
+{
+	if (scan->eol >= scan->end) {
+		scan->pos = scan->end;
+		return 0;
+	}
+	scan->pos = scan->eol + 1;
+	scan->eol = memchr(scan->pos, '\n', scan->end - scan->pos);
+	if (scan->eol == NULL) {
+		scan->eol = scan->end;
+	}
+	return (scan->pos < scan->end) ? 1 : 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   行頭のキー比較
+ * @note    現在行がkeyで始まっていれば，解析位置をkeyの直後に進める．
+ * @param   引数  : scan	解析位置
+ * @param   引数  : key		キー("MemTotal:"等)
+ * @return  戻り値: 1:一致，0:不一致
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_scan_key(procfsScan *scan, const char *key)
+{
+	size_t len = strlen(key);
+
+	if ((size_t)(scan->eol - scan->pos) < len || memcmp(scan->pos, key, len) != 0) {
+		return 0;
+	}
+	scan->pos += len;
+	return 1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   単語取得
+ * @note    現在行の次の空白区切りの単語を返す(NUL終端しない)．
+ * @param   引数  : scan	解析位置
+ * @param   引数  : word	単語の先頭
+ * @return  戻り値: 単語の長さ(0:行末)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_scan_word(procfsScan *scan, const char **word)
+{
+	const char *p = scan->pos;
+
+	while (p < scan->eol && (*p == ' ' || *p == '\t')) {
+		p++;
+	}
+	*word = p;
+	while (p < scan->eol && *p != ' ' && *p != '\t') {
+		p++;
+	}
+	scan->pos = p;
+	return (int)(p - *word);
+}
+
+/*============================================================================*/
+/*
+ * @brief   単語の読み飛ばし
+ * @param   引数  : scan	解析位置
+ * @param   引数  : num		読み飛ばす単語数
+ * @return  戻り値: 読み飛ばした単語数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_scan_skip(procfsScan *scan, int num)
+{
+	const char *word;
+	int cnt;
+
+	for (cnt = 0; cnt < num; cnt++) {
+		if (com_procfs_scan_word(scan, &word) == 0) {
+			break;
+		}
+	}
+	return cnt;
+}
+
+/*============================================================================*/
+/*
+ * @brief   符号なし整数取得
+ * @note    現在行の次の数字列を10進数として読み込む．数字以外は読み飛ばす．
+ * @param   引数  : scan	解析位置
+ * @param   引数  : value	読み込んだ値
+ * @return  戻り値: 0:正常，-1:行末
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_scan_u64(procfsScan *scan, uint64_t *value)
+{
+	const char *p = scan->pos;
+	uint64_t val = 0;
+
+	while (p < scan->eol && (*p < '0' || '9' < *p)) {
+		p++;
+	}
+	if (p >= scan->eol) {
+		scan->pos = p;
+		return -1;
+	}
+	while (p < scan->eol && '0' <= *p && *p <= '9') {
+		val = val * 10 + (uint64_t)(*p - '0');
+		p++;
+	}
+	scan->pos = p;
+	*value = val;
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   符号付き整数取得
+ * @note    数字の直前が'-'なら負数とする．
+ * @param   引数  : scan	解析位置
+ * @param   引数  : value	読み込んだ値
+ * @return  戻り値: 0:正常，-1:行末
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_scan_i64(procfsScan *scan, int64_t *value)
+{
+	const char *p = scan->pos;
+	uint64_t val;
+	int neg = 0;
+
+	while (p < scan->eol && (*p < '0' || '9' < *p)) {
+		p++;
+	}
+	if (p > scan->pos && p[-1] == '-') {
+		neg = 1;
+	}
+	scan->pos = p;
+
+	if (com_procfs_scan_u64(scan, &val) != 0) {
+		return -1;
+	}
+	*value = neg ? -(int64_t)val : (int64_t)val;
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ディスク使用率取得
+ * @note    statvfs()で取得する．dfのUse%と同じく一般ユーザ使用可能領域に対する割合(切り上げ)．
+ * @param   引数  : path	対象ファイルシステム上のパス
+ * @param   引数  : percent	使用率[%]
+ * @return  戻り値: 0:正常，-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_disk_usage(const char *path, int *percent)
+{
+	struct statvfs vfs;
+	uint64_t used;
+	uint64_t total;
+
+	if (statvfs(path, &vfs) != 0) {
+		dprintf(WARN, "statvfs(%s) error=%d\n", path, errno);
+		return -1;
+	}
+
+	used = (uint64_t)(vfs.f_blocks - vfs.f_bfree);
+	total = used + (uint64_t)vfs.f_bavail;
+	*percent = (total == 0) ? 0 : (int)((used * 100 + total - 1) / total);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPUリスト解析
+ * @note    "0-3,5,8-11"形式(sysfsのonline/possible等)を解析する．
+ *          max以上のCPU番号は無視する．
+ * @param   引数  : str		CPUリスト
+ * @param   引数  : mask	CPU毎の有無(1:有)，max個
+ * @param   引数  : max		maskの要素数
+ * @return  戻り値: 0以上:最大CPU番号+1，-1:書式異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_procfs_cpulist(const char *str, uint8_t *mask, int max)
+{
+	procfsScan scan;
+	uint64_t first;
+	uint64_t last;
+	int num = 0;
+
+	memset(mask, 0, max);
+	com_procfs_scan_init(&scan, str, strlen(str));
+
+	while (com_procfs_scan_u64(&scan, &first) == 0) {
+		last = first;
+		if (scan.pos < scan.eol && *scan.pos == '-') {
+			if (com_procfs_scan_u64(&scan, &last) != 0 || last < first) {
+				return -1;
+			}
+		}
+		for (uint64_t cpu = first; cpu <= last && cpu < (uint64_t)max; cpu++) {
+			mask[cpu] = 1;
+		}
+		if ((int)last + 1 > num) {
+			num = (int)last + 1;
+		}
+	}
+
+	return num;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ファイル再オープン
+ * @param   引数  : file	ファイル情報
+ * @return  戻り値: 0:正常，-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int com_procfs_reopen(procfsFile *file)
+{
+	com_procfs_close(file);
+	return com_procfs_open(file, NULL);
+}
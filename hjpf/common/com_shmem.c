@@ -18,6 +18,7 @@
 #include <errno.h>
 #include "com_shmem.h"
 #include "debug.h"
+#include "com_trace.h"
 #include <string.h>
 #include <glib.h>
 #include <libgen.h>
@@ -40,6 +41,11 @@ static memoryInfo saShmMng[DEF_COM_SHMEM_MAX];	/* 共有メモリ情報 */
 /*============================================================================*/
 static int32_t com_shmem_get_ID(char* aShmName);
 static int32_t com_shmem_dump(int32_t aCnt);
+static size_t com_shmem_map_size(int32_t aShmID);
+static shmLatency* com_shmem_tail(int32_t aShmID);
+static void com_shmem_latency_add(int32_t aShmID, shmLatency* aTail);
+static int64_t com_shmem_flow_id(int32_t aShmID, uint64_t aSeq);
+static int32_t com_shmem_read_sub(int32_t aShmID, void* aData, int32_t aSize, struct timespec* aArrival, int32_t aRecord);
 
 /*============================================================================*/
 /* const */
@@ -148,6 +154,7 @@ int32_t com_shmem_conf(char filename[])
  * @param   引数  : なし
  * @return  戻り値：0：正常終了，-1：エラー
  * @date    2023/11/15 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] セマフォの初期値を指定(未指定時は不定値で生成される)
  */
  /*============================================================================*/
 int32_t com_shmem_init(void)
@@ -159,7 +166,7 @@ int32_t com_shmem_init(void)
 		saShmMng[cnt].shmfd = shm_open(saShmMng[cnt].name, O_RDWR | O_CREAT, DEF_COM_SHMEM_MODE);	/* 共有メモリ生成 */
 		if (saShmMng[cnt].shmfd != DEF_COM_SHMEM_FALSE)
 		{
-			if (ftruncate(saShmMng[cnt].shmfd, saShmMng[cnt].size) == DEF_COM_SHMEM_FALSE)	/* 共有メモリサイズ設定 */
+			if (ftruncate(saShmMng[cnt].shmfd, com_shmem_map_size(cnt)) == DEF_COM_SHMEM_FALSE)	/* 共有メモリサイズ設定(末尾に遅延情報) */
 			{
 				dprintf(ERROR, "Share Memory : %s , fail to set size. errno=%d\n", saShmMng[cnt].name, errno);
 				ret = DEF_COM_SHMEM_FALSE;
@@ -172,7 +179,7 @@ int32_t com_shmem_init(void)
 			ret = DEF_COM_SHMEM_FALSE;
 		}
 
-		saShmMng[cnt].sem = sem_open(saShmMng[cnt].name, O_CREAT);	/* セマフォ生成 */
+		saShmMng[cnt].sem = sem_open(saShmMng[cnt].name, O_CREAT, DEF_COM_SHMEM_MODE, DEF_COM_SHMEM_SEM_VALUE);	/* セマフォ生成 */
 			if (saShmMng[cnt].sem == SEM_FAILED)
 			{
 				dprintf(WARN, "Semaphore : %s, fail to init semaphore. errno=%d\n", saShmMng[cnt].name, errno);
@@ -234,6 +241,7 @@ int32_t com_shmem_init(void)
  *					種別(1：プラットフォーム，2：ユーザプロセス)
  * @return  戻り値：0以上：共有メモリID，-1：エラー
  * @date    2023/11/15 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] セマフォの初期値を指定(未指定時は不定値で生成される)
  */
  /*============================================================================*/
 int32_t com_shmem_open(char* aShmName, enum shm_kind aKind)
@@ -261,7 +269,14 @@ int32_t com_shmem_open(char* aShmName, enum shm_kind aKind)
 
 	if (saShmMng[tShmID].shmfd != DEF_COM_SHMEM_FALSE)
 	{
-		saShmMng[tShmID].address = mmap(NULL, saShmMng[tShmID].size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		struct stat tStat;
+		if ((fstat(saShmMng[tShmID].shmfd, &tStat) == 0) &&
+			((size_t)tStat.st_size > com_shmem_map_size(tShmID)))	/* 生成側で拡張されたサイズに合わせる */
+		{
+			saShmMng[tShmID].size = (int32_t)(tStat.st_size - sizeof(shmLatency));
+		}
+
+		saShmMng[tShmID].address = mmap(NULL, com_shmem_map_size(tShmID), PROT_READ | PROT_WRITE, MAP_SHARED,
 			saShmMng[tShmID].shmfd, DEF_COM_SHMEM_OFFSET);	/* 共有メモリをマッピング */
 
 		if (saShmMng[tShmID].address == MAP_FAILED)
@@ -270,7 +285,7 @@ int32_t com_shmem_open(char* aShmName, enum shm_kind aKind)
 			ret = DEF_COM_SHMEM_FALSE;
 		}
 
-		saShmMng[tShmID].sem = sem_open(saShmMng[tShmID].name, O_CREAT);	/* セマフォをオープン */
+		saShmMng[tShmID].sem = sem_open(saShmMng[tShmID].name, O_CREAT, DEF_COM_SHMEM_MODE, DEF_COM_SHMEM_SEM_VALUE);	/* セマフォをオープン */
 
 		if (saShmMng[tShmID].sem != SEM_FAILED)
 		{
@@ -336,7 +351,7 @@ int32_t com_shmem_close(int32_t aShmID)
 
 		if (saShmMng[aShmID].shmfd != DEF_COM_SHMEM_FALSE)	/* 共有メモリがオープンされているかチェック */
 		{
-			if (munmap(saShmMng[aShmID].address, saShmMng[aShmID].size) != DEF_COM_SHMEM_TRUE)	/* 共有メモリをクローズ */
+			if (munmap(saShmMng[aShmID].address, com_shmem_map_size(aShmID)) != DEF_COM_SHMEM_TRUE)	/* 共有メモリをクローズ */
 			{
 				dprintf(ERROR, "Share Memory : %s, fail to close share memory. errno=%d\n", saShmMng[aShmID].name, errno);
 				ret = DEF_COM_SHMEM_FALSE;
@@ -419,8 +434,47 @@ void com_shmem_destroy(void)
  */
  /*============================================================================*/
 int32_t com_shmem_read(int32_t aShmID, void* aData, int32_t aSize)
+{
+	return com_shmem_read_sub(aShmID, aData, aSize, NULL, 0);
+}
+
+/*============================================================================*/
+/*
+ * @brief   共有メモリを読み込み，データの経過時間を遅延ヒストグラムに記録する
+ * @note    データ到着から読み込みまでの時間を記録する．
+ *			同じデータ(書き込み番号)の2回目以降の読み込みは記録しない．
+ * @param   引数  : 共有メモリID
+ *					読み込むデータのアドレス
+ *					読み込みサイズ
+ *					データ到着時刻の格納先(NULL可，未設定時は0)
+ * @return  戻り値：0：正常終了，-1：エラー
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+int32_t com_shmem_read_ts(int32_t aShmID, void* aData, int32_t aSize, struct timespec* aArrival)
+{
+	return com_shmem_read_sub(aShmID, aData, aSize, aArrival, 1);
+}
+
+/*============================================================================*/
+/*
+ * @brief   共有メモリ読み込み処理
+ * @param   引数  : 共有メモリID
+ *					読み込むデータのアドレス
+ *					読み込みサイズ
+ *					データ到着時刻の格納先(NULL可)
+ *					遅延記録有無(0：記録しない，1：記録する)
+ * @return  戻り値：0：正常終了，-1：エラー
+ * @date    2026/10/19 [0.0.1] com_shmem_read()から分離
+ *          2026/10/19 [0.0.2] 遅延を記録したデータのフロー終了をトレースに記録
+ */
+ /*============================================================================*/
+static int32_t com_shmem_read_sub(int32_t aShmID, void* aData, int32_t aSize, struct timespec* aArrival, int32_t aRecord)
 {
 	int32_t		ret = DEF_COM_SHMEM_TRUE;
+	shmLatency*	tTail;
+
+	TRACE_BEGIN("com_shmem_read");
 	if ((aData != NULL) && (aSize <= saShmMng[aShmID].size) && (aShmID <= sShmNum) && (aShmID >= 0))	/* 引数のチェック */
 	{
 #if 1
@@ -431,6 +485,18 @@ int32_t com_shmem_read(int32_t aShmID, void* aData, int32_t aSize)
 			{
 				memcpy(aData, saShmMng[aShmID].address, aSize);	/* 共有メモリを読み込む */
 
+				tTail = com_shmem_tail(aShmID);
+				if (aArrival != NULL)	/* データ到着時刻 */
+				{
+					aArrival->tv_sec = tTail->stamp / 1000000000ULL;
+					aArrival->tv_nsec = tTail->stamp % 1000000000ULL;
+				}
+				if ((aRecord != 0) && (tTail->stamp != 0) && (tTail->seq != saShmMng[aShmID].rdseq))	/* 新しいデータなら遅延を記録 */
+				{
+					com_shmem_latency_add(aShmID, tTail);
+					TRACE_FLOW_END(saShmMng[aShmID].name, com_shmem_flow_id(aShmID, tTail->seq));	/* 書き込みからのフロー */
+				}
+
 				if (sem_post(saShmMng[aShmID].sem) != DEF_COM_SHMEM_TRUE)	/* セマフォをアンロック */
 				{
 					dprintf(WARN, "Semaphore : %s, fail to unlock semaphore. errno=%d.\n", saShmMng[aShmID].name, errno);
@@ -480,6 +546,7 @@ int32_t com_shmem_read(int32_t aShmID, void* aData, int32_t aSize)
 		ret = DEF_COM_SHMEM_FALSE;
 	}
 
+	TRACE_END("com_shmem_read");
 	return ret;
 
 }
@@ -491,6 +558,7 @@ int32_t com_shmem_read(int32_t aShmID, void* aData, int32_t aSize)
  *			セマフォロック
  *			共有メモリ種別が同じなら共有メモリに書き込む
  *			セマフォアンロック
+ *			データ到着時刻は書き込み時刻とする．
  * @param   引数  : 共有メモリID
  *					書き込むデータ(のアドレス)
  *					書き込みサイズ
@@ -499,8 +567,36 @@ int32_t com_shmem_read(int32_t aShmID, void* aData, int32_t aSize)
  */
  /*============================================================================*/
 int32_t com_shmem_write(int32_t aShmID, void* aData, int32_t aSize)
+{
+	return com_shmem_write_ts(aShmID, aData, aSize, NULL);
+}
+
+/*============================================================================*/
+/*
+ * @brief   データ到着時刻を付けて共有メモリに書き込む
+ * @note    com_shmem_write()に加え，デバイスからのデータ到着時刻を記録する．
+ * @param   引数  : 共有メモリID
+ *					書き込むデータ(のアドレス)
+ *					書き込みサイズ
+ *					データ到着時刻(CLOCK_MONOTONIC，NULL：現在時刻，0：未設定)
+ * @return  戻り値：0：正常終了，-1：エラー
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 読み込み側へのフロー開始をトレースに記録
+ */
+ /*============================================================================*/
+int32_t com_shmem_write_ts(int32_t aShmID, void* aData, int32_t aSize, const struct timespec* aArrival)
 {
 	int32_t		ret = DEF_COM_SHMEM_TRUE;
+	struct timespec	tNow;
+	shmLatency*	tTail;
+
+	if (aArrival == NULL)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &tNow);
+		aArrival = &tNow;
+	}
+
+	TRACE_BEGIN("com_shmem_write");
 	if ((aData != NULL) && (aSize <= saShmMng[aShmID].size) && (aShmID <= sShmNum) && (aShmID >= 0))	/* 引数のチェック */
 	{
 #if 1
@@ -512,6 +608,10 @@ int32_t com_shmem_write(int32_t aShmID, void* aData, int32_t aSize)
 				if (saShmMng[aShmID].kind == saShmMng[aShmID].current)	/* 種別のチェック */
 				{
 					memcpy(saShmMng[aShmID].address, aData, aSize);	/* 共有メモリに書き込む */
+					tTail = com_shmem_tail(aShmID);
+					tTail->stamp = (uint64_t)aArrival->tv_sec * 1000000000ULL + (uint64_t)aArrival->tv_nsec;	/* データ到着時刻 */
+					tTail->seq++;
+					TRACE_FLOW_BEGIN(saShmMng[aShmID].name, com_shmem_flow_id(aShmID, tTail->seq));	/* 読み込み側へのフロー */
 					if (sem_post(saShmMng[aShmID].sem) != DEF_COM_SHMEM_TRUE)	/* セマフォをアンロック */
 					{
 						dprintf(ERROR, "Semaphore : %s, fail to unlock semaphore. errno=%d.\n", saShmMng[aShmID].name, errno);
@@ -575,10 +675,217 @@ int32_t com_shmem_write(int32_t aShmID, void* aData, int32_t aSize)
 		ret = DEF_COM_SHMEM_FALSE;
 	}
 
+	TRACE_END("com_shmem_write");
 	return ret;
 
 }
 
+/*============================================================================*/
+/*
+ * @brief   共有メモリの一部に書き込む
+ * @note    com_shmem_write()と同じく，セマフォをロックして書き込む．
+ *			リングバッファ等，大きな共有メモリの一部だけを更新する場合に使う．
+ *			データ到着時刻は書き込み時刻とする．
+ * @param   引数  : 共有メモリID
+ *					書き込み位置(共有メモリ先頭からのオフセット)
+ *					書き込むデータ(のアドレス)
+ *					書き込みサイズ
+ * @return  戻り値：0：正常終了，-1：エラー
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 読み込み側へのフロー開始をトレースに記録
+ */
+ /*============================================================================*/
+int32_t com_shmem_write_part(int32_t aShmID, int32_t aOffset, void* aData, int32_t aSize)
+{
+	int32_t		ret = DEF_COM_SHMEM_TRUE;
+	struct timespec	tNow;
+	shmLatency*	tTail;
+
+	TRACE_BEGIN("com_shmem_write_part");
+	if ((aData != NULL) && (aOffset >= 0) && (aSize >= 0) && (aShmID <= sShmNum) && (aShmID >= 0) &&
+		(aOffset <= saShmMng[aShmID].size - aSize))	/* 引数のチェック */
+	{
+		if ((saShmMng[aShmID].address != MAP_FAILED) && (saShmMng[aShmID].sem != SEM_FAILED) &&
+			(saShmMng[aShmID].shmfd != DEF_COM_SHMEM_FALSE))	/* 共有メモリ，セマフォのオープン確認 */
+		{
+			if (sem_wait(saShmMng[aShmID].sem) == DEF_COM_SHMEM_TRUE)	/* セマフォをロック */
+			{
+				if (saShmMng[aShmID].kind == saShmMng[aShmID].current)	/* 種別のチェック */
+				{
+					memcpy((char*)saShmMng[aShmID].address + aOffset, aData, aSize);	/* 共有メモリに書き込む */
+					clock_gettime(CLOCK_MONOTONIC, &tNow);
+					tTail = com_shmem_tail(aShmID);
+					tTail->stamp = (uint64_t)tNow.tv_sec * 1000000000ULL + (uint64_t)tNow.tv_nsec;	/* データ到着時刻 */
+					tTail->seq++;
+					TRACE_FLOW_BEGIN(saShmMng[aShmID].name, com_shmem_flow_id(aShmID, tTail->seq));	/* 読み込み側へのフロー */
+					if (sem_post(saShmMng[aShmID].sem) != DEF_COM_SHMEM_TRUE)	/* セマフォをアンロック */
+					{
+						dprintf(ERROR, "Semaphore : %s, fail to unlock semaphore. errno=%d.\n", saShmMng[aShmID].name, errno);
+						ret = DEF_COM_SHMEM_FALSE;
+					}
+				}
+				else
+				{
+					dprintf(ERROR, "Share Memory : %s, kind=%d, current=%d. Due to not match kind, not permit to write.\n", saShmMng[aShmID].name, saShmMng[aShmID].kind, saShmMng[aShmID].current);
+					ret = DEF_COM_SHMEM_FALSE;
+				}
+			}
+			else
+			{
+				dprintf(ERROR, "Semaphore : %s, fail to lock semaphore. errno=%d.\n", saShmMng[aShmID].name, errno);
+				ret = DEF_COM_SHMEM_FALSE;
+			}
+		}
+		else
+		{
+			dprintf(ERROR, "Share Memory : %s is not opened.\n", saShmMng[aShmID].name);
+			ret = DEF_COM_SHMEM_FALSE;
+		}
+	}
+	else
+	{
+		dprintf(WARN, "Invalid Argument (com_shmem_write_part(%d,%d,%d))\n", aShmID, aOffset, aSize);
+		ret = DEF_COM_SHMEM_FALSE;
+	}
+
+	TRACE_END("com_shmem_write_part");
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   遅延情報を取得する
+ * @note    データ到着から読み込みまでの遅延ヒストグラム等を取得する．
+ * @param   引数  : 共有メモリID
+ *					遅延情報の格納先
+ *					取得後のクリア有無(0：クリアしない，1：クリアする)
+ * @return  戻り値：0：正常終了，-1：エラー
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+int32_t com_shmem_latency(int32_t aShmID, shmLatency* aLatency, int32_t aReset)
+{
+	int32_t		ret = DEF_COM_SHMEM_TRUE;
+	shmLatency*	tTail;
+
+	if ((aLatency == NULL) || (aShmID > sShmNum) || (aShmID < 0))	/* 引数のチェック */
+	{
+		dprintf(WARN, "Invalid Argument (com_shmem_latency(%d))\n", aShmID);
+		return DEF_COM_SHMEM_FALSE;
+	}
+
+	if ((saShmMng[aShmID].address == MAP_FAILED) || (saShmMng[aShmID].sem == SEM_FAILED))	/* 共有メモリ，セマフォのオープン確認 */
+	{
+		dprintf(WARN, "Share Memory : %s is not opened.\n", saShmMng[aShmID].name);
+		return DEF_COM_SHMEM_FALSE;
+	}
+
+	if (sem_wait(saShmMng[aShmID].sem) == DEF_COM_SHMEM_TRUE)	/* セマフォをロック */
+	{
+		tTail = com_shmem_tail(aShmID);
+		memcpy(aLatency, tTail, sizeof(shmLatency));
+		if (aReset != 0)
+		{
+			tTail->count = 0;
+			tTail->sum = 0;
+			tTail->max = 0;
+			memset(tTail->hist, 0x0, sizeof(tTail->hist));
+		}
+
+		if (sem_post(saShmMng[aShmID].sem) != DEF_COM_SHMEM_TRUE)	/* セマフォをアンロック */
+		{
+			dprintf(WARN, "Semaphore : %s, fail to unlock semaphore. errno=%d.\n", saShmMng[aShmID].name, errno);
+			ret = DEF_COM_SHMEM_FALSE;
+		}
+	}
+	else
+	{
+		dprintf(WARN, "Semaphore : %s, fail to lock semaphore. errno=%d.\n", saShmMng[aShmID].name, errno);
+		ret = DEF_COM_SHMEM_FALSE;
+	}
+
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   遅延のパーセンタイル値を求める
+ * @note    ヒストグラムから求めるため，値はビンの上限値となる．
+ * @param   引数  : 遅延情報
+ *					パーセンタイル(1～100)
+ * @return  戻り値：遅延[us](記録なしは0)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+uint64_t com_shmem_latency_pct(const shmLatency* aLatency, int32_t aPct)
+{
+	uint64_t	tTarget;
+	uint64_t	tSum = 0;
+
+	if ((aLatency == NULL) || (aLatency->count == 0))
+	{
+		return 0;
+	}
+
+	tTarget = (aLatency->count * aPct + 99) / 100;
+	for (int32_t cnt = 0; cnt < DEF_COM_SHMEM_LAT_BIN - 1; cnt++)
+	{
+		tSum += aLatency->hist[cnt];
+		if (tSum >= tTarget)
+		{
+			return (1ULL << cnt);
+		}
+	}
+
+	return aLatency->max;	/* 最終ビンは上限なし */
+}
+
+/*============================================================================*/
+/*
+ * @brief   共有メモリサイズを変更する
+ * @note    CPU数等，起動時に決まるサイズの共有メモリに使用する．
+ *			com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ *			他プロセスはオープン時に実サイズを取得する．
+ * @param   引数  : 共有メモリ名
+ *					サイズ
+ * @return  戻り値：0：正常終了，-1：エラー
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+int32_t com_shmem_set_size(char* aShmName, int32_t aSize)
+{
+	int32_t tShmID;
+
+	tShmID = com_shmem_get_ID(aShmName);
+	if ((tShmID == DEF_COM_SHMEM_FALSE) || (aSize <= 0))
+	{
+		dprintf(WARN, "Invalid Argument (com_shmem_set_size(%s, %d))\n", aShmName, aSize);
+		return DEF_COM_SHMEM_FALSE;
+	}
+
+	dprintf(INFO, "Share Memory : %s, size %d -> %d\n", aShmName, saShmMng[tShmID].size, aSize);
+	saShmMng[tShmID].size = aSize;
+
+	return DEF_COM_SHMEM_TRUE;
+}
+
+/*============================================================================*/
+/*
+ * @brief   共有メモリサイズを取得する
+ * @param   引数  : 共有メモリID
+ * @return  戻り値：0以上：サイズ，-1：エラー
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+int32_t com_shmem_get_size(int32_t aShmID)
+{
+	if ((aShmID > sShmNum) || (aShmID < 0))	/* 引数のチェック */
+	{
+		return DEF_COM_SHMEM_FALSE;
+	}
+	return saShmMng[aShmID].size;
+}
+
 /*============================================================================*/
 /*
  * @brief   共有メモリ管理IDを取得
@@ -658,3 +965,94 @@ static int32_t com_shmem_dump(int32_t aCnt)
 
 	return ret;
 }
+
+/*============================================================================*/
+/*
+ * @brief   マッピングサイズを取得
+ * @note    設定サイズの後ろに遅延情報を配置する．
+ * @param   引数  : 共有メモリ管理ID
+ * @return  戻り値：マッピングサイズ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+static size_t com_shmem_map_size(int32_t aShmID)
+{
+	return DEF_COM_SHMEM_TAIL_OFS(saShmMng[aShmID].size) + sizeof(shmLatency);
+}
+
+/*============================================================================*/
+/*
+ * @brief   遅延情報のアドレスを取得
+ * @param   引数  : 共有メモリ管理ID
+ * @return  戻り値：遅延情報のアドレス
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+static shmLatency* com_shmem_tail(int32_t aShmID)
+{
+	return (shmLatency*)((char*)saShmMng[aShmID].address + DEF_COM_SHMEM_TAIL_OFS(saShmMng[aShmID].size));
+}
+
+/*============================================================================*/
+/*
+ * @brief   遅延をヒストグラムに記録
+ * @note    セマフォをロックした状態で呼び出すこと．
+ * @param   引数  : 共有メモリ管理ID
+ *					遅延情報
+ * @return  戻り値：なし
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+static void com_shmem_latency_add(int32_t aShmID, shmLatency* aTail)
+{
+	struct timespec	tNow;
+	uint64_t	tNowNs;
+	uint64_t	tAge = 0;	/* [us] */
+	int32_t		tBin = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &tNow);
+	tNowNs = (uint64_t)tNow.tv_sec * 1000000000ULL + (uint64_t)tNow.tv_nsec;
+	if (tNowNs > aTail->stamp)
+	{
+		tAge = (tNowNs - aTail->stamp) / 1000;
+	}
+
+	while ((tBin < DEF_COM_SHMEM_LAT_BIN - 1) && ((tAge >> tBin) != 0))	/* ビンiは2^(i-1)以上2^i未満 */
+	{
+		tBin++;
+	}
+
+	aTail->hist[tBin]++;
+	aTail->count++;
+	aTail->sum += tAge;
+	if (tAge > aTail->max)
+	{
+		aTail->max = tAge;
+	}
+	saShmMng[aShmID].rdseq = aTail->seq;
+}
+
+/*============================================================================*/
+/*
+ * @brief   トレースのフローIDを求める
+ * @note    書き込み側と読み込み側(別プロセス)で同じIDになるよう，
+ *			共有メモリ名のハッシュと書き込み番号から求める．
+ *			トレース表示側(JavaScript)で精度が落ちないよう2^52未満とする．
+ * @param   引数  : 共有メモリ管理ID
+ *					書き込み番号
+ * @return  戻り値：フローID
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+ /*============================================================================*/
+static int64_t com_shmem_flow_id(int32_t aShmID, uint64_t aSeq)
+{
+	const unsigned char*	tName = (const unsigned char*)saShmMng[aShmID].name;
+	uint32_t	tHash = 2166136261U;	/* FNV-1a */
+
+	while (*tName != '\0')
+	{
+		tHash = (tHash ^ *tName++) * 16777619U;
+	}
+
+	return (int64_t)(((uint64_t)(tHash & 0xfffffU) << 32) | (aSeq & 0xffffffffULL));
+}
@@ -13,12 +13,18 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
 #include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <libgen.h>
 #include <pthread.h>
 #include "com_shmem.h"
 #include "com_timer.h"
 #include "debug.h"
+#include "com_trace.h"
 
 /*============================================================================*/
 /* global */
@@ -31,9 +37,44 @@ typedef struct _comTimer {
 } comTimer;
 static comTimer	g_comTimer[DEF_COMM_TIMER_MAX];
 
+typedef struct _comClockSlot {		/* 仮想時刻でスリープ中のタイマ(全プロセス共通) */
+	int	sleeping;					/* スリープ中なら1(起床させた側で0にする) */
+	uint32_t	gen;				/* 起床させるたびに加算 */
+	pid_t	pid;					/* スリープ中のプロセス */
+	struct timespec	next;			/* 起床時刻 */
+} comClockSlot;
+
+typedef struct _comClockShm {		/* 仮想時刻(共有メモリ) */
+	atomic_uint	magic;				/* 初期化完了でDEF_CLOCK_MAGIC */
+	int	sleeping;					/* 仮想時刻でスリープ中のタイマ数 */
+	struct timespec	sim_now;		/* 仮想時刻(CLOCK_MONOTONIC相当) */
+	struct timespec	sim_epoch;		/* 仮想時刻0に対応する実時刻(CLOCK_REALTIME) */
+	pthread_mutex_t	mutex;			/* プロセス間共有・ロバスト */
+	pthread_cond_t	wakeup;			/* 仮想時刻の進行通知 */
+	pthread_cond_t	idle;			/* スリープ開始通知(テストドライバ用) */
+	comClockSlot	slot[DEF_CLOCK_SLOT_MAX];
+} comClockShm;
+
+typedef struct _comClock {
+	int	kind;						/* 時刻源(COM_CLOCK_REAL/COM_CLOCK_SIM) */
+	comClockShm	*shm;				/* 仮想時刻の共有メモリ */
+} comClock;
+static comClock	g_comClock = {
+	.kind = COM_CLOCK_REAL,
+	.shm = NULL,
+};
+static pthread_once_t	g_comClockOnce = PTHREAD_ONCE_INIT;
+
 /*============================================================================*/
 /* prototype */
 /*============================================================================*/
+static int com_timespec_cmp(const struct timespec *a, const struct timespec *b);
+static void com_clock_env(void);
+static int com_clock_attach(void);
+static void com_clock_lock(comClockShm *shm);
+static void com_clock_sleep(const int id, const struct timespec *abstime);
+static void com_clock_wakeup(comClockShm *shm);
+static void com_timer_trace(const int id);
 
 /*============================================================================*/
 /* const */
@@ -42,6 +83,9 @@ static comTimer	g_comTimer[DEF_COMM_TIMER_MAX];
 #define DEF_1MILLISECOND 1000000LL
 #define DEF_1SECOND 1000000000LL
 #define DEF_SYNCHRODATA	"/synchrodata"
+#define DEF_SIMCLOCK	"/simclock"		/* 仮想時刻の共有メモリ */
+#define DEF_CLOCK_MAGIC	(0x434b4c53)	/* "SLKC" */
+#define DEF_CLOCK_ATTACH_WAIT	(1000)	/* 他プロセスの初期化待ち[ms] */
 
 /*============================================================================*/
 /*
@@ -67,13 +111,13 @@ int com_mtimer(const int id)
 		// dprintf(WARN, "com_mtimer(%d) period=%d error\n", id, g_comTimer[id].period);
 
 		// 起床時刻までスリープ
-		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &g_comTimer[id].next, NULL);
+		com_clock_sleep(id, &g_comTimer[id].next);
 		g_comTimer[id].now = g_comTimer[id].next;
 		return -1;
 	}
 
 	// 次回起床時刻を計算
-	clock_gettime(CLOCK_MONOTONIC, &now);
+	com_timer_clock_gettime(CLOCK_MONOTONIC, &now);
 
 	g_comTimer[id].next = g_comTimer[id].now;
 	
@@ -94,16 +138,29 @@ int com_mtimer(const int id)
 	}
 
 	// 起床時刻までスリープ
-	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &g_comTimer[id].next, NULL);
+	com_clock_sleep(id, &g_comTimer[id].next);
 	g_comTimer[id].now = g_comTimer[id].next;
+	com_timer_trace(id);
 
 	return cnt;
 }
 
+/*============================================================================*/
+/*
+ * @brief   タイマ初期設定
+ * @note    周期[ms]を設定し、基準時刻から初回起床時刻を算出する。
+ *          仮想時刻で動作中は共有メモリの基準時刻を使わず、仮想時刻を基準とする。
+ * @param   引数  : int id      タイマID
+ *                  int period  周期[ms]
+ * @return  戻り値: int 0:正常、-1:異常
+ * @date    2019/12/20 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 時刻源の切替に対応
+ */
+/*============================================================================*/
 int com_timer_init(const int id, int period)
 {
 	struct timespec now;
-	struct timespec	comStdTimer;
+	struct timespec	comStdTimer = {0, 0};
 	int32_t	ret;
 
 	if (id < 0 || DEF_COMM_TIMER_MAX <= id) {
@@ -112,18 +169,26 @@ int com_timer_init(const int id, int period)
 	}
 
 	// 現在時刻を取得
-	clock_gettime(CLOCK_MONOTONIC, &now);
+	com_timer_clock_gettime(CLOCK_MONOTONIC, &now);
+
+	// 仮想時刻では他プロセスと基準時刻を共有しない
+	if (g_comClock.kind == COM_CLOCK_SIM) {
+		comStdTimer = now;
+	}
 
 	// 共有メモリから基準時刻を取得
-	int shmid = com_shmem_open(DEF_SYNCHRODATA, SHM_KIND_PLATFORM);
-	if (shmid != DEF_COM_SHMEM_FALSE) {
-		ret = com_shmem_read(shmid, &comStdTimer, sizeof(comStdTimer));
-		if (ret == DEF_COM_SHMEM_FALSE) {
-			dprintf(WARN, "id=%d com_shmem_read(%s) error\n", id, DEF_SYNCHRODATA);
+	int shmid = DEF_COM_SHMEM_FALSE;
+	if (g_comClock.kind == COM_CLOCK_REAL) {
+		shmid = com_shmem_open(DEF_SYNCHRODATA, SHM_KIND_PLATFORM);
+		if (shmid != DEF_COM_SHMEM_FALSE) {
+			ret = com_shmem_read(shmid, &comStdTimer, sizeof(comStdTimer));
+			if (ret == DEF_COM_SHMEM_FALSE) {
+				dprintf(WARN, "id=%d com_shmem_read(%s) error\n", id, DEF_SYNCHRODATA);
+			}
+			com_shmem_close(shmid);
+		} else {
+			dprintf(WARN, "id=%d com_shmem_open(%s) error\n", id, DEF_SYNCHRODATA);
 		}
-		com_shmem_close(shmid);
-	} else {
-		dprintf(WARN, "id=%d com_shmem_open(%s) error\n", id, DEF_SYNCHRODATA);
 	}
 
 	// 基準時刻が未設定なら
@@ -151,3 +216,474 @@ int com_timer_init(const int id, int period)
 	return 0;
 }
 
+
+/*============================================================================*/
+/*
+ * @brief   時刻源切替
+ * @note    com_timer_init()より前に呼び出すこと。
+ *          COM_CLOCK_SIMでは共有メモリ(/simclock)の仮想時刻に参加し、時刻は
+ *          com_timer_sim_advance()/com_timer_sim_step()を呼ぶプロセス(テストドライバ)が進める。
+ *          仮想時刻は参加した全プロセスで共通となる。
+ *          環境変数HJPF_CLOCK=simで起動したプロセスは初回のタイマ使用時に参加する(com_clock_env)。
+ * @param   引数  : int kind    COM_CLOCK_REAL/COM_CLOCK_SIM
+ * @return  戻り値: int 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+int com_timer_set_clock(const int kind)
+{
+	if (kind != COM_CLOCK_REAL && kind != COM_CLOCK_SIM) {
+		dprintf(WARN, "com_timer_set_clock(%d) error\n", kind);
+		return -1;
+	}
+
+	// 環境変数による切替を先に済ませ、明示的な指定で上書きする
+	pthread_once(&g_comClockOnce, com_clock_env);
+
+	if (kind == COM_CLOCK_SIM && com_clock_attach() != 0) {
+		return -1;
+	}
+	g_comClock.kind = kind;
+
+	dprintf(INFO, "com_timer_set_clock(%s)\n", kind == COM_CLOCK_SIM ? "sim" : "real");
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   時刻源取得
+ * @note    子プロセスに時刻源を引き継ぐ場合に使用する(環境変数DEF_CLOCK_ENV_SIMを渡す)。
+ * @return  戻り値: int COM_CLOCK_REAL/COM_CLOCK_SIM
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_timer_get_clock(void)
+{
+	pthread_once(&g_comClockOnce, com_clock_env);
+	return g_comClock.kind;
+}
+
+/*============================================================================*/
+/*
+ * @brief   現在時刻取得
+ * @note    clock_gettime()の置き換え。時刻源に応じた時刻を返す。
+ *          CLOCK_MONOTONIC系/CLOCK_REALTIMEのみ仮想時刻に対応する。
+ * @param   引数  : clockid_t clk       クロック種別
+ *                  struct timespec *ts 取得時刻
+ * @return  戻り値: int 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+int com_timer_clock_gettime(const clockid_t clk, struct timespec *ts)
+{
+	comClockShm *shm;
+
+	pthread_once(&g_comClockOnce, com_clock_env);
+	if (g_comClock.kind == COM_CLOCK_REAL) {
+		return clock_gettime(clk, ts);
+	}
+
+	shm = g_comClock.shm;
+	com_clock_lock(shm);
+	*ts = shm->sim_now;
+	if (clk == CLOCK_REALTIME) {
+		ts->tv_sec += shm->sim_epoch.tv_sec;
+		ts->tv_nsec += shm->sim_epoch.tv_nsec;
+		if (ts->tv_nsec >= DEF_1SECOND) {
+			ts->tv_nsec -= DEF_1SECOND;
+			ts->tv_sec++;
+		}
+	}
+	pthread_mutex_unlock(&shm->mutex);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   仮想時刻を進める
+ * @note    テストドライバから呼び出す。起床時刻に達したタイマを全プロセスで起床させる。
+ * @param   引数  : const struct timespec *delta    進める時間
+ * @return  戻り値: int 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+int com_timer_sim_advance(const struct timespec *delta)
+{
+	comClockShm *shm = g_comClock.shm;
+
+	if (g_comClock.kind != COM_CLOCK_SIM || delta == NULL) {
+		return -1;
+	}
+
+	com_clock_lock(shm);
+	shm->sim_now.tv_sec += delta->tv_sec;
+	shm->sim_now.tv_nsec += delta->tv_nsec;
+	while (shm->sim_now.tv_nsec >= DEF_1SECOND) {
+		shm->sim_now.tv_nsec -= DEF_1SECOND;
+		shm->sim_now.tv_sec++;
+	}
+	com_clock_wakeup(shm);
+	pthread_mutex_unlock(&shm->mutex);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   仮想時刻を次の起床時刻まで進める
+ * @note    全プロセスのスリープ中のタイマのうち最も早い起床時刻まで時刻を進める。
+ *          com_timer_sim_wait()と組み合わせると、実時間によらず決定的に実行できる。
+ * @param   引数  : struct timespec *now    進めた後の仮想時刻(NULL可)
+ * @return  戻り値: int 0:正常、-1:スリープ中のタイマなし
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+int com_timer_sim_step(struct timespec *now)
+{
+	comClockShm *shm = g_comClock.shm;
+	const struct timespec *next = NULL;
+	int i;
+
+	if (g_comClock.kind != COM_CLOCK_SIM) {
+		return -1;
+	}
+
+	com_clock_lock(shm);
+	for (i = 0; i < DEF_CLOCK_SLOT_MAX; i++) {
+		if (shm->slot[i].sleeping &&
+			(next == NULL || com_timespec_cmp(&shm->slot[i].next, next) < 0)) {
+			next = &shm->slot[i].next;
+		}
+	}
+	if (next == NULL) {
+		pthread_mutex_unlock(&shm->mutex);
+		return -1;
+	}
+	if (com_timespec_cmp(next, &shm->sim_now) > 0) {
+		shm->sim_now = *next;
+	}
+	if (now != NULL) {
+		*now = shm->sim_now;
+	}
+	com_clock_wakeup(shm);
+	pthread_mutex_unlock(&shm->mutex);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   スリープ待ち合わせ
+ * @note    全プロセスで指定数のタイマが仮想時刻でスリープするまで待つ(テストドライバ用)。
+ * @param   引数  : int num     待ち合わせるタイマ数
+ * @return  戻り値: int 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+int com_timer_sim_wait(const int num)
+{
+	comClockShm *shm = g_comClock.shm;
+
+	if (g_comClock.kind != COM_CLOCK_SIM) {
+		return -1;
+	}
+
+	com_clock_lock(shm);
+	while (shm->sleeping < num) {
+		pthread_cond_wait(&shm->idle, &shm->mutex);
+	}
+	pthread_mutex_unlock(&shm->mutex);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   時刻比較
+ * @return  戻り値: int 負:a<b、0:a==b、正:a>b
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int com_timespec_cmp(const struct timespec *a, const struct timespec *b)
+{
+	if (a->tv_sec != b->tv_sec) {
+		return (a->tv_sec < b->tv_sec) ? -1 : 1;
+	}
+	if (a->tv_nsec != b->tv_nsec) {
+		return (a->tv_nsec < b->tv_nsec) ? -1 : 1;
+	}
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   環境変数による時刻源切替
+ * @note    環境変数HJPF_CLOCK=simのとき仮想時刻に参加する(pthread_onceで1回のみ)。
+ *          hjpfは自身が仮想時刻で動作する場合に限り管理プロセスへ同じ変数を渡す。
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_clock_env(void)
+{
+	const char *env = getenv(DEF_CLOCK_ENV);
+
+	if (env == NULL || strcmp(env, DEF_CLOCK_SIM) != 0) {
+		return;
+	}
+	if (com_clock_attach() == 0) {
+		g_comClock.kind = COM_CLOCK_SIM;
+		dprintf(INFO, "%s=%s\n", DEF_CLOCK_ENV, env);
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   仮想時刻の共有メモリ接続
+ * @note    最初に生成したプロセスが仮想時刻(1秒から開始)と排他を初期化する。
+ *          他プロセスは初期化完了(magic)まで待つ。生成済みなら時刻はそのまま引き継ぐ。
+ * @return  戻り値: int 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int com_clock_attach(void)
+{
+	static pthread_mutex_t attach = PTHREAD_MUTEX_INITIALIZER;
+	pthread_mutexattr_t mattr;
+	pthread_condattr_t cattr;
+	struct timespec real;
+	struct stat st;
+	comClockShm *shm;
+	int creator = 1;
+	int fd;
+	int i;
+
+	pthread_mutex_lock(&attach);
+	if (g_comClock.shm != NULL) {
+		pthread_mutex_unlock(&attach);
+		return 0;
+	}
+
+	fd = shm_open(DEF_SIMCLOCK, O_RDWR | O_CREAT | O_EXCL, DEF_COM_SHMEM_MODE);
+	if (fd < 0 && errno == EEXIST) {
+		creator = 0;
+		fd = shm_open(DEF_SIMCLOCK, O_RDWR, DEF_COM_SHMEM_MODE);
+	}
+	if (fd < 0) {
+		dprintf(WARN, "shm_open(%s) error=%d\n", DEF_SIMCLOCK, errno);
+		pthread_mutex_unlock(&attach);
+		return -1;
+	}
+
+	if (creator) {
+		if (ftruncate(fd, sizeof(comClockShm)) != 0) {
+			dprintf(WARN, "ftruncate(%s) error=%d\n", DEF_SIMCLOCK, errno);
+			close(fd);
+			shm_unlink(DEF_SIMCLOCK);
+			pthread_mutex_unlock(&attach);
+			return -1;
+		}
+	} else {
+		// 生成側のftruncate前にmmapした領域へ触れるとSIGBUSとなるため待つ
+		for (i = 0; i < DEF_CLOCK_ATTACH_WAIT; i++) {
+			if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(comClockShm)) {
+				break;
+			}
+			usleep(DEF_1MICROSECOND);
+		}
+		if (i == DEF_CLOCK_ATTACH_WAIT) {
+			dprintf(WARN, "%s size error\n", DEF_SIMCLOCK);
+			close(fd);
+			pthread_mutex_unlock(&attach);
+			return -1;
+		}
+	}
+
+	shm = mmap(NULL, sizeof(comClockShm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, DEF_COM_SHMEM_OFFSET);
+	close(fd);
+	if (shm == MAP_FAILED) {
+		dprintf(WARN, "mmap(%s) error=%d\n", DEF_SIMCLOCK, errno);
+		pthread_mutex_unlock(&attach);
+		return -1;
+	}
+
+	if (creator) {
+		// 排他中のプロセスが終了しても他プロセスが継続できるようロバストにする
+		pthread_mutexattr_init(&mattr);
+		pthread_mutexattr_setpshared(&mattr, PTHREAD_PROCESS_SHARED);
+		pthread_mutexattr_setrobust(&mattr, PTHREAD_MUTEX_ROBUST);
+		pthread_mutex_init(&shm->mutex, &mattr);
+		pthread_mutexattr_destroy(&mattr);
+		pthread_condattr_init(&cattr);
+		pthread_condattr_setpshared(&cattr, PTHREAD_PROCESS_SHARED);
+		pthread_cond_init(&shm->wakeup, &cattr);
+		pthread_cond_init(&shm->idle, &cattr);
+		pthread_condattr_destroy(&cattr);
+
+		// 仮想時刻は1秒から開始(0は基準時刻未設定と区別できないため)
+		shm->sim_now.tv_sec = 1;
+		shm->sim_now.tv_nsec = 0;
+
+		// CLOCK_REALTIME用に開始時点の実時刻との差分を保持
+		clock_gettime(CLOCK_REALTIME, &real);
+		shm->sim_epoch.tv_sec = real.tv_sec - shm->sim_now.tv_sec;
+		shm->sim_epoch.tv_nsec = real.tv_nsec;
+		atomic_store_explicit(&shm->magic, DEF_CLOCK_MAGIC, memory_order_release);
+	} else {
+		for (i = 0; i < DEF_CLOCK_ATTACH_WAIT; i++) {
+			if (atomic_load_explicit(&shm->magic, memory_order_acquire) == DEF_CLOCK_MAGIC) {
+				break;
+			}
+			usleep(DEF_1MICROSECOND);
+		}
+		if (i == DEF_CLOCK_ATTACH_WAIT) {
+			dprintf(WARN, "%s init error\n", DEF_SIMCLOCK);
+			munmap(shm, sizeof(comClockShm));
+			pthread_mutex_unlock(&attach);
+			return -1;
+		}
+	}
+
+	g_comClock.shm = shm;
+	pthread_mutex_unlock(&attach);
+
+	dprintf(INFO, "%s attached(%s)\n", DEF_SIMCLOCK, creator ? "create" : "open");
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   仮想時刻の排他取得
+ * @note    排他中のプロセスが終了していた場合は状態を回復して取得する。
+ * @param   引数  : comClockShm *shm    仮想時刻
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_clock_lock(comClockShm *shm)
+{
+	if (pthread_mutex_lock(&shm->mutex) == EOWNERDEAD) {
+		pthread_mutex_consistent(&shm->mutex);
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   起床時刻までスリープ
+ * @note    実時刻ではclock_nanosleep()、仮想時刻では時刻が進むまで条件変数で待つ。
+ *          仮想時刻ではスリープ中のタイマを共有メモリの欄に登録し、時刻を進めた側が
+ *          起床させる。欄が無い場合は登録せずに時刻の進行を待つ(com_timer_sim_stepの対象外)。
+ * @param   引数  : int id                          タイマID
+ *                  const struct timespec *abstime  起床時刻
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+static void com_clock_sleep(const int id, const struct timespec *abstime)
+{
+	comClockShm *shm;
+	comClockSlot *slot = NULL;
+	uint32_t gen;
+	int i;
+
+	pthread_once(&g_comClockOnce, com_clock_env);
+	if (g_comClock.kind == COM_CLOCK_REAL) {
+		clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, abstime, NULL);
+		return;
+	}
+
+	shm = g_comClock.shm;
+	com_clock_lock(shm);
+	if (com_timespec_cmp(&shm->sim_now, abstime) >= 0) {
+		pthread_mutex_unlock(&shm->mutex);
+		return;
+	}
+
+	for (i = 0; i < DEF_CLOCK_SLOT_MAX; i++) {
+		if (!shm->slot[i].sleeping) {
+			slot = &shm->slot[i];
+			break;
+		}
+	}
+	if (slot == NULL) {
+		dprintf(WARN, "com_mtimer(%d) %s slot full\n", id, DEF_SIMCLOCK);
+		while (com_timespec_cmp(&shm->sim_now, abstime) < 0) {
+			if (pthread_cond_wait(&shm->wakeup, &shm->mutex) == EOWNERDEAD) {
+				pthread_mutex_consistent(&shm->mutex);
+			}
+		}
+		pthread_mutex_unlock(&shm->mutex);
+		return;
+	}
+
+	slot->sleeping = 1;
+	slot->pid = getpid();
+	slot->next = *abstime;
+	gen = slot->gen;
+	shm->sleeping++;
+	pthread_cond_broadcast(&shm->idle);
+
+	// 起床判定は時刻を進めた側で行う(com_clock_wakeup)
+	// 起床後に欄が再利用されてもgenで判定できる
+	while (slot->gen == gen) {
+		if (pthread_cond_wait(&shm->wakeup, &shm->mutex) == EOWNERDEAD) {
+			pthread_mutex_consistent(&shm->mutex);
+		}
+	}
+	pthread_mutex_unlock(&shm->mutex);
+}
+
+/*============================================================================*/
+/*
+ * @brief   起床時刻に達したタイマの起床
+ * @note    仮想時刻の排他を取得した状態で呼び出すこと。
+ *          時刻を進めた時点でスリープ数から除くため、直後のcom_timer_sim_wait()が
+ *          起床前のスレッドを数えることはない。
+ * @param   引数  : comClockShm *shm    仮想時刻
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 仮想時刻を共有メモリに移動
+ */
+/*============================================================================*/
+static void com_clock_wakeup(comClockShm *shm)
+{
+	int i;
+
+	for (i = 0; i < DEF_CLOCK_SLOT_MAX; i++) {
+		if (shm->slot[i].sleeping &&
+			com_timespec_cmp(&shm->slot[i].next, &shm->sim_now) <= 0) {
+			shm->slot[i].sleeping = 0;
+			shm->slot[i].gen++;
+			shm->sleeping--;
+		}
+	}
+	pthread_cond_broadcast(&shm->wakeup);
+}
+
+/*============================================================================*/
+/*
+ * @brief   起床のトレース記録
+ * @note    起床イベント(値:タイマID)と起床遅れ[us]を記録する。
+ * @param   引数  : int id  タイマID
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_timer_trace(const int id)
+{
+	struct timespec now;
+	int64_t late;
+
+	if (!g_comTraceEnable) {
+		return;
+	}
+
+	com_timer_clock_gettime(CLOCK_MONOTONIC, &now);
+	late = (int64_t)(now.tv_sec - g_comTimer[id].next.tv_sec) * 1000000 +
+		(now.tv_nsec - g_comTimer[id].next.tv_nsec) / 1000;
+
+	TRACE_INSTANT("com_mtimer", id);
+	TRACE_COUNTER("com_mtimer_late_us", late);
+}
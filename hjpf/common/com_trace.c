@@ -0,0 +1,363 @@
+/*============================================================================*/
+/*
+ * @file    com_trace.c
+ * @brief   トレース
+ * @note    スレッド毎のバッファにイベントを記録し、Chrome trace形式で出力する。
+ *          記録時はロックを取らない(バッファはスレッド毎に専有)。
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include "com_trace.h"
+#include "debug.h"
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _traceEvent {
+	uint64_t	ts;					/* 時刻[ns](CLOCK_MONOTONIC) */
+	const char	*name;				/* イベント名(静的領域) */
+	int64_t		value;				/* カウンタ値/フローID/引数 */
+	char		type;				/* enum trace_type */
+} traceEvent;
+
+typedef struct _traceBuf {
+	atomic_int		used;			/* 割り当て中なら1(スレッド終了時に0に戻す) */
+	atomic_ulong	head;			/* 記録数(累計) */
+	pid_t			tid;
+	char			thread_name[16];
+	traceEvent		*event;			/* DEF_TRACE_EVENT_MAX個 */
+} traceBuf;
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+volatile int	g_comTraceEnable = 0;
+static traceBuf	g_traceBuf[DEF_TRACE_THREAD_MAX];
+static atomic_int	g_traceNum = 0;			/* 出力対象のバッファ数(割り当てたことのある範囲) */
+static atomic_uint	g_traceNext = 0;		/* 次に割り当てを試みるバッファ */
+static char	g_tracePath[256];
+static __thread traceBuf	*t_traceBuf = NULL;
+static __thread int	t_traceNoBuf = 0;
+static pthread_once_t	g_traceKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t	g_traceKey;			/* スレッド終了時のバッファ返却 */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static traceBuf* com_trace_buf(void);
+static void com_trace_key_init(void);
+static void com_trace_buf_release(void *arg);
+static void com_trace_json_str(FILE *fp, const char *str);
+static void com_trace_thread_name(traceBuf *buf);
+
+/*============================================================================*/
+/*
+ * @brief   トレース開始
+ * @note    pathがNULLなら環境変数HJPF_TRACEを出力先とし、未定義なら何もしない。
+ * @param   引数  : path	com_trace_stop()時の出力先
+ * @return  戻り値: 0:開始、-1:開始しない
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_trace_start(const char *path)
+{
+	if (path == NULL) {
+		path = getenv(DEF_TRACE_ENV);
+	}
+	if (path == NULL || path[0] == '\0') {
+		return -1;
+	}
+
+	snprintf(g_tracePath, sizeof(g_tracePath), "%s", path);
+	g_comTraceEnable = 1;
+	dprintf(INFO, "com_trace_start(%s)\n", g_tracePath);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   トレース停止
+ * @note    記録を停止し、com_trace_start()で指定したファイルに出力する。
+ * @return  戻り値: 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int com_trace_stop(void)
+{
+	if (!g_comTraceEnable) {
+		return -1;
+	}
+	g_comTraceEnable = 0;
+
+	return com_trace_dump(g_tracePath);
+}
+
+/*============================================================================*/
+/*
+ * @brief   イベント記録
+ * @note    TRACE_*マクロから呼び出す。
+ * @param   引数  : type	イベント種別
+ * @param   引数  : name	イベント名
+ * @param   引数  : value	カウンタ値/フローID/引数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void _com_trace(enum trace_type type, const char *name, int64_t value)
+{
+	traceBuf	*buf;
+	traceEvent	*ev;
+	unsigned long	head;
+	struct timespec	now;
+
+	buf = com_trace_buf();
+	if (buf == NULL) {
+		return;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	head = atomic_load_explicit(&buf->head, memory_order_relaxed);
+	ev = &buf->event[head % DEF_TRACE_EVENT_MAX];
+	ev->ts = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+	ev->name = name;
+	ev->value = value;
+	ev->type = (char)type;
+	atomic_store_explicit(&buf->head, head + 1, memory_order_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   トレース出力
+ * @note    全スレッドの記録をChrome trace形式(JSON)で出力する。
+ *          記録中に呼び出した場合、出力中に上書きされたイベントは不正確になり得る。
+ * @param   引数  : path	出力先ファイル
+ * @return  戻り値: 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] スレッド名を出力時に取得し直す
+ */
+/*============================================================================*/
+int com_trace_dump(const char *path)
+{
+	FILE	*fp;
+	traceBuf	*buf;
+	const traceEvent	*ev;
+	unsigned long	head;
+	unsigned long	cnt;
+	int	num;
+	int	idx;
+	int	first = 1;
+	pid_t	pid = getpid();
+
+	fp = fopen(path, "w");
+	if (fp == NULL) {
+		dprintf(WARN, "com_trace_dump fopen(%s) error\n", path);
+		return -1;
+	}
+
+	fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp);
+
+	num = atomic_load(&g_traceNum);
+	for (idx = 0; idx < num && idx < DEF_TRACE_THREAD_MAX; idx++) {
+		buf = &g_traceBuf[idx];
+		if (buf->event == NULL) {
+			continue;
+		}
+
+		// スレッド名
+		com_trace_thread_name(buf);
+		fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+			first ? "" : ",\n", (int)pid, (int)buf->tid);
+		com_trace_json_str(fp, buf->thread_name);
+		fputs("}}", fp);
+		first = 0;
+
+		head = atomic_load_explicit(&buf->head, memory_order_acquire);
+		cnt = (head > DEF_TRACE_EVENT_MAX) ? head - DEF_TRACE_EVENT_MAX : 0;
+		for (; cnt < head; cnt++) {
+			ev = &buf->event[cnt % DEF_TRACE_EVENT_MAX];
+
+			fprintf(fp, ",\n{\"name\":");
+			com_trace_json_str(fp, ev->name);
+			fprintf(fp, ",\"ph\":\"%c\",\"ts\":%llu.%03llu,\"pid\":%d,\"tid\":%d",
+				ev->type, (unsigned long long)(ev->ts / 1000), (unsigned long long)(ev->ts % 1000),
+				(int)pid, (int)buf->tid);
+
+			switch (ev->type) {
+			case TRACE_TYPE_COUNTER:
+				fprintf(fp, ",\"args\":{\"value\":%lld}", (long long)ev->value);
+				break;
+			case TRACE_TYPE_INSTANT:
+				fprintf(fp, ",\"s\":\"t\",\"args\":{\"value\":%lld}", (long long)ev->value);
+				break;
+			case TRACE_TYPE_FLOW_BEGIN:
+				fprintf(fp, ",\"cat\":\"flow\",\"id\":%lld", (long long)ev->value);
+				break;
+			case TRACE_TYPE_FLOW_END:
+				fprintf(fp, ",\"cat\":\"flow\",\"id\":%lld,\"bp\":\"e\"", (long long)ev->value);
+				break;
+			default:
+				break;
+			}
+			fputc('}', fp);
+		}
+	}
+
+	fputs("\n]}\n", fp);
+	fclose(fp);
+
+	dprintf(INFO, "com_trace_dump(%s) threads=%d\n", path, num);
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   スレッドのバッファ取得
+ * @note    初回呼び出し時に空いているバッファを割り当てる。割り当てできなければNULLを返す。
+ *          スレッド終了時にcom_trace_buf_release()で返却し、他のスレッドが再利用する。
+ *          返却したバッファの記録は再利用されるまで出力対象に残る。
+ *          なるべく古いバッファから再利用するよう、割り当ては順に巡回する。
+ * @return  戻り値: バッファ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 終了したスレッドのバッファを再利用
+ */
+/*============================================================================*/
+static traceBuf* com_trace_buf(void)
+{
+	traceBuf	*buf;
+	int	expect;
+	int	num;
+	int	idx;
+	unsigned int	start;
+
+	if (t_traceBuf != NULL || t_traceNoBuf) {
+		return t_traceBuf;
+	}
+	pthread_once(&g_traceKeyOnce, com_trace_key_init);
+
+	start = atomic_fetch_add(&g_traceNext, 1);
+	for (int cnt = 0; cnt < DEF_TRACE_THREAD_MAX; cnt++) {
+		idx = (start + cnt) % DEF_TRACE_THREAD_MAX;
+		buf = &g_traceBuf[idx];
+		expect = 0;
+		if (!atomic_compare_exchange_strong(&buf->used, &expect, 1)) {
+			continue;
+		}
+
+		if (buf->event == NULL) {
+			buf->event = calloc(DEF_TRACE_EVENT_MAX, sizeof(traceEvent));
+			if (buf->event == NULL) {
+				atomic_store(&buf->used, 0);
+				t_traceNoBuf = 1;
+				return NULL;
+			}
+		}
+
+		// 前のスレッドの記録は破棄する(スレッドIDが変わるため)
+		atomic_store_explicit(&buf->head, 0, memory_order_relaxed);
+		buf->tid = (pid_t)syscall(SYS_gettid);
+		pthread_getname_np(pthread_self(), buf->thread_name, sizeof(buf->thread_name));
+
+		// 出力の走査範囲を広げる
+		num = atomic_load(&g_traceNum);
+		while (num <= idx && !atomic_compare_exchange_weak(&g_traceNum, &num, idx + 1)) {
+		}
+
+		pthread_setspecific(g_traceKey, buf);
+		t_traceBuf = buf;
+		return buf;
+	}
+
+	t_traceNoBuf = 1;
+	return NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   バッファ返却用キーの作成
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_trace_key_init(void)
+{
+	pthread_key_create(&g_traceKey, com_trace_buf_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   バッファ返却
+ * @note    スレッド終了時に呼ばれる(pthread_keyのデストラクタ)。
+ * @param   引数  : arg		バッファ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_trace_buf_release(void *arg)
+{
+	traceBuf	*buf = (traceBuf *)arg;
+
+	t_traceBuf = NULL;
+	atomic_store_explicit(&buf->used, 0, memory_order_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   スレッド名取得
+ * @note    記録開始後にpthread_setname_np()で設定された名前を反映する。
+ *          終了済みのスレッドは記録開始時の名前のままとする。
+ * @param   引数  : buf		スレッドのバッファ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_trace_thread_name(traceBuf *buf)
+{
+	char	path[64];
+	char	name[sizeof(buf->thread_name)];
+	FILE	*fp;
+
+	snprintf(path, sizeof(path), "/proc/self/task/%d/comm", (int)buf->tid);
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		return;
+	}
+	if (fgets(name, sizeof(name), fp) != NULL) {
+		name[strcspn(name, "\n")] = '\0';
+		memcpy(buf->thread_name, name, sizeof(name));
+	}
+	fclose(fp);
+}
+
+/*============================================================================*/
+/*
+ * @brief   JSON文字列出力
+ * @param   引数  : fp		出力先
+ * @param   引数  : str		文字列
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void com_trace_json_str(FILE *fp, const char *str)
+{
+	fputc('"', fp);
+	for (; str != NULL && *str != '\0'; str++) {
+		if (*str == '"' || *str == '\\') {
+			fputc('\\', fp);
+			fputc(*str, fp);
+		} else if ((unsigned char)*str < 0x20) {
+			fprintf(fp, "\\u%04x", (unsigned char)*str);
+		} else {
+			fputc(*str, fp);
+		}
+	}
+	fputc('"', fp);
+}
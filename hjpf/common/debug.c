@@ -3,104 +3,351 @@
  * @file    debug.c
  * @brief   デバッグログ出力
  * @note    デバッグログ出力処理を行う。
+ *          debug_log_start()後はスレッド毎のロックフリーリングバッファに
+ *          フォーマット文字列と引数を格納し、低優先度の出力スレッドが
+ *          シスログまたはファイルへ出力する。
  * @date    2014/09/01
  */
 /*============================================================================*/
 /*============================================================================*/
 /* include */
 /*============================================================================*/
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <syslog.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
 #include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <time.h>
 #include "debug.h"
 
 #ifdef __DEBUG__
 
+/*============================================================================*/
+/* const */
+/*============================================================================*/
+#define DEF_DLOG_RING_NUM		(32)	/* リングバッファ数(ログ出力スレッド数上限) */
+#define DEF_DLOG_RING_SIZE		(128)	/* リングバッファ段数(2のべき乗) */
+#define DEF_DLOG_ARG_MAX		(16)	/* 保持する引数の最大数 */
+#define DEF_DLOG_STR_MAX		(192)	/* 文字列引数の格納領域[byte] */
+#define DEF_DLOG_LINE_MAX		(1024)	/* 1行の最大長[byte] */
+#define DEF_DLOG_SPEC_MAX		(32)	/* 変換指定の最大長[byte] */
+#define DEF_DLOG_DRAIN_CYCLE	(10)	/* 出力スレッドの周期[ms] */
+#define DEF_DLOG_NICE			(19)	/* 出力スレッドのnice値 */
+#define DEF_DLEVEL_DEFAULT		(3)		/* 環境変数DLEVEL未定義時のログレベル(WARN) */
+#define DEF_DLEVEL_REFRESH		(10)	/* 制御用共有メモリの反映周期[出力スレッド周期] */
+#define DEF_DECIMAL				(10)
+
+enum dlog_state {					/* 非同期出力の状態 */
+	DLOG_STATE_SYNC = 0,			/* 未開始(呼び出し元で出力) */
+	DLOG_STATE_RUNNING,				/* 出力スレッド動作中 */
+	DLOG_STATE_STOPPING,			/* 出力スレッド停止中 */
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef union _dlogArg {
+	long long	i;
+	double		d;
+	const void	*p;
+	size_t		off;				/* 文字列のstr[]内オフセット */
+} dlogArg;
+
+typedef struct _dlogEntry {
+	enum dlevel		dl;
+	int				line;
+	const char		*file;			/* __FILE__(静的領域) */
+	const char		*fmt;			/* フォーマット文字列(静的領域) */
+	struct timespec	ts;				/* 出力要求時刻(CLOCK_REALTIME) */
+	int				argc;			/* 保持した引数の数 */
+	int				trunc;			/* 引数を保持しきれなかったら1 */
+	dlogArg			arg[DEF_DLOG_ARG_MAX];
+	size_t			strlen;			/* str[]の使用量 */
+	char			str[DEF_DLOG_STR_MAX];
+} dlogEntry;
+
+typedef struct _dlogRing {
+	atomic_int		used;			/* 割り当て中なら1(スレッド終了時に0に戻す) */
+	atomic_uint		head;			/* 書き込み位置(ログ出力スレッドのみ更新) */
+	atomic_uint		tail;			/* 読み出し位置(出力スレッドのみ更新) */
+	atomic_ulong	drop;			/* 満杯で破棄した件数 */
+	unsigned long	drop_reported;	/* 通知済み破棄件数(出力スレッドのみ参照) */
+	pid_t			tid;
+	dlogEntry		ent[DEF_DLOG_RING_SIZE];
+} dlogRing;
+
+typedef struct _dlogCtl {
+	atomic_int		state;			/* enum dlog_state */
+	atomic_int		num;			/* 使用したことのあるリングバッファ数(出力スレッドの走査範囲) */
+	pthread_t		thread;
+	FILE			*fp;			/* 出力先ファイル(NULLならシスログ) */
+	dlogRing		ring[DEF_DLOG_RING_NUM];
+} dlogCtl;
+
 /*============================================================================*/
 /* global */
 /*============================================================================*/
 static const char *debugHeader[] = {
 	"", "FATAL:", "ERROR:", "WARN:", "INFO:", "DEBUG:"
 };
-//static long	g_dlevel = -1;
-//static struct timeval	g_tv;
+static dlogCtl	g_dlog;
+static pthread_once_t	g_dlogOpenOnce = PTHREAD_ONCE_INIT;
+static __thread dlogRing	*t_dlogRing = NULL;
+static pthread_once_t	g_dlogKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t	g_dlogKey;			/* スレッド終了時のリングバッファ返却 */
+static __thread int	t_dlogBusy = 0;		/* シグナルハンドラからの再入防止 */
+volatile int	g_dlevel[DLOG_MOD_MAX];		/* モジュール毎のログレベル */
+static int	g_dlevelDefault = DEF_DLEVEL_DEFAULT;
+static pthread_once_t	g_dlevelOnce = PTHREAD_ONCE_INIT;
+static atomic_long	g_dlevelRefreshMs;		/* 前回のログレベル反映時刻[ms] */
+
+static const char *dlogModuleName[DLOG_MOD_MAX] = {
+	"common", "main", "proc", "res", "failsafe", "gnss", "ins",
+	"imu", "altmt", "i2c", "ping", "camera", "mavlink", "other"
+};
+
+static const struct {
+	const char	*file;
+	int			module;
+} dlogModuleFile[] = {
+	{ "com_timer.c",	DLOG_MOD_COMMON },
+	{ "com_shmem.c",	DLOG_MOD_COMMON },
+	{ "com_fs.c",		DLOG_MOD_COMMON },
+	{ "com_procfs.c",	DLOG_MOD_COMMON },
+	{ "com_trace.c",	DLOG_MOD_COMMON },
+	{ "com_hb.c",		DLOG_MOD_COMMON },
+	{ "debug.c",		DLOG_MOD_COMMON },
+	{ "hjpf.c",			DLOG_MOD_MAIN },
+	{ "process.c",		DLOG_MOD_PROC },
+	{ "procacct.c",		DLOG_MOD_PROC },
+	{ "proccg.c",		DLOG_MOD_PROC },
+	{ "procready.c",	DLOG_MOD_PROC },
+	{ "procsched.c",	DLOG_MOD_PROC },
+	{ "procperf.c",		DLOG_MOD_PROC },
+	{ "proclog.c",		DLOG_MOD_PROC },
+	{ "resource.c",		DLOG_MOD_RES },
+	{ "thermal.c",		DLOG_MOD_RES },
+	{ "kstat.c",		DLOG_MOD_RES },
+	{ "netstat.c",		DLOG_MOD_RES },
+	{ "reshist.c",		DLOG_MOD_RES },
+	{ "schedstat.c",	DLOG_MOD_RES },
+	{ "failsafe.c",		DLOG_MOD_FAILSAFE },
+	{ "gnss.c",			DLOG_MOD_GNSS },
+	{ "ins.c",			DLOG_MOD_INS },
+	{ "imu.c",			DLOG_MOD_IMU },
+	{ "altmt.c",		DLOG_MOD_ALTMT },
+	{ "i2c.c",			DLOG_MOD_I2C },
+	{ "bme680.c",		DLOG_MOD_I2C },
+	{ "ping.c",			DLOG_MOD_PING },
+	{ "camera.c",		DLOG_MOD_CAMERA },
+	{ "mavlink.c",		DLOG_MOD_MAVLINK },
+};
+
 /*============================================================================*/
 /* prototype */
 /*============================================================================*/
-/*============================================================================*/
-/* const */
-/*============================================================================*/
+static void dlog_openlog(void);
+static int dlog_prio(enum dlevel dl);
+static dlogRing* dlog_ring(void);
+static void dlog_key_init(void);
+static void dlog_ring_release(void *arg);
+static const char* dlog_spec(const char *fmt, char *conv, int *star, int *len);
+static void dlog_capture(dlogEntry *ent, const char *fmt, va_list varg);
+static int dlog_format(const dlogEntry *ent, char *buf, size_t size);
+static void dlog_output(enum dlevel dl, const struct timespec *ts, const char *line);
+static int dlog_drain(void);
+static void* dlog_thread(void *arg);
+static void dlevel_init(void);
+static void dlevel_refresh(void);
+static void dlevel_poll(void);
+static const dlevelCtl* dlevel_map(void);
 
 /*============================================================================*/
 /*
  * @brief   デバッグログ出力処理
- * @note    デバッグログを出力する
+ * @note    デバッグログを出力する。
+ *          出力スレッド動作中はリングバッファに格納するのみでブロックしない。
+ *          リングバッファが満杯の場合は破棄し、件数を後で出力する。
  * @param   引数  : dl		ログレベル
  * @param   引数  : fmt		フォーマット文字列
  * @return  戻り値: 出力文字数
  * @date    2014/09/01 [0.0.1] 新規作成
  * 			2024/01/17 [0.0.2] シスログに，ログ種別&ファイル名&行番号，を出力
+ * 			2026/10/19 [0.0.3] リングバッファ経由の非同期出力に変更
+ * 			2026/10/19 [0.0.4] 出力スレッド未開始時もログレベルを反映
  */
 /*============================================================================*/
 int _dprintf(enum dlevel dl, const char *file, int line, const char *fmt, ...)
 {
 	va_list	varg;
 	int	ret = 0;
-	//int	base = 10;
-	//char	*strdlevel;
-	//char	*endptr;
-	//struct timeval	tv;
-	//time_t	timer;
-	//struct tm 	s_tm;
-	
-#if 0
-	if (g_dlevel < 0) {
-		// 環境変数DLEVELを取得する
-		strdlevel = getenv(DLEVEL);
-
-		// 環境変数DLEVELが定義されていれば
-		if (strdlevel != NULL) {
-			g_dlevel = strtol(strdlevel, &endptr, base);
-			gettimeofday(&g_tv, NULL);
-		} else {
-			g_dlevel = 3;
-		}
+	dlogRing	*ring;
+	dlogEntry	*ent;
+	unsigned int	head;
+	char	buf[DEF_DLOG_LINE_MAX];
+	struct timespec	ts;
+
+	if (dl < FATAL || DEBUG < dl || t_dlogBusy) {
+		return 0;
 	}
+	t_dlogBusy = 1;
 
-	// 環境変数DLEVELが定義されていれば
-	if (g_dlevel > 0) {
-		// 定義されたレベル以上のログレベルなら
-		if ((long)dl <= g_dlevel) {
-			fputs(debugHeader[dl], stderr);
-			fprintf(stderr, "%s(%d):", file, line);
-			time(&timer);
-			localtime_r(&timer, &s_tm);
-			fprintf(stderr, "%02d%02d%02d%02d%02d:", 
-            	s_tm.tm_mon + 1, s_tm.tm_mday,
-            	s_tm.tm_hour, s_tm.tm_min, s_tm.tm_sec);
-			gettimeofday(&tv, NULL);
-//			fprintf(stderr, "%5.5f:", (tv.tv_sec + tv.tv_usec * 1e-6) - (g_tv.tv_sec + g_tv.tv_usec * 1e-6));
-			fprintf(stderr, "%5.5f:", tv.tv_sec + tv.tv_usec * 1e-6);
-			g_tv = tv;
-
-			// デバッグ出力
+	// 出力スレッドが無い場合(debug_log_startを呼ばない管理プロセス等)はここで反映する
+	if (atomic_load_explicit(&g_dlog.state, memory_order_relaxed) != DLOG_STATE_RUNNING) {
+		dlevel_poll();
+	}
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	ring = NULL;
+	if (atomic_load_explicit(&g_dlog.state, memory_order_acquire) == DLOG_STATE_RUNNING) {
+		ring = dlog_ring();
+	}
+
+	if (ring != NULL) {
+		head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+		if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) >= DEF_DLOG_RING_SIZE) {
+			// 満杯なら破棄(呼び出し元をブロックしない)
+			atomic_fetch_add_explicit(&ring->drop, 1, memory_order_relaxed);
+		} else {
+			ent = &ring->ent[head & (DEF_DLOG_RING_SIZE - 1)];
+			ent->dl = dl;
+			ent->file = file;
+			ent->line = line;
+			ent->fmt = fmt;
+			ent->ts = ts;
 			va_start(varg, fmt);
-			ret = vfprintf(stderr, fmt, varg);
+			dlog_capture(ent, fmt, varg);
 			va_end(varg);
-		} else {
-			// NOP
+			atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+		}
+	} else {
+		// 出力スレッド未開始またはリングバッファ不足なら呼び出し元で出力
+		ret = snprintf(buf, sizeof(buf), "%s%s(%d):", debugHeader[dl], file, line);
+		if (ret < 0 || (size_t)ret >= sizeof(buf)) {
+			ret = 0;
+		}
+		va_start(varg, fmt);
+		vsnprintf(buf + ret, sizeof(buf) - ret, fmt, varg);
+		va_end(varg);
+		dlog_output(dl, &ts, buf);
+		ret = 0;
+	}
+
+	t_dlogBusy = 0;
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   非同期ログ出力開始
+ * @note    出力スレッドを生成する。以降のdprintfはリングバッファ経由となる。
+ * @param   引数  : path	出力先ファイル(NULLならシスログ)
+ * @return  戻り値: 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] スレッド名を設定
+ */
+/*============================================================================*/
+int debug_log_start(const char *path)
+{
+	pthread_attr_t	attr;
+	struct sched_param	param;
+	int	ret;
+
+	if (atomic_load(&g_dlog.state) != DLOG_STATE_SYNC) {
+		return -1;
+	}
+
+	g_dlog.fp = NULL;
+	if (path != NULL && path[0] != '\0') {
+		g_dlog.fp = fopen(path, "a");
+		if (g_dlog.fp == NULL) {
+			dprintf(WARN, "debug_log_start fopen(%s) error\n", path);
 		}
 	}
-#else
+
+	// 出力スレッドは実時間スレッドの設定を継承しない
+	memset(&param, 0, sizeof(param));
+	pthread_attr_init(&attr);
+	pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+	pthread_attr_setschedparam(&attr, &param);
+
+	atomic_store(&g_dlog.state, DLOG_STATE_RUNNING);
+	ret = pthread_create(&g_dlog.thread, &attr, dlog_thread, NULL);
+	pthread_attr_destroy(&attr);
+	if (ret != 0) {
+		atomic_store(&g_dlog.state, DLOG_STATE_SYNC);
+		dprintf(WARN, "debug_log_start pthread_create error=%d\n", ret);
+		return -1;
+	}
+	pthread_setname_np(g_dlog.thread, "dlog");
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   非同期ログ出力停止
+ * @note    リングバッファに残ったログを出力して出力スレッドを終了する。
+ * @return  戻り値: 0:正常、-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int debug_log_stop(void)
+{
+	if (atomic_load(&g_dlog.state) != DLOG_STATE_RUNNING) {
+		return -1;
+	}
+
+	atomic_store(&g_dlog.state, DLOG_STATE_STOPPING);
+	pthread_join(g_dlog.thread, NULL);
+
+	if (g_dlog.fp != NULL) {
+		fclose(g_dlog.fp);
+		g_dlog.fp = NULL;
+	}
+	atomic_store(&g_dlog.state, DLOG_STATE_SYNC);
+
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   シスログオープン
+ * @note    プロセスで一度だけオープンする。
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void dlog_openlog(void)
+{
+	openlog("hjpf", LOG_PID|LOG_NDELAY, LOG_DAEMON);
+}
+
+/*============================================================================*/
+/*
+ * @brief   シスログ優先度変換
+ * @param   引数  : dl		ログレベル
+ * @return  戻り値: シスログ優先度
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int dlog_prio(enum dlevel dl)
+{
 	int	prio;
-	char LogHeader[128];
-	sprintf(LogHeader, "%s%s(%d):", debugHeader[dl], file, line);
-	va_start(varg, fmt);
-	strcat(LogHeader, fmt);
 
 	switch(dl) {
 	case DEBUG:
@@ -116,19 +363,726 @@ int _dprintf(enum dlevel dl, const char *file, int line, const char *fmt, ...)
 		prio = LOG_ERR;
 		break;
 	case FATAL:
+	default:
 		prio = LOG_CRIT;
 		break;
 	}
-	openlog("hjpf", LOG_PID|LOG_NDELAY, LOG_DAEMON);
-	//vsyslog(prio, fmt, varg);
-	//va_start(varg, LogHeader);
-	vsyslog(prio, LogHeader, varg);
-	va_end(varg);
-	closelog();
 
-#endif
+	return prio;
+}
 
-	return ret;
+/*============================================================================*/
+/*
+ * @brief   スレッドのリングバッファ取得
+ * @note    初回呼び出し時に空いているリングバッファを割り当てる。
+ *          割り当てできなければNULLを返す(空きができれば次の呼び出しで割り当てる)。
+ *          スレッド終了時にdlog_ring_release()で返却し、他のスレッドが再利用する。
+ * @return  戻り値: リングバッファ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 終了したスレッドのリングバッファを再利用
+ */
+/*============================================================================*/
+static dlogRing* dlog_ring(void)
+{
+	dlogRing	*ring;
+	int	expect;
+	int	num;
+
+	if (t_dlogRing != NULL) {
+		return t_dlogRing;
+	}
+	pthread_once(&g_dlogKeyOnce, dlog_key_init);
+
+	for (int idx = 0; idx < DEF_DLOG_RING_NUM; idx++) {
+		ring = &g_dlog.ring[idx];
+		expect = 0;
+		if (!atomic_compare_exchange_strong(&ring->used, &expect, 1)) {
+			continue;
+		}
+
+		// 出力スレッドの走査範囲を広げる
+		num = atomic_load(&g_dlog.num);
+		while (num <= idx && !atomic_compare_exchange_weak(&g_dlog.num, &num, idx + 1)) {
+		}
+
+		// 前のスレッドの未出力分は残したまま続けて格納する
+		ring->tid = (pid_t)syscall(SYS_gettid);
+		pthread_setspecific(g_dlogKey, ring);
+		t_dlogRing = ring;
+		return ring;
+	}
+
+	return NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   リングバッファ返却用キーの作成
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void dlog_key_init(void)
+{
+	pthread_key_create(&g_dlogKey, dlog_ring_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   リングバッファ返却
+ * @note    スレッド終了時に呼ばれる(pthread_keyのデストラクタ)。
+ * @param   引数  : arg		リングバッファ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void dlog_ring_release(void *arg)
+{
+	dlogRing	*ring = (dlogRing *)arg;
+
+	t_dlogRing = NULL;
+	atomic_store_explicit(&ring->used, 0, memory_order_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   変換指定の解析
+ * @note    '%'の次の文字から変換指定子までを読み飛ばす。
+ * @param   引数  : fmt		'%'の次の文字
+ * @param   引数  : conv	変換指定子
+ * @param   引数  : star	'*'の数(幅・精度を引数で指定)
+ * @param   引数  : len		長さ修飾子('H':hh、'h'、'l'、'q':ll、'L'、'j'、'z'、't'、0:なし)
+ * @return  戻り値: 変換指定子の次の文字
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static const char* dlog_spec(const char *fmt, char *conv, int *star, int *len)
+{
+	*star = 0;
+	*len = 0;
+
+	// フラグ
+	while (*fmt != '\0' && strchr("-+ #0'", *fmt) != NULL) {
+		fmt++;
+	}
+	// 幅・精度
+	while (*fmt != '\0' && (strchr("0123456789.", *fmt) != NULL || *fmt == '*')) {
+		if (*fmt == '*') {
+			(*star)++;
+		}
+		fmt++;
+	}
+	// 長さ修飾子
+	while (*fmt != '\0' && strchr("hlLqjzt", *fmt) != NULL) {
+		if (*fmt == 'h' && *len == 'h') {
+			*len = 'H';
+		} else if (*fmt == 'l' && *len == 'l') {
+			*len = 'q';
+		} else {
+			*len = *fmt;
+		}
+		fmt++;
+	}
+
+	*conv = *fmt;
+	if (*fmt != '\0') {
+		fmt++;
+	}
+
+	return fmt;
+}
+
+/*============================================================================*/
+/*
+ * @brief   引数の保持
+ * @note    フォーマット文字列を解析し、引数を型に応じて取り出して保持する。
+ *          文字列はエントリ内にコピーする(呼び出し元のバッファは出力時に無効のため)。
+ * @param   引数  : ent		格納先エントリ
+ * @param   引数  : fmt		フォーマット文字列
+ * @param   引数  : varg	可変引数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void dlog_capture(dlogEntry *ent, const char *fmt, va_list varg)
+{
+	const char	*str;
+	char	conv;
+	int	star;
+	int	len;
+	int	cnt;
+	size_t	size;
+
+	ent->argc = 0;
+	ent->trunc = 0;
+	ent->strlen = 0;
+
+	while ((fmt = strchr(fmt, '%')) != NULL) {
+		fmt = dlog_spec(fmt + 1, &conv, &star, &len);
+		if (conv == '%' || conv == '\0') {
+			continue;
+		}
+		if (ent->argc + star + 1 > DEF_DLOG_ARG_MAX) {
+			ent->trunc = 1;
+			break;
+		}
+
+		// 幅・精度
+		for (cnt = 0; cnt < star; cnt++) {
+			ent->arg[ent->argc++].i = va_arg(varg, int);
+		}
+
+		switch (conv) {
+		case 'd':
+		case 'i':
+			switch (len) {
+			case 'H': ent->arg[ent->argc].i = (signed char)va_arg(varg, int); break;
+			case 'h': ent->arg[ent->argc].i = (short)va_arg(varg, int); break;
+			case 'l': ent->arg[ent->argc].i = va_arg(varg, long); break;
+			case 'q': ent->arg[ent->argc].i = va_arg(varg, long long); break;
+			case 'j': ent->arg[ent->argc].i = va_arg(varg, intmax_t); break;
+			case 'z': ent->arg[ent->argc].i = va_arg(varg, ssize_t); break;
+			case 't': ent->arg[ent->argc].i = va_arg(varg, ptrdiff_t); break;
+			default:  ent->arg[ent->argc].i = va_arg(varg, int); break;
+			}
+			break;
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			switch (len) {
+			case 'H': ent->arg[ent->argc].i = (unsigned char)va_arg(varg, unsigned int); break;
+			case 'h': ent->arg[ent->argc].i = (unsigned short)va_arg(varg, unsigned int); break;
+			case 'l': ent->arg[ent->argc].i = va_arg(varg, unsigned long); break;
+			case 'q': ent->arg[ent->argc].i = va_arg(varg, unsigned long long); break;
+			case 'j': ent->arg[ent->argc].i = va_arg(varg, uintmax_t); break;
+			case 'z': ent->arg[ent->argc].i = va_arg(varg, size_t); break;
+			case 't': ent->arg[ent->argc].i = va_arg(varg, ptrdiff_t); break;
+			default:  ent->arg[ent->argc].i = va_arg(varg, unsigned int); break;
+			}
+			break;
+		case 'c':
+			ent->arg[ent->argc].i = va_arg(varg, int);
+			break;
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			if (len == 'L') {
+				ent->arg[ent->argc].d = (double)va_arg(varg, long double);
+			} else {
+				ent->arg[ent->argc].d = va_arg(varg, double);
+			}
+			break;
+		case 's':
+			str = va_arg(varg, const char*);
+			if (str == NULL) {
+				str = "(null)";
+			}
+			size = strnlen(str, DEF_DLOG_STR_MAX - ent->strlen - 1);
+			memcpy(&ent->str[ent->strlen], str, size);
+			ent->arg[ent->argc].off = ent->strlen;
+			ent->strlen += size;
+			ent->str[ent->strlen++] = '\0';
+			if (ent->strlen >= DEF_DLOG_STR_MAX - 1) {
+				ent->strlen = DEF_DLOG_STR_MAX - 1;
+			}
+			break;
+		case 'p':
+			ent->arg[ent->argc].p = va_arg(varg, const void*);
+			break;
+		case 'n':
+			// 書き込み先は出力時に無効のため読み捨てる
+			(void)va_arg(varg, void*);
+			break;
+		default:
+			// 未対応の変換指定子以降は保持しない
+			ent->trunc = 1;
+			return;
+		}
+		ent->argc++;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   エントリの文字列化
+ * @note    保持した引数を変換指定毎にsnprintfで展開する。
+ * @param   引数  : ent		エントリ
+ * @param   引数  : buf		出力先
+ * @param   引数  : size	出力先サイズ
+ * @return  戻り値: 出力文字数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int dlog_format(const dlogEntry *ent, char *buf, size_t size)
+{
+	const char	*fmt = ent->fmt;
+	const char	*next;
+	char	spec[DEF_DLOG_SPEC_MAX];
+	char	conv;
+	int	star;
+	int	len;
+	int	argc = 0;
+	int	w = 0;
+	int	p = 0;
+	int	ret;
+	size_t	pos;
+	size_t	cnt;
+	size_t	speclen;
+	const dlogArg	*arg;
+
+	ret = snprintf(buf, size, "%s%s(%d):", debugHeader[ent->dl], ent->file, ent->line);
+	pos = (ret < 0) ? 0 : (size_t)ret;
+
+	while (*fmt != '\0' && pos < size - 1) {
+		if (*fmt != '%') {
+			buf[pos++] = *fmt++;
+			continue;
+		}
+
+		next = dlog_spec(fmt + 1, &conv, &star, &len);
+		if (conv == '%') {
+			buf[pos++] = '%';
+			fmt = next;
+			continue;
+		}
+		if (conv == '\0' || conv == 'n') {
+			fmt = next;
+			continue;
+		}
+		if (argc + star + 1 > ent->argc) {
+			// 保持できなかった引数以降はそのまま出力
+			break;
+		}
+
+		// 長さ修飾子を除いた変換指定を作成し、整数はllを付加する
+		speclen = 0;
+		for (cnt = 0; &fmt[cnt] < next - 1 && speclen < sizeof(spec) - 4; cnt++) {
+			if (strchr("hlLqjzt", fmt[cnt]) == NULL) {
+				spec[speclen++] = fmt[cnt];
+			}
+		}
+		if (strchr("diouxX", conv) != NULL) {
+			spec[speclen++] = 'l';
+			spec[speclen++] = 'l';
+		}
+		spec[speclen++] = conv;
+		spec[speclen] = '\0';
+
+		if (star > 0) {
+			w = (int)ent->arg[argc++].i;
+		}
+		if (star > 1) {
+			p = (int)ent->arg[argc++].i;
+		}
+		arg = &ent->arg[argc++];
+
+#define DLOG_SNPRINTF(val)	\
+		((star == 0) ? snprintf(&buf[pos], size - pos, spec, val) :	\
+		 (star == 1) ? snprintf(&buf[pos], size - pos, spec, w, val) :	\
+		 snprintf(&buf[pos], size - pos, spec, w, p, val))
+
+		switch (conv) {
+		case 'd':
+		case 'i':
+			ret = DLOG_SNPRINTF(arg->i);
+			break;
+		case 'o':
+		case 'u':
+		case 'x':
+		case 'X':
+			ret = DLOG_SNPRINTF((unsigned long long)arg->i);
+			break;
+		case 'c':
+			ret = DLOG_SNPRINTF((int)arg->i);
+			break;
+		case 's':
+			ret = DLOG_SNPRINTF(&ent->str[arg->off]);
+			break;
+		case 'p':
+			ret = DLOG_SNPRINTF(arg->p);
+			break;
+		default:
+			ret = DLOG_SNPRINTF(arg->d);
+			break;
+		}
+#undef DLOG_SNPRINTF
+
+		if (ret > 0) {
+			pos += (size_t)ret;
+			if (pos >= size) {
+				pos = size - 1;
+			}
+		}
+		fmt = next;
+	}
+
+	// 引数を保持できなかった部分は変換せずに出力
+	while (*fmt != '\0' && pos < size - 1) {
+		buf[pos++] = *fmt++;
+	}
+	buf[pos] = '\0';
+
+	return (int)pos;
+}
+
+/*============================================================================*/
+/*
+ * @brief   1行出力
+ * @note    ファイル出力時は時刻を付加する。
+ *          リングバッファを割り当てられないスレッドは出力スレッドと同時に呼び出すため、
+ *          1行単位でファイルをロックする。
+ * @param   引数  : dl		ログレベル
+ * @param   引数  : ts		出力要求時刻
+ * @param   引数  : line	出力文字列
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 呼び出し元での出力と行が混ざらないようロック
+ */
+/*============================================================================*/
+static void dlog_output(enum dlevel dl, const struct timespec *ts, const char *line)
+{
+	struct tm	s_tm;
+	size_t	len;
+
+	if (g_dlog.fp == NULL || atomic_load(&g_dlog.state) == DLOG_STATE_SYNC) {
+		pthread_once(&g_dlogOpenOnce, dlog_openlog);
+		syslog(dlog_prio(dl), "%s", line);
+		return;
+	}
+
+	localtime_r(&ts->tv_sec, &s_tm);
+	flockfile(g_dlog.fp);
+	fprintf(g_dlog.fp, "%04d/%02d/%02d %02d:%02d:%02d.%06ld ",
+		s_tm.tm_year + 1900, s_tm.tm_mon + 1, s_tm.tm_mday,
+		s_tm.tm_hour, s_tm.tm_min, s_tm.tm_sec, ts->tv_nsec / 1000);
+	fputs(line, g_dlog.fp);
+	len = strlen(line);
+	if (len == 0 || line[len - 1] != '\n') {
+		fputc('\n', g_dlog.fp);
+	}
+	funlockfile(g_dlog.fp);
+}
+
+/*============================================================================*/
+/*
+ * @brief   リングバッファの出力
+ * @note    全スレッドのリングバッファに溜まったログを出力する。
+ * @return  戻り値: 出力件数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 出力件数によらず書き出す
+ */
+/*============================================================================*/
+static int dlog_drain(void)
+{
+	char	buf[DEF_DLOG_LINE_MAX];
+	dlogRing	*ring;
+	const dlogEntry	*ent;
+	unsigned int	tail;
+	unsigned long	drop;
+	struct timespec	ts;
+	int	num;
+	int	idx;
+	int	cnt = 0;
+
+	num = atomic_load(&g_dlog.num);
+	for (idx = 0; idx < num && idx < DEF_DLOG_RING_NUM; idx++) {
+		ring = &g_dlog.ring[idx];
+		tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		while (tail != atomic_load_explicit(&ring->head, memory_order_acquire)) {
+			ent = &ring->ent[tail & (DEF_DLOG_RING_SIZE - 1)];
+			dlog_format(ent, buf, sizeof(buf));
+			dlog_output(ent->dl, &ent->ts, buf);
+			tail++;
+			atomic_store_explicit(&ring->tail, tail, memory_order_release);
+			cnt++;
+		}
+
+		drop = atomic_load_explicit(&ring->drop, memory_order_relaxed);
+		if (drop != ring->drop_reported) {
+			clock_gettime(CLOCK_REALTIME, &ts);
+			snprintf(buf, sizeof(buf), "%s%s(%d):tid=%d %lu messages dropped\n",
+				debugHeader[WARN], __FILE__, __LINE__, (int)ring->tid, drop - ring->drop_reported);
+			dlog_output(WARN, &ts, buf);
+			ring->drop_reported = drop;
+		}
+	}
+
+	// リングバッファを使わずに出力した行も周期毎に書き出す
+	if (g_dlog.fp != NULL) {
+		fflush(g_dlog.fp);
+	}
+
+	return cnt;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ログ出力スレッド
+ * @note    低優先度で周期的にリングバッファを出力する。
+ *          停止要求後は残ったログを出力してから終了する。
+ * @param   引数  : arg		未使用
+ * @return  戻り値: NULL
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void* dlog_thread(void *arg)
+{
+	struct timespec	cycle = {0, DEF_DLOG_DRAIN_CYCLE * 1000000L};
+	int	cnt = 0;
+
+	setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), DEF_DLOG_NICE);
+
+	while (atomic_load(&g_dlog.state) == DLOG_STATE_RUNNING) {
+		dlog_drain();
+		if (++cnt >= DEF_DLEVEL_REFRESH) {
+			dlevel_refresh();
+			cnt = 0;
+		}
+		nanosleep(&cycle, NULL);
+	}
+	dlog_drain();
+
+	return NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   呼び出し箇所の初期化
+ * @note    dprintfの初回呼び出し時に、ファイル名からモジュールを決定する。
+ * @param   引数  : site	呼び出し箇所の状態
+ * @param   引数  : file	__FILE__
+ * @return  戻り値: モジュール
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int _dlog_site_init(dlogSite *site, const char *file)
+{
+	const char	*base;
+	int	module = DLOG_MOD_OTHER;
+	size_t	cnt;
+
+	pthread_once(&g_dlevelOnce, dlevel_init);
+
+	base = strrchr(file, '/');
+	base = (base != NULL) ? base + 1 : file;
+	for (cnt = 0; cnt < sizeof(dlogModuleFile) / sizeof(dlogModuleFile[0]); cnt++) {
+		if (strcmp(base, dlogModuleFile[cnt].file) == 0) {
+			module = dlogModuleFile[cnt].module;
+			break;
+		}
+	}
+
+	site->module = module;
+	return module;
+}
+
+/*============================================================================*/
+/*
+ * @brief   呼び出し箇所毎の出力抑止
+ * @note    1秒間にDEF_DLOG_RATE_LIMIT件(FATAL・ERRORはDEF_DLOG_RATE_LIMIT_ERROR件)を
+ *          超えた出力を抑止する。
+ *          抑止した件数は次の1秒間の最初の出力前に出力する。
+ *          複数スレッドから同時に呼ばれた場合の件数の誤差は許容する。
+ * @param   引数  : site	呼び出し箇所の状態
+ * @param   引数  : dl		ログレベル
+ * @param   引数  : file	__FILE__
+ * @param   引数  : line	__LINE__
+ * @return  戻り値: 1:出力する、0:抑止する
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] FATAL・ERRORも上限を増やして抑止対象とする
+ */
+/*============================================================================*/
+int _dlog_ratelimit(dlogSite *site, int dl, const char *file, int line)
+{
+	struct timespec	now;
+	int	suppressed;
+	int	limit = (dl <= ERROR) ? DEF_DLOG_RATE_LIMIT_ERROR : DEF_DLOG_RATE_LIMIT;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+
+	if (__atomic_load_n(&site->window, __ATOMIC_RELAXED) != now.tv_sec) {
+		__atomic_store_n(&site->window, now.tv_sec, __ATOMIC_RELAXED);
+		__atomic_store_n(&site->count, 0, __ATOMIC_RELAXED);
+		suppressed = __atomic_exchange_n(&site->suppressed, 0, __ATOMIC_RELAXED);
+		if (suppressed > 0) {
+			_dprintf(WARN, file, line, "%d messages suppressed\n", suppressed);
+		}
+	}
+
+	if (__atomic_add_fetch(&site->count, 1, __ATOMIC_RELAXED) > limit) {
+		__atomic_add_fetch(&site->suppressed, 1, __ATOMIC_RELAXED);
+		return 0;
+	}
+
+	return 1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   モジュール名検索
+ * @param   引数  : name	モジュール名("camera"等)
+ * @return  戻り値: モジュール、-1:該当なし
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int debug_module_find(const char *name)
+{
+	int	module;
+
+	for (module = 0; module < DLOG_MOD_MAX; module++) {
+		if (strcmp(name, dlogModuleName[module]) == 0) {
+			return module;
+		}
+	}
+
+	return -1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   モジュール名取得
+ * @param   引数  : module	モジュール
+ * @return  戻り値: モジュール名、NULL:該当なし
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+const char* debug_module_name(int module)
+{
+	if (module < 0 || DLOG_MOD_MAX <= module) {
+		return NULL;
+	}
+
+	return dlogModuleName[module];
+}
+
+/*============================================================================*/
+/*
+ * @brief   ログレベル初期化
+ * @note    環境変数DLEVELを既定のログレベルとする。
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void dlevel_init(void)
+{
+	char	*strdlevel;
+	char	*endptr;
+	long	level;
+	int	module;
+
+	// 環境変数DLEVELを取得する
+	strdlevel = getenv(DLEVEL);
+
+	// 環境変数DLEVELが定義されていれば
+	if (strdlevel != NULL) {
+		level = strtol(strdlevel, &endptr, DEF_DECIMAL);
+		if (endptr != strdlevel && 0 <= level && level <= DEBUG) {
+			g_dlevelDefault = (int)level;
+		}
+	}
+
+	for (module = 0; module < DLOG_MOD_MAX; module++) {
+		g_dlevel[module] = g_dlevelDefault;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   ログレベル反映
+ * @note    制御用共有メモリのモジュール別ログレベルを反映する。
+ *          出力スレッドと呼び出し元(dlevel_poll)の両方から呼ばれるため、
+ *          他のスレッドが反映中なら何もしない。
+ *          共有メモリが未作成(hjpf未起動)の場合は次回再確認する。
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] com_shmemを使わず直接参照(dprintfから呼び出すため)
+ */
+/*============================================================================*/
+static void dlevel_refresh(void)
+{
+	static pthread_mutex_t	mutex = PTHREAD_MUTEX_INITIALIZER;
+	static const dlevelCtl	*ctl = NULL;
+	int32_t	level;
+	int	module;
+
+	if (pthread_mutex_trylock(&mutex) != 0) {
+		return;
+	}
+	pthread_once(&g_dlevelOnce, dlevel_init);
+
+	if (ctl == NULL) {
+		ctl = dlevel_map();
+	}
+
+	if (ctl != NULL) {
+		for (module = 0; module < DLOG_MOD_MAX; module++) {
+			level = __atomic_load_n(&ctl->level[module], __ATOMIC_RELAXED);
+			if (FATAL <= level && level <= DEBUG) {
+				g_dlevel[module] = level;
+			} else {
+				g_dlevel[module] = g_dlevelDefault;
+			}
+		}
+	}
+
+	pthread_mutex_unlock(&mutex);
+}
+
+/*============================================================================*/
+/*
+ * @brief   ログレベル反映(呼び出し元)
+ * @note    出力スレッドの反映周期と同じ間隔で、dprintfの呼び出し元から反映する。
+ *          出力が抑止されたログレベルの呼び出しでは反映しないため、
+ *          ログレベルを上げた場合は次に出力されるログの時点で反映される。
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void dlevel_poll(void)
+{
+	struct timespec	now;
+	long	ms;
+	long	prev;
+
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+	ms = (long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+	prev = atomic_load_explicit(&g_dlevelRefreshMs, memory_order_relaxed);
+	if (prev != 0 && ms - prev < DEF_DLEVEL_REFRESH * DEF_DLOG_DRAIN_CYCLE) {
+		return;
+	}
+	if (!atomic_compare_exchange_strong(&g_dlevelRefreshMs, &prev, ms)) {
+		return;
+	}
+
+	dlevel_refresh();
+}
+
+/*============================================================================*/
+/*
+ * @brief   制御用共有メモリの参照
+ * @note    com_shmemはdprintfを呼び出す処理(排他中を含む)から使えないため、
+ *          読み込み専用で直接マッピングする(ログレベルは1要素ずつ参照する)。
+ * @return  戻り値: 制御用共有メモリ、NULL:未作成
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static const dlevelCtl* dlevel_map(void)
+{
+	struct stat	st;
+	void	*addr;
+	int	fd;
+
+	fd = shm_open(DEF_DLEVEL_SHMEM_NAME, O_RDONLY | O_CLOEXEC, 0);
+	if (fd < 0) {
+		return NULL;
+	}
+	if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(dlevelCtl)) {
+		close(fd);
+		return NULL;
+	}
+	addr = mmap(NULL, sizeof(dlevelCtl), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	return (addr != MAP_FAILED) ? (const dlevelCtl *)addr : NULL;
 }
 
 #endif // __DEBUG__
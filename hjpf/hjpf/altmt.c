@@ -33,6 +33,7 @@
 /* ************************************************************************** */
 #include "altmt.h"
 #include "debug.h"
+#include "com_trace.h"
 #include "com_shmem.h"
 #include "hjpf.h"
 #include "resource.h"
@@ -63,6 +64,7 @@
 /* ************************************************************************** */
 static STR_ALTMT_INFO AltmtInfo;							/* 受信した高度計のデータ */
 static uint32_t sAltmtSaveLen;									/* セーブフレームのサイズ */
+static struct timespec sAltmtArrival;							/* データ到着時刻 */
 
 
 /* ************************************************************************** */
@@ -120,6 +122,11 @@ static int32_t altmt_serial_recv(int32_t aFiledes, char* aSaveFrame)
     /* シリアル受信 */
     tSize = read(aFiledes, tFrame, DEF_ALTMT_READ_SIZE);
 	pthread_mutex_unlock(&g_mutex);
+    if (tSize > 0)
+    {
+        /* データ到着時刻 */
+        clock_gettime(CLOCK_MONOTONIC, &sAltmtArrival);
+    }
 
     if (tSize == -1)
     {
@@ -231,18 +238,20 @@ void* altmt_serial_main(void* arg)
     tFiledes = com_serial_open(uartALTMT->devname, tBaudrate);
 
     AltmtInfo.Stat = 0;
-    com_shmem_write(tShmemID, &AltmtInfo, sizeof(AltmtInfo));
+    com_shmem_write_ts(tShmemID, &AltmtInfo, sizeof(AltmtInfo), &sAltmtArrival);
     
     /* IMUデータ受信 */
     while(gComm_StopFlg == DEF_COMM_OFF)
     {
+        TRACE_BEGIN("altmt_serial_recv");
         ret = altmt_serial_recv(tFiledes, savefr);
+        TRACE_END("altmt_serial_recv");
         if (ret == DEF_ALTMT_TRUE)
         {
             /* 共有メモリに書き込み */
             timeout_cnt = 0;
             AltmtInfo.Stat = 0;
-            com_shmem_write(tShmemID, &AltmtInfo, sizeof(AltmtInfo));
+            com_shmem_write_ts(tShmemID, &AltmtInfo, sizeof(AltmtInfo), &sAltmtArrival);
         }
         else
         {
@@ -259,7 +268,7 @@ void* altmt_serial_main(void* arg)
         if(timeout_cnt > uartALTMT->timeout)
         {
             AltmtInfo.Stat = 1;
-            com_shmem_write(tShmemID, &AltmtInfo, sizeof(AltmtInfo));
+            com_shmem_write_ts(tShmemID, &AltmtInfo, sizeof(AltmtInfo), &sAltmtArrival);
             com_serial_close(tFiledes);
             tFiledes = com_serial_open(uartALTMT->devname, tBaudrate);
         }
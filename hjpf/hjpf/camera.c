@@ -30,6 +30,7 @@
 #include "com_timer.h"
 #include "com_shmem.h"
 #include "debug.h"
+#include "com_trace.h"
 #include "hjpf.h"
 #include "camera.h"
 #include "resource.h"
@@ -52,7 +53,7 @@ static int xioctl(int _fd, int request, void *arg);
 static void close_device(int _fd);
 static int stream_stop(int _fd);
 static int unmap_buffer(size_t buffer_size, struct buffer *_buffer);
-static int dequeue_buffer(int _fd);
+static int dequeue_buffer(int _fd, struct timespec *arrival);
 static int start_streaming(int _fd);
 static int enqueue_buffer(int _fd, size_t index);
 static int enqueue_buffers(int _fd, size_t buffer_size);
@@ -81,7 +82,7 @@ static int CameraInit(size_t camera_num);
 /*============================================================================*/
 static int xioctl(int _fd, int request, void *arg)
 {
-    dprintf(INFO, "xioctl(%d, %d, %s)\n", _fd, request, arg);
+    dprintf(DEBUG, "xioctl(%d, %d, %p)\n", _fd, request, arg);
     int r;
     do
         r = ioctl(_fd, request, arg);
@@ -169,13 +170,16 @@ static int unmap_buffer(size_t buffer_size, struct buffer *_buffer)
  * @brief   バッファデキュー
  * @note    バッファをデキューする
  * @param   引数  : _fd     ファイルディスクリプタ（カメラデバイス）
+ *                  arrival フレーム到着時刻の格納先（CLOCK_MONOTONIC）
  *
  * @return  戻り値: -1以外  デキューされたバッファの番号
  *                  -1      デキュー失敗
  * @date    2023/12/08 [1.0.0] 
+ *          2026/10/19 [1.0.1] フレーム到着時刻を追加
+ *          2026/10/19 [1.0.2] フレーム毎に発生し得る失敗はWARNで出力
  */
 /*============================================================================*/
-static int dequeue_buffer(int _fd)
+static int dequeue_buffer(int _fd, struct timespec *arrival)
 {
   struct pollfd fds[1];
   fds[0].fd = _fd;
@@ -183,7 +187,7 @@ static int dequeue_buffer(int _fd)
   int p = poll(fds, 1, 5000);
   if (-1 == p)
   {
-    perror("Waiting for Frame");
+    dprintf(WARN, "Waiting for Frame: %s\n", strerror(errno));
     return DEF_RET_NG;
   }
 
@@ -192,9 +196,20 @@ static int dequeue_buffer(int _fd)
   buf.memory = V4L2_MEMORY_MMAP;
   if (-1 == xioctl(_fd, VIDIOC_DQBUF, &buf))
   {
-    perror("Retrieving Frame");
+    dprintf(WARN, "Retrieving Frame: %s\n", strerror(errno));
     return DEF_RET_NG;
   }
+
+  /* ドライバのタイムスタンプがCLOCK_MONOTONICならそれを到着時刻とする */
+  if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+  {
+    arrival->tv_sec = buf.timestamp.tv_sec;
+    arrival->tv_nsec = buf.timestamp.tv_usec * 1000;
+  }
+  else
+  {
+    clock_gettime(CLOCK_MONOTONIC, arrival);
+  }
   return buf.index;
 }
 
@@ -440,6 +455,7 @@ static int is_camera(int _fd)
 static int CameraRun(cameraInfo *CameraInfo, size_t cameraNum)
 {
     int timeout_cnt = 0;
+    struct timespec arrival = {0, 0};   /* フレーム到着時刻 */
 
     if (is_camera(CameraInfo->fd) == DEF_RET_NG)
     {
@@ -478,17 +494,19 @@ static int CameraRun(cameraInfo *CameraInfo, size_t cameraNum)
     }
     com_timer_init(ENUM_TIMER_CAMERA, g_CameraInfo->period);
     g_CameraStat[cameraNum]->Stat = 0;
-    com_shmem_write(CameraInfo->shm_id, g_CameraStat[cameraNum], sizeof(cameraStat));
+    com_shmem_write_ts(CameraInfo->shm_id, g_CameraStat[cameraNum], sizeof(cameraStat), &arrival);
 
     while (gComm_StopFlg == DEF_COMM_OFF)
     {
-        int index = dequeue_buffer(CameraInfo->fd);
+        TRACE_BEGIN("camera_dequeue");
+        int index = dequeue_buffer(CameraInfo->fd, &arrival);
+        TRACE_END("camera_dequeue");
         if (index == -1)
         {
             if(timeout_cnt > g_CameraInfo->timeout)
             {
                 g_CameraStat[cameraNum]->Stat = 1;
-                com_shmem_write(CameraInfo->shm_id, g_CameraStat[cameraNum], sizeof(cameraStat));
+                com_shmem_write_ts(CameraInfo->shm_id, g_CameraStat[cameraNum], sizeof(cameraStat), &arrival);
             }
 
 			com_mtimer(ENUM_TIMER_CAMERA);
@@ -501,14 +519,18 @@ static int CameraRun(cameraInfo *CameraInfo, size_t cameraNum)
         g_CameraStat[cameraNum]->Stat = 0;
 
         struct timespec now;
-        clock_gettime(CLOCK_MONOTONIC, &now);
+        com_timer_clock_gettime(CLOCK_MONOTONIC, &now);
         g_CameraStat[cameraNum]->timestamp = now.tv_sec * 1000 + now.tv_nsec / 1000000;
 
+        TRACE_BEGIN("camera_copy");
         memcpy(g_CameraStat[cameraNum]->img_data , CameraInfo->buffers[index].start, CameraInfo->buffers[index].length);
-        com_shmem_write(CameraInfo->shm_id, g_CameraStat[cameraNum], sizeof(cameraStat));
+        TRACE_END("camera_copy");
+        com_shmem_write_ts(CameraInfo->shm_id, g_CameraStat[cameraNum], sizeof(cameraStat), &arrival);
         //free(pCameraStat);
 
+        TRACE_BEGIN("camera_enqueue");
         enqueue_buffer(CameraInfo->fd, index);
+        TRACE_END("camera_enqueue");
 
         com_mtimer(ENUM_TIMER_CAMERA);
         timeout_cnt += g_CameraInfo->period;
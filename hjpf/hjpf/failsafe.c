@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <signal.h>
 #include <sys/time.h>
@@ -34,6 +35,7 @@
 /* include(ユーザ定義ヘッダ)                                                  */
 /* ************************************************************************** */
 #include "debug.h"
+#include "com_trace.h"
 #include "com_timer.h"
 #include "com_shmem.h"
 #include "failsafe.h"
@@ -46,6 +48,8 @@
 #include "i2c.h"
 #include "camera.h"
 #include "mavlink.h"
+#include "thermal.h"
+#include "netstat.h"
 
 /* ************************************************************************** */
 /* マクロ定義                                                                 */
@@ -83,42 +87,55 @@ static HMC6343 FsInfoMAG;										/* 磁気センサリソース情報 */
 static BME680 FsInfoATM;										/* 大気圧計リソース情報 */
 static cameraStat FsInfoCamera[6];									/* カメラリソース情報 */
 static mavlinkRecv FsInfoMavlink;								/* キューブパイロット情報 */
+static failsafeExt FsExt;										/* 拡張監視情報 */
+static thermalStat *FsInfoThermal = NULL;						/* 温度監視情報(サイズは生成側で決まる) */
+static int32_t FsInfoThermalSize = 0;
+static netStat *FsInfoNet = NULL;								/* ネットワーク監視情報(サイズは生成側で決まる) */
+static int32_t FsInfoNetSize = 0;
+static int32_t FsExtNetNum = 0;									/* 拡張監視のNET.項目数 */
+static resourceStat *FsInfoRescExt = NULL;						/* CPU毎の負荷を含むリソース情報(サイズは生成側で決まる) */
+static int32_t FsInfoRescExtSize = 0;
+static int32_t FsExtCpuNum = 0;									/* 拡張監視のCPU.項目数 */
+static int32_t FsExtPSINum = 0;									/* 拡張監視のPSI.項目数 */
+static uint32_t FsExtPSIEvents[DEF_FS_EXT_MAX];					/* PSI.項目の前回判定時のトリガ発生回数 */
+static uint8_t FsExtPSIValid[DEF_FS_EXT_MAX];					/* 1:FsExtPSIEventsが有効 */
+static int32_t FsExtCpuAll = DEF_FS_FALSE;						/* CPU.allの閾値(-1:未展開の指定なし) */
 
 static failsafeTable FsTable[] = {
-	{ENUM_FS_PROC, DEF_PROC_SHMMNG_NAME, &FsInfoProc, sizeof(FsInfoProc), &FsThresh[0], &(FsInfoProc.stat[0]), &(FsInfo.proc)},	
-	{ENUM_FS_CPU, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[1], &(FsInfoResc.cpu_load[0]), &(FsInfo.cpu_load[0])},
-	{ENUM_FS_CPU1, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[2], &(FsInfoResc.cpu_load[1]), &(FsInfo.cpu_load[1])},
-	{ENUM_FS_CPU2, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[3], &(FsInfoResc.cpu_load[2]), &(FsInfo.cpu_load[2])},
-	{ENUM_FS_CPU3, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[4], &(FsInfoResc.cpu_load[3]), &(FsInfo.cpu_load[3])},
-	{ENUM_FS_CPU4, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[5], &(FsInfoResc.cpu_load[4]), &(FsInfo.cpu_load[4])},
-	{ENUM_FS_CPU5, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[6], &(FsInfoResc.cpu_load[5]), &(FsInfo.cpu_load[5])},
-	{ENUM_FS_CPU6, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[7], &(FsInfoResc.cpu_load[6]), &(FsInfo.cpu_load[6])},
-	{ENUM_FS_CPU7, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[8], &(FsInfoResc.cpu_load[7]), &(FsInfo.cpu_load[7])},
-	{ENUM_FS_CPU8, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[9], &(FsInfoResc.cpu_load[8]), &(FsInfo.cpu_load[8])},
-	{ENUM_FS_CPU9, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[10], &(FsInfoResc.cpu_load[9]), &(FsInfo.cpu_load[9])},
-	{ENUM_FS_CPU10, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[11], &(FsInfoResc.cpu_load[10]), &(FsInfo.cpu_load[10])},
-	{ENUM_FS_CPU11, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[12], &(FsInfoResc.cpu_load[11]), &(FsInfo.cpu_load[11])},
-	{ENUM_FS_CPU12, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[13], &(FsInfoResc.cpu_load[12]), &(FsInfo.cpu_load[12])},
-	{ENUM_FS_MEM, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[14], &(FsInfoResc.mem_load), &(FsInfo.mem)},
-	{ENUM_FS_DISK, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[15], &(FsInfoResc.disk_load), &(FsInfo.disk)},
-	{ENUM_FS_THERM, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[16], &(FsInfoResc.cpu_therm), &(FsInfo.cpu_therm)},
-	{ENUM_FS_CAMERA1, "/readcam0", &FsInfoCamera[0], sizeof(FsInfoCamera[0]), &FsThresh[17], &(FsInfoCamera[0].Stat), &(FsInfo.camera[0])},
-	{ENUM_FS_CAMERA2, "/readcam1", &FsInfoCamera[1], sizeof(FsInfoCamera[1]), &FsThresh[18], &(FsInfoCamera[1].Stat), &(FsInfo.camera[1])},
-	{ENUM_FS_CAMERA3, "/readcam2", &FsInfoCamera[2], sizeof(FsInfoCamera[2]), &FsThresh[19], &(FsInfoCamera[2].Stat), &(FsInfo.camera[2])},
-	{ENUM_FS_CAMERA4, "/readcam3", &FsInfoCamera[3], sizeof(FsInfoCamera[3]), &FsThresh[20], &(FsInfoCamera[3].Stat), &(FsInfo.camera[3])},
-	{ENUM_FS_CAMERA5, "/readcam4", &FsInfoCamera[4], sizeof(FsInfoCamera[4]), &FsThresh[21], &(FsInfoCamera[4].Stat), &(FsInfo.camera[4])},
-	{ENUM_FS_CAMERA6, "/readcam5", &FsInfoCamera[5], sizeof(FsInfoCamera[5]), &FsThresh[22], &(FsInfoCamera[5].Stat), &(FsInfo.camera[5])},
-	{ENUM_FS_ALTITUDE, DEF_ALTMT_SHMEM_NAME, &FsInfoALTMT, sizeof(FsInfoALTMT), &FsThresh[23], &(FsInfoALTMT.Stat), &(FsInfo.altitude)},
-	{ENUM_FS_GNSS_TAKION, DEF_GNSS_SHMEM_NAME, &FsInfoGNSS, sizeof(FsInfoGNSS), &FsThresh[24], &(FsInfoGNSS.Stat), &(FsInfo.gnss_takion)},
-	{ENUM_FS_INS, DEF_INS_SHMEM_NAME, &FsInfoINS, sizeof(FsInfoINS), &FsThresh[25], &(FsInfoINS.Stat), &(FsInfo.ins)},
-	{ENUM_FS_IMU, DEF_IMU_SHMEM_NAME, &FsInfoIMU, sizeof(FsInfoIMU), &FsThresh[26], &(FsInfoIMU.Stat), &(FsInfo.imu)},
-	{ENUM_FS_WIFI, "/wifi", &FsInfoPING[0], sizeof(FsInfoPING[0]), &FsThresh[27], &(FsInfoPING[0].Stat), &(FsInfo.wifi)},
-	{ENUM_FS_ATM_PRESSURE, DEF_BME_SHMEM_NAME, &FsInfoATM, sizeof(FsInfoATM), &FsThresh[28], &(FsInfoATM.Stat), &(FsInfo.atm_pressure)},
-	{ENUM_FS_ECU_JETSON1, "/ecu0", &FsInfoPING[1], sizeof(FsInfoPING[1]), &FsThresh[29], &(FsInfoPING[1].Stat), &(FsInfo.ecu_jetson[0])},
-	{ENUM_FS_ECU_JETSON2, "/ecu1", &FsInfoPING[2], sizeof(FsInfoPING[2]), &FsThresh[30], &(FsInfoPING[2].Stat), &(FsInfo.ecu_jetson[1])},
-	{ENUM_FS_ECU_JETSON3, "/ecu2", &FsInfoPING[3], sizeof(FsInfoPING[3]), &FsThresh[31], &(FsInfoPING[3].Stat), &(FsInfo.ecu_jetson[2])},
-	{ENUM_FS_MAG, DEF_HMC_SHMEM_NAME, &FsInfoMAG, sizeof(FsInfoMAG), &FsThresh[32], &(FsInfoMAG.Stat), &(FsInfo.mag)},
-	{ENUM_FS_ECU, "/mavlink_recv", &FsInfoMavlink, sizeof(FsInfoMavlink), &FsThresh[33], &(FsInfoMavlink.Stat), &(FsInfo.ecu)},
+	{ENUM_FS_PROC, DEF_PROC_SHMMNG_NAME, &FsInfoProc, sizeof(FsInfoProc), &FsThresh[0], &(FsInfoProc.stat[0]), &(FsInfo.proc), "PROC"},
+	{ENUM_FS_CPU, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[1], &(FsInfoResc.cpu_load[0]), &(FsInfo.cpu_load[0]), "CPULoad1"},
+	{ENUM_FS_CPU1, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[2], &(FsInfoResc.cpu_load[1]), &(FsInfo.cpu_load[1]), "CPULoad2"},
+	{ENUM_FS_CPU2, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[3], &(FsInfoResc.cpu_load[2]), &(FsInfo.cpu_load[2]), "CPULoad3"},
+	{ENUM_FS_CPU3, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[4], &(FsInfoResc.cpu_load[3]), &(FsInfo.cpu_load[3]), "CPULoad4"},
+	{ENUM_FS_CPU4, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[5], &(FsInfoResc.cpu_load[4]), &(FsInfo.cpu_load[4]), "CPULoad5"},
+	{ENUM_FS_CPU5, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[6], &(FsInfoResc.cpu_load[5]), &(FsInfo.cpu_load[5]), "CPULoad6"},
+	{ENUM_FS_CPU6, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[7], &(FsInfoResc.cpu_load[6]), &(FsInfo.cpu_load[6]), "CPULoad7"},
+	{ENUM_FS_CPU7, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[8], &(FsInfoResc.cpu_load[7]), &(FsInfo.cpu_load[7]), "CPULoad8"},
+	{ENUM_FS_CPU8, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[9], &(FsInfoResc.cpu_load[8]), &(FsInfo.cpu_load[8]), "CPULoad9"},
+	{ENUM_FS_CPU9, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[10], &(FsInfoResc.cpu_load[9]), &(FsInfo.cpu_load[9]), "CPULoad10"},
+	{ENUM_FS_CPU10, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[11], &(FsInfoResc.cpu_load[10]), &(FsInfo.cpu_load[10]), "CPULoad11"},
+	{ENUM_FS_CPU11, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[12], &(FsInfoResc.cpu_load[11]), &(FsInfo.cpu_load[11]), "CPULoad12"},
+	{ENUM_FS_CPU12, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[13], &(FsInfoResc.cpu_load[12]), &(FsInfo.cpu_load[12]), "CPULoad13"},
+	{ENUM_FS_MEM, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[14], &(FsInfoResc.mem_load), &(FsInfo.mem), "MEM"},
+	{ENUM_FS_DISK, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[15], &(FsInfoResc.disk_load), &(FsInfo.disk), "DISK"},
+	{ENUM_FS_THERM, DEF_RES_SHMMNG_NAME, &FsInfoResc, sizeof(FsInfoResc), &FsThresh[16], &(FsInfoResc.cpu_therm), &(FsInfo.cpu_therm), "THERM"},
+	{ENUM_FS_CAMERA1, "/readcam0", &FsInfoCamera[0], sizeof(FsInfoCamera[0]), &FsThresh[17], &(FsInfoCamera[0].Stat), &(FsInfo.camera[0]), "CAMERA0"},
+	{ENUM_FS_CAMERA2, "/readcam1", &FsInfoCamera[1], sizeof(FsInfoCamera[1]), &FsThresh[18], &(FsInfoCamera[1].Stat), &(FsInfo.camera[1]), "CAMERA1"},
+	{ENUM_FS_CAMERA3, "/readcam2", &FsInfoCamera[2], sizeof(FsInfoCamera[2]), &FsThresh[19], &(FsInfoCamera[2].Stat), &(FsInfo.camera[2]), "CAMERA2"},
+	{ENUM_FS_CAMERA4, "/readcam3", &FsInfoCamera[3], sizeof(FsInfoCamera[3]), &FsThresh[20], &(FsInfoCamera[3].Stat), &(FsInfo.camera[3]), "CAMERA3"},
+	{ENUM_FS_CAMERA5, "/readcam4", &FsInfoCamera[4], sizeof(FsInfoCamera[4]), &FsThresh[21], &(FsInfoCamera[4].Stat), &(FsInfo.camera[4]), "CAMERA4"},
+	{ENUM_FS_CAMERA6, "/readcam5", &FsInfoCamera[5], sizeof(FsInfoCamera[5]), &FsThresh[22], &(FsInfoCamera[5].Stat), &(FsInfo.camera[5]), "CAMERA5"},
+	{ENUM_FS_ALTITUDE, DEF_ALTMT_SHMEM_NAME, &FsInfoALTMT, sizeof(FsInfoALTMT), &FsThresh[23], &(FsInfoALTMT.Stat), &(FsInfo.altitude), "ALT"},
+	{ENUM_FS_GNSS_TAKION, DEF_GNSS_SHMEM_NAME, &FsInfoGNSS, sizeof(FsInfoGNSS), &FsThresh[24], &(FsInfoGNSS.Stat), &(FsInfo.gnss_takion), "GNSS"},
+	{ENUM_FS_INS, DEF_INS_SHMEM_NAME, &FsInfoINS, sizeof(FsInfoINS), &FsThresh[25], &(FsInfoINS.Stat), &(FsInfo.ins), "INS"},
+	{ENUM_FS_IMU, DEF_IMU_SHMEM_NAME, &FsInfoIMU, sizeof(FsInfoIMU), &FsThresh[26], &(FsInfoIMU.Stat), &(FsInfo.imu), "IMU"},
+	{ENUM_FS_WIFI, "/wifi", &FsInfoPING[0], sizeof(FsInfoPING[0]), &FsThresh[27], &(FsInfoPING[0].Stat), &(FsInfo.wifi), "WIFI"},
+	{ENUM_FS_ATM_PRESSURE, DEF_BME_SHMEM_NAME, &FsInfoATM, sizeof(FsInfoATM), &FsThresh[28], &(FsInfoATM.Stat), &(FsInfo.atm_pressure), "ATM"},
+	{ENUM_FS_ECU_JETSON1, "/ecu0", &FsInfoPING[1], sizeof(FsInfoPING[1]), &FsThresh[29], &(FsInfoPING[1].Stat), &(FsInfo.ecu_jetson[0]), "ECUJetson0"},
+	{ENUM_FS_ECU_JETSON2, "/ecu1", &FsInfoPING[2], sizeof(FsInfoPING[2]), &FsThresh[30], &(FsInfoPING[2].Stat), &(FsInfo.ecu_jetson[1]), "ECUJetson1"},
+	{ENUM_FS_ECU_JETSON3, "/ecu2", &FsInfoPING[3], sizeof(FsInfoPING[3]), &FsThresh[31], &(FsInfoPING[3].Stat), &(FsInfo.ecu_jetson[2]), "ECUJetson2"},
+	{ENUM_FS_MAG, DEF_HMC_SHMEM_NAME, &FsInfoMAG, sizeof(FsInfoMAG), &FsThresh[32], &(FsInfoMAG.Stat), &(FsInfo.mag), "MAG"},
+	{ENUM_FS_ECU, "/mavlink_recv", &FsInfoMavlink, sizeof(FsInfoMavlink), &FsThresh[33], &(FsInfoMavlink.Stat), &(FsInfo.ecu), "ECU"},
 	//{ENUM_FS_ECU, &FsThresh[26]},
 };				    /* 監視一覧表 */
 
@@ -134,6 +151,19 @@ extern int gComm_StopFlg;
 static int32_t FailsafeConf(char aFilename[]);
 static int32_t FailsafeJudge(int32_t aIndex);
 static int32_t FailsafeGetID(ENUM_FS_ERRCODE aErrcode);
+static int32_t FailsafeLevel(int32_t aValue, int32_t aThresh, int32_t aLevel);
+static int32_t FailsafeExtAdd(GKeyFile* aKeyFile, const char* aGroup);
+static void FailsafeExtCpuAll(int32_t aCpuNum);
+static void FailsafeExtJudge(void);
+static int32_t FailsafeExtValue(failsafeExtEntry *aEntry, const thermalStat *aThermal, const netStat *aNet, const resourceStat *aResc, int32_t *aThresh);
+static int32_t FailsafeExtNetValue(failsafeExtEntry *aEntry, const netStat *aNet);
+static int32_t FailsafeExtDiskValue(failsafeExtEntry *aEntry);
+static int32_t FailsafeExtCpuValue(failsafeExtEntry *aEntry, const resourceStat *aResc);
+static int32_t FailsafeExtPSIValue(failsafeExtEntry *aEntry, const resourceStat *aResc);
+static int32_t FailsafeReadShmem(const char* aName, void** aBuf, int32_t* aBufSize);
+static const thermalStat* FailsafeReadThermal(void);
+static const netStat* FailsafeReadNet(void);
+static const resourceStat* FailsafeReadResc(void);
 
 
 /* ************************************************************************** */
@@ -147,12 +177,20 @@ static int32_t FailsafeGetID(ENUM_FS_ERRCODE aErrcode);
  * 引数:    aFilename：[i] 設定ファイル名
  * 戻り値:  0：正常終了，-1：エラー
  * 作成日   2023/12/12 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] グループ名で閾値を対応付けるよう変更
+ *          2026/10/19 [0.0.3] 拡張監視(THERM.<zone種別>，THROTTLE)を追加
+ *          2026/10/19 [0.0.4] 拡張監視にPSI.<種別>を追加
+ *          2026/10/19 [0.0.5] 拡張監視にNET.<インタフェース名>.<項目>を追加
+ *          2026/10/19 [0.0.6] 拡張監視にDISK.<デバイス名>.<項目>，MOUNT.<マウントポイント>を追加
+ *          2026/10/19 [0.0.7] 拡張監視にCPU.<CPU番号>，CPU.allを追加
+ *          2026/10/19 [0.0.8] PSI.<種別>をトリガの発生回数で判定
  */
 /* ************************************************************************** */
 static int32_t FailsafeConf(char aFilename[])
 {
     int32_t ret = DEF_FS_TRUE;	/* 戻り値変数 */
     int32_t tErrNum = 0;        /* エラー一覧数 */
+	int32_t index;				/* 監視一覧表の位置 */
 	GKeyFile* tFSKeyFile;
 	GError* err = NULL;
 	gchar** tGroupArray;
@@ -172,12 +210,32 @@ static int32_t FailsafeConf(char aFilename[])
 
 		for (int cnt = 0; cnt < tErrNum; cnt++)
 		{
+			/* グループ名から監視一覧表の位置を検索(記述順に依存しない) */
+			index = -1;
+			for (int i = 0; i < (int)(sizeof(FsTable) / sizeof(FsTable[0])); i++)
+			{
+				if (0 == strcmp(FsTable[i].confname, tGroupArray[cnt]))
+				{
+					index = i;
+					break;
+				}
+			}
+			if (index < 0)
+			{
+				/* 拡張監視(thermal zone毎等) */
+				if (FailsafeExtAdd(tFSKeyFile, tGroupArray[cnt]) == DEF_FS_FALSE)
+				{
+					dprintf(WARN, "unknown failsafe group [%s].\n", tGroupArray[cnt]);
+				}
+				continue;
+			}
+
             /* 故障閾値を取得 */
-			FsThresh[cnt] = (int32_t)g_key_file_get_integer(tFSKeyFile, tGroupArray[cnt], "Thresh", &err);
+			FsThresh[index] = (int32_t)g_key_file_get_integer(tFSKeyFile, tGroupArray[cnt], "Thresh", &err);
 
-			if ((DEF_FS_FALSE > FsThresh[cnt]) || (NULL != err))
+			if ((DEF_FS_FALSE > FsThresh[index]) || (NULL != err))
 			{
-				dprintf(ERROR, "failed to parse thresh(No.%d).\n", cnt);
+				dprintf(ERROR, "failed to parse thresh([%s]).\n", tGroupArray[cnt]);
 				ret = DEF_FS_FALSE;
 			}
 		}
@@ -201,6 +259,7 @@ static int32_t FailsafeConf(char aFilename[])
  * 引数:    arg：[i] 引数
  * 戻り値:  なし
  * 作成日   2023/12/12 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 監視情報の読み込みで遅延を記録(com_shmem_read_ts)
  */
 /* ************************************************************************** */
 void* FailsafeMain(void* arg)
@@ -208,6 +267,7 @@ void* FailsafeMain(void* arg)
     int32_t ret;
 	int32_t tShmemID;
 	int32_t tFsShmID;
+	int32_t tExtShmID;
 	int32_t index;
 
 	com_timer_init(ENUM_TIMER_FAILSAFE, 100);
@@ -227,9 +287,18 @@ void* FailsafeMain(void* arg)
         pthread_exit(NULL);
     }
 
+	/* 拡張監視の共有メモリオープン */
+	tExtShmID = com_shmem_open(DEF_FS_EXT_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(tExtShmID == DEF_COM_SHMEM_FALSE)
+	{
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_FS_EXT_SHMEM_NAME);
+	}
+
 	/* フェールセーフ */
 	while (gComm_StopFlg == DEF_COMM_OFF)
 	{
+		TRACE_BEGIN("failsafe_cycle");
+
 		/* 設定フェールセーフ数まで */
 		for(uint32_t errocode = 1; errocode <= DEF_FS_ERR_MAX; errocode++)
 		{
@@ -243,20 +312,36 @@ void* FailsafeMain(void* arg)
 					continue;
 				}
 				//printf("errorcode=%d, index=%d, tShmemID=%d\n", errocode, index, tShmemID);
-				com_shmem_read(tShmemID, FsTable[index].resDataInfo, FsTable[index].size);
+				com_shmem_read_ts(tShmemID, FsTable[index].resDataInfo, FsTable[index].size, NULL);
 				com_shmem_close(tShmemID);
 
 				/* 故障レベル判定 */
 				*(FsTable[index].data) = FailsafeJudge(index);
+				if (*(FsTable[index].data) == DEF_FS_FAIL_NOW) {
+					TRACE_INSTANT("failsafe_fail", errocode);
+				}
 				//printf("errorcode=%d , fail level = %d\n", errocode, *FsTable[index].data);
 				/* 共有メモリ書き込み */
 				com_shmem_write(tFsShmID, &FsInfo, sizeof(FsInfo));
 			}
 		}
+
+		/* 拡張監視 */
+		if ((FsExt.num > 0) && (tExtShmID != DEF_COM_SHMEM_FALSE))
+		{
+			FailsafeExtJudge();
+			com_shmem_write(tExtShmID, &FsExt, sizeof(FsExt));
+		}
+		TRACE_END("failsafe_cycle");
+
 		com_mtimer(ENUM_TIMER_FAILSAFE);
 	}
 
 	/* 共有メモリクローズ */
+	if (tExtShmID != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(tExtShmID);
+	}
     com_shmem_close(tFsShmID);
 	pthread_exit(NULL);
 	
@@ -272,14 +357,30 @@ void* FailsafeMain(void* arg)
  */
 /* ************************************************************************** */
 static int32_t FailsafeJudge(int32_t aIndex)
+{
+	return FailsafeLevel(*(FsTable[aIndex].resData), *(FsTable[aIndex].thresh), *(FsTable[aIndex].data));
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   故障レベル判定
+ * 機能     リソース値と閾値から故障レベルを判定する．
+ * 引数:    aValue：[i] リソース値
+ *          aThresh：[i] 故障閾値
+ *          aLevel：[i] 前回の故障レベル
+ * 戻り値:   故障レベル
+ * 作成日   2026/10/19 [0.0.1] 新規作成(FailsafeJudgeから分離)
+ */
+/* ************************************************************************** */
+static int32_t FailsafeLevel(int32_t aValue, int32_t aThresh, int32_t aLevel)
 {
 	int32_t ret = DEF_FS_FALSE;
 
-	if (*(FsTable[aIndex].resData) > *(FsTable[aIndex].thresh))
+	if (aValue > aThresh)
 	{
 		ret = DEF_FS_FAIL_NOW;	/* 現在故障 */
 	}
-	else if (*(FsTable[aIndex].data) != DEF_FS_SAFE)
+	else if (aLevel != DEF_FS_SAFE)
 	{
 		ret = DEF_FS_FAIL_PAST;	/* 過去故障 */
 	}
@@ -291,6 +392,651 @@ static int32_t FailsafeJudge(int32_t aIndex)
 	return ret;
 }
 
+/* ************************************************************************** */
+/* 
+ * 関数名   拡張監視登録
+ * 機能     設定ファイルのグループを拡張監視に登録する．
+ *          [THERM.<zone種別>]：thermal zoneの温度[1/1000℃]．Thresh省略時はトリップ温度．
+ *          [THROTTLE]：スロットリング中のCPU数．
+ *          [PSI.<cpu|memory|io>.<some|full>]：前回判定からのPSIトリガの発生回数(Thresh必須)．
+ *          [NET.<インタフェース名>.<項目>]：ネットワークインタフェースの状態(Thresh必須)．
+ *          [DISK.<デバイス名>.<項目>]：ブロックデバイスのI/O(Thresh必須)．
+ *          [MOUNT.<マウントポイント>]：マウントポイントの使用量[%](Thresh必須)．
+ *          [CPU.<CPU番号>]：CPU毎の負荷[%](Thresh必須)．CPU番号は0から．
+ *          [CPU.all]：全CPUのCPU.<CPU番号>を同じ閾値で登録する(Thresh必須)．
+ *          CPU数はリソース情報の取得後に決まるため，最初の判定時に展開する(FailsafeExtCpuAll)．
+ * 引数:    aKeyFile：[i] 設定ファイル
+ *          aGroup：[i] グループ名
+ * 戻り値:  0：正常終了，-1：拡張監視のグループではない
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] NET.<インタフェース名>.<項目>を追加
+ *          2026/10/19 [0.0.3] DISK.<デバイス名>.<項目>，MOUNT.<マウントポイント>を追加
+ *          2026/10/19 [0.0.4] CPU.<CPU番号>，CPU.allを追加
+ *          2026/10/19 [0.0.5] PSI.<種別>をトリガの発生回数に変更
+ */
+/* ************************************************************************** */
+static int32_t FailsafeExtAdd(GKeyFile* aKeyFile, const char* aGroup)
+{
+	failsafeExtEntry *tEntry;
+	GError* err = NULL;
+
+	if ((strncmp(aGroup, DEF_FS_EXT_THERM, strlen(DEF_FS_EXT_THERM)) != 0) && (strcmp(aGroup, DEF_FS_EXT_THROTTLE) != 0) &&
+		(strncmp(aGroup, DEF_FS_EXT_PSI, strlen(DEF_FS_EXT_PSI)) != 0) && (strncmp(aGroup, DEF_FS_EXT_NET, strlen(DEF_FS_EXT_NET)) != 0) &&
+		(strncmp(aGroup, DEF_FS_EXT_DISK, strlen(DEF_FS_EXT_DISK)) != 0) && (strncmp(aGroup, DEF_FS_EXT_MOUNT, strlen(DEF_FS_EXT_MOUNT)) != 0) &&
+		(strncmp(aGroup, DEF_FS_EXT_CPU, strlen(DEF_FS_EXT_CPU)) != 0))
+	{
+		return DEF_FS_FALSE;
+	}
+
+	/* CPU.allは閾値のみ保持し，CPU数が分かってから展開する */
+	if (strcmp(aGroup, DEF_FS_EXT_CPU_ALL) == 0)
+	{
+		FsExtCpuAll = (int32_t)g_key_file_get_integer(aKeyFile, aGroup, "Thresh", &err);
+		if ((NULL != err) || (FsExtCpuAll < 0))
+		{
+			dprintf(ERROR, "failed to parse thresh([%s]).\n", aGroup);
+			FsExtCpuAll = DEF_FS_FALSE;
+		}
+		if (NULL != err)
+		{
+			g_error_free(err);
+		}
+		return DEF_FS_TRUE;
+	}
+	if (FsExt.num >= DEF_FS_EXT_MAX)
+	{
+		dprintf(WARN, "too many failsafe group. ignore [%s].\n", aGroup);
+		return DEF_FS_TRUE;
+	}
+
+	tEntry = &FsExt.entry[FsExt.num];
+	snprintf(tEntry->name, sizeof(tEntry->name), "%s", aGroup);
+	tEntry->thresh = DEF_FS_EXT_THRESH_TRIP;
+	if (g_key_file_has_key(aKeyFile, aGroup, "Thresh", NULL))
+	{
+		tEntry->thresh = (int32_t)g_key_file_get_integer(aKeyFile, aGroup, "Thresh", &err);
+		if (NULL != err)
+		{
+			dprintf(ERROR, "failed to parse thresh([%s]).\n", aGroup);
+			g_error_free(err);
+			return DEF_FS_TRUE;
+		}
+	}
+	tEntry->level = DEF_FS_SAFE;
+	FsExt.num++;
+	if (strncmp(aGroup, DEF_FS_EXT_NET, strlen(DEF_FS_EXT_NET)) == 0)
+	{
+		FsExtNetNum++;
+	}
+	if (strncmp(aGroup, DEF_FS_EXT_CPU, strlen(DEF_FS_EXT_CPU)) == 0)
+	{
+		FsExtCpuNum++;
+	}
+	if (strncmp(aGroup, DEF_FS_EXT_PSI, strlen(DEF_FS_EXT_PSI)) == 0)
+	{
+		FsExtPSINum++;
+	}
+
+	return DEF_FS_TRUE;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   CPU.allの展開
+ * 機能     CPU.allの閾値で全CPUのCPU.<CPU番号>を拡張監視に登録する．
+ *          設定ファイルで個別に指定したCPUはその閾値を優先する．
+ * 引数:    aCpuNum：[i] CPU数(リソース情報のcpu_num)
+ * 戻り値:  なし
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static void FailsafeExtCpuAll(int32_t aCpuNum)
+{
+	char tName[DEF_FS_EXT_NAME_LEN];
+	failsafeExtEntry *tEntry;
+	int32_t tFound;
+
+	for (int32_t cpu = 0; cpu < aCpuNum; cpu++)
+	{
+		snprintf(tName, sizeof(tName), "%s%d", DEF_FS_EXT_CPU, cpu);
+		tFound = 0;
+		for (int32_t cnt = 0; cnt < FsExt.num; cnt++)
+		{
+			if (strcmp(FsExt.entry[cnt].name, tName) == 0)
+			{
+				tFound = 1;
+				break;
+			}
+		}
+		if (tFound)
+		{
+			continue;
+		}
+		if (FsExt.num >= DEF_FS_EXT_MAX)
+		{
+			dprintf(WARN, "too many failsafe group. ignore [%s] after %s.\n", DEF_FS_EXT_CPU_ALL, tName);
+			break;
+		}
+
+		tEntry = &FsExt.entry[FsExt.num];
+		snprintf(tEntry->name, sizeof(tEntry->name), "%s", tName);
+		tEntry->thresh = FsExtCpuAll;
+		tEntry->level = DEF_FS_SAFE;
+		FsExt.num++;
+		FsExtCpuNum++;
+	}
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   拡張監視判定
+ * 機能     拡張監視の各項目のリソース値を取得し，故障レベルを判定する．
+ *          リソース値が取得できない項目は故障レベルを変更しない．
+ * 引数:    なし
+ * 戻り値:  なし
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] ネットワーク監視情報を追加
+ *          2026/10/19 [0.0.3] CPU毎の負荷を追加
+ *          2026/10/19 [0.0.4] PSIもCPU毎の負荷と同時に読み込んだリソース情報で判定
+ */
+/* ************************************************************************** */
+static void FailsafeExtJudge(void)
+{
+	const thermalStat *tThermal;
+	const netStat *tNet = NULL;
+	const resourceStat *tResc = NULL;
+	failsafeExtEntry *tEntry;
+	int32_t tThresh;
+
+	/* 温度監視情報(取得できなければTHERM.，THROTTLEは判定しない) */
+	tThermal = FailsafeReadThermal();
+	/* ネットワーク監視情報(NET.項目がある場合のみ) */
+	if (FsExtNetNum > 0)
+	{
+		tNet = FailsafeReadNet();
+	}
+	/* CPU毎の負荷，PSI(CPU.，PSI.項目がある場合のみ，CPU.allは最初に取得できた時に展開する) */
+	if ((FsExtCpuNum > 0) || (FsExtPSINum > 0) || (FsExtCpuAll != DEF_FS_FALSE))
+	{
+		tResc = FailsafeReadResc();
+		if ((tResc != NULL) && (FsExtCpuAll != DEF_FS_FALSE))
+		{
+			FailsafeExtCpuAll(tResc->cpu_num);
+			FsExtCpuAll = DEF_FS_FALSE;
+		}
+	}
+
+	for (int32_t cnt = 0; cnt < FsExt.num; cnt++)
+	{
+		tEntry = &FsExt.entry[cnt];
+		tThresh = tEntry->thresh;
+
+		if (FailsafeExtValue(tEntry, tThermal, tNet, tResc, &tThresh) == DEF_FS_FALSE)
+		{
+			continue;
+		}
+		if (tThresh > 0 || tEntry->thresh == 0)
+		{
+			tEntry->level = FailsafeLevel(tEntry->value, tThresh, tEntry->level);
+			if (tEntry->level == DEF_FS_FAIL_NOW)
+			{
+				TRACE_INSTANT("failsafe_fail_ext", cnt);
+			}
+		}
+	}
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   拡張監視のリソース値取得
+ * 機能     監視名に対応するリソース値を取得する．
+ * 引数:    aEntry：[i/o] 拡張監視項目(valueに格納する)
+ *          aThermal：[i] 温度監視情報(NULL可)
+ *          aNet：[i] ネットワーク監視情報(NULL可)
+ *          aResc：[i] CPU毎の負荷，PSIを含むリソース情報(NULL可)
+ *          aThresh：[i/o] 故障閾値(トリップ温度を使う場合は置き換える)
+ * 戻り値:  0：正常終了，-1：取得できない
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] NET.<インタフェース名>.<項目>を追加
+ *          2026/10/19 [0.0.3] DISK.<デバイス名>.<項目>，MOUNT.<マウントポイント>を追加
+ *          2026/10/19 [0.0.4] CPU.<CPU番号>を追加
+ *          2026/10/19 [0.0.5] PSI.<種別>をトリガの発生回数に変更(FailsafeExtPSIValue)
+ */
+/* ************************************************************************** */
+static int32_t FailsafeExtValue(failsafeExtEntry *aEntry, const thermalStat *aThermal, const netStat *aNet, const resourceStat *aResc, int32_t *aThresh)
+{
+	const thermZone *tZone;
+	const char *tName;
+
+	/* CPU.<CPU番号> */
+	if (strncmp(aEntry->name, DEF_FS_EXT_CPU, strlen(DEF_FS_EXT_CPU)) == 0)
+	{
+		return (aResc != NULL) ? FailsafeExtCpuValue(aEntry, aResc) : DEF_FS_FALSE;
+	}
+
+	/* NET.<インタフェース名>.<項目> */
+	if (strncmp(aEntry->name, DEF_FS_EXT_NET, strlen(DEF_FS_EXT_NET)) == 0)
+	{
+		return (aNet != NULL) ? FailsafeExtNetValue(aEntry, aNet) : DEF_FS_FALSE;
+	}
+
+	/* DISK.<デバイス名>.<項目>，MOUNT.<マウントポイント> */
+	if ((strncmp(aEntry->name, DEF_FS_EXT_DISK, strlen(DEF_FS_EXT_DISK)) == 0) ||
+		(strncmp(aEntry->name, DEF_FS_EXT_MOUNT, strlen(DEF_FS_EXT_MOUNT)) == 0))
+	{
+		return FailsafeExtDiskValue(aEntry);
+	}
+
+	/* PSI.<cpu|memory|io>.<some|full> */
+	if (strncmp(aEntry->name, DEF_FS_EXT_PSI, strlen(DEF_FS_EXT_PSI)) == 0)
+	{
+		return (aResc != NULL) ? FailsafeExtPSIValue(aEntry, aResc) : DEF_FS_FALSE;
+	}
+
+	if (aThermal == NULL)
+	{
+		return DEF_FS_FALSE;
+	}
+
+	/* THROTTLE：スロットリング中のCPU数 */
+	if (strcmp(aEntry->name, DEF_FS_EXT_THROTTLE) == 0)
+	{
+		aEntry->value = aThermal->throttled;
+		return DEF_FS_TRUE;
+	}
+
+	/* THERM.<zone種別>：温度[1/1000℃] */
+	tName = aEntry->name + strlen(DEF_FS_EXT_THERM);
+	tZone = THERM_ZONE(aThermal);
+	for (int32_t zone = 0; zone < aThermal->zone_num; zone++)
+	{
+		if ((strcmp(tZone[zone].type, tName) == 0) && (tZone[zone].temp != INT32_MIN))
+		{
+			aEntry->value = tZone[zone].temp;
+			if (*aThresh == DEF_FS_EXT_THRESH_TRIP)
+			{
+				*aThresh = tZone[zone].trip;	/* トリップポイントが無ければ0(判定しない) */
+			}
+			return DEF_FS_TRUE;
+		}
+	}
+	return DEF_FS_FALSE;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   ネットワーク監視のリソース値取得
+ * 機能     NET.<インタフェース名>.<項目>のリソース値を取得する．
+ *          down：リンクダウンなら1，signal：無線の信号強度[-dBm]，
+ *          rx_err，tx_err，rx_drop，tx_drop：エラー・破棄の発生率[個/s]．
+ *          インタフェース名は'.'を含んでもよい(VLAN等)．
+ * 引数:    aEntry：[i/o] 拡張監視項目(valueに格納する)
+ *          aNet：[i] ネットワーク監視情報
+ * 戻り値:  0：正常終了，-1：取得できない
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static int32_t FailsafeExtNetValue(failsafeExtEntry *aEntry, const netStat *aNet)
+{
+	char tIfName[DEF_NET_NAME_LEN];
+	const char *tName;
+	const char *tItem;
+	const netIf *tIf;
+
+	tName = aEntry->name + strlen(DEF_FS_EXT_NET);
+	tItem = strrchr(tName, '.');
+	if ((tItem == NULL) || (tItem == tName) || (tItem - tName >= DEF_NET_NAME_LEN))
+	{
+		return DEF_FS_FALSE;
+	}
+	memcpy(tIfName, tName, tItem - tName);
+	tIfName[tItem - tName] = '\0';
+	tItem++;
+
+	/* 存在しないインタフェースはリンクダウンとみなす */
+	tIf = NetFind(aNet, tIfName);
+	if (strcmp(tItem, "down") == 0)
+	{
+		aEntry->value = ((tIf == NULL) || (tIf->up == 0)) ? 1 : 0;
+		return DEF_FS_TRUE;
+	}
+	if (tIf == NULL)
+	{
+		return DEF_FS_FALSE;
+	}
+
+	if (strcmp(tItem, "signal") == 0)
+	{
+		/* 無線でない，または未接続(信号強度0)は判定しない */
+		if ((tIf->wireless == 0) || (tIf->level == 0))
+		{
+			return DEF_FS_FALSE;
+		}
+		aEntry->value = -tIf->level;
+	}
+	else if (strcmp(tItem, "rx_err") == 0)
+	{
+		aEntry->value = tIf->rx_err_ps;
+	}
+	else if (strcmp(tItem, "tx_err") == 0)
+	{
+		aEntry->value = tIf->tx_err_ps;
+	}
+	else if (strcmp(tItem, "rx_drop") == 0)
+	{
+		aEntry->value = tIf->rx_drop_ps;
+	}
+	else if (strcmp(tItem, "tx_drop") == 0)
+	{
+		aEntry->value = tIf->tx_drop_ps;
+	}
+	else
+	{
+		return DEF_FS_FALSE;
+	}
+	return DEF_FS_TRUE;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   ディスク監視のリソース値取得
+ * 機能     DISK.<デバイス名>.<項目>，MOUNT.<マウントポイント>のリソース値を取得する．
+ *          DISKの項目はrd_iops，wr_iops[回/s]，rd_kbps，wr_kbps[KiB/s]，
+ *          rd_await，wr_await，svctm[us]，queue[1/100]，util[%]．
+ * 引数:    aEntry：[i/o] 拡張監視項目(valueに格納する)
+ * 戻り値:  0：正常終了，-1：取得できない
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static int32_t FailsafeExtDiskValue(failsafeExtEntry *aEntry)
+{
+	static const struct {
+		const char *name;
+		size_t offset;
+	} tItem[] = {
+		{ "rd_iops", offsetof(resDiskStat, rd_iops) },
+		{ "wr_iops", offsetof(resDiskStat, wr_iops) },
+		{ "rd_kbps", offsetof(resDiskStat, rd_kbps) },
+		{ "wr_kbps", offsetof(resDiskStat, wr_kbps) },
+		{ "rd_await", offsetof(resDiskStat, rd_await) },
+		{ "wr_await", offsetof(resDiskStat, wr_await) },
+		{ "svctm", offsetof(resDiskStat, svctm) },
+		{ "queue", offsetof(resDiskStat, queue) },
+		{ "util", offsetof(resDiskStat, util) },
+	};
+	const char *tName;
+	const char *tDot;
+	int32_t tNum;
+
+	/* MOUNT.<マウントポイント>：使用量[%] */
+	if (strncmp(aEntry->name, DEF_FS_EXT_MOUNT, strlen(DEF_FS_EXT_MOUNT)) == 0)
+	{
+		tName = aEntry->name + strlen(DEF_FS_EXT_MOUNT);
+		tNum = (FsInfoResc.mount_num < DEF_RES_MOUNT_MAX) ? FsInfoResc.mount_num : DEF_RES_MOUNT_MAX;
+		for (int32_t cnt = 0; cnt < tNum; cnt++)
+		{
+			if ((strncmp(FsInfoResc.mount[cnt].path, tName, DEF_RES_MOUNT_PATH_LEN) == 0) && (FsInfoResc.mount[cnt].usage >= 0))
+			{
+				aEntry->value = FsInfoResc.mount[cnt].usage;
+				return DEF_FS_TRUE;
+			}
+		}
+		return DEF_FS_FALSE;
+	}
+
+	/* DISK.<デバイス名>.<項目> */
+	tName = aEntry->name + strlen(DEF_FS_EXT_DISK);
+	tDot = strrchr(tName, '.');
+	if ((tDot == NULL) || (tDot == tName) || (tDot - tName >= DEF_RES_DISK_NAME_LEN))
+	{
+		return DEF_FS_FALSE;
+	}
+	tNum = (FsInfoResc.disk_num < DEF_RES_DISK_MAX) ? FsInfoResc.disk_num : DEF_RES_DISK_MAX;
+	for (int32_t cnt = 0; cnt < tNum; cnt++)
+	{
+		const resDiskStat *tDisk = &FsInfoResc.disk[cnt];
+
+		if ((strncmp(tDisk->name, tName, tDot - tName) != 0) || (tDisk->name[tDot - tName] != '\0'))
+		{
+			continue;
+		}
+		for (size_t item = 0; item < sizeof(tItem) / sizeof(tItem[0]); item++)
+		{
+			if (strcmp(tDot + 1, tItem[item].name) == 0)
+			{
+				aEntry->value = *(const int32_t *)((const char *)tDisk + tItem[item].offset);
+				return DEF_FS_TRUE;
+			}
+		}
+		break;
+	}
+	return DEF_FS_FALSE;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   CPU監視のリソース値取得
+ * 機能     CPU.<CPU番号>の負荷[%]を取得する．オフラインのCPUは判定しない．
+ * 引数:    aEntry：[i/o] 拡張監視項目(valueに格納する)
+ *          aResc：[i] CPU毎の負荷を含むリソース情報
+ * 戻り値:  0：正常終了，-1：取得できない
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static int32_t FailsafeExtCpuValue(failsafeExtEntry *aEntry, const resourceStat *aResc)
+{
+	const char *tName;
+	char *tEnd;
+	long tCpu;
+
+	tName = aEntry->name + strlen(DEF_FS_EXT_CPU);
+	tCpu = strtol(tName, &tEnd, 10);
+	if ((tEnd == tName) || (*tEnd != '\0') || (tCpu < 0) || (tCpu >= aResc->cpu_num))
+	{
+		return DEF_FS_FALSE;
+	}
+
+	/* cpu[0]は全体，cpu[n]はCPU n-1 */
+	if (aResc->cpu[tCpu + 1].online == 0)
+	{
+		return DEF_FS_FALSE;
+	}
+	aEntry->value = aResc->cpu[tCpu + 1].load;
+	return DEF_FS_TRUE;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   PSI監視のリソース値取得
+ * 機能     PSI.<cpu|memory|io>.<some|full>の値として，前回判定からのPSIトリガの発生回数を取得する．
+ *          トリガ(リソース設定ファイルの[psi])はカーネルが窓内の停滞時間で判定し，
+ *          PSIトリガ待ちスレッドが即時に共有メモリへ反映するため，10秒平均と異なり
+ *          短い停滞でも次の判定周期で検知できる．
+ *          種別(some/full)が一致するトリガが登録されていない場合は判定しない．
+ *          初回は発生回数の基準を取得するのみとする．
+ * 引数:    aEntry：[i/o] 拡張監視項目(valueに格納する)
+ *          aResc：[i] PSIを含むリソース情報
+ * 戻り値:  0：正常終了，-1：取得できない
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static int32_t FailsafeExtPSIValue(failsafeExtEntry *aEntry, const resourceStat *aResc)
+{
+	static const char *tPSIName[RES_PSI_MAX] = { "cpu.", "memory.", "io." };
+	const resPSIStat *tPSI;
+	const char *tName;
+	int32_t tIndex = (int32_t)(aEntry - FsExt.entry);
+	int32_t tTrig;
+	uint32_t tEvents;
+
+	tName = aEntry->name + strlen(DEF_FS_EXT_PSI);
+	for (int32_t kind = 0; kind < RES_PSI_MAX; kind++)
+	{
+		if (strncmp(tName, tPSIName[kind], strlen(tPSIName[kind])) != 0)
+		{
+			continue;
+		}
+		tName += strlen(tPSIName[kind]);
+		if (strcmp(tName, "some") == 0)
+		{
+			tTrig = RES_PSI_TRIG_SOME;
+		}
+		else if (strcmp(tName, "full") == 0)
+		{
+			tTrig = RES_PSI_TRIG_FULL;
+		}
+		else
+		{
+			break;
+		}
+
+		tPSI = &aResc->psi[kind];
+		if (tPSI->trigger != tTrig)
+		{
+			FsExtPSIValid[tIndex] = 0;
+			return DEF_FS_FALSE;
+		}
+
+		/* 発生回数は累計(uint32_tの周回は差分で吸収する) */
+		tEvents = tPSI->events;
+		if (FsExtPSIValid[tIndex] == 0)
+		{
+			FsExtPSIEvents[tIndex] = tEvents;
+			FsExtPSIValid[tIndex] = 1;
+			return DEF_FS_FALSE;
+		}
+		aEntry->value = (int32_t)(tEvents - FsExtPSIEvents[tIndex]);
+		FsExtPSIEvents[tIndex] = tEvents;
+		return DEF_FS_TRUE;
+	}
+	return DEF_FS_FALSE;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   共有メモリ読込
+ * 機能     生成側でサイズが決まる共有メモリを読み込む．
+ *          読込先の領域は共有メモリのサイズに合わせて拡張する．
+ * 引数:    aName：[i] 共有メモリ名
+ *          aBuf：[i/o] 読込先の領域
+ *          aBufSize：[i/o] 読込先の領域のサイズ
+ * 戻り値:  読み込んだサイズ，0：取得失敗
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 遅延を記録する読み込みに変更
+ */
+/* ************************************************************************** */
+static int32_t FailsafeReadShmem(const char* aName, void** aBuf, int32_t* aBufSize)
+{
+	int32_t tShmemID;
+	int32_t tSize;
+
+	tShmemID = com_shmem_open((char*)aName, SHM_KIND_PLATFORM);
+	if (tShmemID == DEF_COM_SHMEM_FALSE)
+	{
+		return 0;
+	}
+
+	tSize = com_shmem_get_size(tShmemID);
+	if (tSize > *aBufSize)
+	{
+		free(*aBuf);
+		*aBuf = calloc(1, tSize);
+		*aBufSize = (*aBuf != NULL) ? tSize : 0;
+	}
+	if ((*aBuf == NULL) || (tSize <= 0))
+	{
+		com_shmem_close(tShmemID);
+		return 0;
+	}
+	com_shmem_read_ts(tShmemID, *aBuf, tSize, NULL);
+	com_shmem_close(tShmemID);
+
+	return tSize;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   温度監視情報取得
+ * 機能     温度監視の共有メモリを読み込む．サイズは生成側の構成に合わせる．
+ * 引数:    なし
+ * 戻り値:  温度監視情報，NULL：取得失敗
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 共有メモリ読込をFailsafeReadShmem()に分離
+ */
+/* ************************************************************************** */
+static const thermalStat* FailsafeReadThermal(void)
+{
+	int32_t tSize;
+
+	tSize = FailsafeReadShmem(DEF_THERM_SHMEM_NAME, (void**)&FsInfoThermal, &FsInfoThermalSize);
+	if (tSize < (int32_t)sizeof(thermalStat))
+	{
+		return NULL;
+	}
+
+	/* 書き込み前の共有メモリ等，構成とサイズが合わない場合は使わない */
+	if (tSize < DEF_THERM_STAT_SIZE(FsInfoThermal->zone_num, FsInfoThermal->cool_num, FsInfoThermal->cpu_num))
+	{
+		return NULL;
+	}
+	return FsInfoThermal;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   ネットワーク監視情報取得
+ * 機能     ネットワーク監視の共有メモリを読み込む．サイズは生成側の構成に合わせる．
+ * 引数:    なし
+ * 戻り値:  ネットワーク監視情報，NULL：取得失敗
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static const netStat* FailsafeReadNet(void)
+{
+	int32_t tSize;
+
+	tSize = FailsafeReadShmem(DEF_NET_SHMEM_NAME, (void**)&FsInfoNet, &FsInfoNetSize);
+	if (tSize < (int32_t)sizeof(netStat))
+	{
+		return NULL;
+	}
+
+	/* 書き込み前の共有メモリ等，構成とサイズが合わない場合は使わない */
+	if ((FsInfoNet->if_max <= 0) || (tSize < DEF_NET_STAT_SIZE(FsInfoNet->if_max)))
+	{
+		return NULL;
+	}
+	return FsInfoNet;
+}
+
+/* ************************************************************************** */
+/* 
+ * 関数名   拡張監視のリソース情報取得
+ * 機能     リソースの共有メモリをCPU毎の統計まで読み込む(CPU.，PSI.項目用)．
+ *          サイズは生成側のCPU数に合わせる．
+ * 引数:    なし
+ * 戻り値:  リソース情報，NULL：取得失敗
+ * 作成日   2026/10/19 [0.0.1] 新規作成
+ */
+/* ************************************************************************** */
+static const resourceStat* FailsafeReadResc(void)
+{
+	int32_t tSize;
+
+	tSize = FailsafeReadShmem(DEF_RES_SHMMNG_NAME, (void**)&FsInfoRescExt, &FsInfoRescExtSize);
+	if (tSize < (int32_t)sizeof(resourceStat))
+	{
+		return NULL;
+	}
+
+	/* 書き込み前の共有メモリ等，構成とサイズが合わない場合は使わない */
+	if ((FsInfoRescExt->cpu_num <= 0) || (tSize < DEF_RES_STAT_SIZE(FsInfoRescExt->cpu_num)))
+	{
+		return NULL;
+	}
+	return FsInfoRescExt;
+}
+
 /* ************************************************************************** */
 /* 
  * 関数名   インデックス番号取得
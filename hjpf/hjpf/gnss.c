@@ -22,6 +22,7 @@
 #include "com_timer.h"
 #include "com_shmem.h"
 #include "debug.h"
+#include "com_trace.h"
 #include "hjpf.h"
 #include "resource.h"
 #include "gnss.h"
@@ -30,6 +31,7 @@
 /* global */
 /*============================================================================*/
 static gnssStat GnssStat;
+static struct timespec sGnssArrival;	//データ到着時刻
 extern int gComm_StopFlg;
 extern pthread_mutex_t g_mutex;   
 
@@ -299,6 +301,11 @@ static int GNSSSerialRecv(int fd, char *savefr)
 	//シリアル受信
 	size = read(fd, frame, DEF_READ_SIZE);
 	pthread_mutex_unlock(&g_mutex);
+	if (size > 0)
+	{
+		//データ到着時刻
+		clock_gettime(CLOCK_MONOTONIC, &sGnssArrival);
+	}
 
 	if( size == -1 )
     {
@@ -412,18 +419,20 @@ void* GNSSMain(void* arg){
     fd = com_serial_open(uartGNSS->devname, baudrate);
 
     GnssStat.Stat = 0;
-    com_shmem_write(id, &GnssStat, sizeof(GnssStat));
+    com_shmem_write_ts(id, &GnssStat, sizeof(GnssStat), &sGnssArrival);
 
     //データ受信
     while (gComm_StopFlg == DEF_COMM_OFF) 
     {
+        TRACE_BEGIN("gnss_serial_recv");
         ret = GNSSSerialRecv(fd, savefr);
+        TRACE_END("gnss_serial_recv");
         if(ret == DEF_RET_OK)
         {
             //共有メモリに書き込み
             GnssStat.Stat = 0;
             timeout_cnt = 0;
-            com_shmem_write(id, &GnssStat, sizeof(GnssStat));
+            com_shmem_write_ts(id, &GnssStat, sizeof(GnssStat), &sGnssArrival);
         } 
         else
         {
@@ -440,7 +449,7 @@ void* GNSSMain(void* arg){
         if(timeout_cnt > uartGNSS->timeout)
         {
             GnssStat.Stat = 1;
-            com_shmem_write(id, &GnssStat, sizeof(GnssStat));
+            com_shmem_write_ts(id, &GnssStat, sizeof(GnssStat), &sGnssArrival);
             com_serial_close(fd);
             fd = com_serial_open(uartGNSS->devname, baudrate);
         }
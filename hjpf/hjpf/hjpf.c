@@ -25,6 +25,7 @@
 #include "com_timer.h"
 #include "com_shmem.h"
 #include "debug.h"
+#include "com_trace.h"
 #include "hjpf.h"
 #include "process.h"
 #include "resource.h"
@@ -45,9 +46,9 @@ static void AplSigHandler(const int signo);
 static void AplInitSignal(void);
 
 threadInfo g_threadInfo[] = {
-	{ ProcMonit, "process.conf", -1 },
-	{ ResMain, "resource.conf", -1 },
-	{ FailsafeMain, "failsafe.conf", -1 },
+	{ ProcMonit, "process.conf", -1, "hjpf_proc" },
+	{ ResMain, "resource.conf", -1, "hjpf_res" },
+	{ FailsafeMain, "failsafe.conf", -1, "hjpf_failsafe" },
 };
 
 /*============================================================================*/
@@ -73,12 +74,14 @@ dprintf(INFO, "AplSigHandler=%d\n", signo);
  * @param   引数  : なし
  * @return  戻り値: なし
  * @date    2020/01/07 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] SIGCHLDのブロックを追加
  */
 /*============================================================================*/
 static void AplInitSignal(void)
 {
 	struct sigaction	sa_sig;
 	struct sigaction	sa_sigign;
+	sigset_t			set;
 
 dprintf(INFO, "AplInitSignal=%d\n");
 	// シグナルアクション(SIGTERM,SIGINT)の設定
@@ -92,6 +95,12 @@ dprintf(INFO, "AplInitSignal=%d\n");
 	memset(&sa_sigign, 0, sizeof(sa_sigign));
 	sa_sigign.sa_handler = SIG_IGN;
 	sigaction(SIGPIPE, &sa_sigign, NULL);
+
+	// SIGCHLDは全スレッドでブロックし，プロセス管理のsignalfdで受け取る
+	// (スレッド生成前に設定し，全スレッドに引き継ぐ)
+	sigemptyset(&set);
+	sigaddset(&set, SIGCHLD);
+	pthread_sigmask(SIG_BLOCK, &set, NULL);
 }
 
 /*============================================================================*/
@@ -103,6 +112,7 @@ dprintf(INFO, "AplInitSignal=%d\n");
  *
  * @return  戻り値: int
  * @date    2020/01/07 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] スレッド名を設定(トレース・/proc/<pid>/task/<tid>/commで識別する)
  */
 /*============================================================================*/
 int main(int argc, char *argv[])
@@ -136,6 +146,12 @@ int main(int argc, char *argv[])
 #endif
 	gComm_StopFlg = DEF_COMM_OFF;
 
+	// 非同期ログ出力開始(環境変数DLOGFILE未定義ならシスログ)
+	debug_log_start(getenv(DLOGFILE));
+
+	// トレース開始(環境変数HJPF_TRACE定義時のみ)
+	com_trace_start(NULL);
+
 	if (pthread_mutex_init(&g_mutex, NULL) != 0) {                                    
 		dprintf(WARN, "pthread_mutex_init() error=%d\n", errno);
 		return DEF_COM_SHMEM_FALSE;
@@ -147,6 +163,9 @@ int main(int argc, char *argv[])
 	/* 設定ファイルの読み込み */
 	com_shmem_conf("memory.conf");
 
+	/* CPU構成取得(リソース共有メモリのサイズを決定) */
+	ResCPUInit();
+
 	/* 共有メモリ生成 */
 	com_shmem_init();
 
@@ -160,6 +179,7 @@ int main(int argc, char *argv[])
 			dprintf(WARN, "pthread_create(%d) error=%d\n", cnt, errno);
 			return DEF_RET_NG;
 		}
+		pthread_setname_np(g_threadInfo[cnt].threadid, g_threadInfo[cnt].name);
 	}
 
 	// 終了待ち
@@ -181,6 +201,12 @@ int main(int argc, char *argv[])
 
 	dprintf(INFO, "Trans End\n");
 
+	// トレース出力
+	com_trace_stop();
+
+	// 残りのログを出力して終了
+	debug_log_stop();
+
 	return 0;
 }
 
@@ -29,6 +29,7 @@ typedef struct _threadInfo {
 	void		*(*thread) (void *arg);
 	void		*arg;
 	pthread_t	threadid;
+	const char	*name;		/* スレッド名(15文字以内) */
 } threadInfo;
 
 typedef enum {
@@ -36,6 +36,9 @@ extern int gComm_StopFlg;
 static struct bme680_dev gas_sensor;
 static HMC6343 hmc;
 static BME680 bme;
+static struct timespec sI2cArrival;	/* 最後のI2C読み込み完了時刻 */
+static struct timespec sHmcArrival;	/* HMC6343データ到着時刻 */
+static struct timespec sBmeArrival;	/* BME680データ到着時刻 */
 
 /*============================================================================*/
 /* prototype */
@@ -172,6 +175,8 @@ static int i2c_read(int fd, uint8_t dev_adr, uint8_t reg_addr, void *buf, uint32
 	ret = ioctl(fd, I2C_RDWR, &packets);
 	if (ret < 0) {
 		dprintf(ERROR, "i2c_read(%d) error=%d\n", fd, errno);
+	} else {
+		clock_gettime(CLOCK_MONOTONIC, &sI2cArrival);	/* データ到着時刻 */
 	}
 	
 	return ret;
@@ -202,6 +207,7 @@ static int hmc_read(int fd)
 		dprintf(ERROR, "i2c_read(%d) error=%d\n", fd, errno);
 		return ret;
 	}
+	sHmcArrival = sI2cArrival;	/* 最初の読み込み完了時刻をデータ到着時刻とする */
 	hmc.Ax = (uint32_t)((buf[0] << 8) | buf[1]);
 	hmc.Ay = (uint32_t)((buf[2] << 8) | buf[3]);
 	hmc.Az = (uint32_t)((buf[4] << 8) | buf[5]);
@@ -359,6 +365,7 @@ static int bme_read(int fd)
 	struct bme680_field_data data;
 
 	ret = bme680_get_sensor_data(&data, &gas_sensor);
+	sBmeArrival = sI2cArrival;
 	bme.Press = data.pressure;
 	bme.Temp = data.temperature;
 	bme.Hum = data.humidity;
@@ -413,8 +420,8 @@ void* i2c_main(void* arg)
 
 	hmc.Stat = 0;
 	bme.Stat = 0;
-	com_shmem_write(id_hmc, &hmc, sizeof(hmc));
-	com_shmem_write(id_bme, &bme, sizeof(bme));
+	com_shmem_write_ts(id_hmc, &hmc, sizeof(hmc), &sHmcArrival);
+	com_shmem_write_ts(id_bme, &bme, sizeof(bme), &sBmeArrival);
 
 	while (!gComm_StopFlg) {
 		//user_delay_ms(meas_period);
@@ -427,7 +434,7 @@ void* i2c_main(void* arg)
 		if(ret >= 0){
 			timeout_cnt = 0;
 			hmc.Stat = 0;
-			com_shmem_write(id_hmc, &hmc, sizeof(hmc));
+			com_shmem_write_ts(id_hmc, &hmc, sizeof(hmc), &sHmcArrival);
 		}
 		else
 		{
@@ -442,7 +449,7 @@ void* i2c_main(void* arg)
 			if(timeout_cnt > i2cBME_HMC->timeout)
 			{
 				hmc.Stat = 1;
-				com_shmem_write(id_hmc, &hmc, sizeof(hmc));
+				com_shmem_write_ts(id_hmc, &hmc, sizeof(hmc), &sHmcArrival);
 			}
 		}
 
@@ -451,7 +458,7 @@ void* i2c_main(void* arg)
 		if(ret == 0){
 			timeout_cnt = 0;
 			hmc.Stat = 0;
-			com_shmem_write(id_bme, &bme, sizeof(bme));
+			com_shmem_write_ts(id_bme, &bme, sizeof(bme), &sBmeArrival);
 		}
 		else
 		{
@@ -465,7 +472,7 @@ void* i2c_main(void* arg)
 			if(timeout_cnt > i2cBME_HMC->timeout)
 			{
 				bme.Stat = 1;
-				com_shmem_write(id_bme, &bme, sizeof(bme));
+				com_shmem_write_ts(id_bme, &bme, sizeof(bme), &sBmeArrival);
 			}
 		}
 	}
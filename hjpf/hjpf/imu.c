@@ -33,6 +33,7 @@
 /* ************************************************************************** */
 #include "imu.h"
 #include "debug.h"
+#include "com_trace.h"
 #include "com_shmem.h"
 #include "hjpf.h"
 #include "resource.h"
@@ -62,6 +63,7 @@
 /* ************************************************************************** */
 static STR_IMU_INFO ImuInfo;								    /* 受信したIMUデータ */
 static uint32_t sImuSaveLen = 0;								/* セーブフレームのサイズ */
+static struct timespec sImuArrival;								/* データ到着時刻 */
 
 /* ************************************************************************** */
 /* global 変数宣言                                                            */
@@ -121,6 +123,11 @@ static int32_t imu_serial_recv(int32_t aFiledes, char* aSaveFrame)
     /* シリアル受信 */
     tSize = read(aFiledes, tFrame, DEF_IMU_READ_SIZE);
 	pthread_mutex_unlock(&g_mutex);
+    if (tSize > 0)
+    {
+        /* データ到着時刻 */
+        clock_gettime(CLOCK_MONOTONIC, &sImuArrival);
+    }
 
     if (tSize == -1)
     {
@@ -253,19 +260,21 @@ void* imu_serial_main(void* arg)
     /* シリアル通信オープン */
     tFiledes = com_serial_open(uartIMU->devname, tBaudrate);
     ImuInfo.Stat = 0;
-    com_shmem_write(tShmemID, &ImuInfo, sizeof(ImuInfo));
+    com_shmem_write_ts(tShmemID, &ImuInfo, sizeof(ImuInfo), &sImuArrival);
 
     /* IMUデータ受信 */
     while(gComm_StopFlg == DEF_COMM_OFF)
     {
+        TRACE_BEGIN("imu_serial_recv");
         ret = imu_serial_recv(tFiledes, savefr);
+        TRACE_END("imu_serial_recv");
 
         if (ret == DEF_IMU_TRUE)
         {
             /* 共有メモリに書き込み */
             timeout_cnt = 0;
             ImuInfo.Stat = 0;
-            com_shmem_write(tShmemID, &ImuInfo, sizeof(ImuInfo));
+            com_shmem_write_ts(tShmemID, &ImuInfo, sizeof(ImuInfo), &sImuArrival);
         }
         else
         {
@@ -282,7 +291,7 @@ void* imu_serial_main(void* arg)
         if(timeout_cnt > uartIMU->timeout)
         {
             ImuInfo.Stat = 1;
-            com_shmem_write(tShmemID, &ImuInfo, sizeof(ImuInfo));
+            com_shmem_write_ts(tShmemID, &ImuInfo, sizeof(ImuInfo), &sImuArrival);
             com_serial_close(tFiledes);
             tFiledes = com_serial_open(uartIMU->devname, tBaudrate);
         }
@@ -33,6 +33,7 @@
 /* ************************************************************************** */
 #include "ins.h"
 #include "debug.h"
+#include "com_trace.h"
 #include "com_shmem.h"
 #include "hjpf.h"
 #include "resource.h"
@@ -63,6 +64,7 @@
 static STR_INS_INFO InsInfo;                                   /* 受信したINSデータ */
 //static char saInsSaveFrame[DEF_INS_SAVE_SIZE];					/* セーブフレームデータ */
 static uint32_t sInsSaveLen = 0;								/* セーブフレームのサイズ */
+static struct timespec sInsArrival;								/* データ到着時刻 */
 
 
 /* ************************************************************************** */
@@ -122,6 +124,11 @@ static int32_t ins_serial_recv(int32_t aFiledes, char* aSaveFrame)
     /* シリアル受信 */
     tSize = read(aFiledes, tFrame, DEF_INS_READ_SIZE);
 	pthread_mutex_unlock(&g_mutex);
+    if (tSize > 0)
+    {
+        /* データ到着時刻 */
+        clock_gettime(CLOCK_MONOTONIC, &sInsArrival);
+    }
 
     if (tSize == -1)
     {
@@ -241,13 +248,15 @@ void* ins_serial_main(void* arg)
     tFiledes = com_serial_open(uartINS->devname, tBaudrate);
 
     InsInfo.Stat = 0;
-    com_shmem_write(tShmemID, &InsInfo, sizeof(InsInfo));
+    com_shmem_write_ts(tShmemID, &InsInfo, sizeof(InsInfo), &sInsArrival);
     
     /* INSデータ受信 */
     while(gComm_StopFlg == DEF_COMM_OFF)
     {
         usleep(10000);
+        TRACE_BEGIN("ins_serial_recv");
         ret = ins_serial_recv(tFiledes, savefr);
+        TRACE_END("ins_serial_recv");
         if (ret == DEF_INS_TRUE)
         {
             /* 共有メモリに書き込み */
@@ -265,7 +274,7 @@ void* ins_serial_main(void* arg)
             // );
             InsInfo.Stat = 0;
             timeout_cnt = 0;
-            com_shmem_write(tShmemID, &InsInfo, sizeof(InsInfo));
+            com_shmem_write_ts(tShmemID, &InsInfo, sizeof(InsInfo), &sInsArrival);
         }
         else
         {
@@ -282,7 +291,7 @@ void* ins_serial_main(void* arg)
         if(timeout_cnt > uartINS->timeout)
         {
             InsInfo.Stat = 1;
-            com_shmem_write(tShmemID, &InsInfo, sizeof(InsInfo));
+            com_shmem_write_ts(tShmemID, &InsInfo, sizeof(InsInfo), &sInsArrival);
             com_serial_close(tFiledes);
             tFiledes = com_serial_open(uartINS->devname, tBaudrate);
         }
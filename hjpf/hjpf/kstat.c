@@ -0,0 +1,498 @@
+/*============================================================================*/
+/*
+ * @file    kstat.c
+ * @brief   カーネル活動監視
+ * @note    /proc/stat，/proc/interrupts，/proc/softirqsの累計値の差分から
+ *          発生率[回/s]を求め，共有メモリに書き込む．
+ *          /proc/interrupts，/proc/softirqsの列はオンラインCPUのみのため，
+ *          ヘッダ行のCPU番号で列とCPUを対応付ける．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "com_shmem.h"
+#include "com_procfs.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "kstat.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static kernelStat *KernelStat = NULL;
+static int KernelStatSize = 0;
+static uint64_t *KstatIrqPrev = NULL;		/* IRQ毎・CPU毎の前回値 */
+static uint8_t *KstatIrqSeen = NULL;		/* 1:前回値あり */
+static uint64_t *KstatSoftPrev = NULL;		/* ソフト割り込み種別毎・CPU毎の前回値 */
+static int *KstatColumn = NULL;				/* 列に対応するCPU番号 */
+static uint64_t KstatPrevTime = 0;			/* 前回取得時刻[ms] */
+
+static const char *KstatSoftName[KSTAT_SOFTIRQ_MAX] = {
+	"HI:", "TIMER:", "NET_TX:", "NET_RX:", "BLOCK:", "IRQ_POLL:", "TASKLET:", "SCHED:", "HRTIMER:", "RCU:"
+};
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int KstatProcStat(void);
+static int KstatInterrupts(uint64_t interval);
+static int KstatSoftirqs(uint64_t interval);
+static int KstatHeader(procfsScan *scan);
+static int KstatNumber(procfsScan *scan, uint64_t *value);
+static int KstatIrqSlot(const char *name, int len, int hint);
+static int32_t KstatRate(uint64_t curr, uint64_t prev, uint64_t interval);
+
+/*============================================================================*/
+/*
+ * @brief   カーネル活動監視初期化処理
+ * @note    起動時のIRQ数から共有メモリのサイズを決定する．
+ *          com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ * @param   引数  : cpu_num	CPU数
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int KstatInit(int cpu_num)
+{
+	procfsFile file = COM_PROCFS_FILE("/proc/interrupts");
+	char *buf;
+	procfsScan scan;
+	int len;
+	int irq_max = 0;
+
+	if(KernelStat != NULL)
+	{
+		return DEF_RET_OK;
+	}
+
+	//現在のIRQ数(ヘッダ行を除く行数)
+	buf = malloc(DEF_KSTAT_BUF_MAX);
+	if(buf == NULL)
+	{
+		dprintf(ERROR, "malloc failed.\n");
+		return DEF_RET_NG;
+	}
+	len = com_procfs_read(&file, buf, DEF_KSTAT_BUF_MAX);
+	com_procfs_close(&file);
+	if(len > 0)
+	{
+		com_procfs_scan_init(&scan, buf, len);
+		while(com_procfs_scan_line(&scan))
+		{
+			irq_max++;
+		}
+	}
+	free(buf);
+
+	irq_max += DEF_KSTAT_IRQ_SPARE;
+	if(irq_max > DEF_KSTAT_IRQ_MAX)
+	{
+		irq_max = DEF_KSTAT_IRQ_MAX;
+	}
+
+	KernelStatSize = DEF_KSTAT_STAT_SIZE(irq_max, cpu_num);
+	KernelStat = calloc(1, KernelStatSize);
+	KstatIrqPrev = calloc((size_t)irq_max * cpu_num, sizeof(uint64_t));
+	KstatIrqSeen = calloc(irq_max, sizeof(uint8_t));
+	KstatSoftPrev = calloc((size_t)KSTAT_SOFTIRQ_MAX * cpu_num, sizeof(uint64_t));
+	KstatColumn = calloc(cpu_num, sizeof(int));
+	if(KernelStat == NULL || KstatIrqPrev == NULL || KstatIrqSeen == NULL || KstatSoftPrev == NULL || KstatColumn == NULL)
+	{
+		dprintf(ERROR, "calloc failed.\n");
+		return DEF_RET_NG;
+	}
+	KernelStat->cpu_num = cpu_num;
+	KernelStat->irq_max = irq_max;
+
+	//共有メモリサイズを設定
+	com_shmem_set_size(DEF_KSTAT_SHMEM_NAME, KernelStatSize);
+	dprintf(INFO, "irq max = %d, %s size = %d\n", irq_max, DEF_KSTAT_SHMEM_NAME, KernelStatSize);
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   カーネル活動監視処理
+ * @note    各累計値を取得して発生率を求め，共有メモリに書き込む．
+ *          初回は累計値のみ記録し，発生率は0とする．
+ * @param   引数  : id	共有メモリID(DEF_KSTAT_SHMEM_NAME)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int KstatUpdate(int id)
+{
+	struct timespec ts;
+	uint64_t now;
+	uint64_t interval = 0;
+	int ret = DEF_RET_OK;
+
+	if(KernelStat == NULL)
+	{
+		return DEF_RET_NG;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	if(KstatPrevTime != 0 && now > KstatPrevTime)
+	{
+		interval = now - KstatPrevTime;
+	}
+	KstatPrevTime = now;
+	KernelStat->interval = (int32_t)interval;
+
+	if(KstatProcStat() != DEF_RET_OK || KstatInterrupts(interval) != DEF_RET_OK || KstatSoftirqs(interval) != DEF_RET_OK)
+	{
+		ret = DEF_RET_NG;
+	}
+
+	//共有メモリに書き込み
+	com_shmem_write(id, KernelStat, KernelStatSize);
+
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   /proc/stat取得処理
+ * @note    ctxt，intr(合計)，procs_running，procs_blockedを取得する．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int KstatProcStat(void)
+{
+	static procfsFile file = COM_PROCFS_FILE("/proc/stat");
+	static char buf[DEF_KSTAT_BUF_MAX];
+	procfsScan scan;
+	uint64_t value;
+	uint64_t interval = (uint64_t)KernelStat->interval;
+	int len;
+
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
+	{
+		dprintf(ERROR, "/proc/stat read failed.\n");
+		return DEF_RET_NG;
+	}
+
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		if(com_procfs_scan_key(&scan, "ctxt ") && com_procfs_scan_u64(&scan, &value) == 0)
+		{
+			KernelStat->ctxt_rate = KstatRate(value, KernelStat->ctxt, interval);
+			KernelStat->ctxt = value;
+		}
+		else if(com_procfs_scan_key(&scan, "intr ") && com_procfs_scan_u64(&scan, &value) == 0)
+		{
+			KernelStat->intr_rate = KstatRate(value, KernelStat->intr, interval);
+			KernelStat->intr = value;
+		}
+		else if(com_procfs_scan_key(&scan, "procs_running ") && com_procfs_scan_u64(&scan, &value) == 0)
+		{
+			KernelStat->procs_running = (int32_t)value;
+		}
+		else if(com_procfs_scan_key(&scan, "procs_blocked ") && com_procfs_scan_u64(&scan, &value) == 0)
+		{
+			KernelStat->procs_blocked = (int32_t)value;
+		}
+	} while(com_procfs_scan_line(&scan));
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   /proc/interrupts取得処理
+ * @note    "  45:   12   34   GICv3  45 Level  xhci-hcd:usb1"形式．
+ *          IPI等の行も同様に扱う．ERR/MIS等の1列だけの行はCPU0に計上する．
+ * @param   引数  : interval	前回取得からの経過時間[ms](0:初回)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int KstatInterrupts(uint64_t interval)
+{
+	static procfsFile file = COM_PROCFS_FILE("/proc/interrupts");
+	static char buf[DEF_KSTAT_BUF_MAX];
+	procfsScan scan;
+	kstatIrq *irq = KSTAT_IRQ(KernelStat);
+	int32_t *rate;
+	uint64_t *prev;
+	uint64_t value;
+	const char *word;
+	const char *desc;
+	int cols;
+	int col;
+	int cpu;
+	int slot;
+	int line = 0;
+	int len;
+
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
+	{
+		dprintf(ERROR, "/proc/interrupts read failed.\n");
+		return DEF_RET_NG;
+	}
+	com_procfs_scan_init(&scan, buf, len);
+	cols = KstatHeader(&scan);
+
+	while(com_procfs_scan_line(&scan))
+	{
+		//IRQ名("45:")
+		len = com_procfs_scan_word(&scan, &word);
+		if(len < 2 || word[len - 1] != ':')
+		{
+			continue;
+		}
+		slot = KstatIrqSlot(word, len - 1, line++);
+		if(slot < 0)
+		{
+			continue;
+		}
+
+		rate = KSTAT_IRQ_RATE(KernelStat, slot);
+		prev = &KstatIrqPrev[(size_t)slot * KernelStat->cpu_num];
+		memset(rate, 0, KernelStat->cpu_num * sizeof(int32_t));
+		irq[slot].rate = 0;
+		for(col = 0; col < cols && KstatNumber(&scan, &value) == 0; col++)
+		{
+			cpu = KstatColumn[col];
+			if(KstatIrqSeen[slot])
+			{
+				rate[cpu] = KstatRate(value, prev[cpu], interval);
+				irq[slot].rate += rate[cpu];
+			}
+			prev[cpu] = value;
+		}
+		KstatIrqSeen[slot] = 1;
+
+		//説明(残り全体，長い場合はデバイス名のある末尾を残す)
+		while(scan.pos < scan.eol && (*scan.pos == ' ' || *scan.pos == '\t'))
+		{
+			scan.pos++;
+		}
+		desc = scan.pos;
+		len = (int)(scan.eol - desc);
+		if(len >= DEF_KSTAT_DESC_LEN)
+		{
+			desc += len - (DEF_KSTAT_DESC_LEN - 1);
+			len = DEF_KSTAT_DESC_LEN - 1;
+		}
+		memcpy(irq[slot].desc, desc, len);
+		irq[slot].desc[len] = '\0';
+	}
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   /proc/softirqs取得処理
+ * @note    "      TIMER:   1234   5678"形式．
+ * @param   引数  : interval	前回取得からの経過時間[ms](0:初回)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int KstatSoftirqs(uint64_t interval)
+{
+	static procfsFile file = COM_PROCFS_FILE("/proc/softirqs");
+	static char buf[DEF_KSTAT_BUF_MAX];
+	procfsScan scan;
+	int32_t *rate;
+	uint64_t *prev;
+	uint64_t value;
+	const char *word;
+	int cols;
+	int cpu;
+	int len;
+	int kind;
+
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
+	{
+		dprintf(ERROR, "/proc/softirqs read failed.\n");
+		return DEF_RET_NG;
+	}
+	com_procfs_scan_init(&scan, buf, len);
+	cols = KstatHeader(&scan);
+
+	KernelStat->softirq_rate = 0;
+	while(com_procfs_scan_line(&scan))
+	{
+		len = com_procfs_scan_word(&scan, &word);
+		for(kind = 0; kind < KSTAT_SOFTIRQ_MAX; kind++)
+		{
+			if((int)strlen(KstatSoftName[kind]) == len && memcmp(word, KstatSoftName[kind], len) == 0)
+			{
+				break;
+			}
+		}
+		if(kind >= KSTAT_SOFTIRQ_MAX)
+		{
+			continue;
+		}
+
+		rate = KSTAT_SOFTIRQ_RATE(KernelStat, kind);
+		prev = &KstatSoftPrev[(size_t)kind * KernelStat->cpu_num];
+		memset(rate, 0, KernelStat->cpu_num * sizeof(int32_t));
+		for(int col = 0; col < cols && KstatNumber(&scan, &value) == 0; col++)
+		{
+			cpu = KstatColumn[col];
+			if(interval > 0)
+			{
+				rate[cpu] = KstatRate(value, prev[cpu], interval);
+				KernelStat->softirq_rate += rate[cpu];
+			}
+			prev[cpu] = value;
+		}
+	}
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ヘッダ行解析
+ * @note    "   CPU0   CPU2"のCPU番号を列順にKstatColumnに格納する．
+ * @param   引数  : scan	解析位置(先頭行)
+ * @return  戻り値: 列数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int KstatHeader(procfsScan *scan)
+{
+	const char *word;
+	int len;
+	int cpu;
+	int cols = 0;
+
+	while((len = com_procfs_scan_word(scan, &word)) > 0 && cols < KernelStat->cpu_num)
+	{
+		if(len < 4 || memcmp(word, "CPU", 3) != 0)
+		{
+			break;
+		}
+		cpu = atoi(word + 3);
+		if(cpu < 0 || cpu >= KernelStat->cpu_num)
+		{
+			break;
+		}
+		KstatColumn[cols++] = cpu;
+	}
+	return cols;
+}
+
+/*============================================================================*/
+/*
+ * @brief   数値列取得
+ * @note    次の単語が数字のみの場合に読み込む．それ以外は解析位置を戻す．
+ * @param   引数  : scan	解析位置
+ * @param   引数  : value	読み込んだ値
+ * @return  戻り値: 0:正常，-1:数値でない
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int KstatNumber(procfsScan *scan, uint64_t *value)
+{
+	const char *pos = scan->pos;
+	const char *word;
+	uint64_t val = 0;
+	int len;
+
+	len = com_procfs_scan_word(scan, &word);
+	if(len == 0)
+	{
+		return -1;
+	}
+	for(int i = 0; i < len; i++)
+	{
+		if(word[i] < '0' || '9' < word[i])
+		{
+			scan->pos = pos;
+			return -1;
+		}
+		val = val * 10 + (uint64_t)(word[i] - '0');
+	}
+	*value = val;
+	return 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   IRQの格納位置取得
+ * @note    前回と同じ行順であればhintの位置を使う．
+ *          見つからなければ追加し，格納できなければ-1を返す．
+ * @param   引数  : name	IRQ名
+ * @param   引数  : len		IRQ名の長さ
+ * @param   引数  : hint	行番号
+ * @return  戻り値: 格納位置，-1:格納できない
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int KstatIrqSlot(const char *name, int len, int hint)
+{
+	kstatIrq *irq = KSTAT_IRQ(KernelStat);
+	int slot;
+
+	if(len >= DEF_KSTAT_NAME_LEN)
+	{
+		len = DEF_KSTAT_NAME_LEN - 1;
+	}
+
+	if(hint < KernelStat->irq_num && strncmp(irq[hint].name, name, len) == 0 && irq[hint].name[len] == '\0')
+	{
+		return hint;
+	}
+	for(slot = 0; slot < KernelStat->irq_num; slot++)
+	{
+		if(strncmp(irq[slot].name, name, len) == 0 && irq[slot].name[len] == '\0')
+		{
+			return slot;
+		}
+	}
+
+	//追加
+	if(KernelStat->irq_num >= KernelStat->irq_max)
+	{
+		dprintf(WARN, "too many irq. ignore %.*s\n", len, name);
+		return -1;
+	}
+	slot = KernelStat->irq_num++;
+	memcpy(irq[slot].name, name, len);
+	irq[slot].name[len] = '\0';
+	KstatIrqSeen[slot] = 0;
+	return slot;
+}
+
+/*============================================================================*/
+/*
+ * @brief   発生率計算
+ * @param   引数  : curr		今回の累計値
+ * @param   引数  : prev		前回の累計値
+ * @param   引数  : interval	経過時間[ms](0:初回)
+ * @return  戻り値: 発生率[回/s]
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int32_t KstatRate(uint64_t curr, uint64_t prev, uint64_t interval)
+{
+	if(interval == 0 || curr < prev)
+	{
+		return 0;
+	}
+	return (int32_t)((curr - prev) * 1000 / interval);
+}
@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <unistd.h>
 #include <pthread.h>
@@ -52,13 +53,14 @@ static int Start(int fd);
  * @param   引数  : 
  * @return  戻り値: uint64_t
  * @date    2023/12/15 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] com_timerの時刻源から取得
  */
 /*============================================================================*/
 static uint64_t get_time_usec()
 {
-	static struct timeval _time_stamp;
-	gettimeofday(&_time_stamp, NULL);
-	return _time_stamp.tv_sec*1000000 + _time_stamp.tv_usec;
+	struct timespec _time_stamp;
+	com_timer_clock_gettime(CLOCK_REALTIME, &_time_stamp);
+	return (uint64_t)_time_stamp.tv_sec*1000000 + _time_stamp.tv_nsec/1000;
 }
 
 /*============================================================================*/
@@ -614,6 +616,7 @@ static void commands(int fd)
  * @param   引数  : int fd
  * @return  戻り値: int ret
  * @date    2023/12/15 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] スレッド名を設定
  */
 /*============================================================================*/
 static int Start(int fd)
@@ -628,6 +631,7 @@ static int Start(int fd)
         dprintf(WARN, "read thread create error=%d\n", errno);
         return DEF_RET_NG;
     }
+    pthread_setname_np(read_thread_id, "hjpf_mav_read");
 
     dprintf(INFO, "CHECK FOR MESSAGES\n");
 
@@ -669,6 +673,7 @@ static int Start(int fd)
         dprintf(WARN, "write thread create error=%d\n", errno);
         return DEF_RET_NG;
     }
+    pthread_setname_np(write_thread_id, "hjpf_mav_write");
 
     return 0;
 }
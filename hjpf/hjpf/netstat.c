@@ -0,0 +1,457 @@
+/*============================================================================*/
+/*
+ * @file    netstat.c
+ * @brief   ネットワークインタフェース監視
+ * @note    /proc/net/devの累計値の差分から送受信量・エラー・破棄の発生率を求める．
+ *          無線インタフェースは/proc/net/wirelessの信号強度・雑音と，
+ *          SIOCGIWRATEのビットレートを取得する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <net/if.h>
+#include <linux/wireless.h>
+#include "com_shmem.h"
+#include "com_procfs.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "netstat.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static netStat *NetStat = NULL;
+static int NetStatSize = 0;
+static uint8_t *NetSeen = NULL;			/* 1:前回値あり */
+static uint64_t NetPrevTime = 0;		/* 前回取得時刻[ms] */
+static int NetSock = -1;				/* ioctl用ソケット */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int NetDev(uint64_t interval);
+static int NetWireless(void);
+static int NetSlot(const char *name, int len);
+static void NetLink(netIf *ifs);
+static int32_t NetRate(uint64_t curr, uint64_t prev, uint64_t interval);
+
+/*============================================================================*/
+/*
+ * @brief   ネットワーク監視初期化処理
+ * @note    起動時のインタフェース数から共有メモリのサイズを決定する．
+ *          com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int NetInit(void)
+{
+	procfsFile file = COM_PROCFS_FILE("/proc/net/dev");
+	char buf[DEF_NET_BUF_MAX];
+	procfsScan scan;
+	int if_max = 0;
+	int len;
+
+	if(NetStat != NULL)
+	{
+		return DEF_RET_OK;
+	}
+
+	//現在のインタフェース数(ヘッダ2行を除く行数)
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	com_procfs_close(&file);
+	if(len > 0)
+	{
+		com_procfs_scan_init(&scan, buf, len);
+		while(com_procfs_scan_line(&scan))
+		{
+			if(memchr(scan.pos, ':', scan.eol - scan.pos) != NULL)
+			{
+				if_max++;
+			}
+		}
+	}
+	if_max += DEF_NET_IF_SPARE;
+	if(if_max > DEF_NET_IF_MAX)
+	{
+		if_max = DEF_NET_IF_MAX;
+	}
+
+	NetStatSize = DEF_NET_STAT_SIZE(if_max);
+	NetStat = calloc(1, NetStatSize);
+	NetSeen = calloc(if_max, sizeof(uint8_t));
+	if(NetStat == NULL || NetSeen == NULL)
+	{
+		dprintf(ERROR, "calloc failed.\n");
+		return DEF_RET_NG;
+	}
+	NetStat->if_max = if_max;
+
+	//共有メモリサイズを設定
+	com_shmem_set_size(DEF_NET_SHMEM_NAME, NetStatSize);
+	dprintf(INFO, "if max = %d, %s size = %d\n", if_max, DEF_NET_SHMEM_NAME, NetStatSize);
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ネットワーク監視処理
+ * @note    各インタフェースの統計を取得し，共有メモリに書き込む．
+ * @param   引数  : id	共有メモリID(DEF_NET_SHMEM_NAME)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int NetUpdate(int id)
+{
+	struct timespec ts;
+	uint64_t now;
+	uint64_t interval = 0;
+	int ret;
+
+	if(NetStat == NULL)
+	{
+		return DEF_RET_NG;
+	}
+	if(NetSock < 0)
+	{
+		NetSock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	if(NetPrevTime != 0 && now > NetPrevTime)
+	{
+		interval = now - NetPrevTime;
+	}
+	NetPrevTime = now;
+	NetStat->interval = (int32_t)interval;
+
+	ret = NetDev(interval);
+	if(ret == DEF_RET_OK)
+	{
+		NetWireless();
+	}
+
+	//共有メモリに書き込み
+	com_shmem_write(id, NetStat, NetStatSize);
+
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   インタフェース検索
+ * @param   引数  : stat	ネットワーク監視情報
+ * @param   引数  : name	インタフェース名
+ * @return  戻り値: インタフェース，NULL:該当なし
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+const netIf* NetFind(const netStat *stat, const char *name)
+{
+	for(int i = 0; i < stat->if_num && i < stat->if_max; i++)
+	{
+		if(strncmp(stat->ifs[i].name, name, DEF_NET_NAME_LEN) == 0)
+		{
+			return &stat->ifs[i];
+		}
+	}
+	return NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   /proc/net/dev取得処理
+ * @note    "  eth0: 1234 5 0 0 0 0 0 0 5678 6 0 0 0 0 0 0"形式
+ *          (受信:bytes packets errs drop fifo frame compressed multicast，
+ *           送信:bytes packets errs drop fifo colls carrier compressed)．
+ *          今回の一覧に無いインタフェースはスロットを残したままダウンとし，
+ *          レートを0にする．
+ * @param   引数  : interval	前回取得からの経過時間[ms](0:初回)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 消滅したインタフェースをダウン扱いに変更
+ */
+/*============================================================================*/
+static int NetDev(uint64_t interval)
+{
+	static procfsFile file = COM_PROCFS_FILE("/proc/net/dev");
+	static char buf[DEF_NET_BUF_MAX];
+	procfsScan scan;
+	netIf *ifs;
+	netIf prev;
+	uint8_t found[DEF_NET_IF_MAX] = {0};
+	uint64_t val[16];
+	const char *name;
+	const char *colon;
+	int slot;
+	int len;
+	int cnt;
+
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
+	{
+		dprintf(ERROR, "/proc/net/dev read failed.\n");
+		return DEF_RET_NG;
+	}
+
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		//インタフェース名(大きな値では':'の直後に数値が続く)
+		colon = memchr(scan.pos, ':', scan.eol - scan.pos);
+		if(colon == NULL)
+		{
+			continue;
+		}
+		for(name = scan.pos; name < colon && *name == ' '; name++);
+		slot = NetSlot(name, (int)(colon - name));
+		if(slot < 0)
+		{
+			continue;
+		}
+
+		scan.pos = colon + 1;
+		for(cnt = 0; cnt < 16 && com_procfs_scan_u64(&scan, &val[cnt]) == 0; cnt++);
+		if(cnt < 16)
+		{
+			continue;
+		}
+
+		ifs = &NetStat->ifs[slot];
+		prev = *ifs;
+		ifs->rx_bytes = val[0];
+		ifs->rx_packets = val[1];
+		ifs->rx_errors = val[2];
+		ifs->rx_drop = val[3];
+		ifs->tx_bytes = val[8];
+		ifs->tx_packets = val[9];
+		ifs->tx_errors = val[10];
+		ifs->tx_drop = val[11];
+
+		if(NetSeen[slot] && interval > 0)
+		{
+			ifs->rx_bps = (ifs->rx_bytes >= prev.rx_bytes) ? (int64_t)((ifs->rx_bytes - prev.rx_bytes) * 1000 / interval) : 0;
+			ifs->tx_bps = (ifs->tx_bytes >= prev.tx_bytes) ? (int64_t)((ifs->tx_bytes - prev.tx_bytes) * 1000 / interval) : 0;
+			ifs->rx_pps = NetRate(ifs->rx_packets, prev.rx_packets, interval);
+			ifs->tx_pps = NetRate(ifs->tx_packets, prev.tx_packets, interval);
+			ifs->rx_err_ps = NetRate(ifs->rx_errors, prev.rx_errors, interval);
+			ifs->tx_err_ps = NetRate(ifs->tx_errors, prev.tx_errors, interval);
+			ifs->rx_drop_ps = NetRate(ifs->rx_drop, prev.rx_drop, interval);
+			ifs->tx_drop_ps = NetRate(ifs->tx_drop, prev.tx_drop, interval);
+		}
+		NetSeen[slot] = 1;
+		found[slot] = 1;
+
+		NetLink(ifs);
+	} while(com_procfs_scan_line(&scan));
+
+	//消滅したインタフェース(再出現時はレートを初回扱いで再計算)
+	for(slot = 0; slot < NetStat->if_num; slot++)
+	{
+		if(found[slot])
+		{
+			continue;
+		}
+		ifs = &NetStat->ifs[slot];
+		ifs->up = 0;
+		ifs->rx_bps = 0;
+		ifs->tx_bps = 0;
+		ifs->rx_pps = 0;
+		ifs->tx_pps = 0;
+		ifs->rx_err_ps = 0;
+		ifs->tx_err_ps = 0;
+		ifs->rx_drop_ps = 0;
+		ifs->tx_drop_ps = 0;
+		NetSeen[slot] = 0;
+	}
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   /proc/net/wireless取得処理
+ * @note    " wlan0: 0000   70.  -40.  -256  0 0 0 0 0  0"形式
+ *          (status，link，level，noise，...)．
+ *          記載の無いインタフェースは無線でないものとする．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int NetWireless(void)
+{
+	static procfsFile file = COM_PROCFS_FILE("/proc/net/wireless");
+	static int exist = 1;
+	char buf[DEF_NET_BUF_MAX];
+	procfsScan scan;
+	struct iwreq wrq;
+	netIf *ifs;
+	const char *name;
+	const char *colon;
+	int32_t val[3];
+	int slot;
+	int len;
+
+	for(int i = 0; i < NetStat->if_num; i++)
+	{
+		NetStat->ifs[i].wireless = 0;
+	}
+
+	//無線拡張が無いカーネルでは毎回オープンを試みない
+	if(!exist)
+	{
+		return DEF_RET_OK;
+	}
+	if(file.fd < 0 && access(file.path, R_OK) != 0)
+	{
+		exist = 0;
+		return DEF_RET_OK;
+	}
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
+	{
+		return DEF_RET_NG;
+	}
+
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		colon = memchr(scan.pos, ':', scan.eol - scan.pos);
+		if(colon == NULL)
+		{
+			continue;
+		}
+		for(name = scan.pos; name < colon && *name == ' '; name++);
+		slot = NetSlot(name, (int)(colon - name));
+		if(slot < 0)
+		{
+			continue;
+		}
+		ifs = &NetStat->ifs[slot];
+		ifs->wireless = 1;
+		memset(val, 0, sizeof(val));
+
+		//status(16進)を読み飛ばし，link，level，noise("70."，"-40."等の整数部)
+		scan.pos = colon + 1;
+		com_procfs_scan_skip(&scan, 1);
+		for(int i = 0; i < 3 && com_procfs_scan_word(&scan, &name) > 0; i++)
+		{
+			val[i] = (int32_t)strtol(name, NULL, 10);
+		}
+		ifs->link = val[0];
+		ifs->level = val[1];
+		ifs->noise = val[2];
+
+		//ビットレート
+		ifs->bitrate = 0;
+		if(NetSock >= 0)
+		{
+			memset(&wrq, 0, sizeof(wrq));
+			snprintf(wrq.ifr_name, sizeof(wrq.ifr_name), "%s", ifs->name);
+			if(ioctl(NetSock, SIOCGIWRATE, &wrq) == 0)
+			{
+				ifs->bitrate = (int32_t)(wrq.u.bitrate.value / 1000);
+			}
+		}
+	} while(com_procfs_scan_line(&scan));
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   インタフェースの格納位置取得
+ * @note    見つからなければ追加し，格納できなければ-1を返す．
+ * @param   引数  : name	インタフェース名
+ * @param   引数  : len		インタフェース名の長さ
+ * @return  戻り値: 格納位置，-1:格納できない
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int NetSlot(const char *name, int len)
+{
+	int slot;
+
+	if(len <= 0 || len >= DEF_NET_NAME_LEN)
+	{
+		return -1;
+	}
+	for(slot = 0; slot < NetStat->if_num; slot++)
+	{
+		if(strncmp(NetStat->ifs[slot].name, name, len) == 0 && NetStat->ifs[slot].name[len] == '\0')
+		{
+			return slot;
+		}
+	}
+
+	//追加
+	if(NetStat->if_num >= NetStat->if_max)
+	{
+		dprintf(WARN, "too many interface. ignore %.*s\n", len, name);
+		return -1;
+	}
+	slot = NetStat->if_num++;
+	memcpy(NetStat->ifs[slot].name, name, len);
+	NetStat->ifs[slot].name[len] = '\0';
+	NetSeen[slot] = 0;
+	return slot;
+}
+
+/*============================================================================*/
+/*
+ * @brief   リンク状態取得
+ * @param   引数  : ifs	インタフェース
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void NetLink(netIf *ifs)
+{
+	struct ifreq ifr;
+
+	ifs->up = 0;
+	if(NetSock < 0)
+	{
+		return;
+	}
+	memset(&ifr, 0, sizeof(ifr));
+	snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "%s", ifs->name);
+	if(ioctl(NetSock, SIOCGIFFLAGS, &ifr) == 0)
+	{
+		ifs->up = ((ifr.ifr_flags & IFF_UP) && (ifr.ifr_flags & IFF_RUNNING)) ? 1 : 0;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   発生率計算
+ * @param   引数  : curr		今回の累計値
+ * @param   引数  : prev		前回の累計値
+ * @param   引数  : interval	経過時間[ms]
+ * @return  戻り値: 発生率[個/s]
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int32_t NetRate(uint64_t curr, uint64_t prev, uint64_t interval)
+{
+	if(interval == 0 || curr < prev)
+	{
+		return 0;
+	}
+	return (int32_t)((curr - prev) * 1000 / interval);
+}
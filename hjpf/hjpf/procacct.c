@@ -0,0 +1,322 @@
+/*============================================================================*/
+/*
+ * @file    procacct.c
+ * @brief   プロセス毎のリソース使用量取得
+ * @note    topをpopen()で起動してgrepする代わりに，対象プロセスの/procのファイルを
+ *          pread()で読み直す．起動時にオープンし，終了を検知したら閉じる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include "com_procfs.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "procacct.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static const char *AcctFileName[ACCT_FILE_MAX] = { "stat", "statm", "io", "smaps_rollup" };
+static long AcctTick = 0;				/* 1秒あたりのclock tick */
+static long AcctPageKB = 0;				/* ページサイズ[kB] */
+static uint64_t AcctMemKB = 0;			/* 物理メモリ量[kB] */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int ProcAcctStat(procAcct *acct, uint64_t *ticks);
+static int ProcAcctStatm(procAcct *acct, int32_t *rss);
+static int ProcAcctIO(procAcct *acct, uint64_t *rd, uint64_t *wr);
+static int ProcAcctPss(procAcct *acct, int32_t *pss);
+
+/*============================================================================*/
+/*
+ * @brief   取得開始
+ * @note    プロセス起動直後に呼び出す．io，smaps_rollupが無い場合はその項目のみ取得しない．
+ * @param   引数  : acct	取得状態
+ * @param   引数  : pid		プロセスID
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcAcctOpen(procAcct *acct, int pid)
+{
+	if(AcctTick == 0)
+	{
+		AcctTick = sysconf(_SC_CLK_TCK);
+		AcctPageKB = sysconf(_SC_PAGESIZE) / 1024;
+		AcctMemKB = (uint64_t)sysconf(_SC_PHYS_PAGES) * (uint64_t)AcctPageKB;
+	}
+
+	ProcAcctClose(acct);
+	memset(acct, 0, sizeof(*acct));
+	acct->pid = pid;
+	for(int i = 0; i < ACCT_FILE_MAX; i++)
+	{
+		acct->file[i].fd = -1;
+	}
+	for(int i = 0; i < ACCT_FILE_MAX; i++)
+	{
+		snprintf(acct->path[i], sizeof(acct->path[i]), "/proc/%d/%s", pid, AcctFileName[i]);
+		if(com_procfs_open(&acct->file[i], acct->path[i]) != 0 && i == ACCT_FILE_STAT)
+		{
+			ProcAcctClose(acct);
+			return DEF_RET_NG;
+		}
+	}
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   使用量取得
+ * @note    CPU使用率・I/O量は前回からの差分(初回は0)．
+ * @param   引数  : acct	取得状態
+ * @param   引数  : value	取得結果
+ * @return  戻り値: int(DEF_RET_NG:プロセスが存在しない)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcAcctUpdate(procAcct *acct, procAcctValue *value)
+{
+	struct timespec ts;
+	uint64_t now;
+	uint64_t interval = 0;
+	uint64_t ticks;
+	uint64_t rd = 0;
+	uint64_t wr = 0;
+
+	memset(value, 0, sizeof(*value));
+	value->pss = -1;
+	if(acct->pid <= 0 || ProcAcctStat(acct, &ticks) != DEF_RET_OK)
+	{
+		return DEF_RET_NG;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	if(acct->stamp != 0 && now > acct->stamp)
+	{
+		interval = now - acct->stamp;
+	}
+
+	//CPU使用率
+	if(interval > 0 && ticks >= acct->ticks)
+	{
+		value->cpu = (float)(ticks - acct->ticks) * 100000.0f / (float)AcctTick / (float)interval;
+	}
+
+	//メモリ
+	if(ProcAcctStatm(acct, &value->rss) == DEF_RET_OK && AcctMemKB > 0)
+	{
+		value->mem = (float)value->rss * 100.0f / (float)AcctMemKB;
+	}
+	ProcAcctPss(acct, &value->pss);
+
+	//I/O量
+	if(ProcAcctIO(acct, &rd, &wr) == DEF_RET_OK && interval > 0)
+	{
+		if(rd >= acct->rd_bytes)
+		{
+			value->rd_kbps = (int32_t)((rd - acct->rd_bytes) * 1000 / 1024 / interval);
+		}
+		if(wr >= acct->wr_bytes)
+		{
+			value->wr_kbps = (int32_t)((wr - acct->wr_bytes) * 1000 / 1024 / interval);
+		}
+	}
+
+	acct->ticks = ticks;
+	acct->rd_bytes = rd;
+	acct->wr_bytes = wr;
+	acct->stamp = now;
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   取得終了
+ * @note    プロセス終了を検知したら，PIDの再利用で別プロセスを読まないよう閉じる．
+ * @param   引数  : acct	取得状態
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcAcctClose(procAcct *acct)
+{
+	if(acct->pid <= 0)
+	{
+		return;
+	}
+	for(int i = 0; i < ACCT_FILE_MAX; i++)
+	{
+		com_procfs_close(&acct->file[i]);
+	}
+	acct->pid = 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPU時間取得
+ * @note    comm(第2項目)は空白や')'を含み得るため，最後の')'以降を解析する．
+ * @param   引数  : acct	取得状態
+ * @param   引数  : ticks	utime+stime[clock tick]
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcAcctStat(procAcct *acct, uint64_t *ticks)
+{
+	char buf[512];
+	procfsScan scan;
+	uint64_t utime;
+	uint64_t stime;
+	char *p;
+	int len;
+
+	if(acct->file[ACCT_FILE_STAT].fd < 0)
+	{
+		return DEF_RET_NG;
+	}
+	len = com_procfs_read(&acct->file[ACCT_FILE_STAT], buf, sizeof(buf));
+	if(len <= 0 || (p = strrchr(buf, ')')) == NULL)
+	{
+		return DEF_RET_NG;
+	}
+
+	//state(第3項目)からcstime(第13項目)までを読み飛ばし，utime，stimeを取得
+	com_procfs_scan_init(&scan, p + 1, len - (int)(p + 1 - buf));
+	if(com_procfs_scan_skip(&scan, 11) != 11 ||
+		com_procfs_scan_u64(&scan, &utime) != 0 || com_procfs_scan_u64(&scan, &stime) != 0)
+	{
+		return DEF_RET_NG;
+	}
+	*ticks = utime + stime;
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   常駐サイズ取得
+ * @param   引数  : acct	取得状態
+ * @param   引数  : rss		常駐サイズ[kB]
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcAcctStatm(procAcct *acct, int32_t *rss)
+{
+	char buf[128];
+	procfsScan scan;
+	uint64_t size;
+	uint64_t resident;
+	int len;
+
+	if(acct->file[ACCT_FILE_STATM].fd < 0)
+	{
+		return DEF_RET_NG;
+	}
+	len = com_procfs_read(&acct->file[ACCT_FILE_STATM], buf, sizeof(buf));
+	if(len <= 0)
+	{
+		return DEF_RET_NG;
+	}
+	com_procfs_scan_init(&scan, buf, len);
+	if(com_procfs_scan_u64(&scan, &size) != 0 || com_procfs_scan_u64(&scan, &resident) != 0)
+	{
+		return DEF_RET_NG;
+	}
+	*rss = (int32_t)(resident * (uint64_t)AcctPageKB);
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   I/O量取得
+ * @note    ページキャッシュを除いたストレージへの読み書き量(read_bytes，write_bytes)．
+ * @param   引数  : acct	取得状態
+ * @param   引数  : rd		read_bytes(累計)
+ * @param   引数  : wr		write_bytes(累計)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcAcctIO(procAcct *acct, uint64_t *rd, uint64_t *wr)
+{
+	char buf[256];
+	procfsScan scan;
+	int found = 0;
+	int len;
+
+	if(acct->file[ACCT_FILE_IO].fd < 0)
+	{
+		return DEF_RET_NG;
+	}
+	len = com_procfs_read(&acct->file[ACCT_FILE_IO], buf, sizeof(buf));
+	if(len <= 0)
+	{
+		return DEF_RET_NG;
+	}
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		if(com_procfs_scan_key(&scan, "read_bytes:") && com_procfs_scan_u64(&scan, rd) == 0)
+		{
+			found++;
+		}
+		else if(com_procfs_scan_key(&scan, "write_bytes:") && com_procfs_scan_u64(&scan, wr) == 0)
+		{
+			found++;
+		}
+	} while(found < 2 && com_procfs_scan_line(&scan));
+
+	return (found == 2) ? DEF_RET_OK : DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   比例配分サイズ取得
+ * @note    smaps_rollupの無いカーネル(4.14未満)では取得しない．
+ * @param   引数  : acct	取得状態
+ * @param   引数  : pss		比例配分サイズ[kB]
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcAcctPss(procAcct *acct, int32_t *pss)
+{
+	char buf[1024];
+	procfsScan scan;
+	uint64_t val;
+	int len;
+
+	if(acct->file[ACCT_FILE_SMAPS].fd < 0)
+	{
+		return DEF_RET_NG;
+	}
+	len = com_procfs_read(&acct->file[ACCT_FILE_SMAPS], buf, sizeof(buf));
+	if(len <= 0)
+	{
+		return DEF_RET_NG;
+	}
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		if(com_procfs_scan_key(&scan, "Pss:") && com_procfs_scan_u64(&scan, &val) == 0)
+		{
+			*pss = (int32_t)val;
+			return DEF_RET_OK;
+		}
+	} while(com_procfs_scan_line(&scan));
+
+	return DEF_RET_NG;
+}
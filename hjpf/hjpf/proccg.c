@@ -0,0 +1,370 @@
+/*============================================================================*/
+/*
+ * @file    proccg.c
+ * @brief   管理プロセスのcgroup v2制御
+ * @note    子プロセスはfork後，execveの前に自身をcgroup.procsへ書き込むため，
+ *          起動直後から制限が掛かる．cgroup v2が無い環境では何もしない
+ *          (従来どおり/procの値で監視し，上限超過時はSIGINTで停止する)．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "com_procfs.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "proccg.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static const char *CgFileName[CG_FILE_MAX] = { "cpu.stat", "memory.current", "memory.events" };
+static const char *CgController[] = { "+cpu", "+memory", "+io" };
+static int CgEnable = DEF_COMM_OFF;		/* cgroup v2使用可 */
+static uint64_t CgMemBytes = 0;			/* 物理メモリ量[byte] */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int ProcCgWrite(const char *dir, const char *name, const char *value);
+static int ProcCgRead(procCg *cg, int kind, char *buf, int size);
+
+/*============================================================================*/
+/*
+ * @brief   cgroup初期化
+ * @note    cgroup v2を確認し，DEF_CG_ROOTを作成してcpu，memory，ioコントローラを有効にする．
+ * @param   引数  : void
+ * @return  戻り値: int(DEF_RET_NG:cgroup v2を使用しない)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcCgInit(void)
+{
+	CgEnable = DEF_COMM_OFF;
+	CgMemBytes = (uint64_t)sysconf(_SC_PHYS_PAGES) * (uint64_t)sysconf(_SC_PAGESIZE);
+
+	if(access(DEF_CG_MOUNT "/cgroup.controllers", R_OK) != 0)
+	{
+		dprintf(INFO, "cgroup v2 is not mounted on %s.\n", DEF_CG_MOUNT);
+		return DEF_RET_NG;
+	}
+	if(mkdir(DEF_CG_ROOT, 0755) != 0 && errno != EEXIST)
+	{
+		dprintf(WARN, "mkdir(%s) failed. errno = %d\n", DEF_CG_ROOT, errno);
+		return DEF_RET_NG;
+	}
+
+	//コントローラは個別に有効にする(使えないものがあっても他は有効にする)
+	for(int i = 0; i < sizeof(CgController) / sizeof(CgController[0]); i++)
+	{
+		if(ProcCgWrite(DEF_CG_MOUNT, "cgroup.subtree_control", CgController[i]) == DEF_RET_OK)
+		{
+			ProcCgWrite(DEF_CG_ROOT, "cgroup.subtree_control", CgController[i]);
+		}
+	}
+
+	CgEnable = DEF_COMM_ON;
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   cgroup作成
+ * @note    DEF_CG_ROOT/<name>を作成し，設定値を書き込む．既に有れば設定のみ行う．
+ * @param   引数  : cg		cgroup
+ * @param   引数  : name	cgroup名(process.confのグループ名)
+ * @param   引数  : conf	設定値
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] パスが切り詰められる場合は作成しない
+ */
+/*============================================================================*/
+int ProcCgCreate(procCg *cg, const char *name, const procCgConf *conf)
+{
+	char value[16];
+	char *p;
+
+	memset(cg, 0, sizeof(*cg));
+	cg->procs_fd = -1;
+	for(int i = 0; i < CG_FILE_MAX; i++)
+	{
+		cg->file[i].fd = -1;
+	}
+	if(CgEnable != DEF_COMM_ON)
+	{
+		return DEF_RET_NG;
+	}
+
+	if(snprintf(cg->path, sizeof(cg->path), "%s/%s", DEF_CG_ROOT, name) >= (int)sizeof(cg->path))
+	{
+		dprintf(WARN, "cgroup name(%s) is too long.\n", name);
+		cg->path[0] = '\0';
+		return DEF_RET_NG;
+	}
+	for(p = cg->path + strlen(DEF_CG_ROOT) + 1; *p != '\0'; p++)
+	{
+		if(*p == '/' || *p == ' ')
+		{
+			*p = '_';
+		}
+	}
+	if(mkdir(cg->path, 0755) != 0 && errno != EEXIST)
+	{
+		dprintf(WARN, "mkdir(%s) failed. errno = %d\n", cg->path, errno);
+		cg->path[0] = '\0';
+		return DEF_RET_NG;
+	}
+
+	//制限
+	if(conf->cpu_max[0] != '\0' && ProcCgWrite(cg->path, "cpu.max", conf->cpu_max) == DEF_RET_OK)
+	{
+		cg->cpu_limit = (strncmp(conf->cpu_max, "max", 3) != 0);
+	}
+	if(conf->cpu_weight > 0)
+	{
+		snprintf(value, sizeof(value), "%d", conf->cpu_weight);
+		ProcCgWrite(cg->path, "cpu.weight", value);
+	}
+	if(conf->memory_high[0] != '\0' && ProcCgWrite(cg->path, "memory.high", conf->memory_high) == DEF_RET_OK)
+	{
+		cg->mem_limit = (strcmp(conf->memory_high, "max") != 0);
+	}
+	if(conf->memory_max[0] != '\0' && ProcCgWrite(cg->path, "memory.max", conf->memory_max) == DEF_RET_OK)
+	{
+		cg->mem_limit |= (strcmp(conf->memory_max, "max") != 0);
+	}
+	if(conf->io_max[0] != '\0')
+	{
+		ProcCgWrite(cg->path, "io.max", conf->io_max);
+	}
+
+	//子プロセスの登録先(forkで引き継ぎ，execveで閉じる)
+	snprintf(cg->file_path[0], sizeof(cg->file_path[0]), "%s/cgroup.procs", cg->path);
+	cg->procs_fd = open(cg->file_path[0], O_WRONLY | O_CLOEXEC);
+	if(cg->procs_fd < 0)
+	{
+		dprintf(WARN, "open(%s) failed. errno = %d\n", cg->file_path[0], errno);
+		ProcCgDestroy(cg);
+		return DEF_RET_NG;
+	}
+
+	//使用量
+	for(int i = 0; i < CG_FILE_MAX; i++)
+	{
+		snprintf(cg->file_path[i], sizeof(cg->file_path[i]), "%s/%s", cg->path, CgFileName[i]);
+		com_procfs_open(&cg->file[i], cg->file_path[i]);
+	}
+
+	dprintf(INFO, "%s created. cpu_limit = %d, mem_limit = %d\n", cg->path, cg->cpu_limit, cg->mem_limit);
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   cgroupへの登録
+ * @note    fork後の子プロセスでexecveの前に呼び出す(非同期シグナル安全な処理のみ)．
+ * @param   引数  : cg	cgroup
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcCgAttach(procCg *cg)
+{
+	if(cg->procs_fd < 0)
+	{
+		return DEF_RET_NG;
+	}
+	return (write(cg->procs_fd, "0", 1) == 1) ? DEF_RET_OK : DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   使用量取得
+ * @note    CPU使用率・抑制時間の割合は前回からの差分(初回は0)．
+ *          cgroupにはプロセスが起動した子プロセスも含まれる．
+ * @param   引数  : cg		cgroup
+ * @param   引数  : value	取得結果
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcCgUpdate(procCg *cg, procCgValue *value)
+{
+	char buf[512];
+	procfsScan scan;
+	struct timespec ts;
+	uint64_t now;
+	uint64_t interval = 0;
+	uint64_t usage = 0;
+	uint64_t throttled = 0;
+	uint64_t val;
+	int len;
+
+	memset(value, 0, sizeof(*value));
+	if(cg->procs_fd < 0 || (len = ProcCgRead(cg, CG_FILE_CPU_STAT, buf, sizeof(buf))) <= 0)
+	{
+		return DEF_RET_NG;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	if(cg->stamp != 0 && now > cg->stamp)
+	{
+		interval = now - cg->stamp;
+	}
+
+	//CPU使用時間，抑制時間
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		if(com_procfs_scan_key(&scan, "usage_usec "))
+		{
+			com_procfs_scan_u64(&scan, &usage);
+		}
+		else if(com_procfs_scan_key(&scan, "throttled_usec "))
+		{
+			com_procfs_scan_u64(&scan, &throttled);
+		}
+	} while(com_procfs_scan_line(&scan));
+	if(interval > 0)
+	{
+		if(usage >= cg->usage_usec)
+		{
+			value->cpu = (float)(usage - cg->usage_usec) / 10.0f / (float)interval;	/* [us] / ([ms] * 1000) * 100 */
+		}
+		if(throttled >= cg->throttled_usec)
+		{
+			value->throttle = (int32_t)((throttled - cg->throttled_usec) / 10 / interval);
+		}
+	}
+	cg->usage_usec = usage;
+	cg->throttled_usec = throttled;
+	cg->stamp = now;
+
+	//メモリ使用量
+	if((len = ProcCgRead(cg, CG_FILE_MEM_CURRENT, buf, sizeof(buf))) > 0 && CgMemBytes > 0)
+	{
+		com_procfs_scan_init(&scan, buf, len);
+		if(com_procfs_scan_u64(&scan, &val) == 0)
+		{
+			value->mem = (float)val * 100.0f / (float)CgMemBytes;
+		}
+	}
+
+	//メモリ上限超過
+	if((len = ProcCgRead(cg, CG_FILE_MEM_EVENTS, buf, sizeof(buf))) > 0)
+	{
+		com_procfs_scan_init(&scan, buf, len);
+		do
+		{
+			if((com_procfs_scan_key(&scan, "high ") || com_procfs_scan_key(&scan, "max ") ||
+				com_procfs_scan_key(&scan, "oom_kill ")) && com_procfs_scan_u64(&scan, &val) == 0)
+			{
+				value->mem_events += (int32_t)val;
+			}
+		} while(com_procfs_scan_line(&scan));
+	}
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   cgroup削除
+ * @note    プロセス停止後に呼び出す．
+ * @param   引数  : cg	cgroup
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcCgDestroy(procCg *cg)
+{
+	if(cg->path[0] == '\0')
+	{
+		return;
+	}
+	for(int i = 0; i < CG_FILE_MAX; i++)
+	{
+		com_procfs_close(&cg->file[i]);
+	}
+	if(cg->procs_fd >= 0)
+	{
+		close(cg->procs_fd);
+		cg->procs_fd = -1;
+	}
+	if(rmdir(cg->path) != 0)
+	{
+		dprintf(WARN, "rmdir(%s) failed. errno = %d\n", cg->path, errno);
+	}
+	cg->path[0] = '\0';
+}
+
+/*============================================================================*/
+/*
+ * @brief   cgroupファイル書き込み
+ * @param   引数  : dir		cgroupのディレクトリ
+ * @param   引数  : name	ファイル名
+ * @param   引数  : value	書き込む値
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] パスが切り詰められる場合は書き込まない
+ */
+/*============================================================================*/
+static int ProcCgWrite(const char *dir, const char *name, const char *value)
+{
+	char path[DEF_CG_PATH_LEN + DEF_CG_FILE_LEN];
+	ssize_t len;
+	int fd;
+
+	if(snprintf(path, sizeof(path), "%s/%s", dir, name) >= (int)sizeof(path))
+	{
+		dprintf(WARN, "path(%s/%s) is too long.\n", dir, name);
+		return DEF_RET_NG;
+	}
+	fd = open(path, O_WRONLY | O_CLOEXEC);
+	if(fd < 0)
+	{
+		dprintf(WARN, "open(%s) failed. errno = %d\n", path, errno);
+		return DEF_RET_NG;
+	}
+	len = write(fd, value, strlen(value));
+	if(len != (ssize_t)strlen(value))
+	{
+		dprintf(WARN, "write(%s, %s) failed. errno = %d\n", path, value, errno);
+		close(fd);
+		return DEF_RET_NG;
+	}
+	close(fd);
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   cgroupファイル読み込み
+ * @param   引数  : cg		cgroup
+ * @param   引数  : kind	enum cg_file
+ * @param   引数  : buf		読み込み先
+ * @param   引数  : size	読み込み先サイズ
+ * @return  戻り値: 読み込みサイズ(-1:異常)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcCgRead(procCg *cg, int kind, char *buf, int size)
+{
+	if(cg->file[kind].fd < 0)
+	{
+		return -1;
+	}
+	return com_procfs_read(&cg->file[kind], buf, size);
+}
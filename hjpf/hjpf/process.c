@@ -12,23 +12,64 @@
 /*============================================================================*/
 #define _GNU_SOURCE
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <glib.h>
 #include <sys/stat.h>
 #include <sys/wait.h>
 #include <sched.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <stddef.h>
 #include "process.h"
+#include "procacct.h"
+#include "proccg.h"
+#include "procready.h"
+#include "procsched.h"
+#include "procperf.h"
+#include "proclog.h"
 #include "com_timer.h"
 #include "com_shmem.h"
+#include "com_hb.h"
 #include "debug.h"
 #include "hjpf.h"
 
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open (434)				//pidfd_open(Linux 5.3以降，全アーキテクチャ共通)
+#endif
+
 /*============================================================================*/
 /* global */
 /*============================================================================*/
 static processInfo ProcessInfo[DEF_PROC_MAX];
 static procStat ProcStat;
+static procAcct ProcAcct[DEF_PROC_MAX];
+static procPerf ProcPerf[DEF_PROC_MAX];
+static procLog ProcLog[DEF_PROC_MAX];
+static processReStart ProcReStart[DEF_PROC_MAX];
+static procCg ProcCg[DEF_PROC_MAX];
+static procReady ProcReady[DEF_PROC_MAX];
+static procSchedTask ProcSchedTask[DEF_PROC_MAX];
+static procStandby ProcStandby[DEF_PROC_MAX];
+static pthread_mutex_t ProcMutex = PTHREAD_MUTEX_INITIALIZER;	/* ProcessInfo，ProcStatの排他 */
+static int ProcPidFd[DEF_PROC_MAX];		/* 子プロセスのpidfd(-1:無し) */
+static int ProcReapFd = -1;				/* 終了監視のepoll(-1:waitpidで確認) */
+static int ProcSigFd = -1;				/* SIGCHLDのsignalfd(pidfdを使えない場合) */
+static int ProcShmId = DEF_COM_SHMEM_FALSE;
+static struct timespec ProcBootTime;	/* プロセス管理開始時刻(起動・起動完了時刻の基準) */
+static int ProcBootDone = 0;			/* 全プロセス起動完了済み */
+static int ProcHbShmId = DEF_COM_SHMEM_FALSE;	/* ハートビートの共有メモリ(-1:監視しない) */
+static hbStat ProcHb;
 #if 0
 procStat ProcStat2;
 #endif
@@ -40,13 +81,46 @@ extern int gComm_StopFlg;
 /*============================================================================*/
 static void ProcCmd(char str[], char pathname[], char* argptr[]);
 static int ProcLaunch(int id);
+static pid_t ProcExec(int id, int standby, procPerf *perf);
+static void ProcAttach(int id, pid_t pid);
+static int ProcSpawn(void *arg);
 static int ProcReadFile(char filename[]);
+static void ProcReadCg(GKeyFile *file, const gchar *group, processInfo *info);
+static int ProcReadSpawn(GKeyFile *file, const gchar *group, processInfo *info);
+static int ProcReadSched(GKeyFile *file, const gchar *group, processInfo *info);
+static int ProcReadDepend(GKeyFile *file, gchar **group, gsize group_size, int base);
 static int ProcInit(void);
+static int ProcStart(void);
+static int ProcNowMs(void);
+static int ProcHbInit(void);
+static void ProcHbLaunch(int id, int pid);
+static int ProcHbCheck(void);
+static void ProcStandbyCheck(void);
+static int ProcStandbyActivate(int id, const struct timespec *death);
 static int ProcTerm(void);
+static int ProcReapInit(void);
+static void ProcReapAdd(int id);
+static void* ProcReap(void *arg);
+static void ProcDeath(int id, int status);
 
 /*============================================================================*/
 /* const */
 /*============================================================================*/
+static const struct {					/* process.confのrlimitの名前 */
+	const char *name;
+	int resource;
+} ProcRlimitName[] = {
+	{ "as", RLIMIT_AS },
+	{ "core", RLIMIT_CORE },
+	{ "cpu", RLIMIT_CPU },
+	{ "data", RLIMIT_DATA },
+	{ "fsize", RLIMIT_FSIZE },
+	{ "memlock", RLIMIT_MEMLOCK },
+	{ "nofile", RLIMIT_NOFILE },
+	{ "nproc", RLIMIT_NPROC },
+	{ "rtprio", RLIMIT_RTPRIO },
+	{ "stack", RLIMIT_STACK },
+};
 
 /*============================================================================*/
 /*
@@ -102,6 +176,14 @@ static void ProcCmd(char str[], char pathname[], char* argptr[])
  *                  
  * @return  戻り値: int
  * @date    2023/11/13 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] cgroupの設定を追加
+ *          2026/10/19 [0.0.3] 環境変数，rlimitの設定を追加
+ *          2026/10/19 [0.0.4] depends，readyの設定を追加
+ *          2026/10/19 [0.0.5] cpuをCPUリストに変更，policy，threadの設定を追加
+ *          2026/10/19 [0.0.6] deadlineの設定を追加
+ *          2026/10/19 [0.0.7] standbyの設定を追加
+ *          2026/10/19 [0.0.8] logの設定を追加
+ *          2026/10/19 [0.0.9] deadline_initの設定を追加
  */
 /*============================================================================*/
 static int ProcReadFile(char filename[])
@@ -112,6 +194,8 @@ static int ProcReadFile(char filename[])
 	gsize group_size;
 	int ret = 0;
 	gchar* cmd_value;
+	gchar* cpu_value;
+	int base = ProcNum;
 
 	file = g_key_file_new();
 
@@ -151,19 +235,20 @@ dprintf(ERROR, "path search failed. %s\n", pathname);
 				}
 			}
 			
-			// cpu取得
-			if(0 == (ProcessInfo[ProcNum].cpu = g_key_file_get_integer(file, group[i], "cpu", &err)) && (NULL != err))
+			// cpu取得(-1，CPUリスト，isolated，housekeeping)
+			if(NULL == (cpu_value = g_key_file_get_string(file, group[i], "cpu", &err)))
 			{
 dprintf(ERROR, "load cpu failed. %s\n", err->message);
 				ret = DEF_RET_NG;
 			}
 			else
 			{
-				if(ProcessInfo[ProcNum].cpu < DEF_CPU_MIN || ProcessInfo[ProcNum].cpu > DEF_CPU_MAX)
+				if(ProcSchedParseCpu(&ProcessInfo[ProcNum].sched, (char*)cpu_value) != DEF_RET_OK)
 				{
-dprintf(ERROR, "cpu value failed. %d\n", ProcessInfo[ProcNum].cpu);
+dprintf(ERROR, "cpu value failed. %s\n", cpu_value);
 					ret = DEF_RET_NG;
 				}
+				g_free(cpu_value);
 			}
 			
 			// priority取得
@@ -240,10 +325,83 @@ dprintf(ERROR, "restart cpu_rate failed. %d\n", ProcessInfo[ProcNum].mem_rate);
 					ret = DEF_RET_NG;
 				}
 			}
+
+
+			// cgroup設定取得(任意)
+			ProcReadCg(file, group[i], &ProcessInfo[ProcNum]);
+
+			// 環境変数，rlimit取得(任意)
+			if(ProcReadSpawn(file, group[i], &ProcessInfo[ProcNum]) != DEF_RET_OK)
+			{
+				ret = DEF_RET_NG;
+			}
+
+			// スケジューリングポリシー，スレッド毎の設定取得(任意)
+			if(ProcReadSched(file, group[i], &ProcessInfo[ProcNum]) != DEF_RET_OK)
+			{
+				ret = DEF_RET_NG;
+			}
+
+			// ハートビートの更新期限取得(任意)
+			ProcessInfo[ProcNum].deadline = DEF_DEADLINE_MIN;
+			if(g_key_file_has_key(file, group[i], "deadline", NULL))
+			{
+				ProcessInfo[ProcNum].deadline = g_key_file_get_integer(file, group[i], "deadline", NULL);
+				if(DEF_DEADLINE_MIN > ProcessInfo[ProcNum].deadline)
+				{
+dprintf(ERROR, "[%s] deadline value failed. %d\n", group[i], ProcessInfo[ProcNum].deadline);
+					ret = DEF_RET_NG;
+				}
+			}
+			ProcessInfo[ProcNum].deadline_init = DEF_DEADLINE_INIT;
+			if(g_key_file_has_key(file, group[i], "deadline_init", NULL))
+			{
+				ProcessInfo[ProcNum].deadline_init = g_key_file_get_integer(file, group[i], "deadline_init", NULL);
+				if(DEF_DEADLINE_MIN > ProcessInfo[ProcNum].deadline_init)
+				{
+dprintf(ERROR, "[%s] deadline_init value failed. %d\n", group[i], ProcessInfo[ProcNum].deadline_init);
+					ret = DEF_RET_NG;
+				}
+			}
+			if(ProcessInfo[ProcNum].deadline_init < ProcessInfo[ProcNum].deadline)
+			{
+				ProcessInfo[ProcNum].deadline_init = ProcessInfo[ProcNum].deadline;
+			}
+
+			// 待機インスタンス取得(任意，再起動する場合のみ)
+			ProcessInfo[ProcNum].standby = DEF_STANDBY_OFF;
+			if(g_key_file_has_key(file, group[i], "standby", NULL))
+			{
+				ProcessInfo[ProcNum].standby = g_key_file_get_integer(file, group[i], "standby", NULL);
+				if((DEF_STANDBY_OFF != ProcessInfo[ProcNum].standby && DEF_STANDBY_ON != ProcessInfo[ProcNum].standby) ||
+					(DEF_STANDBY_ON == ProcessInfo[ProcNum].standby && DEF_RESTART_ON != ProcessInfo[ProcNum].restart))
+				{
+dprintf(ERROR, "[%s] standby value failed. %d (restart = %d)\n", group[i], ProcessInfo[ProcNum].standby, ProcessInfo[ProcNum].restart);
+					ret = DEF_RET_NG;
+				}
+			}
+
+			// 標準出力・標準エラー出力の取り込み取得(任意，無い場合は取り込む)
+			ProcessInfo[ProcNum].log = DEF_LOG_ON;
+			if(g_key_file_has_key(file, group[i], "log", NULL))
+			{
+				ProcessInfo[ProcNum].log = g_key_file_get_integer(file, group[i], "log", NULL);
+				if(DEF_LOG_OFF != ProcessInfo[ProcNum].log && DEF_LOG_ON != ProcessInfo[ProcNum].log)
+				{
+dprintf(ERROR, "[%s] log value failed. %d\n", group[i], ProcessInfo[ProcNum].log);
+					ret = DEF_RET_NG;
+				}
+			}
 			
 			g_free(cmd_value);
 			ProcNum++;
 		}
+
+		// depends，ready取得(任意，全グループの読み込み後に名前を解決する)
+		if(ProcReadDepend(file, group, group_size, base) != DEF_RET_OK)
+		{
+			ret = DEF_RET_NG;
+		}
 		g_strfreev(group);
 	}
 	
@@ -258,292 +416,1523 @@ dprintf(ERROR, "restart cpu_rate failed. %d\n", ProcessInfo[ProcNum].mem_rate);
 
 /*============================================================================*/
 /*
- * @brief   プロセス起動処理
- * @note    プロセス生成、CPUと優先度の割り当て
- * @param   引数  : void
- *                  
- * @return  戻り値: int
- * @date    2023/11/13 [0.0.1] 新規作成
+ * @brief   cgroup設定読み込み処理
+ * @note    process.confのcpu_max，cpu_weight，memory_high，memory_max，io_maxを読み込む．
+ *          無い項目は設定しない(cgroupのデフォルトのまま)．
+ * @param   引数  : file	設定ファイル
+ * @param   引数  : group	グループ名(cgroup名とする)
+ * @param   引数  : info	プロセス情報
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
  */
 /*============================================================================*/
-static int ProcLaunch(int id)
+static void ProcReadCg(GKeyFile *file, const gchar *group, processInfo *info)
 {
-	int ret = DEF_RET_OK;
-	int ret_sched;
-	pid_t pid = fork();
-		
-	//エラー
-	if(pid < 0)
+	static const char *key[] = { "cpu_max", "memory_high", "memory_max", "io_max" };
+	char *value[] = { info->cg.cpu_max, info->cg.memory_high, info->cg.memory_max, info->cg.io_max };
+	gchar *str;
+
+	snprintf(info->name, sizeof(info->name), "%s", group);
+	memset(&info->cg, 0, sizeof(info->cg));
+	for(int i = 0; i < sizeof(key) / sizeof(key[0]); i++)
 	{
-dprintf(ERROR, "fork failed.\n");
-		ProcessInfo[id].pid = DEF_FAILED_FORK;
-		ret = DEF_RET_NG;
+		if(g_key_file_has_key(file, group, key[i], NULL) &&
+			(str = g_key_file_get_string(file, group, key[i], NULL)) != NULL)
+		{
+			snprintf(value[i], DEF_CG_VALUE_LEN, "%s", (char*)str);
+			g_free(str);
+		}
 	}
-	//子プロセス処理
-	else if(pid == 0)
+	if(g_key_file_has_key(file, group, "cpu_weight", NULL))
 	{
-		char pathname[DEF_PATH_MAX];
-		char* argptr[DEF_PROC_MAX];
-		char* envp[DEF_PROC_MAX];
-		ProcCmd(ProcessInfo[id].cmd, pathname, argptr);
-		envp[0] = NULL;
-
-#if 0			
-for (int cnt=0; argptr[cnt]; cnt++){
-dprintf(ERROR, "[%s] [%s] arg[%d]=[%s] \n", ProcessInfo[i].cmd, pathname, cnt, argptr[cnt]);
-}
-#endif
-		execve(pathname, argptr, envp);
+		info->cg.cpu_weight = g_key_file_get_integer(file, group, "cpu_weight", NULL);
 	}
-	//親プロセス処理
-	else
+}
+
+/*============================================================================*/
+/*
+ * @brief   起動設定読み込み処理
+ * @note    process.confのenv("KEY=VALUE;…")，rlimit("nofile=1024;core=0;…")を読み込む．
+ *          envが無い場合は従来どおり環境変数なしで起動する．
+ *          rlimitの値は"unlimited"で無制限とし，ソフト・ハード制限の両方に設定する．
+ * @param   引数  : file	設定ファイル
+ * @param   引数  : group	グループ名
+ * @param   引数  : info	プロセス情報
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcReadSpawn(GKeyFile *file, const gchar *group, processInfo *info)
+{
+	gchar **list;
+	gsize num = 0;
+	char *value;
+	int ret = DEF_RET_OK;
+	int kind;
+
+	//環境変数
+	info->env_num = 0;
+	if(g_key_file_has_key(file, group, "env", NULL) &&
+		(list = g_key_file_get_string_list(file, group, "env", &num, NULL)) != NULL)
 	{
-		ProcessInfo[id].pid = pid;
-		struct sched_param prio;
-		setuid(0);
-		
-		//cpu割り当て
-		if(ProcessInfo[id].cpu >= 0)
+		for(gsize i = 0; i < num; i++)
 		{
-			cpu_set_t cpu_set;
-			
-			CPU_ZERO(&cpu_set);
-			CPU_SET(ProcessInfo[id].cpu, &cpu_set);
-			if(sched_setaffinity(ProcessInfo[id].pid, sizeof(cpu_set_t), &cpu_set) == -1)
+			if(info->env_num >= DEF_ENV_MAX || strlen(list[i]) >= DEF_ENV_STR_MAX || strchr(list[i], '=') == NULL)
 			{
-dprintf(ERROR, "cpu set failed. pid = %d\n", ProcessInfo[id].pid);
-				ProcTerm();
+dprintf(ERROR, "[%s] env value failed. %s\n", group, list[i]);
 				ret = DEF_RET_NG;
+				continue;
 			}
+			strcpy(info->env[info->env_num++], list[i]);
 		}
-		
-		//優先度割り当て
-		prio.sched_priority = ProcessInfo[id].prio;
-		if(ProcessInfo[id].prio == 0)
-		{
-			ret_sched = sched_setscheduler(ProcessInfo[id].pid, SCHED_OTHER, &prio);
-		}
-		else
-		{
-			ret_sched = sched_setscheduler(ProcessInfo[id].pid, SCHED_FIFO, &prio);
-		}
-		
-		if(ret_sched < 0)
+		g_strfreev(list);
+	}
+
+	//rlimit
+	info->rlimit_num = 0;
+	if(g_key_file_has_key(file, group, "rlimit", NULL) &&
+		(list = g_key_file_get_string_list(file, group, "rlimit", &num, NULL)) != NULL)
+	{
+		for(gsize i = 0; i < num; i++)
 		{
-dprintf(ERROR, "priority set failed. pid = %d, errno = %d\n", ProcessInfo[id].pid, errno);
-			ProcTerm();
-			ret = DEF_RET_NG;
+			value = strchr(list[i], '=');
+			for(kind = 0; value != NULL && kind < sizeof(ProcRlimitName) / sizeof(ProcRlimitName[0]); kind++)
+			{
+				if(strncmp(list[i], ProcRlimitName[kind].name, value - list[i]) == 0 &&
+					ProcRlimitName[kind].name[value - list[i]] == '\0')
+				{
+					break;
+				}
+			}
+			if(value == NULL || kind >= sizeof(ProcRlimitName) / sizeof(ProcRlimitName[0]) ||
+				info->rlimit_num >= DEF_RLIMIT_MAX)
+			{
+dprintf(ERROR, "[%s] rlimit value failed. %s\n", group, list[i]);
+				ret = DEF_RET_NG;
+				continue;
+			}
+			info->rlimit[info->rlimit_num].resource = ProcRlimitName[kind].resource;
+			info->rlimit[info->rlimit_num].value =
+				(strcmp(value + 1, "unlimited") == 0) ? RLIM_INFINITY : strtoull(value + 1, NULL, 0);
+			info->rlimit_num++;
 		}
+		g_strfreev(list);
 	}
-	
+
 	return ret;
 }
 
-
 /*============================================================================*/
 /*
- * @brief   プロセス初期処理
- * @note    全プロセス起動
- * @param   引数  : void
- *                  
+ * @brief   スケジューリング設定読み込み処理
+ * @note    process.confのpolicy(other，batch，idle，fifo，rr，deadline)，
+ *          dl_runtime，dl_deadline，dl_period(SCHED_DEADLINEの実行時間，相対デッドライン，周期[us])，
+ *          thread("<スレッド名>:<policy>[:<prio または 実行時間/相対デッドライン/周期>[:<cpu>]];…")を読み込む．
+ *          policyが無い場合は従来どおりprioでSCHED_FIFOかSCHED_OTHERを選ぶ．
+ * @param   引数  : file	設定ファイル
+ * @param   引数  : group	グループ名
+ * @param   引数  : info	プロセス情報(cpu，prioは読み込み済み)
  * @return  戻り値: int
- * @date    2023/11/13 [0.0.1] 新規作成
+ * @date    2026/10/19 [0.0.1] 新規作成
  */
 /*============================================================================*/
-static int ProcInit(void)
+static int ProcReadSched(GKeyFile *file, const gchar *group, processInfo *info)
 {
-	int	ret = DEF_RET_OK;
+	static const char *key[] = { "dl_runtime", "dl_deadline", "dl_period" };
+	uint64_t dl[3] = { 0, 0, 0 };
+	gchar *policy = NULL;
+	gchar **list;
+	gsize num = 0;
+	int ret = DEF_RET_OK;
 
-	for(int i = 0; i < ProcNum; i++)
+	//プロセスのポリシー
+	if(g_key_file_has_key(file, group, "policy", NULL))
+	{
+		policy = g_key_file_get_string(file, group, "policy", NULL);
+	}
+	for(int i = 0; i < sizeof(key) / sizeof(key[0]); i++)
 	{
-		if(ProcLaunch(i) == DEF_RET_NG)
+		if(g_key_file_has_key(file, group, key[i], NULL))
 		{
-dprintf(ERROR, "ProcInit(%i) failed.\n", i);
-			ret = DEF_RET_NG;
+			dl[i] = (uint64_t)g_key_file_get_integer(file, group, key[i], NULL);
 		}
 	}
-	
+	if(ProcSchedParsePolicy(&info->sched, (char*)policy, info->prio, dl) != DEF_RET_OK)
+	{
+dprintf(ERROR, "[%s] policy value failed. %s prio = %d\n", group, (policy != NULL) ? (char*)policy : "-", info->prio);
+		ret = DEF_RET_NG;
+	}
+	g_free(policy);
+
+	//スレッド毎のポリシー
+	info->thread_num = 0;
+	if(g_key_file_has_key(file, group, "thread", NULL) &&
+		(list = g_key_file_get_string_list(file, group, "thread", &num, NULL)) != NULL)
+	{
+		for(gsize i = 0; i < num; i++)
+		{
+			if(info->thread_num >= DEF_PSCHED_THREAD_MAX ||
+				ProcSchedParseThread(&info->thread[info->thread_num], list[i]) != DEF_RET_OK)
+			{
+dprintf(ERROR, "[%s] thread value failed. %s\n", group, list[i]);
+				ret = DEF_RET_NG;
+				continue;
+			}
+			info->thread_num++;
+		}
+		g_strfreev(list);
+	}
+
 	return ret;
 }
 
 /*============================================================================*/
 /*
- * @brief   monit process
- * @note    monitor process and write life or death
- * @param   引数  : void
- *                  
+ * @brief   起動順序設定読み込み処理
+ * @note    process.confのdepends("グループ名;…")，ready(起動完了の条件)を読み込む．
+ *          dependsのプロセスが全て起動完了してから起動する．dependsが無いプロセスは
+ *          ProcInit()で一斉に起動する．存在しないグループ名，循環はエラーとする．
+ * @param   引数  : file		設定ファイル
+ * @param   引数  : group		グループ名
+ * @param   引数  : group_size	グループ数
+ * @param   引数  : base		先頭グループのprocess.confの順番
  * @return  戻り値: int
- * @date    2023/11/13 [0.0.1] 新規作成
+ * @date    2026/10/19 [0.0.1] 新規作成
  */
 /*============================================================================*/
-void* ProcMonit(void *arg)
+static int ProcReadDepend(GKeyFile *file, gchar **group, gsize group_size, int base)
 {
-	processReStart ProcessReStart[DEF_PROC_MAX];
-	int time = DEF_RET_OK;
-	int status;
-	int	ret;
-	int id;
-	char buf[1024];
-	FILE *fp;	
-	int pid, pr, ni, virt, res, shr;
-	float cpu, mem;
-	char user[32], S[5];
-	char cmd[256];
-	
-	com_timer_init(ENUM_TIMER_PROC, DEF_MONIT_CYCLE);
-	
-	// 設定ファイル読み込み
-	ret = ProcReadFile(arg);
-	if (ret == DEF_RET_NG) {
-dprintf(ERROR, "ProcReadFile(%s) failed.\n", arg);
-		pthread_exit(NULL);
-	}
-	
-	// プロセス初期化
-	ret = ProcInit();
-	if (ret == DEF_RET_NG) {
-dprintf(ERROR, "ProcInit() failed.\n");
-		pthread_exit(NULL);
-	}
-	
-	//共有メモリオープン
-	id = com_shmem_open(DEF_PROC_SHMMNG_NAME, SHM_KIND_PLATFORM);
-	if(id == DEF_COM_SHMEM_FALSE){
-                dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_PROC_SHMMNG_NAME);
-		pthread_exit(NULL);
-	}
-
-	ProcStat.num = ProcNum;
+	int done[DEF_PROC_MAX];
+	processInfo *info;
+	gchar **list;
+	gchar *str;
+	gsize num = 0;
+	gsize j;
+	int ret = DEF_RET_OK;
+	int update;
 
-	while(gComm_StopFlg == DEF_COMM_OFF)
+	for(gsize i = 0; i < group_size; i++)
 	{
-		for(int i = 0; i < ProcNum; i++)
-		{
-			if(time % ProcessInfo[i].period == 0 && ProcessInfo[i].period != DEF_PERIOD_MIN && ProcessInfo[i].pid != DEF_FAILED_FORK)
-			{
-				//共有メモリ書き込み
-				if(waitpid(ProcessInfo[i].pid, &status, WNOHANG) == 0)
-				{
-					// プロセスが活動中
-#if DEF_PROC_TEST
-					printf("[%d]alive. pid = %d. restart time = %d. cnt = %d.\n", i, ProcessInfo[i].pid, ProcessReStart[i].time, ProcessReStart[i].num);
-#endif				
-					//プロセスCPU、メモリ使用率計測
-					sprintf(cmd, "%s%d", "top -b -n 1 | grep --line-buffered ", ProcessInfo[i].pid);
-					fp = popen(cmd, "r");
-					if(fp == NULL)
-					{
-						dprintf(WARN, "top error. cmd = %s\n", cmd);
-					}
-					fgets(buf, 1024, fp);
-					sscanf(buf, "%d %s %d %d %d %d %d %s %f %f", &pid, user, &pr, &ni, &virt, &res, &shr, S, &cpu, &mem);
-					pclose(fp);
-
-					ProcStat.cpu[i] = cpu;
-					ProcStat.mem[i] = mem;
-
-					if(cpu > (float)ProcessInfo[i].cpu_rate)
-					{
-						ProcessInfo[i].cnt_cpu++;
-						dprintf(WARN, "%d cnt_cpu = %d\n", ProcessInfo[i].pid, ProcessInfo[i].cnt_cpu);
-					}
-					else
-					{
-						ProcessInfo[i].cnt_cpu = 0;
-					}
-
-					if(mem > (float)ProcessInfo[i].mem_rate)
-					{
-						ProcessInfo[i].cnt_mem++;
-						dprintf(WARN, "%d cnt_mem = %d\n", ProcessInfo[i].pid, ProcessInfo[i].cnt_mem);
-					}
-					else
-					{
-						ProcessInfo[i].cnt_mem = 0;
-					}
+		info = &ProcessInfo[base + i];
 
-					if(ProcessInfo[i].cnt_cpu > DEF_MAX_CPU_AND_MEM)
-					{
-						dprintf(ERROR, "Killed %d due to exceeding CPU limit.\n", ProcessInfo[i].pid);
-						kill(ProcessInfo[i].pid, SIGINT);
-					}
-					else if(ProcessInfo[i].cnt_mem > DEF_MAX_CPU_AND_MEM)
-					{
-						dprintf(ERROR, "Killed %d due to exceeding MEMORY limit.\n", ProcessInfo[i].pid);
-						kill(ProcessInfo[i].pid, SIGINT);
-					}
+		//起動完了の条件(無い場合は起動した時点)
+		str = NULL;
+		if(g_key_file_has_key(file, group[i], "ready", NULL))
+		{
+			str = g_key_file_get_string(file, group[i], "ready", NULL);
+		}
+		if(ProcReadyParse(&ProcReady[base + i], (char*)str) != DEF_RET_OK)
+		{
+dprintf(ERROR, "[%s] ready value failed. %s\n", group[i], (char*)str);
+			ret = DEF_RET_NG;
+		}
+		g_free(str);
 
-					//タイムアウト処理
-					if(ProcessReStart[i].time >= DEF_CANCEL_RESTART_TIME)
-					{
-						ProcessReStart[i].num = 0;
-						ProcStat.stat[i] = 0;
-					}
-					com_shmem_write(id, &ProcStat, sizeof(ProcStat));
-				}
-				else
+		//起動完了を待つプロセス
+		info->depend_num = 0;
+		if(g_key_file_has_key(file, group[i], "depends", NULL) &&
+			(list = g_key_file_get_string_list(file, group[i], "depends", &num, NULL)) != NULL)
+		{
+			for(gsize n = 0; n < num; n++)
+			{
+				for(j = 0; j < group_size && strcmp(group[j], list[n]) != 0; j++);
+				if(j >= group_size || j == i || info->depend_num >= DEF_DEPEND_MAX)
 				{
-					// プロセスが不活
-#if DEF_PROC_TEST
-					printf("[%d]dead. pid = %d. restart time = %d. cnt = %d.\n", i, ProcessInfo[i].pid, ProcessReStart[i].time, ProcessReStart[i].num);
-#endif
-					ProcessInfo[i].pid = -1;
-					
-					//　プロセス再起動
-					if(ProcessInfo[i].restart == DEF_RESTART_ON)
-					{
-						ProcessReStart[i].num++;						
-						if(ProcessReStart[i].num >= DEF_RESTART_FAIL)
-						{
-							ProcStat.stat[i] = 1;
-							dprintf(ERROR, "process restart 3.\n");
-						}
-
-						ProcLaunch(i);
-					}
-					else
-					{
-						ProcStat.stat[i] = 1;
-					}
-					com_shmem_write(id, &ProcStat, sizeof(ProcStat));
+dprintf(ERROR, "[%s] depends value failed. %s\n", group[i], list[n]);
+					ret = DEF_RET_NG;
+					continue;
 				}
+				info->depend[info->depend_num++] = base + (int)j;
 			}
-			
-			if(ProcessReStart[i].num > DEF_RESTART_NONE)
+			g_strfreev(list);
+		}
+	}
+
+	//循環の確認(起動可能になったものから順に除いていき，残ったものが循環)
+	memset(done, 0, sizeof(done));
+	do
+	{
+		update = 0;
+		for(int i = base; i < base + (int)group_size; i++)
+		{
+			int wait = 0;
+			for(int n = 0; n < ProcessInfo[i].depend_num; n++)
 			{
-				ProcessReStart[i].time += DEF_MONIT_CYCLE;
+				wait += !done[ProcessInfo[i].depend[n]];
+			}
+			if(!done[i] && wait == 0)
+			{
+				done[i] = 1;
+				update = 1;
 			}
 		}
-		
-		com_mtimer(ENUM_TIMER_PROC);
-		time+=DEF_MONIT_CYCLE;
+	} while(update);
+	for(int i = base; i < base + (int)group_size; i++)
+	{
+		if(!done[i])
+		{
+dprintf(ERROR, "[%s] depends is circular.\n", ProcessInfo[i].name);
+			ret = DEF_RET_NG;
+		}
 	}
 
-	com_shmem_close(id);
-	
-	// 全プロセス停止
-	ProcTerm();
-
-	pthread_exit(NULL);
+	return ret;
 }
 
 /*============================================================================*/
 /*
- * @brief   term process
- * @note    kill process
+ * @brief   プロセス起動処理
+ * @note    プロセス生成、CPUと優先度の割り当て
  * @param   引数  : void
  *                  
  * @return  戻り値: int
  * @date    2023/11/13 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] プロセスIDを共有メモリに公開
+ *          2026/10/19 [0.0.3] リソース使用量の取得開始を追加
+ *          2026/10/19 [0.0.4] 終了監視(pidfd)への登録を追加
+ *          2026/10/19 [0.0.5] 子プロセスをcgroupに登録
+ *          2026/10/19 [0.0.6] forkからclone(CLONE_VM|CLONE_VFORK)に変更，
+ *                             CPU・優先度・rlimit・環境変数をexecveの前に設定
+ *          2026/10/19 [0.0.7] ready=notifyの場合はNOTIFY_SOCKETを渡す，起動時刻を記録
+ *          2026/10/19 [0.0.8] スレッド毎の設定を起動毎にやり直す
+ *          2026/10/19 [0.0.9] deadline指定時はハートビートの欄番号を渡す
+ *          2026/10/19 [0.0.10] 生成をProcExec()，起動後の登録をProcAttach()に分離
+ *          2026/10/19 [0.0.11] perf_eventカウンタを生成直後にオープン
  */
 /*============================================================================*/
-static int ProcTerm(void)
+static int ProcLaunch(int id)
 {
-	int status;
-	int ret = DEF_RET_OK;
+	pid_t pid;
+
+	pid = ProcExec(id, 0, &ProcPerf[id]);
+	if(pid < 0)
+	{
+		ProcessInfo[id].pid = DEF_FAILED_FORK;
+		ProcStat.pid[id] = DEF_FAILED_FORK;
+		return DEF_RET_NG;
+	}
+
+	ProcAttach(id, pid);
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   プロセス生成処理
+ * @note    clone(CLONE_VM|CLONE_VFORK)でプロセスを生成し，execveまで待つ．
+ *          ProcMutexを獲得して呼び出すこと．
+ *          子プロセスが親のスタック・メモリ上でhjpfのシグナルハンドラを実行しないよう，
+ *          clone中は全シグナルをブロックする(posix_spawnと同じ)．
+ * @param   引数  : id		process.confの順番
+ * @param   引数  : standby	待機インスタンスとして起動(HJPF_STANDBYを渡す)
+ * @param   引数  : perf	perf_eventカウンタ(生成直後にオープンする)
+ * @return  戻り値: pid_t(-1:失敗)
+ * @date    2026/10/19 [0.0.1] ProcLaunch()から分離，待機インスタンスの起動を追加
+ *          2026/10/19 [0.0.2] clone中は全シグナルをブロック
+ *          2026/10/19 [0.0.3] perf_eventカウンタのオープンをProcAttach()から移動
+ *          2026/10/19 [0.0.4] hjpfが仮想時刻で動作中はHJPF_CLOCK=simを渡す
+ */
+/*============================================================================*/
+static pid_t ProcExec(int id, int standby, procPerf *perf)
+{
+	/* 子プロセスのスタック(ProcExecはProcMutexで排他されるため1つを共用する) */
+	static char stack[DEF_SPAWN_STACK] __attribute__((aligned(16)));
+	char pathname[DEF_PATH_MAX];
+	char* argptr[DEF_ARG_MAX];
+	char* envp[DEF_ENV_MAX + 5];
+	char hb_env[sizeof(DEF_HB_ENV) + 16];
+	procSpawn spawn;
+	sigset_t all;
+	sigset_t oldmask;
+	int env_num;
+	int status;
+	int err;
+	pid_t pid;
+
+	//引数・環境変数は子プロセスで加工しないよう事前に作成する
+	ProcCmd(ProcessInfo[id].cmd, pathname, argptr);
+	for(int i = 0; i < ProcessInfo[id].env_num; i++)
+	{
+		envp[i] = ProcessInfo[id].env[i];
+	}
+	env_num = ProcessInfo[id].env_num;
+	if(ProcReady[id].kind == READY_KIND_NOTIFY)
+	{
+		envp[env_num++] = (char *)DEF_READY_NOTIFY_ENV;
+	}
+	if(ProcessInfo[id].deadline > 0 && ProcHbShmId != DEF_COM_SHMEM_FALSE)
+	{
+		snprintf(hb_env, sizeof(hb_env), "%s=%d", DEF_HB_ENV, id);
+		envp[env_num++] = hb_env;
+	}
+	if(standby)
+	{
+		envp[env_num++] = (char *)DEF_HB_STANDBY_ENV "=1";
+	}
+	if(com_timer_get_clock() == COM_CLOCK_SIM)
+	{
+		envp[env_num++] = (char *)DEF_CLOCK_ENV_SIM;
+	}
+	envp[env_num] = NULL;
+
+	memset(&spawn, 0, sizeof(spawn));
+	spawn.id = id;
+	spawn.path = pathname;
+	spawn.argv = argptr;
+	spawn.envp = envp;
+
+	//子プロセスがexecveするまで親は停止する(ページテーブルをコピーしない)
+	//シグナルは子プロセスがハンドラを既定に戻してから解除する
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, &oldmask);
+	pid = clone(ProcSpawn, stack + sizeof(stack), CLONE_VM | CLONE_VFORK | SIGCHLD, &spawn);
+	err = errno;
+	pthread_sigmask(SIG_SETMASK, &oldmask, NULL);
+		
+	//エラー
+	if(pid < 0)
+	{
+dprintf(ERROR, "clone failed. errno = %d\n", err);
+		return -1;
+	}
+	if(spawn.err != 0)
+	{
+dprintf(ERROR, "%s failed. cmd = %s, errno = %d\n", spawn.step, ProcessInfo[id].cmd, spawn.err);
+		waitpid(pid, &status, 0);
+		return -1;
+	}
+
+	//perf_eventカウンタはスレッドを生成する前(execve直後)にオープンし，
+	//以降に生成されたスレッドをinheritで含める(待機インスタンスは切り替え時に引き継ぐ)
+	ProcPerfOpen(perf, pid);
+
+	return pid;
+}
+
+/*============================================================================*/
+/*
+ * @brief   起動後の登録処理
+ * @note    プロセスIDを公開し，起動完了判定・ハートビート・リソース使用量・終了監視を開始する．
+ *          起動した直後と待機インスタンスを切り替えた直後に呼び出す．
+ * @param   引数  : id	process.confの順番
+ * @param   引数  : pid	プロセスID
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] ProcLaunch()から分離
+ *          2026/10/19 [0.0.2] perf_eventカウンタの取得開始を追加
+ *          2026/10/19 [0.0.3] perf_eventカウンタのオープンをProcExec()に移動
+ *          2026/10/19 [0.0.4] 再起動の判定用に起動時刻を記録
+ */
+/*============================================================================*/
+static void ProcAttach(int id, pid_t pid)
+{
+	ProcessInfo[id].pid = pid;
+	ProcStat.pid[id] = pid;
+	ProcReStart[id].time = ProcNowMs();
+	ProcReStart[id].next = -1;
+
+	//スレッド毎の設定は新しいプロセスのスレッドに対して行う
+	ProcSchedTask[id].num = 0;
+
+	//起動完了判定の基準時刻
+	ProcReadyLaunch(&ProcReady[id]);
+	if(ProcStat.start_ms[id] < 0)
+	{
+		ProcStat.start_ms[id] = ProcNowMs();
+	}
+
+	//ハートビート監視の開始
+	ProcHbLaunch(id, pid);
+
+	//リソース使用量の取得開始
+	if(ProcAcctOpen(&ProcAcct[id], pid) != DEF_RET_OK)
+	{
+dprintf(WARN, "ProcAcctOpen failed. pid = %d\n", pid);
+	}
+
+	//終了監視
+	ProcReapAdd(id);
+}
+
+/*============================================================================*/
+/*
+ * @brief   子プロセス処理
+ * @note    clone(CLONE_VM|CLONE_VFORK)で親とメモリを共有するため，
+ *          非同期シグナル安全な処理のみ行い，失敗はspawn->err，stepで親に返す．
+ *          CPU・優先度をexecveの前に設定し，誤ったCPU・優先度で動作する期間を無くす．
+ * @param   引数  : arg	起動情報(procSpawn)
+ * @return  戻り値: int(戻らない)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] CPUリスト，SCHED_RR，SCHED_DEADLINE等に対応
+ *          2026/10/19 [0.0.3] 標準出力・標準エラー出力を取り込み用のパイプに接続
+ *          2026/10/19 [0.0.4] ハンドラを設定した全シグナルを既定に戻してからブロックを解除
+ */
+/*============================================================================*/
+static int ProcSpawn(void *arg)
+{
+	procSpawn *spawn = (procSpawn *)arg;
+	processInfo *info = &ProcessInfo[spawn->id];
+	struct sigaction sa;
+	struct sigaction old;
+	struct rlimit rlim;
+	sigset_t set;
+
+	//hjpfのシグナル設定を既定に戻し，ブロックしているSIGCHLD等を解除する
+	//(親が全シグナルをブロックしてcloneするため，解除までハンドラは実行されない)
+	//(無視設定とシグナルマスクはexecveで引き継がれる)
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = SIG_DFL;
+	for(int sig = 1; sig < NSIG; sig++)
+	{
+		if(sigaction(sig, NULL, &old) == 0 && old.sa_handler != SIG_DFL && old.sa_handler != SIG_IGN)
+		{
+			sigaction(sig, &sa, NULL);
+		}
+	}
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	sigaction(SIGPIPE, &sa, NULL);
+	sigemptyset(&set);
+	sigprocmask(SIG_SETMASK, &set, NULL);
+
+	//標準出力・標準エラー出力をパイプに接続(待機インスタンスも同じファイルに出力する)
+	if(ProcLog[spawn->id].wfd >= 0 &&
+		(dup2(ProcLog[spawn->id].wfd, STDOUT_FILENO) < 0 || dup2(ProcLog[spawn->id].wfd, STDERR_FILENO) < 0))
+	{
+		spawn->step = "dup2";
+		goto err;
+	}
+
+	//cgroupに入る(起動直後から制限する)
+	ProcCgAttach(&ProcCg[spawn->id]);
+
+	//cpu割り当て，スケジューリングポリシー
+	if(ProcSchedApply(0, &info->sched, &spawn->step) != DEF_RET_OK)
+	{
+		goto err;
+	}
+
+	//rlimit
+	for(int i = 0; i < info->rlimit_num; i++)
+	{
+		rlim.rlim_cur = info->rlimit[i].value;
+		rlim.rlim_max = info->rlimit[i].value;
+		if(setrlimit(info->rlimit[i].resource, &rlim) != 0)
+		{
+			spawn->step = "setrlimit";
+			goto err;
+		}
+	}
+
+	execve(spawn->path, spawn->argv, spawn->envp);
+	spawn->step = "execve";
+
+err:
+	spawn->err = errno;
+	_exit(127);
+}
+
+/*============================================================================*/
+/*
+ * @brief   プロセス初期処理
+ * @note    全プロセス起動
+ * @param   引数  : void
+ *                  
+ * @return  戻り値: int
+ * @date    2023/11/13 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] プロセス毎のcgroup作成を追加
+ *          2026/10/19 [0.0.3] dependsの無いプロセスのみ起動し，残りはProcStart()で起動
+ *          2026/10/19 [0.0.4] ハートビート監視の初期化を追加
+ *          2026/10/19 [0.0.5] 待機インスタンスの初期化を追加
+ *          2026/10/19 [0.0.6] 標準出力・標準エラー出力の取り込みを追加
+ *          2026/10/19 [0.0.7] 再起動の予定を初期化
+ */
+/*============================================================================*/
+static int ProcInit(void)
+{
+	int	ret = DEF_RET_OK;
+	int cg = (ProcCgInit() == DEF_RET_OK);
+	int notify = 0;
+
+	for(int i = 0; i < ProcNum; i++)
+	{
+		//cgroup作成(cgroup v2が無い場合は作成しない)
+		if(cg)
+		{
+			ProcCgCreate(&ProcCg[i], ProcessInfo[i].name, &ProcessInfo[i].cg);
+		}
+		else
+		{
+			ProcCg[i].procs_fd = -1;
+		}
+
+		ProcessInfo[i].pid = DEF_FAILED_FORK;
+		ProcessInfo[i].state = PROC_STATE_WAIT;
+		ProcStat.pid[i] = DEF_FAILED_FORK;
+		ProcStat.start_ms[i] = -1;
+		ProcStat.ready_ms[i] = -1;
+		ProcStat.standby[i] = -1;
+		ProcReStart[i].next = -1;
+		for(int e = 0; e < PERF_EVENT_MAX; e++)
+		{
+			ProcStat.perf[e][i] = DEF_PERF_NONE;
+		}
+		ProcStandby[i].pid = -1;
+		ProcStandby[i].state = STANDBY_STATE_NONE;
+		notify |= (ProcReady[i].kind == READY_KIND_NOTIFY);
+
+		//標準出力・標準エラー出力のパイプ作成(log=0は作成しない)
+		ProcLogOpen(&ProcLog[i], (ProcessInfo[i].log == DEF_LOG_ON) ? ProcessInfo[i].name : NULL);
+	}
+
+	//標準出力・標準エラー出力の取り込み(開始できない場合はhjpfの出力を引き継ぐ)
+	if(ProcLogStart(ProcLog, ProcNum) != DEF_RET_OK)
+	{
+		dprintf(WARN, "ProcLogStart() failed. log is ignored.\n");
+	}
+
+	//通知メッセージ受信(受信できない場合は起動した時点で起動完了とする)
+	if(notify && ProcReadyInit() != DEF_RET_OK)
+	{
+		dprintf(WARN, "ProcReadyInit() failed. ready=notify is treated as ready=start.\n");
+		for(int i = 0; i < ProcNum; i++)
+		{
+			if(ProcReady[i].kind == READY_KIND_NOTIFY)
+			{
+				ProcReady[i].kind = READY_KIND_START;
+			}
+		}
+	}
+
+	//ハートビート(起動前に共有メモリを用意し，欄番号を渡す)
+	if(ProcHbInit() != DEF_RET_OK)
+	{
+		dprintf(WARN, "ProcHbInit() failed. deadline is ignored.\n");
+	}
+
+	//dependsの無いプロセスを一斉に起動
+	if(ProcStart() != DEF_RET_OK)
+	{
+dprintf(ERROR, "ProcInit() launch failed.\n");
+		ret = DEF_RET_NG;
+	}
+	
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   起動順序制御
+ * @note    起動完了を判定し，dependsが全て起動完了したプロセスを起動する．
+ *          起動と同時に完了するプロセス(ready=start)を待つプロセスは同じ周期で続けて起動する．
+ *          起動完了は最初の1回のみ記録し，再起動しても待ち状態には戻さない．
+ *          ProcInit()と監視周期毎に呼び出す(ProcMonit開始後はProcMutexを獲得して呼び出すこと)．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcStart(void)
+{
+	int pid[DEF_PROC_MAX];
+	struct timespec ts;
+	int ret = DEF_RET_OK;
+	int change = 0;
+	int update;
+	int ready = 0;
+	int wait;
+	int num;
+
+	//通知メッセージ
+	num = ProcReadyNotify(pid, DEF_PROC_MAX);
+	for(int n = 0; n < num; n++)
+	{
+		for(int i = 0; i < ProcNum; i++)
+		{
+			if(ProcessInfo[i].pid == pid[n])
+			{
+				ProcReady[i].notified = 1;
+			}
+		}
+	}
+
+	do
+	{
+		update = 0;
+		for(int i = 0; i < ProcNum; i++)
+		{
+			//起動
+			if(ProcessInfo[i].state == PROC_STATE_WAIT)
+			{
+				wait = 0;
+				for(int n = 0; n < ProcessInfo[i].depend_num; n++)
+				{
+					wait += (ProcessInfo[ProcessInfo[i].depend[n]].state != PROC_STATE_READY);
+				}
+				if(wait > 0)
+				{
+					continue;
+				}
+				ProcessInfo[i].state = PROC_STATE_START;
+				if(ProcLaunch(i) != DEF_RET_OK)
+				{
+dprintf(ERROR, "ProcLaunch(%d) failed.\n", i);
+					ret = DEF_RET_NG;
+				}
+				update++;
+			}
+
+			//起動完了
+			if(ProcessInfo[i].state == PROC_STATE_START && ProcessInfo[i].pid > 0)
+			{
+				if(ProcReadyPoll(&ProcReady[i]))
+				{
+					ProcessInfo[i].state = PROC_STATE_READY;
+					ProcStat.ready_ms[i] = ProcNowMs();
+					dprintf(INFO, "[%s] ready. start = %d ms, ready = %d ms\n", ProcessInfo[i].name,
+						ProcStat.start_ms[i], ProcStat.ready_ms[i]);
+					update++;
+				}
+				else if(!ProcessInfo[i].ready_warn && ProcNowMs() - ProcStat.start_ms[i] > DEF_READY_WARN_TIME)
+				{
+					dprintf(WARN, "[%s] not ready for %d ms.\n", ProcessInfo[i].name, DEF_READY_WARN_TIME);
+					ProcessInfo[i].ready_warn = 1;
+				}
+			}
+		}
+		change += update;
+	} while(update > 0);
+
+	//コールドブート時間(プロセス管理開始から，OS起動から)
+	for(int i = 0; i < ProcNum; i++)
+	{
+		ready += (ProcessInfo[i].state == PROC_STATE_READY);
+	}
+	if(!ProcBootDone && ready == ProcNum)
+	{
+		clock_gettime(CLOCK_BOOTTIME, &ts);
+		dprintf(INFO, "all processes ready in %d ms (%ld ms since boot).\n", ProcNowMs(),
+			(long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+		ProcBootDone = 1;
+	}
+
+	if(change > 0 && ProcShmId != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_write(ProcShmId, &ProcStat, sizeof(ProcStat));
+	}
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   経過時間取得
+ * @param   引数  : void
+ * @return  戻り値: int(プロセス管理開始からの経過時間[ms])
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcNowMs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (int)((ts.tv_sec - ProcBootTime.tv_sec) * 1000 + (ts.tv_nsec - ProcBootTime.tv_nsec) / 1000000);
+}
+
+/*============================================================================*/
+/*
+ * @brief   ハートビート監視初期化
+ * @note    deadlineを指定したプロセスがある場合のみ共有メモリ(/heartbeat)をオープンする．
+ *          管理プロセスも書き込むため種別はSHM_KIND_USERでオープンする．
+ *          オープンできない場合はハートビートを監視しない(生存監視のみ)．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcHbInit(void)
+{
+	int num = 0;
+
+	for(int i = 0; i < ProcNum; i++)
+	{
+		num += (ProcessInfo[i].deadline > 0);
+	}
+	if(num == 0)
+	{
+		return DEF_RET_OK;
+	}
+
+	ProcHbShmId = com_shmem_open(DEF_HB_SHMEM_NAME, SHM_KIND_USER);
+	if(ProcHbShmId == DEF_COM_SHMEM_FALSE)
+	{
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_HB_SHMEM_NAME);
+		return DEF_RET_NG;
+	}
+
+	memset(&ProcHb, 0, sizeof(ProcHb));
+	ProcHb.num = ProcNum;
+	for(int i = 0; i < ProcNum; i++)
+	{
+		ProcHb.entry[i].pid = DEF_FAILED_FORK;
+		ProcHb.entry[i].deadline = ProcessInfo[i].deadline;
+	}
+	com_shmem_write(ProcHbShmId, &ProcHb, sizeof(ProcHb));
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ハートビート監視開始
+ * @note    プロセスID，更新期限のみ書き込み，更新回数・時刻は管理プロセスに任せる
+ *          (起動直後の更新を消さないよう0クリアしない)．
+ *          起動時刻(ProcReady[id].launch)より前の更新は前回起動分として無視する．
+ * @param   引数  : id	process.confの順番
+ * @param   引数  : pid	プロセスID
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcHbLaunch(int id, int pid)
+{
+	int32_t value[2] = { pid, ProcessInfo[id].deadline };
+
+	ProcessInfo[id].hb_kill = 0;
+	if(ProcessInfo[id].deadline > 0 && ProcHbShmId != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_write_part(ProcHbShmId, (int32_t)offsetof(hbStat, entry[id].pid), value, sizeof(value));
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   ハートビート途絶判定
+ * @note    監視周期毎に全プロセスの最終更新時刻を確認し，deadlineを超えて更新されない
+ *          プロセスをハングとみなしてSIGKILLで停止する．停止後の再起動は終了監視から
+ *          ProcDeath()で行い，restart=の設定に従う．
+ *          起動後に1回も更新していないプロセスは起動時刻からdeadline_init以内に
+ *          更新しなければ停止する(初期化中にハングしたプロセスも検出する)．
+ *          ProcMutexを獲得して呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: int(停止したプロセス数)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 起動後に1回も更新しないプロセスも判定
+ */
+/*============================================================================*/
+static int ProcHbCheck(void)
+{
+	struct timespec ts;
+	uint64_t now;
+	uint64_t stamp;
+	int deadline;
+	int num = 0;
+
+	if(ProcHbShmId == DEF_COM_SHMEM_FALSE ||
+		com_shmem_read(ProcHbShmId, &ProcHb, sizeof(ProcHb)) != DEF_COM_SHMEM_TRUE)
+	{
+		return 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+	for(int i = 0; i < ProcNum; i++)
+	{
+		if(ProcessInfo[i].deadline <= 0 || ProcessInfo[i].pid <= 0 || ProcessInfo[i].hb_kill)
+		{
+			continue;
+		}
+		stamp = ProcHb.entry[i].stamp;
+		deadline = ProcessInfo[i].deadline;
+		if(stamp == 0 || stamp < ProcReady[i].launch)
+		{
+			//前回起動分の更新は無視し，起動時刻から初回の更新を待つ
+			stamp = ProcReady[i].launch;
+			deadline = ProcessInfo[i].deadline_init;
+		}
+		if(now > stamp + (uint64_t)deadline * 1000000ULL)
+		{
+			dprintf(ERROR, "[%s] pid = %d heartbeat missed for %llu ms (deadline = %d ms, count = %llu). killed.\n",
+				ProcessInfo[i].name, ProcessInfo[i].pid, (unsigned long long)((now - stamp) / 1000000ULL),
+				deadline, (unsigned long long)ProcHb.entry[i].count);
+			kill(ProcessInfo[i].pid, SIGKILL);
+			ProcessInfo[i].hb_kill = 1;
+			ProcStat.hang[i]++;
+			num++;
+		}
+	}
+
+	if(num > 0 && ProcShmId != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_write(ProcShmId, &ProcStat, sizeof(ProcStat));
+	}
+	return num;
+}
+
+/*============================================================================*/
+/*
+ * @brief   待機インスタンスの確認
+ * @note    standby=1のプロセスが起動完了したら2つ目のインスタンスを起動する．
+ *          待機インスタンスは初期化後にcom_hb_standby()でSIGSTOPにより停止し，
+ *          停止をwaitpid(WUNTRACED)で確認した時点で切り替え可能とする．
+ *          DEF_STANDBY_WAIT_TIME以内に停止しない場合(com_hb_standby()を呼び出さない
+ *          アプリケーション)は二重に動作させないよう終了させ，以降は起動しない．
+ *          ProcMutexを獲得して呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] perf_eventカウンタを起動時にオープン
+ */
+/*============================================================================*/
+static void ProcStandbyCheck(void)
+{
+	procStandby *sb;
+	int change = 0;
+	int status;
+	pid_t pid;
+
+	for(int i = 0; i < ProcNum; i++)
+	{
+		sb = &ProcStandby[i];
+		if(ProcessInfo[i].standby != DEF_STANDBY_ON)
+		{
+			continue;
+		}
+
+		//起動(稼働中のプロセスの初期化と競合しないよう起動完了後)
+		if(sb->pid <= 0)
+		{
+			if(sb->fail < DEF_RESTART_FAIL && ProcessInfo[i].state == PROC_STATE_READY && ProcessInfo[i].pid > 0)
+			{
+				pid = ProcExec(i, 1, &sb->perf);
+				if(pid < 0)
+				{
+					sb->fail++;
+					continue;
+				}
+				sb->pid = pid;
+				sb->state = STANDBY_STATE_INIT;
+				sb->start_ms = ProcNowMs();
+			}
+			continue;
+		}
+
+		//停止・終了の確認(切り替え可能になった後も終了を確認する)
+		pid = waitpid(sb->pid, &status, WNOHANG | WUNTRACED);
+		if(pid == sb->pid && WIFSTOPPED(status))
+		{
+			if(sb->state == STANDBY_STATE_INIT)
+			{
+				dprintf(INFO, "[%s] standby pid = %d ready in %d ms.\n", ProcessInfo[i].name, sb->pid,
+					ProcNowMs() - sb->start_ms);
+			}
+			sb->state = STANDBY_STATE_READY;
+			sb->fail = 0;
+			ProcStat.standby[i] = sb->pid;
+			change++;
+		}
+		else if(pid == sb->pid)
+		{
+			dprintf(WARN, "[%s] standby pid = %d exited.\n", ProcessInfo[i].name, sb->pid);
+			ProcPerfClose(&sb->perf);
+			sb->pid = -1;
+			sb->state = STANDBY_STATE_NONE;
+			sb->fail++;
+			ProcStat.standby[i] = -1;
+			change++;
+		}
+		else if(sb->state == STANDBY_STATE_INIT && ProcNowMs() - sb->start_ms > DEF_STANDBY_WAIT_TIME)
+		{
+			dprintf(ERROR, "[%s] standby pid = %d did not stop in %d ms (com_hb_standby() is not called). standby is disabled.\n",
+				ProcessInfo[i].name, sb->pid, DEF_STANDBY_WAIT_TIME);
+			kill(sb->pid, SIGKILL);
+			waitpid(sb->pid, &status, 0);
+			ProcPerfClose(&sb->perf);
+			sb->pid = -1;
+			sb->state = STANDBY_STATE_NONE;
+			sb->fail = DEF_RESTART_FAIL;
+		}
+	}
+
+	if(change > 0 && ProcShmId != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_write(ProcShmId, &ProcStat, sizeof(ProcStat));
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   待機インスタンスへの切り替え
+ * @note    停止済みの待機インスタンスを稼働中のプロセスとして登録し，SIGCONTで再開させる．
+ *          ハートビートの欄のプロセスIDを先に書き換え，com_hb_standby()から戻れるようにする．
+ *          新しい待機インスタンスは次の監視周期でProcStandbyCheck()が起動する．
+ *          ProcMutexを獲得して呼び出すこと．
+ * @param   引数  : id		process.confの順番
+ * @param   引数  : death	終了を検知した時刻(CLOCK_MONOTONIC)
+ * @return  戻り値: int(DEF_RET_NG:切り替え可能な待機インスタンスなし)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 起動時にオープンしたperf_eventカウンタを引き継ぐ
+ */
+/*============================================================================*/
+static int ProcStandbyActivate(int id, const struct timespec *death)
+{
+	procStandby *sb = &ProcStandby[id];
+	struct timespec ts;
+	pid_t pid = sb->pid;
+
+	if(sb->state != STANDBY_STATE_READY || pid <= 0)
+	{
+		return DEF_RET_NG;
+	}
+	sb->pid = -1;
+	sb->state = STANDBY_STATE_NONE;
+	ProcStat.standby[id] = -1;
+
+	//起動時(シングルスレッドの間)にオープンしたカウンタを使う
+	ProcPerfClose(&ProcPerf[id]);
+	ProcPerf[id] = sb->perf;
+	sb->perf.pid = 0;
+
+	ProcAttach(id, pid);
+	if(kill(pid, SIGCONT) != 0)
+	{
+dprintf(ERROR, "kill(SIGCONT) failed. pid = %d. errno = %d\n", pid, errno);
+	}
+	ProcStat.failover[id]++;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	dprintf(INFO, "[%s] standby pid = %d activated in %ld us.\n", ProcessInfo[id].name, pid,
+		(long)((ts.tv_sec - death->tv_sec) * 1000000 + (ts.tv_nsec - death->tv_nsec) / 1000));
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   monit process
+ * @note    monitor process and write life or death
+ * @param   引数  : void
+ *                  
+ * @return  戻り値: int
+ * @date    2023/11/13 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] プロセスIDを共有メモリに公開
+ *          2026/10/19 [0.0.3] top/grepの代わりに/procから直接CPU・メモリ使用率を取得
+ *          2026/10/19 [0.0.4] 終了の検知を終了監視スレッド(pidfd/signalfd)に変更
+ *          2026/10/19 [0.0.5] cgroupの使用量取得，cgroupで制限中は上限超過で停止しない
+ *          2026/10/19 [0.0.6] dependsで待っているプロセスを監視周期毎に起動
+ *          2026/10/19 [0.0.7] スレッド毎のポリシー設定を追加
+ *          2026/10/19 [0.0.8] ハートビート途絶の判定を監視周期毎に追加
+ *          2026/10/19 [0.0.9] 待機インスタンスの起動・停止の確認を追加
+ *          2026/10/19 [0.0.10] perf_eventカウンタの取得を追加
+ *          2026/10/19 [0.0.11] 標準出力・標準エラー出力の破棄量の公開，取り込みの終了を追加
+ *          2026/10/19 [0.0.12] 終了監視スレッドのスレッド名を設定
+ *          2026/10/19 [0.0.13] 再起動の待ち時間が経過したプロセスを起動
+ */
+/*============================================================================*/
+void* ProcMonit(void *arg)
+{
+	pthread_t reap_thread;
+	int time = DEF_RET_OK;
+	int status = 0;
+	int	ret;
+	int id;
+	procAcctValue acct;
+	procCgValue cg;
+	procPerfValue perf;
+	float cpu, mem;
+	
+	com_timer_init(ENUM_TIMER_PROC, DEF_MONIT_CYCLE);
+	clock_gettime(CLOCK_MONOTONIC, &ProcBootTime);
+	ProcSchedInit();
+	if(ProcPerfInit() != DEF_RET_OK)
+	{
+		dprintf(WARN, "ProcPerfInit() failed. perf_event is not available.\n");
+	}
+	
+	// 設定ファイル読み込み
+	ret = ProcReadFile(arg);
+	if (ret == DEF_RET_NG) {
+dprintf(ERROR, "ProcReadFile(%s) failed.\n", arg);
+		pthread_exit(NULL);
+	}
+	
+	// 終了監視初期化(起動前に行い，起動直後の終了も検知する)
+	if(ProcReapInit() != DEF_RET_OK)
+	{
+		dprintf(WARN, "ProcReapInit() failed. use waitpid polling.\n");
+	}
+
+	// プロセス初期化
+	ret = ProcInit();
+	if (ret == DEF_RET_NG) {
+dprintf(ERROR, "ProcInit() failed.\n");
+		pthread_exit(NULL);
+	}
+	
+	//共有メモリオープン
+	id = com_shmem_open(DEF_PROC_SHMMNG_NAME, SHM_KIND_PLATFORM);
+	if(id == DEF_COM_SHMEM_FALSE){
+                dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_PROC_SHMMNG_NAME);
+		pthread_exit(NULL);
+	}
+	ProcShmId = id;
+
+	ProcStat.num = ProcNum;
+	com_shmem_write(id, &ProcStat, sizeof(ProcStat));
+
+	// 終了監視スレッド生成
+	if(ProcReapFd >= 0 && pthread_create(&reap_thread, NULL, ProcReap, NULL) != 0)
+	{
+		dprintf(WARN, "pthread_create(ProcReap) error=%d. use waitpid polling.\n", errno);
+		close(ProcReapFd);
+		ProcReapFd = -1;
+	}
+	else if(ProcReapFd >= 0)
+	{
+		pthread_setname_np(reap_thread, "hjpf_proc_reap");
+	}
+
+	while(gComm_StopFlg == DEF_COMM_OFF)
+	{
+		// 起動完了したプロセスを待つプロセスを起動
+		pthread_mutex_lock(&ProcMutex);
+		ProcStart();
+
+		// ハートビートが途絶したプロセスを停止(periodに関わらずdeadline以内に判定する)
+		ProcHbCheck();
+
+		// 起動完了したプロセスの待機インスタンスを起動し，停止(切り替え可能)を確認
+		ProcStandbyCheck();
+		pthread_mutex_unlock(&ProcMutex);
+
+		for(int i = 0; i < ProcNum; i++)
+		{
+			pthread_mutex_lock(&ProcMutex);
+			if(time % ProcessInfo[i].period == 0 && ProcessInfo[i].period != DEF_PERIOD_MIN && ProcessInfo[i].pid != DEF_FAILED_FORK)
+			{
+				//終了は終了監視スレッドで検知する(使用できない場合のみwaitpidで確認)
+				if(ProcReapFd >= 0 || waitpid(ProcessInfo[i].pid, &status, WNOHANG) == 0)
+				{
+					// プロセスが活動中
+#if DEF_PROC_TEST
+					printf("[%d]alive. pid = %d. restart time = %d. cnt = %d.\n", i, ProcessInfo[i].pid, ProcReStart[i].time, ProcReStart[i].num);
+#endif				
+					//プロセスCPU、メモリ使用率計測
+					ProcAcctUpdate(&ProcAcct[i], &acct);
+					cpu = acct.cpu;
+					mem = acct.mem;
+
+
+					//cgroup使用時はcgroupの値(子プロセスを含む)
+					if(ProcCgUpdate(&ProcCg[i], &cg) == DEF_RET_OK)
+					{
+						cpu = cg.cpu;
+						mem = cg.mem;
+						ProcStat.throttle[i] = cg.throttle;
+						ProcStat.mem_events[i] = cg.mem_events;
+					}
+
+					ProcStat.cpu[i] = cpu;
+					ProcStat.mem[i] = mem;
+					ProcStat.rss[i] = acct.rss;
+					ProcStat.pss[i] = acct.pss;
+					ProcStat.io_read[i] = acct.rd_kbps;
+					ProcStat.io_write[i] = acct.wr_kbps;
+
+					//perf_eventカウンタ(コンテキストスイッチ，CPU移動，ページフォルト等)
+					ProcPerfUpdate(&ProcPerf[i], &perf);
+					for(int e = 0; e < PERF_EVENT_MAX; e++)
+					{
+						ProcStat.perf[e][i] = perf.rate[e];
+					}
+					ProcStat.log_drop[i] = (int)atomic_load(&ProcLog[i].drop);
+
+					//新しいスレッドにスレッド毎のポリシーを設定
+					ProcSchedThreads(ProcessInfo[i].pid, ProcessInfo[i].thread, ProcessInfo[i].thread_num, &ProcSchedTask[i]);
+
+					if(cpu > (float)ProcessInfo[i].cpu_rate)
+					{
+						ProcessInfo[i].cnt_cpu++;
+						dprintf(WARN, "%d cnt_cpu = %d\n", ProcessInfo[i].pid, ProcessInfo[i].cnt_cpu);
+					}
+					else
+					{
+						ProcessInfo[i].cnt_cpu = 0;
+					}
+
+					if(mem > (float)ProcessInfo[i].mem_rate)
+					{
+						ProcessInfo[i].cnt_mem++;
+						dprintf(WARN, "%d cnt_mem = %d\n", ProcessInfo[i].pid, ProcessInfo[i].cnt_mem);
+					}
+					else
+					{
+						ProcessInfo[i].cnt_mem = 0;
+					}
+
+					//cgroupで制限している場合はカーネルが抑制するため停止しない
+					if(ProcessInfo[i].cnt_cpu > DEF_MAX_CPU_AND_MEM && !ProcCg[i].cpu_limit)
+					{
+						dprintf(ERROR, "Killed %d due to exceeding CPU limit.\n", ProcessInfo[i].pid);
+						kill(ProcessInfo[i].pid, SIGINT);
+					}
+					else if(ProcessInfo[i].cnt_mem > DEF_MAX_CPU_AND_MEM && !ProcCg[i].mem_limit)
+					{
+						dprintf(ERROR, "Killed %d due to exceeding MEMORY limit.\n", ProcessInfo[i].pid);
+						kill(ProcessInfo[i].pid, SIGINT);
+					}
+
+					//タイムアウト処理(起動から一定時間動作すれば再起動回数・待ち時間を戻す)
+					if(ProcReStart[i].num > DEF_RESTART_NONE && ProcNowMs() - ProcReStart[i].time >= DEF_CANCEL_RESTART_TIME)
+					{
+						ProcReStart[i].num = 0;
+						ProcReStart[i].backoff = 0;
+						ProcStat.stat[i] = 0;
+					}
+					com_shmem_write(id, &ProcStat, sizeof(ProcStat));
+				}
+				else
+				{
+					// プロセスが不活
+					ProcDeath(i, status);
+				}
+			}
+			
+			//再起動(待ち時間の経過後)
+			if(ProcReStart[i].next >= 0 && ProcessInfo[i].pid <= 0 && ProcNowMs() - ProcReStart[i].next >= 0)
+			{
+				ProcReStart[i].next = -1;
+				if(ProcLaunch(i) != DEF_RET_OK)
+				{
+					dprintf(ERROR, "ProcLaunch(%d) failed. retry after %d ms\n", i, DEF_RESTART_BACKOFF_MAX);
+					ProcReStart[i].next = ProcNowMs() + DEF_RESTART_BACKOFF_MAX;
+				}
+				com_shmem_write(id, &ProcStat, sizeof(ProcStat));
+			}
+			pthread_mutex_unlock(&ProcMutex);
+		}
+		
+		com_mtimer(ENUM_TIMER_PROC);
+		time+=DEF_MONIT_CYCLE;
+	}
+
+	// 終了監視スレッド終了待ち(停止中のプロセスを再起動しないよう先に止める)
+	if(ProcReapFd >= 0)
+	{
+		pthread_join(reap_thread, NULL);
+		close(ProcReapFd);
+		ProcReapFd = -1;
+	}
+
+	com_shmem_close(id);
+	
+	// 全プロセス停止
+	ProcTerm();
+
+	// 標準出力・標準エラー出力の残りを書き込む
+	ProcLogTerm(ProcLog, ProcNum);
+
+	// cgroup削除
+	for(int i = 0; i < ProcNum; i++)
+	{
+		ProcCgDestroy(&ProcCg[i]);
+	}
+	ProcReadyTerm(ProcReady, ProcNum);
+	if(ProcHbShmId != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(ProcHbShmId);
+		ProcHbShmId = DEF_COM_SHMEM_FALSE;
+	}
+
+	pthread_exit(NULL);
+}
+
+/*============================================================================*/
+/*
+ * @brief   終了監視初期化
+ * @note    子プロセス毎のpidfd(Linux 5.3以降)をepollで待つ．pidfdが使えない場合は
+ *          SIGCHLDのsignalfdを待つ(SIGCHLDはmain()で全スレッドでブロック済み)．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcReapInit(void)
+{
+	struct epoll_event ev;
+	sigset_t set;
+	int fd;
+
+	for(int i = 0; i < DEF_PROC_MAX; i++)
+	{
+		ProcPidFd[i] = -1;
+	}
+
+	ProcReapFd = epoll_create1(EPOLL_CLOEXEC);
+	if(ProcReapFd < 0)
+	{
+		dprintf(ERROR, "epoll_create1 failed. errno = %d\n", errno);
+		return DEF_RET_NG;
+	}
+
+	//pidfd
+	fd = (int)syscall(SYS_pidfd_open, getpid(), 0);
+	if(fd >= 0)
+	{
+		close(fd);
+		ProcSigFd = -1;
+		dprintf(INFO, "child exit is watched by pidfd.\n");
+		return DEF_RET_OK;
+	}
+
+	//signalfd
+	sigemptyset(&set);
+	sigaddset(&set, SIGCHLD);
+	ProcSigFd = signalfd(-1, &set, SFD_NONBLOCK | SFD_CLOEXEC);
+	if(ProcSigFd >= 0)
+	{
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.u32 = DEF_REAP_SIGNALFD;
+		if(epoll_ctl(ProcReapFd, EPOLL_CTL_ADD, ProcSigFd, &ev) == 0)
+		{
+			dprintf(INFO, "child exit is watched by signalfd(SIGCHLD).\n");
+			return DEF_RET_OK;
+		}
+		close(ProcSigFd);
+		ProcSigFd = -1;
+	}
+
+	dprintf(ERROR, "pidfd_open and signalfd failed. errno = %d\n", errno);
+	close(ProcReapFd);
+	ProcReapFd = -1;
+	return DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   終了監視対象の追加
+ * @note    pidfd使用時のみ．起動直後に終了していてもpidfdは読み込み可能になる．
+ * @param   引数  : id	process.confの順番
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcReapAdd(int id)
+{
+	struct epoll_event ev;
+
+	if(ProcReapFd < 0 || ProcSigFd >= 0)
+	{
+		return;
+	}
+	ProcPidFd[id] = (int)syscall(SYS_pidfd_open, ProcessInfo[id].pid, 0);
+	if(ProcPidFd[id] < 0)
+	{
+		dprintf(ERROR, "pidfd_open failed. pid = %d, errno = %d\n", ProcessInfo[id].pid, errno);
+		return;
+	}
+	fcntl(ProcPidFd[id], F_SETFD, FD_CLOEXEC);
+
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.u32 = (uint32_t)id;
+	if(epoll_ctl(ProcReapFd, EPOLL_CTL_ADD, ProcPidFd[id], &ev) != 0)
+	{
+		dprintf(ERROR, "epoll_ctl failed. pid = %d, errno = %d\n", ProcessInfo[id].pid, errno);
+		close(ProcPidFd[id]);
+		ProcPidFd[id] = -1;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   終了監視スレッド
+ * @note    子プロセスの終了を待ち，終了したら直ちに終了処理(再起動)を行う．
+ * @param   引数  : void*
+ * @return  戻り値: void*
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void* ProcReap(void *arg)
+{
+	struct epoll_event ev[DEF_REAP_EVENT_MAX];
+	struct signalfd_siginfo info;
+	int status;
+	int num;
+	int id;
+
+	while(gComm_StopFlg == DEF_COMM_OFF)
+	{
+		num = epoll_wait(ProcReapFd, ev, DEF_REAP_EVENT_MAX, DEF_REAP_WAIT);
+		if(num < 0)
+		{
+			if(errno != EINTR)
+			{
+				dprintf(ERROR, "epoll_wait failed. errno = %d\n", errno);
+				break;
+			}
+			continue;
+		}
+
+		pthread_mutex_lock(&ProcMutex);
+		for(int n = 0; n < num; n++)
+		{
+			id = (int)ev[n].data.u32;
+			if(id == DEF_REAP_SIGNALFD)
+			{
+				//SIGCHLDはまとめて通知されるため全プロセスを確認する
+				while(read(ProcSigFd, &info, sizeof(info)) == sizeof(info));
+				for(int i = 0; i < ProcNum; i++)
+				{
+					if(ProcessInfo[i].pid > 0 && waitpid(ProcessInfo[i].pid, &status, WNOHANG) == ProcessInfo[i].pid)
+					{
+						ProcDeath(i, status);
+					}
+				}
+			}
+			else if(id < ProcNum && ProcessInfo[id].pid > 0 &&
+				waitpid(ProcessInfo[id].pid, &status, WNOHANG) == ProcessInfo[id].pid)
+			{
+				ProcDeath(id, status);
+			}
+		}
+		pthread_mutex_unlock(&ProcMutex);
+	}
+
+	if(ProcSigFd >= 0)
+	{
+		close(ProcSigFd);
+		ProcSigFd = -1;
+	}
+	for(int i = 0; i < ProcNum; i++)
+	{
+		if(ProcPidFd[i] >= 0)
+		{
+			close(ProcPidFd[i]);
+			ProcPidFd[i] = -1;
+		}
+	}
+	pthread_exit(NULL);
+}
+
+/*============================================================================*/
+/*
+ * @brief   プロセス終了処理
+ * @note    終了コード・シグナルを記録し，restart=1なら再起動を予約する．
+ *          停止済みの待機インスタンスがある場合は起動せずに切り替える．
+ *          再起動はperiodから終了毎に倍にした待ち時間(上限DEF_RESTART_BACKOFF_MAX)の後に
+ *          ProcMonit()で行う．起動からDEF_CANCEL_RESTART_TIME以内の終了が
+ *          DEF_RESTART_FAIL回続いた場合は故障とし，DEF_RESTART_RETRY_TIME後に再び起動する．
+ *          ProcMutexを獲得して呼び出すこと．
+ * @param   引数  : id		process.confの順番
+ * @param   引数  : status	waitpid()の終了状態
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 待機インスタンスへの切り替えを追加
+ *          2026/10/19 [0.0.3] perf_eventカウンタの取得終了を追加
+ *          2026/10/19 [0.0.4] 再起動を待ち時間の後に行い，続けて終了した場合は再起動をやめる
+ */
+/*============================================================================*/
+static void ProcDeath(int id, int status)
+{
+	struct timespec death;
+	int now;
+	int wait;
+
+	clock_gettime(CLOCK_MONOTONIC, &death);
+#if DEF_PROC_TEST
+	printf("[%d]dead. pid = %d. restart time = %d. cnt = %d.\n", id, ProcessInfo[id].pid, ProcReStart[id].time, ProcReStart[id].num);
+#endif
+	if(WIFSIGNALED(status))
+	{
+		ProcStat.exit_code[id] = -1;
+		ProcStat.exit_signal[id] = WTERMSIG(status);
+	}
+	else
+	{
+		ProcStat.exit_code[id] = WEXITSTATUS(status);
+		ProcStat.exit_signal[id] = 0;
+	}
+	dprintf(WARN, "[%d] pid = %d exited. code = %d, signal = %d\n", id, ProcessInfo[id].pid,
+		ProcStat.exit_code[id], ProcStat.exit_signal[id]);
+
+	if(ProcPidFd[id] >= 0)
+	{
+		close(ProcPidFd[id]);
+		ProcPidFd[id] = -1;
+	}
+	ProcessInfo[id].pid = -1;
+	ProcStat.pid[id] = -1;
+	ProcAcctClose(&ProcAcct[id]);
+	ProcPerfClose(&ProcPerf[id]);
+	
+	//　プロセス再起動
+	if(ProcessInfo[id].restart == DEF_RESTART_ON)
+	{
+		now = ProcNowMs();
+		if(now - ProcReStart[id].time >= DEF_CANCEL_RESTART_TIME)
+		{
+			//一定時間動作した後の終了は続けて終了した回数に数えない
+			ProcReStart[id].num = 0;
+			ProcReStart[id].backoff = 0;
+		}
+		ProcReStart[id].num++;						
+		if(ProcReStart[id].num >= DEF_RESTART_FAIL)
+		{
+			ProcStat.stat[id] = 1;
+			ProcReStart[id].next = now + DEF_RESTART_RETRY_TIME;
+			dprintf(ERROR, "[%s] exited %d times in a row within %d ms of start. retry after %d ms\n", ProcessInfo[id].name,
+				ProcReStart[id].num, DEF_CANCEL_RESTART_TIME, DEF_RESTART_RETRY_TIME);
+		}
+		else if(ProcStandbyActivate(id, &death) != DEF_RET_OK)
+		{
+			wait = (ProcReStart[id].backoff > 0) ? ProcReStart[id].backoff * 2 : ProcessInfo[id].period;
+			if(wait < DEF_MONIT_CYCLE)
+			{
+				wait = DEF_MONIT_CYCLE;
+			}
+			if(wait > DEF_RESTART_BACKOFF_MAX)
+			{
+				wait = DEF_RESTART_BACKOFF_MAX;
+			}
+			ProcReStart[id].backoff = wait;
+			ProcReStart[id].next = now + wait;
+			dprintf(WARN, "[%s] restart after %d ms\n", ProcessInfo[id].name, wait);
+		}
+	}
+	else
+	{
+		ProcStat.stat[id] = 1;
+	}
+	com_shmem_write(ProcShmId, &ProcStat, sizeof(ProcStat));
+}
+
+/*============================================================================*/
+/*
+ * @brief   term process
+ * @note    kill process
+ * @param   引数  : void
+ *                  
+ * @return  戻り値: int
+ * @date    2023/11/13 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 待機インスタンスの停止を追加
+ *          2026/10/19 [0.0.3] 待機インスタンスのperf_eventカウンタを閉じる
+ */
+/*============================================================================*/
+static int ProcTerm(void)
+{
+	int status;
+	int ret = DEF_RET_OK;
 	
 	for(int i = 0; i < ProcNum; i++)
 	{
+		//待機インスタンス(SIGSTOPで停止中のためSIGKILLで終了)
+		if(ProcStandby[i].pid > 0)
+		{
+			kill(ProcStandby[i].pid, SIGKILL);
+			waitpid(ProcStandby[i].pid, &status, 0);
+			ProcPerfClose(&ProcStandby[i].perf);
+			ProcStandby[i].pid = -1;
+		}
+
 		if(ProcessInfo[i].pid != -1 && ProcessInfo[i].pid != 0)
 		{
 			//プロセス終了
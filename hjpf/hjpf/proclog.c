@@ -0,0 +1,616 @@
+/*============================================================================*/
+/*
+ * @file    proclog.c
+ * @brief   管理プロセスの標準出力・標準エラー出力の取り込み
+ * @note    パイプの書き込み側は子プロセスの標準出力・標準エラー出力とし(ブロッキングのまま)，
+ *          hjpf側は非ブロッキングで読み込む．読み込みスレッドはリングバッファへの格納のみ行い，
+ *          ファイルへの書き込み(ストレージの遅延)で子プロセスの出力が止まらないようにする．
+ *          リングバッファは読み込みスレッドが格納し，書き込みスレッドが取り出す(ロックなし)．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include "debug.h"
+#include "hjpf.h"
+#include "proclog.h"
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_PLOG_STAMP_LEN (27)				//行頭の時刻("YYYY/MM/DD HH:MM:SS.uuuuuu ")
+#define DEF_PLOG_MARK_LEN (96)				//破棄の通知行の最大長
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static procLog *LogTbl = NULL;				/* 取り込み状態(process.confの順番) */
+static int LogNum = 0;
+static int LogEpFd = -1;					/* パイプの読み込み待ち(-1:未開始) */
+static atomic_int LogRun;					/* スレッド動作中 */
+static pthread_t LogReadThread;
+static pthread_t LogWriteThread;
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static void ProcLogClose(procLog *log);
+static void ProcLogStamp(char *str, size_t size);
+static unsigned int ProcLogFree(procLog *log);
+static unsigned int ProcLogCopy(procLog *log, unsigned int head, const char *data, unsigned int len);
+static void ProcLogPut(procLog *log, const char *data, unsigned int len);
+static void ProcLogDrain(procLog *log);
+static int ProcLogRotate(procLog *log);
+static void ProcLogWrite(procLog *log);
+static void* ProcLogRead(void *arg);
+static void* ProcLogWriter(void *arg);
+
+/*============================================================================*/
+/*
+ * @brief   取り込み準備
+ * @note    パイプとリングバッファを作成する．子プロセスの起動(ProcSpawn)でwfdを
+ *          標準出力・標準エラー出力に複製する．取り込まない場合・失敗した場合はwfdを-1とし，
+ *          子プロセスはhjpfの標準出力・標準エラー出力を引き継ぐ．
+ * @param   引数  : log		取り込み状態
+ * @param   引数  : name	グループ名(ファイル名，NULL:取り込まない)
+ * @return  戻り値: int(DEF_RET_NG:取り込まない)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcLogOpen(procLog *log, const char *name)
+{
+	int fd[2];
+
+	memset(log, 0, sizeof(*log));
+	log->rfd = -1;
+	log->wfd = -1;
+	log->fd = -1;
+	log->bol = 1;
+	if(name == NULL)
+	{
+		return DEF_RET_NG;
+	}
+
+	if(snprintf(log->path, sizeof(log->path), "%s/%s.log", DEF_PLOG_DIR, name) >= (int)sizeof(log->path))
+	{
+		dprintf(WARN, "[%s] log path is too long.\n", name);
+		return DEF_RET_NG;
+	}
+	if((log->buf = malloc(DEF_PLOG_RING_SIZE)) == NULL)
+	{
+		dprintf(WARN, "[%s] log buffer malloc failed.\n", name);
+		return DEF_RET_NG;
+	}
+
+	//読み込み側のみ非ブロッキング(書き込み側は子プロセスの標準出力として通常の動作とする)
+	if(pipe2(fd, O_CLOEXEC) != 0)
+	{
+		dprintf(WARN, "[%s] pipe2 failed. errno = %d\n", name, errno);
+		ProcLogClose(log);
+		return DEF_RET_NG;
+	}
+	log->rfd = fd[0];
+	log->wfd = fd[1];
+	fcntl(log->rfd, F_SETFL, fcntl(log->rfd, F_GETFL) | O_NONBLOCK);
+
+	//読み込みが遅れた場合に子プロセスが書き込みで待たないよう大きくする
+	if(fcntl(log->rfd, F_SETPIPE_SZ, DEF_PLOG_PIPE_SIZE) < 0)
+	{
+		dprintf(INFO, "[%s] F_SETPIPE_SZ failed. errno = %d\n", name, errno);
+	}
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   取り込み開始
+ * @note    読み込みスレッド・書き込みスレッドを生成する．管理プロセスの起動前に呼び出す．
+ *          失敗した場合は全てのパイプを閉じ，子プロセスはhjpfの出力を引き継ぐ．
+ *          スレッドは実時間スレッドの設定を継承しない．
+ * @param   引数  : log		取り込み状態(process.confの順番)
+ * @param   引数  : num		管理プロセス数
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] スレッド名を設定
+ */
+/*============================================================================*/
+int ProcLogStart(procLog *log, int num)
+{
+	struct epoll_event ev;
+	pthread_attr_t attr;
+	struct sched_param param;
+	int cnt = 0;
+
+	LogTbl = log;
+	LogNum = num;
+
+	if(mkdir(DEF_PLOG_DIR, 0755) != 0 && errno != EEXIST)
+	{
+		dprintf(WARN, "mkdir(%s) failed. errno = %d\n", DEF_PLOG_DIR, errno);
+		goto err;
+	}
+	if((LogEpFd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+	{
+		dprintf(WARN, "epoll_create1 failed. errno = %d\n", errno);
+		goto err;
+	}
+	for(int i = 0; i < num; i++)
+	{
+		if(log[i].rfd < 0)
+		{
+			continue;
+		}
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.ptr = &log[i];
+		if(epoll_ctl(LogEpFd, EPOLL_CTL_ADD, log[i].rfd, &ev) != 0)
+		{
+			dprintf(WARN, "epoll_ctl failed. path = %s, errno = %d\n", log[i].path, errno);
+			ProcLogClose(&log[i]);
+			continue;
+		}
+		cnt++;
+	}
+	if(cnt == 0)
+	{
+		goto err;
+	}
+
+	memset(&param, 0, sizeof(param));
+	pthread_attr_init(&attr);
+	pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+	pthread_attr_setschedparam(&attr, &param);
+
+	atomic_store(&LogRun, 1);
+	if(pthread_create(&LogReadThread, &attr, ProcLogRead, NULL) != 0)
+	{
+		dprintf(WARN, "pthread_create(ProcLogRead) error=%d\n", errno);
+		pthread_attr_destroy(&attr);
+		goto err;
+	}
+	if(pthread_create(&LogWriteThread, &attr, ProcLogWriter, NULL) != 0)
+	{
+		dprintf(WARN, "pthread_create(ProcLogWriter) error=%d\n", errno);
+		atomic_store(&LogRun, 0);
+		pthread_join(LogReadThread, NULL);
+		pthread_attr_destroy(&attr);
+		goto err;
+	}
+	pthread_attr_destroy(&attr);
+	pthread_setname_np(LogReadThread, "hjpf_plog_read");
+	pthread_setname_np(LogWriteThread, "hjpf_plog_write");
+	return DEF_RET_OK;
+
+err:
+	atomic_store(&LogRun, 0);
+	for(int i = 0; i < num; i++)
+	{
+		ProcLogClose(&log[i]);
+	}
+	if(LogEpFd >= 0)
+	{
+		close(LogEpFd);
+		LogEpFd = -1;
+	}
+	return DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   取り込み終了
+ * @note    全プロセス停止(ProcTerm)の後に呼び出し，パイプに残った出力を書き込んでから閉じる．
+ * @param   引数  : log		取り込み状態(process.confの順番)
+ * @param   引数  : num		管理プロセス数
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcLogTerm(procLog *log, int num)
+{
+	if(LogEpFd < 0)
+	{
+		return;
+	}
+
+	atomic_store(&LogRun, 0);
+	pthread_join(LogReadThread, NULL);
+	pthread_join(LogWriteThread, NULL);
+
+	//スレッド終了後は呼び出し元で格納・取り出しを行う
+	for(int i = 0; i < num; i++)
+	{
+		if(log[i].rfd >= 0)
+		{
+			ProcLogDrain(&log[i]);
+			ProcLogWrite(&log[i]);
+		}
+		ProcLogClose(&log[i]);
+	}
+	close(LogEpFd);
+	LogEpFd = -1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   パイプ・ファイルを閉じる
+ * @param   引数  : log		取り込み状態
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcLogClose(procLog *log)
+{
+	if(log->rfd >= 0)
+	{
+		close(log->rfd);
+		log->rfd = -1;
+	}
+	if(log->wfd >= 0)
+	{
+		close(log->wfd);
+		log->wfd = -1;
+	}
+	if(log->fd >= 0)
+	{
+		close(log->fd);
+		log->fd = -1;
+	}
+	free(log->buf);
+	log->buf = NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   行頭の時刻
+ * @note    デバッグログと同じ形式とする(DEF_PLOG_STAMP_LEN文字)．
+ * @param   引数  : str		出力先
+ * @param   引数  : size	出力先のサイズ
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcLogStamp(char *str, size_t size)
+{
+	struct timespec ts;
+	struct tm tm;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	localtime_r(&ts.tv_sec, &tm);
+	snprintf(str, size, "%04d/%02d/%02d %02d:%02d:%02d.%06ld ",
+		tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+		ts.tv_nsec / 1000);
+}
+
+/*============================================================================*/
+/*
+ * @brief   リングバッファの空き
+ * @param   引数  : log		取り込み状態
+ * @return  戻り値: unsigned int(空き[byte])
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static unsigned int ProcLogFree(procLog *log)
+{
+	unsigned int head = atomic_load_explicit(&log->head, memory_order_relaxed);
+	unsigned int tail = atomic_load_explicit(&log->tail, memory_order_acquire);
+
+	return DEF_PLOG_RING_SIZE - (head - tail);
+}
+
+/*============================================================================*/
+/*
+ * @brief   リングバッファへの格納
+ * @note    空きを確認してから呼び出すこと．格納位置の公開はProcLogPut()でまとめて行う．
+ * @param   引数  : log		取り込み状態
+ * @param   引数  : head	格納位置
+ * @param   引数  : data	データ
+ * @param   引数  : len		サイズ
+ * @return  戻り値: unsigned int(次の格納位置)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static unsigned int ProcLogCopy(procLog *log, unsigned int head, const char *data, unsigned int len)
+{
+	unsigned int pos = head & (DEF_PLOG_RING_SIZE - 1);
+	unsigned int seg = DEF_PLOG_RING_SIZE - pos;
+
+	if(seg > len)
+	{
+		seg = len;
+	}
+	memcpy(log->buf + pos, data, seg);
+	memcpy(log->buf, data + seg, len - seg);
+	return head + len;
+}
+
+/*============================================================================*/
+/*
+ * @brief   読み込んだデータの格納
+ * @note    行頭に時刻を付けて格納する．全て格納できない場合は読み込んだ分を全て破棄し，
+ *          次に格納できた時点で破棄量を1行残す(行の途中で破棄した場合は改行してから)．
+ * @param   引数  : log		取り込み状態
+ * @param   引数  : data	読み込んだデータ
+ * @param   引数  : len		サイズ(0:破棄量のみ残す)
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcLogPut(procLog *log, const char *data, unsigned int len)
+{
+	char stamp[DEF_PLOG_MARK_LEN];
+	char mark[DEF_PLOG_MARK_LEN + DEF_PLOG_MARK_LEN];
+	unsigned int head = atomic_load_explicit(&log->head, memory_order_relaxed);
+	unsigned int mark_len = 0;
+	unsigned int need;
+	unsigned int n;
+	const char *eol;
+	int bol;
+
+	ProcLogStamp(stamp, sizeof(stamp));
+	if(log->lost > 0)
+	{
+		mark_len = (unsigned int)snprintf(mark, sizeof(mark), "%s%s--- %u bytes dropped ---\n",
+			log->bol ? "" : "\n", stamp, log->lost);
+	}
+
+	//時刻を付けた後のサイズ
+	need = mark_len + len;
+	bol = (mark_len > 0) ? 1 : log->bol;
+	for(unsigned int i = 0; i < len; i++)
+	{
+		if(bol)
+		{
+			need += DEF_PLOG_STAMP_LEN;
+		}
+		bol = (data[i] == '\n');
+	}
+
+	if(need > ProcLogFree(log))
+	{
+		log->lost += len;
+		atomic_fetch_add_explicit(&log->drop, len, memory_order_relaxed);
+		return;
+	}
+
+	if(mark_len > 0)
+	{
+		head = ProcLogCopy(log, head, mark, mark_len);
+		log->lost = 0;
+		log->bol = 1;
+	}
+	while(len > 0)
+	{
+		if(log->bol)
+		{
+			head = ProcLogCopy(log, head, stamp, DEF_PLOG_STAMP_LEN);
+		}
+		eol = memchr(data, '\n', len);
+		n = (eol != NULL) ? (unsigned int)(eol - data) + 1 : len;
+		log->bol = (eol != NULL);
+		head = ProcLogCopy(log, head, data, n);
+		data += n;
+		len -= n;
+	}
+
+	//格納したデータを書き込みスレッドに公開する
+	atomic_store_explicit(&log->head, head, memory_order_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   パイプの読み込み
+ * @note    読み込めなくなる(EAGAIN)まで読み込む．破棄した後に出力が無い場合も破棄量を残す．
+ * @param   引数  : log		取り込み状態
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcLogDrain(procLog *log)
+{
+	char buf[DEF_PLOG_READ_SIZE];
+	ssize_t len;
+
+	while((len = read(log->rfd, buf, sizeof(buf))) > 0)
+	{
+		ProcLogPut(log, buf, (unsigned int)len);
+	}
+	if(log->lost > 0)
+	{
+		ProcLogPut(log, NULL, 0);
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   ファイルの世代の切り替え
+ * @note    <名前>.log.<N-1>を<名前>.log.<N>に変更し，最も古い世代を上書きする．
+ * @param   引数  : log		取り込み状態
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcLogRotate(procLog *log)
+{
+	char from[DEF_PLOG_PATH_LEN + 8];
+	char to[DEF_PLOG_PATH_LEN + 8];
+
+	if(log->fd >= 0)
+	{
+		close(log->fd);
+		log->fd = -1;
+	}
+	for(int i = DEF_PLOG_FILE_NUM - 1; i > 0; i--)
+	{
+		if(i > 1)
+		{
+			snprintf(from, sizeof(from), "%s.%d", log->path, i - 1);
+		}
+		else
+		{
+			snprintf(from, sizeof(from), "%s", log->path);
+		}
+		snprintf(to, sizeof(to), "%s.%d", log->path, i);
+		if(rename(from, to) != 0 && errno != ENOENT)
+		{
+			dprintf(WARN, "rename(%s) failed. errno = %d\n", from, errno);
+		}
+	}
+
+	if((log->fd = open(log->path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644)) < 0)
+	{
+		dprintf(WARN, "open(%s) failed. errno = %d\n", log->path, errno);
+		return DEF_RET_NG;
+	}
+	log->size = 0;
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ファイルへの書き込み
+ * @note    リングバッファに格納されている分を書き込む．書き込めない場合も取り出し位置を進め，
+ *          読み込みスレッドの格納を止めない．世代の切り替えは行末で行う
+ *          (1行がファイルの残りより長い場合はその行の途中で切り替える)．
+ * @param   引数  : log		取り込み状態
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ProcLogWrite(procLog *log)
+{
+	unsigned int head = atomic_load_explicit(&log->head, memory_order_acquire);
+	unsigned int tail = atomic_load_explicit(&log->tail, memory_order_relaxed);
+	unsigned int pos;
+	unsigned int seg;
+	const char *eol;
+	struct stat st;
+
+	if(head == tail)
+	{
+		return;
+	}
+
+	if(log->fd < 0)
+	{
+		if((log->fd = open(log->path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644)) >= 0)
+		{
+			log->size = (fstat(log->fd, &st) == 0) ? st.st_size : 0;
+		}
+		else
+		{
+			dprintf(WARN, "open(%s) failed. errno = %d\n", log->path, errno);
+		}
+	}
+
+	while(tail != head)
+	{
+		pos = tail & (DEF_PLOG_RING_SIZE - 1);
+		seg = DEF_PLOG_RING_SIZE - pos;
+		if(seg > head - tail)
+		{
+			seg = head - tail;
+		}
+		//リングバッファの末尾で分かれている場合も残り全体で切り替えを判定する
+		if(log->fd >= 0 && log->size + (head - tail) > DEF_PLOG_FILE_SIZE)
+		{
+			eol = (log->size < DEF_PLOG_FILE_SIZE) ? memrchr(log->buf + pos, '\n',
+				(log->size + seg > DEF_PLOG_FILE_SIZE) ? (size_t)(DEF_PLOG_FILE_SIZE - log->size) : seg) : NULL;
+			if(eol != NULL)
+			{
+				seg = (unsigned int)(eol - (log->buf + pos)) + 1;
+			}
+			else if(log->size > 0)
+			{
+				ProcLogRotate(log);
+			}
+		}
+		if(log->fd >= 0 && write(log->fd, log->buf + pos, seg) > 0)
+		{
+			log->size += seg;
+		}
+		tail += seg;
+	}
+	atomic_store_explicit(&log->tail, tail, memory_order_release);
+}
+
+/*============================================================================*/
+/*
+ * @brief   読み込みスレッド
+ * @note    読み込めるパイプを全て読み込み，リングバッファに格納する．
+ *          破棄量を残していないプロセスは空きができるまで待ち時間毎に再確認する．
+ * @param   引数  : arg	未使用
+ * @return  戻り値: void*
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void* ProcLogRead(void *arg)
+{
+	struct epoll_event ev[DEF_PLOG_EVENT_MAX];
+	int num;
+
+	(void)arg;
+
+	while(atomic_load(&LogRun))
+	{
+		num = epoll_wait(LogEpFd, ev, DEF_PLOG_EVENT_MAX, DEF_PLOG_WAIT);
+		for(int i = 0; i < num; i++)
+		{
+			ProcLogDrain((procLog *)ev[i].data.ptr);
+		}
+		for(int i = 0; i < LogNum; i++)
+		{
+			if(LogTbl[i].lost > 0)
+			{
+				ProcLogDrain(&LogTbl[i]);
+			}
+		}
+	}
+	return NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   書き込みスレッド
+ * @note    書き込み周期毎に全プロセスのリングバッファをファイルに書き込む．
+ *          ストレージの書き込みで他の処理を妨げないよう優先度を下げる．
+ * @param   引数  : arg	未使用
+ * @return  戻り値: void*
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void* ProcLogWriter(void *arg)
+{
+	struct timespec cycle = {0, DEF_PLOG_WRITE_CYCLE * 1000000L};
+
+	(void)arg;
+	setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), DEF_PLOG_NICE);
+
+	while(atomic_load(&LogRun))
+	{
+		for(int i = 0; i < LogNum; i++)
+		{
+			if(LogTbl[i].rfd >= 0)
+			{
+				ProcLogWrite(&LogTbl[i]);
+			}
+		}
+		nanosleep(&cycle, NULL);
+	}
+	return NULL;
+}
@@ -0,0 +1,240 @@
+/*============================================================================*/
+/*
+ * @file    procperf.c
+ * @brief   プロセス毎のperf_eventカウンタ取得
+ * @note    perf_event_open()でプロセス単位(inherit:起動後に生成されたスレッドを含む)の
+ *          カウンタをオープンし，周期毎にread()で読み込む．
+ *          ハードウェアカウンタはPMUが無い(仮想環境等)・数が足りない場合があるため，
+ *          ProcPerfInit()で使用可否を確認し，多重化された値は動作時間の割合で補正する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "debug.h"
+#include "hjpf.h"
+#include "procperf.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static const struct {					/* カウンタの定義(enum perf_event) */
+	const char *name;
+	uint32_t type;
+	uint64_t config;
+	uint64_t unit;						/* 1秒あたりの値の単位 */
+} PerfEvent[PERF_EVENT_MAX] = {
+	{ "task-clock",			PERF_TYPE_SOFTWARE,	PERF_COUNT_SW_TASK_CLOCK,		1000000 },
+	{ "context-switches",	PERF_TYPE_SOFTWARE,	PERF_COUNT_SW_CONTEXT_SWITCHES,	1 },
+	{ "cpu-migrations",		PERF_TYPE_SOFTWARE,	PERF_COUNT_SW_CPU_MIGRATIONS,	1 },
+	{ "page-faults",		PERF_TYPE_SOFTWARE,	PERF_COUNT_SW_PAGE_FAULTS,		1 },
+	{ "major-faults",		PERF_TYPE_SOFTWARE,	PERF_COUNT_SW_PAGE_FAULTS_MAJ,	1 },
+	{ "cycles",				PERF_TYPE_HARDWARE,	PERF_COUNT_HW_CPU_CYCLES,		1000000 },
+	{ "instructions",		PERF_TYPE_HARDWARE,	PERF_COUNT_HW_INSTRUCTIONS,		1000000 },
+	{ "cache-misses",		PERF_TYPE_HARDWARE,	PERF_COUNT_HW_CACHE_MISSES,		1000 },
+};
+static int PerfAvail[PERF_EVENT_MAX];	/* 使用可否(ProcPerfInit()で確認) */
+static int PerfExclKernel[PERF_EVENT_MAX];	/* カーネル空間を除外(perf_event_paranoidで制限される場合) */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int ProcPerfEventOpen(int event, int pid, int inherit);
+
+/*============================================================================*/
+/*
+ * @brief   取得初期化
+ * @note    自プロセスで各カウンタをオープンして使用可否を確認する．
+ *          カーネル空間を含めて計測できない場合はユーザ空間のみとする．
+ * @param   引数  : void
+ * @return  戻り値: int(DEF_RET_NG:使用できるカウンタなし)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcPerfInit(void)
+{
+	int num = 0;
+	int fd;
+
+	for(int i = 0; i < PERF_EVENT_MAX; i++)
+	{
+		PerfAvail[i] = 1;
+		PerfExclKernel[i] = 0;
+		fd = ProcPerfEventOpen(i, 0, 0);
+		if(fd < 0 && (errno == EACCES || errno == EPERM))
+		{
+			PerfExclKernel[i] = 1;
+			fd = ProcPerfEventOpen(i, 0, 0);
+		}
+		if(fd < 0)
+		{
+			dprintf(INFO, "perf_event %s is not available. errno = %d\n", PerfEvent[i].name, errno);
+			PerfAvail[i] = 0;
+			continue;
+		}
+		close(fd);
+		num++;
+	}
+
+	return (num > 0) ? DEF_RET_OK : DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   取得開始
+ * @note    プロセス起動直後に呼び出す．起動後に生成されたスレッド・子プロセスの値を含む．
+ *          一部のカウンタをオープンできない場合はその項目のみ取得しない
+ *          (カウンタ毎にファイルディスクリプタを1つ使う)．
+ * @param   引数  : perf	取得状態
+ * @param   引数  : pid		プロセスID
+ * @return  戻り値: int(DEF_RET_NG:オープンできたカウンタなし)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcPerfOpen(procPerf *perf, int pid)
+{
+	int num = 0;
+
+	ProcPerfClose(perf);
+	memset(perf, 0, sizeof(*perf));
+	perf->pid = pid;
+	for(int i = 0; i < PERF_EVENT_MAX; i++)
+	{
+		perf->fd[i] = PerfAvail[i] ? ProcPerfEventOpen(i, pid, 1) : -1;
+		if(PerfAvail[i] && perf->fd[i] < 0)
+		{
+			dprintf(WARN, "perf_event_open(%s) failed. pid = %d, errno = %d\n", PerfEvent[i].name, pid, errno);
+		}
+		num += (perf->fd[i] >= 0);
+	}
+	if(num == 0)
+	{
+		ProcPerfClose(perf);
+		return DEF_RET_NG;
+	}
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   カウンタ取得
+ * @note    前回からの差分を1秒あたりの値にする(初回は0)．
+ *          ハードウェアカウンタが多重化された場合は有効時間/動作時間で補正する．
+ * @param   引数  : perf	取得状態
+ * @param   引数  : value	取得結果
+ * @return  戻り値: int(DEF_RET_NG:未オープン)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcPerfUpdate(procPerf *perf, procPerfValue *value)
+{
+	struct timespec ts;
+	uint64_t buf[3];					/* value，time_enabled，time_running */
+	uint64_t now;
+	uint64_t interval = 0;
+	uint64_t count;
+
+	for(int i = 0; i < PERF_EVENT_MAX; i++)
+	{
+		value->rate[i] = DEF_PERF_NONE;
+	}
+	if(perf->pid <= 0)
+	{
+		return DEF_RET_NG;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+	if(perf->stamp != 0 && now > perf->stamp)
+	{
+		interval = now - perf->stamp;
+	}
+
+	for(int i = 0; i < PERF_EVENT_MAX; i++)
+	{
+		if(perf->fd[i] < 0 || read(perf->fd[i], buf, sizeof(buf)) != sizeof(buf))
+		{
+			continue;
+		}
+		count = buf[0];
+		if(buf[2] > 0 && buf[2] < buf[1])
+		{
+			count = (uint64_t)((double)buf[0] * (double)buf[1] / (double)buf[2]);
+		}
+
+		value->rate[i] = 0;
+		if(interval > 0 && count >= perf->count[i])
+		{
+			value->rate[i] = (int32_t)((double)(count - perf->count[i]) * 1e9 / (double)interval /
+				(double)PerfEvent[i].unit);
+		}
+		perf->count[i] = count;
+	}
+	perf->stamp = now;
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   取得終了
+ * @note    プロセス終了を検知したら閉じる．
+ * @param   引数  : perf	取得状態
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcPerfClose(procPerf *perf)
+{
+	if(perf->pid <= 0)
+	{
+		return;
+	}
+	for(int i = 0; i < PERF_EVENT_MAX; i++)
+	{
+		if(perf->fd[i] >= 0)
+		{
+			close(perf->fd[i]);
+			perf->fd[i] = -1;
+		}
+	}
+	perf->pid = 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   カウンタオープン
+ * @param   引数  : event	enum perf_event
+ * @param   引数  : pid		プロセスID(0:自プロセス)
+ * @param   引数  : inherit	生成されたスレッド・子プロセスを含める
+ * @return  戻り値: int(ファイルディスクリプタ，-1:失敗)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcPerfEventOpen(int event, int pid, int inherit)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PerfEvent[event].type;
+	attr.config = PerfEvent[event].config;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	attr.inherit = inherit;
+	attr.exclude_kernel = PerfExclKernel[event];
+	attr.exclude_hv = 1;
+
+	return (int)syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
@@ -0,0 +1,356 @@
+/*============================================================================*/
+/*
+ * @file    procready.c
+ * @brief   管理プロセスの起動完了判定
+ * @note    ProcMonitの監視周期毎にProcReadyPoll()で判定する．
+ *          通知メッセージはsd_notify()と同じ形式(NOTIFY_SOCKETへの"READY=1"のデータグラム)とし，
+ *          送信元のプロセスIDはSCM_CREDENTIALSで取得する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "com_shmem.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "procready.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static const char *ReadyKindName[READY_KIND_MAX] = { "start", "shmem", "socket", "notify" };
+static int ReadyNotifyFd = -1;			/* 通知メッセージの受信ソケット(-1:未使用) */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static socklen_t ProcReadyAddr(struct sockaddr_un *addr, const char *path);
+static int ProcReadyShmem(procReady *ready);
+static int ProcReadySocket(procReady *ready);
+
+/*============================================================================*/
+/*
+ * @brief   起動完了条件の解析
+ * @note    "start"，"shmem:<共有メモリ名>"，"socket:<パス>"，"notify"のいずれか．
+ *          ソケットのパスの先頭が'@'の場合は抽象名前空間とする．
+ * @param   引数  : ready	起動完了条件
+ * @param   引数  : str		process.confのready=(NULL:start)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcReadyParse(procReady *ready, const char *str)
+{
+	const char *arg;
+	size_t len;
+
+	memset(ready, 0, sizeof(*ready));
+	ready->kind = READY_KIND_START;
+	ready->shm_id = DEF_COM_SHMEM_FALSE;
+	if(str == NULL)
+	{
+		return DEF_RET_OK;
+	}
+
+	arg = strchr(str, ':');
+	len = (arg != NULL) ? (size_t)(arg - str) : strlen(str);
+	for(ready->kind = 0; ready->kind < READY_KIND_MAX; ready->kind++)
+	{
+		if(strncmp(str, ReadyKindName[ready->kind], len) == 0 && ReadyKindName[ready->kind][len] == '\0')
+		{
+			break;
+		}
+	}
+
+	switch(ready->kind)
+	{
+	case READY_KIND_START:
+	case READY_KIND_NOTIFY:
+		return (arg == NULL) ? DEF_RET_OK : DEF_RET_NG;
+	case READY_KIND_SHMEM:
+	case READY_KIND_SOCKET:
+		if(arg == NULL || arg[1] == '\0' || strlen(arg + 1) >= sizeof(ready->arg))
+		{
+			return DEF_RET_NG;
+		}
+		strcpy(ready->arg, arg + 1);
+		return DEF_RET_OK;
+	default:
+		ready->kind = READY_KIND_START;
+		return DEF_RET_NG;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   通知メッセージ受信開始
+ * @note    ready=notifyのプロセスがある場合のみ呼び出す．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcReadyInit(void)
+{
+	struct sockaddr_un addr;
+	socklen_t len;
+	int on = 1;
+
+	if(ReadyNotifyFd >= 0)
+	{
+		return DEF_RET_OK;
+	}
+
+	ReadyNotifyFd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(ReadyNotifyFd < 0)
+	{
+		dprintf(ERROR, "socket failed. errno = %d\n", errno);
+		return DEF_RET_NG;
+	}
+
+	//送信元のプロセスIDを受け取る
+	len = ProcReadyAddr(&addr, DEF_READY_NOTIFY_SOCKET);
+	if(setsockopt(ReadyNotifyFd, SOL_SOCKET, SO_PASSCRED, &on, sizeof(on)) != 0 ||
+		bind(ReadyNotifyFd, (struct sockaddr *)&addr, len) != 0)
+	{
+		dprintf(ERROR, "bind(%s) failed. errno = %d\n", DEF_READY_NOTIFY_SOCKET, errno);
+		close(ReadyNotifyFd);
+		ReadyNotifyFd = -1;
+		return DEF_RET_NG;
+	}
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   起動時刻の記録
+ * @note    ProcLaunch()でプロセスを起動した直後に呼び出す．
+ *          共有メモリはこの時刻以降に書き込まれた場合に起動完了とする．
+ * @param   引数  : ready	起動完了条件
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcReadyLaunch(procReady *ready)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	ready->launch = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+	ready->notified = 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   起動完了判定
+ * @param   引数  : ready	起動完了条件
+ * @return  戻り値: int(1:起動完了，0:未完了)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcReadyPoll(procReady *ready)
+{
+	switch(ready->kind)
+	{
+	case READY_KIND_SHMEM:
+		return ProcReadyShmem(ready);
+	case READY_KIND_SOCKET:
+		return ProcReadySocket(ready);
+	case READY_KIND_NOTIFY:
+		return ready->notified;
+	default:
+		return 1;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   通知メッセージ受信
+ * @note    受信済みのメッセージを全て読み込み，"READY=1"を含むものの送信元を返す．
+ * @param   引数  : pid	送信元のプロセスID
+ * @param   引数  : max	pidの要素数
+ * @return  戻り値: int(送信元の数)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcReadyNotify(int *pid, int max)
+{
+	char buf[DEF_READY_NOTIFY_LEN];
+	char ctrl[CMSG_SPACE(sizeof(struct ucred))];
+	struct ucred *cred;
+	struct cmsghdr *cmsg;
+	struct msghdr msg;
+	struct iovec iov;
+	ssize_t len;
+	int num = 0;
+
+	while(ReadyNotifyFd >= 0 && num < max)
+	{
+		memset(&msg, 0, sizeof(msg));
+		iov.iov_base = buf;
+		iov.iov_len = sizeof(buf) - 1;
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = ctrl;
+		msg.msg_controllen = sizeof(ctrl);
+		len = recvmsg(ReadyNotifyFd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+		if(len < 0)
+		{
+			break;
+		}
+		buf[len] = '\0';
+
+		cred = NULL;
+		for(cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg))
+		{
+			if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_CREDENTIALS)
+			{
+				cred = (struct ucred *)CMSG_DATA(cmsg);
+			}
+		}
+
+		//改行区切りの"KEY=VALUE"(STATUS=等は無視する)
+		for(char *p = buf; cred != NULL && p != NULL; p = strchr(p, '\n'))
+		{
+			p += (*p == '\n');
+			if(strncmp(p, DEF_READY_NOTIFY_MSG, strlen(DEF_READY_NOTIFY_MSG)) == 0)
+			{
+				pid[num++] = cred->pid;
+				break;
+			}
+		}
+	}
+	return num;
+}
+
+/*============================================================================*/
+/*
+ * @brief   起動完了判定終了
+ * @param   引数  : ready	起動完了条件
+ * @param   引数  : num		管理プロセス数
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcReadyTerm(procReady *ready, int num)
+{
+	for(int i = 0; i < num; i++)
+	{
+		if(ready[i].shm_id != DEF_COM_SHMEM_FALSE)
+		{
+			com_shmem_close(ready[i].shm_id);
+			ready[i].shm_id = DEF_COM_SHMEM_FALSE;
+		}
+	}
+	if(ReadyNotifyFd >= 0)
+	{
+		close(ReadyNotifyFd);
+		ReadyNotifyFd = -1;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   UNIXソケットのアドレス作成
+ * @param   引数  : addr	アドレス
+ * @param   引数  : path	パス(先頭@:抽象名前空間)
+ * @return  戻り値: socklen_t(アドレス長)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static socklen_t ProcReadyAddr(struct sockaddr_un *addr, const char *path)
+{
+	size_t len = strlen(path);
+
+	memset(addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	if(len >= sizeof(addr->sun_path))
+	{
+		len = sizeof(addr->sun_path) - 1;
+	}
+	memcpy(addr->sun_path, path, len);
+	if(path[0] == '@')
+	{
+		addr->sun_path[0] = '\0';
+		return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + len);
+	}
+	return (socklen_t)sizeof(*addr);
+}
+
+/*============================================================================*/
+/*
+ * @brief   共有メモリの書き込み判定
+ * @note    書き込み時刻(末尾のデータ到着時刻)が起動時刻以降なら起動完了とする．
+ *          遅延を記録しないようcom_shmem_latency()で時刻のみ読み込む．
+ *          hjpf内では書き込まないため，種別はSHM_KIND_PLATFORMでオープンする
+ *          (hjpfのスレッドが書き込む共有メモリでも書き込みを妨げない)．
+ * @param   引数  : ready	起動完了条件
+ * @return  戻り値: int(1:起動完了，0:未完了)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcReadyShmem(procReady *ready)
+{
+	shmLatency tail;
+
+	if(ready->shm_id == DEF_COM_SHMEM_FALSE)
+	{
+		ready->shm_id = com_shmem_open(ready->arg, SHM_KIND_PLATFORM);
+		if(ready->shm_id == DEF_COM_SHMEM_FALSE)
+		{
+			return 0;
+		}
+	}
+	if(com_shmem_latency(ready->shm_id, &tail, 0) != DEF_COM_SHMEM_TRUE)
+	{
+		return 0;
+	}
+	if(tail.stamp == 0 || tail.stamp < ready->launch)
+	{
+		return 0;
+	}
+
+	com_shmem_close(ready->shm_id);
+	ready->shm_id = DEF_COM_SHMEM_FALSE;
+	return 1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ソケットの待ち受け判定
+ * @note    SOCK_STREAMで接続できたら(listen()済み)起動完了とし，直ちに切断する．
+ * @param   引数  : ready	起動完了条件
+ * @return  戻り値: int(1:起動完了，0:未完了)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcReadySocket(procReady *ready)
+{
+	struct sockaddr_un addr;
+	socklen_t len;
+	int fd;
+	int ret;
+
+	fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(fd < 0)
+	{
+		return 0;
+	}
+	len = ProcReadyAddr(&addr, ready->arg);
+	ret = connect(fd, (struct sockaddr *)&addr, len);
+	close(fd);
+	return (ret == 0 || errno == EAGAIN) ? 1 : 0;
+}
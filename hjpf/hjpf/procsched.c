@@ -0,0 +1,538 @@
+/*============================================================================*/
+/*
+ * @file    procsched.c
+ * @brief   管理プロセスのCPU割り当て・スケジューリングポリシー設定
+ * @note    ProcSchedApply()はclone(CLONE_VM|CLONE_VFORK)の子プロセスからも呼び出すため，
+ *          システムコールのみで構成する．SCHED_DEADLINEはglibcにラッパーが無いため
+ *          sched_setattrを直接呼び出す．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include "com_procfs.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "procsched.h"
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE (6)
+#endif
+#ifndef SCHED_FLAG_RESET_ON_FORK
+#define SCHED_FLAG_RESET_ON_FORK (0x01)
+#endif
+#if !defined(SYS_sched_setattr) && defined(__NR_sched_setattr)
+#define SYS_sched_setattr __NR_sched_setattr
+#endif
+#ifndef SYS_sched_setattr						//古いヘッダ向け(番号はアーキテクチャ毎に異なる)
+#if defined(__x86_64__)
+#define SYS_sched_setattr (314)
+#elif defined(__aarch64__)
+#define SYS_sched_setattr (274)
+#endif
+#endif
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procSchedAttr{			/* struct sched_attr(SCHED_ATTR_SIZE_VER0) */
+	uint32_t size;
+	uint32_t sched_policy;
+	uint64_t sched_flags;
+	int32_t sched_nice;
+	uint32_t sched_priority;
+	uint64_t sched_runtime;
+	uint64_t sched_deadline;
+	uint64_t sched_period;
+} procSchedAttr;
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static const struct {					/* process.confのpolicyの名前 */
+	const char *name;
+	int policy;
+} ProcSchedPolicyName[] = {
+	{ "other", SCHED_OTHER },
+	{ "batch", SCHED_BATCH },
+	{ "idle", SCHED_IDLE },
+	{ "fifo", SCHED_FIFO },
+	{ "rr", SCHED_RR },
+	{ "deadline", SCHED_DEADLINE },
+};
+static uint8_t ProcSchedIsolated[DEF_PSCHED_CPU_MAX];	/* isolcpus，nohz_fullのCPU */
+static uint8_t ProcSchedOnline[DEF_PSCHED_CPU_MAX];		/* オンラインのCPU */
+static int ProcSchedCpuNum = 0;			/* CPU数(0:未初期化) */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int ProcSchedMask(procSched *sched, const uint8_t *mask, int num);
+static int ProcSchedReadList(const char *path, uint8_t *mask);
+static int ProcSchedMatch(const procSchedThread *thread, const char *comm);
+
+/*============================================================================*/
+/*
+ * @brief   CPU構成取得
+ * @note    isolcpus，nohz_fullで分離されたCPUを取得する．
+ *          ProcSchedParseCpu()より前に呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcSchedInit(void)
+{
+	uint8_t mask[DEF_PSCHED_CPU_MAX];
+	char list[DEF_PSCHED_LIST_LEN];
+	int num = 0;
+
+	ProcSchedCpuNum = (int)sysconf(_SC_NPROCESSORS_CONF);
+	if(ProcSchedCpuNum <= 0 || ProcSchedCpuNum > DEF_PSCHED_CPU_MAX)
+	{
+		ProcSchedCpuNum = DEF_PSCHED_CPU_MAX;
+	}
+	if(ProcSchedReadList(DEF_PSCHED_CPU_ONLINE, ProcSchedOnline) != DEF_RET_OK)
+	{
+		memset(ProcSchedOnline, 1, sizeof(ProcSchedOnline));
+	}
+
+	//isolcpusとnohz_fullの和
+	memset(ProcSchedIsolated, 0, sizeof(ProcSchedIsolated));
+	if(ProcSchedReadList(DEF_PSCHED_CPU_ISOLATED, mask) == DEF_RET_OK)
+	{
+		for(int i = 0; i < DEF_PSCHED_CPU_MAX; i++)
+		{
+			ProcSchedIsolated[i] |= mask[i];
+		}
+	}
+	if(ProcSchedReadList(DEF_PSCHED_CPU_NOHZ, mask) == DEF_RET_OK)
+	{
+		for(int i = 0; i < DEF_PSCHED_CPU_MAX; i++)
+		{
+			ProcSchedIsolated[i] |= mask[i];
+		}
+	}
+
+	list[0] = '\0';
+	for(int i = 0; i < ProcSchedCpuNum; i++)
+	{
+		if(ProcSchedIsolated[i])
+		{
+			snprintf(list + strlen(list), sizeof(list) - strlen(list), "%s%d", (num > 0) ? "," : "", i);
+			num++;
+		}
+	}
+	dprintf(INFO, "cpu num = %d, isolated cpu = %s\n", ProcSchedCpuNum, (num > 0) ? list : "none");
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPU割り当て解析
+ * @note    "-1"(割り当てない)，CPUリスト("2"，"0-3,6")，"isolated"(isolcpus，nohz_fullのCPU)，
+ *          "housekeeping"(分離されていないオンラインのCPU)のいずれか．
+ *          分離されたCPUが無い環境ではisolated，housekeepingは割り当てない．
+ * @param   引数  : sched	設定先
+ * @param   引数  : str		process.confのcpu
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcSchedParseCpu(procSched *sched, const char *str)
+{
+	uint8_t mask[DEF_PSCHED_CPU_MAX];
+	int isolated = 0;
+	int num;
+
+	memset(sched->cpus, 0, sizeof(sched->cpus));
+	sched->cpu_num = 0;
+	if(str == NULL || str[0] == '\0' || strcmp(str, "-1") == 0)
+	{
+		return DEF_RET_OK;
+	}
+
+	if(strcmp(str, "isolated") == 0 || strcmp(str, "housekeeping") == 0)
+	{
+		isolated = (strcmp(str, "isolated") == 0);
+		for(num = 0; num < ProcSchedCpuNum && !ProcSchedIsolated[num]; num++);
+		if(num >= ProcSchedCpuNum)
+		{
+			dprintf(WARN, "no isolated cpu. cpu=%s is ignored.\n", str);
+			return DEF_RET_OK;
+		}
+		for(int i = 0; i < ProcSchedCpuNum; i++)
+		{
+			mask[i] = ProcSchedOnline[i] && ((ProcSchedIsolated[i] != 0) == isolated);
+		}
+		return ProcSchedMask(sched, mask, ProcSchedCpuNum);
+	}
+
+	num = com_procfs_cpulist(str, mask, DEF_PSCHED_CPU_MAX);
+	if(num <= 0 || num > ProcSchedCpuNum)
+	{
+		return DEF_RET_NG;
+	}
+	return ProcSchedMask(sched, mask, num);
+}
+
+/*============================================================================*/
+/*
+ * @brief   スケジューリングポリシー解析
+ * @note    policyが無い場合は従来どおりprioが0ならSCHED_OTHER，1以上ならSCHED_FIFOとする．
+ *          fifo，rrはprioが1～99，other，batch，idleはprioが0であること．
+ *          deadlineはdl(実行時間，相対デッドライン，周期[us])が実行時間≦相対デッドライン≦周期で
+ *          あること(相対デッドラインが0の場合は周期)．SCHED_DEADLINEは全CPUで実行可能である
+ *          必要があるため，cpuによる割り当てとは併用できない．
+ * @param   引数  : sched	設定先(cpuは解析済み)
+ * @param   引数  : str		process.confのpolicy(NULL:従来の設定)
+ * @param   引数  : prio	process.confのprio
+ * @param   引数  : dl		実行時間，相対デッドライン，周期[us]
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcSchedParsePolicy(procSched *sched, const char *str, int prio, const uint64_t *dl)
+{
+	int kind;
+
+	sched->prio = prio;
+	sched->runtime = 0;
+	sched->deadline = 0;
+	sched->period = 0;
+	if(str == NULL)
+	{
+		sched->policy = (prio == 0) ? SCHED_OTHER : SCHED_FIFO;
+		return DEF_RET_OK;
+	}
+
+	for(kind = 0; kind < sizeof(ProcSchedPolicyName) / sizeof(ProcSchedPolicyName[0]); kind++)
+	{
+		if(strcmp(str, ProcSchedPolicyName[kind].name) == 0)
+		{
+			break;
+		}
+	}
+	if(kind >= sizeof(ProcSchedPolicyName) / sizeof(ProcSchedPolicyName[0]))
+	{
+		return DEF_RET_NG;
+	}
+	sched->policy = ProcSchedPolicyName[kind].policy;
+
+	switch(sched->policy)
+	{
+	case SCHED_FIFO:
+	case SCHED_RR:
+		return (prio >= 1 && prio <= 99) ? DEF_RET_OK : DEF_RET_NG;
+	case SCHED_DEADLINE:
+		sched->runtime = dl[0] * 1000;
+		sched->period = dl[2] * 1000;
+		sched->deadline = (dl[1] == 0) ? sched->period : dl[1] * 1000;
+		if(prio != 0 || sched->cpu_num > 0 || sched->runtime < DEF_PSCHED_DL_MIN ||
+			sched->runtime > sched->deadline || sched->deadline > sched->period)
+		{
+			return DEF_RET_NG;
+		}
+		return DEF_RET_OK;
+	default:
+		return (prio == 0) ? DEF_RET_OK : DEF_RET_NG;
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   スレッド毎の設定解析
+ * @note    "<スレッド名>:<policy>[:<prio または 実行時間/相対デッドライン/周期[us]>[:<cpu>]]"．
+ *          スレッド名はpthread_setname_np()等で設定した名前(/proc/<pid>/task/<tid>/comm)．
+ * @param   引数  : thread	設定先
+ * @param   引数  : str		process.confのthreadの1項目
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ProcSchedParseThread(procSchedThread *thread, const char *str)
+{
+	char buf[DEF_PSCHED_LIST_LEN];
+	char *field[4] = { NULL, NULL, NULL, NULL };
+	char *save = NULL;
+	uint64_t dl[3] = { 0, 0, 0 };
+	int prio = 0;
+	int num = 0;
+
+	memset(thread, 0, sizeof(*thread));
+	if(strlen(str) >= sizeof(buf))
+	{
+		return DEF_RET_NG;
+	}
+	strcpy(buf, str);
+	for(char *p = strtok_r(buf, ":", &save); p != NULL && num < 4; p = strtok_r(NULL, ":", &save))
+	{
+		field[num++] = p;
+	}
+	if(num < 2 || strlen(field[0]) >= sizeof(thread->comm))
+	{
+		return DEF_RET_NG;
+	}
+	strcpy(thread->comm, field[0]);
+
+	if(ProcSchedParseCpu(&thread->sched, field[3]) != DEF_RET_OK)
+	{
+		return DEF_RET_NG;
+	}
+	if(field[2] != NULL && strchr(field[2], '/') != NULL)
+	{
+		if(sscanf(field[2], "%" SCNu64 "/%" SCNu64 "/%" SCNu64, &dl[0], &dl[1], &dl[2]) != 3)
+		{
+			return DEF_RET_NG;
+		}
+	}
+	else if(field[2] != NULL)
+	{
+		prio = atoi(field[2]);
+	}
+	return ProcSchedParsePolicy(&thread->sched, field[1], prio, dl);
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPU割り当て・スケジューリングポリシー設定
+ * @note    システムコールのみで構成する(clone(CLONE_VM|CLONE_VFORK)の子プロセスから呼び出す)．
+ *          SCHED_DEADLINEは子プロセスのfork，スレッド生成を可能にするため
+ *          SCHED_FLAG_RESET_ON_FORKを付ける(生成されたスレッドはSCHED_OTHERになる)．
+ *          sched_setattrが無いカーネル(番号が不明なアーキテクチャを含む)では
+ *          SCHED_DEADLINE以外をsched_setschedulerで設定する．
+ * @param   引数  : tid		スレッドID(0:呼び出し元)
+ * @param   引数  : sched	設定
+ * @param   引数  : step	失敗した処理
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] sched_setattrの番号をアーキテクチャ毎に定義
+ */
+/*============================================================================*/
+int ProcSchedApply(int tid, const procSched *sched, const char **step)
+{
+	struct sched_param param;
+	procSchedAttr attr;
+	cpu_set_t set;
+
+	//cpu割り当て
+	if(sched->cpu_num > 0)
+	{
+		CPU_ZERO(&set);
+		for(int i = 0; i < DEF_PSCHED_CPU_MAX; i++)
+		{
+			if(sched->cpus[i / 64] & (1ULL << (i % 64)))
+			{
+				CPU_SET(i, &set);
+			}
+		}
+		if(sched_setaffinity(tid, sizeof(set), &set) != 0)
+		{
+			*step = "sched_setaffinity";
+			return DEF_RET_NG;
+		}
+	}
+
+	//スケジューリングポリシー
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.sched_policy = (uint32_t)sched->policy;
+	attr.sched_priority = (uint32_t)sched->prio;
+	if(sched->policy == SCHED_DEADLINE)
+	{
+		attr.sched_flags = SCHED_FLAG_RESET_ON_FORK;
+		attr.sched_runtime = sched->runtime;
+		attr.sched_deadline = sched->deadline;
+		attr.sched_period = sched->period;
+	}
+#ifdef SYS_sched_setattr
+	if(syscall(SYS_sched_setattr, tid, &attr, 0) == 0)
+	{
+		return DEF_RET_OK;
+	}
+#else
+	errno = ENOSYS;
+#endif
+	if(errno == ENOSYS && sched->policy != SCHED_DEADLINE)
+	{
+		param.sched_priority = sched->prio;
+		if(sched_setscheduler(tid, sched->policy, &param) == 0)
+		{
+			return DEF_RET_OK;
+		}
+	}
+	*step = "sched_setattr";
+	return DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   スレッド毎の設定
+ * @note    /proc/<pid>/task/<tid>/commがthreadと一致するスレッドに設定する．
+ *          設定済みのスレッドは記録して再設定しない．一致しないスレッドは
+ *          生成後に名前を付ける場合があるため毎回確認する．
+ * @param   引数  : pid		プロセスID
+ * @param   引数  : thread	スレッド毎の設定
+ * @param   引数  : num		threadの数
+ * @param   引数  : task	設定済みスレッド(プロセス起動時に0クリアすること)
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+void ProcSchedThreads(int pid, const procSchedThread *thread, int num, procSchedTask *task)
+{
+	char path[64];
+	char comm[DEF_PSCHED_COMM_LEN + 1];
+	const char *step = "";
+	struct dirent *ent;
+	procSchedTask prev;
+	DIR *dir;
+	int done;
+	int tid;
+	int len;
+	int fd;
+	int n;
+
+	if(num <= 0 || pid <= 0)
+	{
+		return;
+	}
+	snprintf(path, sizeof(path), "/proc/%d/task", pid);
+	dir = opendir(path);
+	if(dir == NULL)
+	{
+		return;
+	}
+
+	//終了したスレッドを除くため作り直す
+	prev = *task;
+	task->num = 0;
+	while((ent = readdir(dir)) != NULL && task->num < DEF_PSCHED_TID_MAX)
+	{
+		if(ent->d_name[0] < '0' || ent->d_name[0] > '9')
+		{
+			continue;
+		}
+		tid = atoi(ent->d_name);
+		for(done = 0; done < prev.num && prev.tid[done] != tid; done++);
+		if(done < prev.num)
+		{
+			task->tid[task->num++] = tid;
+			continue;
+		}
+
+		snprintf(path, sizeof(path), "/proc/%d/task/%d/comm", pid, tid);
+		fd = open(path, O_RDONLY | O_CLOEXEC);
+		if(fd < 0)
+		{
+			continue;
+		}
+		len = (int)read(fd, comm, sizeof(comm) - 1);
+		close(fd);
+		comm[(len > 0) ? len - 1 : 0] = '\0';	/* 末尾の改行 */
+
+		for(n = 0; n < num && !ProcSchedMatch(&thread[n], comm); n++);
+		if(n >= num)
+		{
+			continue;
+		}
+		if(ProcSchedApply(tid, &thread[n].sched, &step) != DEF_RET_OK)
+		{
+			dprintf(ERROR, "%s failed. pid = %d, tid = %d(%s), errno = %d\n", step, pid, tid, comm, errno);
+		}
+		else
+		{
+			dprintf(INFO, "pid = %d, tid = %d(%s) policy = %d, prio = %d\n", pid, tid, comm,
+				thread[n].sched.policy, thread[n].sched.prio);
+		}
+		task->tid[task->num++] = tid;	/* 失敗しても繰り返さない */
+	}
+	closedir(dir);
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPUマスク設定
+ * @param   引数  : sched	設定先
+ * @param   引数  : mask	CPU毎の有無
+ * @param   引数  : num		maskの要素数
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcSchedMask(procSched *sched, const uint8_t *mask, int num)
+{
+	for(int i = 0; i < num && i < DEF_PSCHED_CPU_MAX; i++)
+	{
+		if(mask[i])
+		{
+			sched->cpus[i / 64] |= 1ULL << (i % 64);
+			sched->cpu_num++;
+		}
+	}
+	return (sched->cpu_num > 0) ? DEF_RET_OK : DEF_RET_NG;
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPUリストファイル読み込み
+ * @param   引数  : path	sysfsのファイル
+ * @param   引数  : mask	CPU毎の有無
+ * @return  戻り値: int(DEF_RET_NG:ファイルが無い)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcSchedReadList(const char *path, uint8_t *mask)
+{
+	procfsFile file = COM_PROCFS_FILE(path);
+	char list[DEF_PSCHED_LIST_LEN];
+	int len;
+
+	memset(mask, 0, DEF_PSCHED_CPU_MAX);
+	len = com_procfs_read(&file, list, sizeof(list));
+	com_procfs_close(&file);
+	if(len < 0)
+	{
+		return DEF_RET_NG;
+	}
+	//空ファイルは該当CPUなし
+	return (com_procfs_cpulist(list, mask, DEF_PSCHED_CPU_MAX) < 0) ? DEF_RET_NG : DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   スレッド名の比較
+ * @param   引数  : thread	スレッド毎の設定
+ * @param   引数  : comm	スレッド名
+ * @return  戻り値: int(1:一致)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ProcSchedMatch(const procSchedThread *thread, const char *comm)
+{
+	size_t len = strlen(thread->comm);
+
+	if(len > 0 && thread->comm[len - 1] == '*')
+	{
+		return strncmp(thread->comm, comm, len - 1) == 0;
+	}
+	return strcmp(thread->comm, comm) == 0;
+}
@@ -0,0 +1,239 @@
+/*============================================================================*/
+/*
+ * @file    reshist.c
+ * @brief   リソース履歴
+ * @note    最も細かい段(段0)はリソース監視の値が更新された時にそのまま記録し，
+ *          上の段は下の段の値を周期毎にまとめて最小・平均・最大を記録する．
+ *          共有メモリは全体を書き直さず，更新した値とヘッダのみを書き込む．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "com_shmem.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "resource.h"
+#include "reshist.h"
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _histAcc{				/* 上の段にまとめる途中の値 */
+	uint64_t bucket;					/* 周期番号(時刻/周期) */
+	int64_t sum[HIST_KIND_MAX];			/* 合計 */
+	int32_t min[HIST_KIND_MAX];
+	int32_t max[HIST_KIND_MAX];
+	int32_t num;						/* まとめた値の数(段0換算) */
+} histAcc;
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static resHist HistHead;				/* 共有メモリのヘッダ */
+static histAcc HistAcc[DEF_HIST_LEVEL_MAX];	/* [n]:段nにまとめる途中の値(n>=1) */
+static const int32_t HistLen[DEF_HIST_LEVEL_MAX] = { DEF_HIST_L0_LEN, DEF_HIST_L1_LEN, DEF_HIST_L2_LEN };
+static const int32_t HistPeriod[DEF_HIST_LEVEL_MAX] = { DEF_HIST_L1_PERIOD, DEF_HIST_L1_PERIOD, DEF_HIST_L2_PERIOD };	/* [0]:初期値(HistUpdate()で更新) */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static void HistSample(const resourceStat *stat, int32_t *value);
+static void HistAdd(int level, const histAcc *src);
+static void HistPut(int id, int level, const histValue *value, uint64_t now);
+
+/*============================================================================*/
+/*
+ * @brief   リソース履歴初期化処理
+ * @note    共有メモリのサイズを設定する．
+ *          com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int HistInit(void)
+{
+	int offset = 0;
+
+	memset(&HistHead, 0, sizeof(HistHead));
+	memset(HistAcc, 0, sizeof(HistAcc));
+	HistHead.kind_num = HIST_KIND_MAX;
+	HistHead.level_num = DEF_HIST_LEVEL_MAX;
+	for(int level = 0; level < DEF_HIST_LEVEL_MAX; level++)
+	{
+		HistHead.ring[level].period = HistPeriod[level];
+		HistHead.ring[level].len = HistLen[level];
+		HistHead.ring[level].offset = offset;
+		offset += HistLen[level];
+	}
+
+	//共有メモリサイズを設定
+	com_shmem_set_size(DEF_HIST_SHMEM_NAME, DEF_HIST_SIZE);
+	dprintf(INFO, "%s size = %d\n", DEF_HIST_SHMEM_NAME, DEF_HIST_SIZE);
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   リソース履歴更新処理
+ * @note    現在のリソース監視の値を段0に記録し，周期が切り替わった段に
+ *          まとめた値を記録する．
+ *          同じ値を重ねて記録しないよう，リソース監視の値を取得した後にのみ
+ *          呼び出すこと．
+ * @param   引数  : id		共有メモリID(DEF_HIST_SHMEM_NAME)
+ * @param   引数  : stat	リソース監視情報
+ * @param   引数  : period	段0の周期[ms](最も短い取得周期)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 段0は取得値の更新時のみ記録する
+ */
+/*============================================================================*/
+int HistUpdate(int id, const resourceStat *stat, int period)
+{
+	struct timespec ts;
+	uint64_t now;
+	int32_t value[HIST_KIND_MAX];
+	histValue entry[HIST_KIND_MAX];
+	histAcc sample;
+	histAcc *acc;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	HistHead.ring[0].period = period;
+
+	//段0：現在値
+	HistSample(stat, value);
+	for(int kind = 0; kind < HIST_KIND_MAX; kind++)
+	{
+		entry[kind].min = entry[kind].avg = entry[kind].max = value[kind];
+		sample.sum[kind] = value[kind];
+		sample.min[kind] = value[kind];
+		sample.max[kind] = value[kind];
+	}
+	sample.num = 1;
+	HistPut(id, 0, entry, now);
+
+	//上の段：周期が切り替わったらまとめた値を記録し，次の段に加える
+	for(int level = 1; level < DEF_HIST_LEVEL_MAX; level++)
+	{
+		acc = &HistAcc[level];
+		if(acc->num > 0 && acc->bucket != now / HistPeriod[level])
+		{
+			for(int kind = 0; kind < HIST_KIND_MAX; kind++)
+			{
+				entry[kind].min = acc->min[kind];
+				entry[kind].avg = (int32_t)(acc->sum[kind] / acc->num);
+				entry[kind].max = acc->max[kind];
+			}
+			HistPut(id, level, entry, now);
+			if(level + 1 < DEF_HIST_LEVEL_MAX)
+			{
+				HistAdd(level + 1, acc);
+			}
+			acc->num = 0;
+		}
+		if(level == 1)
+		{
+			HistAdd(level, &sample);
+		}
+		acc->bucket = now / HistPeriod[level];
+	}
+
+	//ヘッダ(書き込み位置・件数)
+	return com_shmem_write_part(id, 0, &HistHead, sizeof(HistHead));
+}
+
+/*============================================================================*/
+/*
+ * @brief   履歴の項目取得
+ * @param   引数  : stat	リソース監視情報
+ * @param   引数  : value	項目毎の値(enum hist_kind)
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void HistSample(const resourceStat *stat, int32_t *value)
+{
+	int32_t util = 0;
+
+	value[HIST_KIND_CPU] = stat->cpu_load[0];
+	value[HIST_KIND_MEM] = stat->mem_load;
+	value[HIST_KIND_DISK] = stat->disk_load;
+	value[HIST_KIND_THERM] = stat->cpu_therm;
+	value[HIST_KIND_PSI_CPU] = stat->psi[RES_PSI_CPU].some_avg10;
+	value[HIST_KIND_PSI_MEM] = stat->psi[RES_PSI_MEMORY].some_avg10;
+	value[HIST_KIND_PSI_IO] = stat->psi[RES_PSI_IO].some_avg10;
+	for(int i = 0; i < stat->disk_num && i < DEF_RES_DISK_MAX; i++)
+	{
+		if(stat->disk[i].util > util)
+		{
+			util = stat->disk[i].util;
+		}
+	}
+	value[HIST_KIND_DISK_UTIL] = util;
+}
+
+/*============================================================================*/
+/*
+ * @brief   まとめる途中の値に加える
+ * @param   引数  : level	加える段
+ * @param   引数  : src		加える値
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void HistAdd(int level, const histAcc *src)
+{
+	histAcc *acc = &HistAcc[level];
+
+	for(int kind = 0; kind < HIST_KIND_MAX; kind++)
+	{
+		if(acc->num == 0 || src->min[kind] < acc->min[kind])
+		{
+			acc->min[kind] = src->min[kind];
+		}
+		if(acc->num == 0 || src->max[kind] > acc->max[kind])
+		{
+			acc->max[kind] = src->max[kind];
+		}
+		acc->sum[kind] = (acc->num == 0) ? src->sum[kind] : acc->sum[kind] + src->sum[kind];
+	}
+	acc->num += src->num;
+}
+
+/*============================================================================*/
+/*
+ * @brief   リングバッファへの記録
+ * @param   引数  : id		共有メモリID
+ * @param   引数  : level	段
+ * @param   引数  : value	記録する値(histValue[HIST_KIND_MAX])
+ * @param   引数  : now		時刻[ms]
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void HistPut(int id, int level, const histValue *value, uint64_t now)
+{
+	histRing *ring = &HistHead.ring[level];
+	int offset;
+
+	offset = (int)(offsetof(resHist, data) + (ring->offset + ring->head) * HIST_KIND_MAX * sizeof(histValue));
+	com_shmem_write_part(id, offset, (void *)value, HIST_KIND_MAX * sizeof(histValue));
+
+	ring->head = (ring->head + 1) % ring->len;
+	if(ring->count < ring->len)
+	{
+		ring->count++;
+	}
+	ring->stamp = now;
+}
@@ -10,7 +10,10 @@
 /*============================================================================*/
 /* include */
 /*============================================================================*/
+#define _GNU_SOURCE
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <glib.h>
 #include <sys/wait.h>
@@ -20,12 +23,22 @@
 #include <ctype.h>
 #include <errno.h>
 #include <termios.h>
+#include <poll.h>
 #include <sys/ioctl.h>
+#include <time.h>
 #include "com_timer.h"
 #include "com_shmem.h"
+#include "com_procfs.h"
+#include "com_trace.h"
 #include "debug.h"
 #include "hjpf.h"
 #include "resource.h"
+#include "thermal.h"
+#include "kstat.h"
+#include "netstat.h"
+#include "reshist.h"
+#include "schedstat.h"
+#include "process.h"
 #include "gnss.h"
 #include "i2c.h"
 #include "ins.h"
@@ -39,7 +52,9 @@
 /* global */
 /*============================================================================*/
 static resourceInfo ResourceInfo;
-static resourceStat ResourceStat;
+static resourceStat *ResourceStat = NULL;
+static int ResourceStatSize = 0;
+static pthread_mutex_t ResourceStatMutex = PTHREAD_MUTEX_INITIALIZER;	//ResourceStatの更新・書き込み(監視周期とPSIトリガ待ちスレッド)
 extern int gComm_StopFlg;
 extern pthread_mutex_t g_mutex;   
 static resUARTInfo	g_uartGNSS;
@@ -65,22 +80,42 @@ static confSectionTbl ConfSectionTble[RES_KIND_MAX] = {
 	{RES_KIND_MEM_LOAD, "mem_load"},
 	{RES_KIND_DISK_LOAD, "disk_load"},
 	{RES_KIND_CPU_THERM, "cpu_therm"},
+	{RES_KIND_PSI, DEF_RES_PSI_SECTION},
+	{RES_KIND_KSTAT, "kstat"},
+	{RES_KIND_NET, "net"},
+	{RES_KIND_SCHED, "schedstat"},
+	{RES_KIND_HIST, "hist"},
 };
 
+static const char *ResPSIName[RES_PSI_MAX] = { "cpu", "memory", "io" };
+static procfsFile ResPSIFile[RES_PSI_MAX] = {
+	COM_PROCFS_FILE(DEF_RES_PSI_PATH "cpu"),
+	COM_PROCFS_FILE(DEF_RES_PSI_PATH "memory"),
+	COM_PROCFS_FILE(DEF_RES_PSI_PATH "io"),
+};
+static char ResPSITrigger[RES_PSI_MAX][DEF_STR_MAX];	//トリガ設定("some 150000 1000000"等)
+static int ResPSITriggerFd[RES_PSI_MAX] = { -1, -1, -1 };
+static int ResDiskAuto = 1;										//1:ブロックデバイスを自動で選ぶ
+static uint64_t ResDiskPrev[DEF_RES_DISK_MAX][DISKSTATS_KIND_MAX];	//前回の/proc/diskstats
+static uint8_t ResDiskSeen[DEF_RES_DISK_MAX];					//1:前回値あり
+static uint64_t ResDiskPrevTime = 0;							//前回取得時刻[ms]
+static int32_t ResAdaptCpuThresh[DEF_RES_CPU_MAX + 1];			//適応周期:CPU毎の故障閾値[%]([0]:全体，[n]:CPU n-1)
+static uint8_t ResHistNew = 0;									//1:履歴に未記録の取得値あり(ResourceStatMutex)
+
 static resThreadInfo g_res_threadInfo[] = {
-	{ GNSSMain, &g_uartGNSS, -1, &g_uartGNSSRun},
-	{ ins_serial_main, &g_uartINS, -1, &g_uartINSRun},
-	{ imu_serial_main, &g_uartIMU, -1, &g_uartIMURun},
-	{ altmt_serial_main, &g_uartALTMT, -1, &g_uartALTMTRun},
-	{ i2c_main, &g_i2cBME_HMC, -1, &g_i2cBME_HMCRun},
-	{ ping_main, &g_Ping, -1, &g_PingRun},
-	{ MavlinkMain, &g_Mavlink, -1, &g_MavlinkRun},
-	{ CameraMain, &g_Camera[0], -1, &g_CameraRun[0]},
-	{ CameraMain, &g_Camera[1], -1, &g_CameraRun[1]},
-	{ CameraMain, &g_Camera[2], -1, &g_CameraRun[2]},
-	{ CameraMain, &g_Camera[3], -1, &g_CameraRun[3]},
-	{ CameraMain, &g_Camera[4], -1, &g_CameraRun[4]},
-	{ CameraMain, &g_Camera[5], -1, &g_CameraRun[5]},
+	{ GNSSMain, &g_uartGNSS, -1, &g_uartGNSSRun, "hjpf_gnss"},
+	{ ins_serial_main, &g_uartINS, -1, &g_uartINSRun, "hjpf_ins"},
+	{ imu_serial_main, &g_uartIMU, -1, &g_uartIMURun, "hjpf_imu"},
+	{ altmt_serial_main, &g_uartALTMT, -1, &g_uartALTMTRun, "hjpf_altmt"},
+	{ i2c_main, &g_i2cBME_HMC, -1, &g_i2cBME_HMCRun, "hjpf_i2c"},
+	{ ping_main, &g_Ping, -1, &g_PingRun, "hjpf_ping"},
+	{ MavlinkMain, &g_Mavlink, -1, &g_MavlinkRun, "hjpf_mavlink"},
+	{ CameraMain, &g_Camera[0], -1, &g_CameraRun[0], "hjpf_camera0"},
+	{ CameraMain, &g_Camera[1], -1, &g_CameraRun[1], "hjpf_camera1"},
+	{ CameraMain, &g_Camera[2], -1, &g_CameraRun[2], "hjpf_camera2"},
+	{ CameraMain, &g_Camera[3], -1, &g_CameraRun[3], "hjpf_camera3"},
+	{ CameraMain, &g_Camera[4], -1, &g_CameraRun[4], "hjpf_camera4"},
+	{ CameraMain, &g_Camera[5], -1, &g_CameraRun[5], "hjpf_camera5"},
 };
 
 /*============================================================================*/
@@ -88,8 +123,19 @@ static resThreadInfo g_res_threadInfo[] = {
 /*============================================================================*/
 static int ResCPUTherm(void);
 static int ResDiskLoad(void);
+static int ResDiskStats(void);
+static int ResDiskSlot(const char *name, int len);
+static int32_t ResDiskRate(uint64_t curr, uint64_t prev, uint64_t mul, uint64_t div);
 static int ResMemLoad(void);
 static int ResCPULoad(void);
+static int ResPSILoad(void);
+static int32_t ResPSIPercent(const char *str, const char *end);
+static void ResPSIInit(void);
+static void* ResPSIWait(void *arg);
+static void ResDiskConf(GKeyFile *file);
+static void ResAdaptConf(GKeyFile *file);
+static int32_t ResAdaptValue(int kind);
+static void ResAdaptPeriod(int kind, uint64_t time);
 static int ResReadFile(char filename[]);
 static int ResCheckDevice(char* ResGroupName);
 
@@ -107,29 +153,23 @@ static int ResCheckDevice(char* ResGroupName);
  *                  
  * @return  戻り値: int
  * @date    2023/11/27 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] ファイルを開いたまま読み込むよう変更
  */
 /*============================================================================*/
 static int ResCPUTherm(void)
 {
-	int ret = DEF_RET_OK;
-	int fd;
-	char str[DEF_STR_MAX];
+	static procfsFile file = COM_PROCFS_FILE(DEF_RES_THERM_PATH);
+	int64_t temp;
 	
 	//GPU温度を取得
-	fd = open("/sys/devices/virtual/thermal/thermal_zone0/temp", O_RDONLY);
-	if(fd == -1)
-	{
-dprintf(ERROR, "gpu load failed.\n");
-		ret = DEF_RET_NG;
-	}
-	else
+	if(com_procfs_read_i64(&file, &temp) != 0)
 	{
-		read(fd, str, sizeof(str));
-		ResourceStat.cpu_therm = strtol(str, NULL, DEF_DECIMAL);
+		dprintf(ERROR, "gpu load failed.\n");
+		return DEF_RET_NG;
 	}
-	close(fd);
+	ResourceStat->cpu_therm = (int)temp;
 	
-	return ret;
+	return DEF_RET_OK;
 }
 
 /*============================================================================*/
@@ -140,44 +180,215 @@ dprintf(ERROR, "gpu load failed.\n");
  *                  
  * @return  戻り値: int
  * @date    2023/11/27 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] dfコマンドからstatvfs()に変更
+ *          2026/10/19 [0.0.3] 全マウントポイントの使用量とブロックデバイス毎のI/Oを追加
  */
 /*============================================================================*/
 static int ResDiskLoad(void)
 {
-	int ret = DEF_RET_OK;
-	char str[DEF_STR_MAX];
-	FILE *fp;
+	resMountStat *mount;
+	int ok = 0;
+	int usage;
 	
-	char filesystem[DEF_STR_MAX];
-	char use[DEF_STR_MAX];
-	int blocks, used, available;
+	//マウントポイント毎の使用量(disk_loadはその最大値)
+	ResourceStat->disk_load = 0;
+	for(int i = 0; i < ResourceStat->mount_num; i++)
+	{
+		mount = &ResourceStat->mount[i];
+		if(com_procfs_disk_usage(mount->path, &usage) != 0)
+		{
+			mount->usage = -1;
+			continue;
+		}
+		mount->usage = usage;
+		if(usage > ResourceStat->disk_load)
+		{
+			ResourceStat->disk_load = usage;
+		}
+		ok++;
+	}
 	
-	//dfコマンド結果を取得
-	fp = popen("df", "r");
-	if(fp == NULL)
+	//ブロックデバイス毎のI/O
+	if(ResDiskStats() == DEF_RET_OK)
 	{
-dprintf(ERROR, "mem load failed.\n");
-		ret = DEF_RET_NG;
+		ok++;
 	}
-	else
+	
+	if(ok == 0)
 	{
-		//ディスク使用量を取得
-		fgets(str, sizeof(str), fp);
-		fgets(str, sizeof(str), fp);
-		sscanf(str, "%s %d %d %d %s",
-					filesystem,
-					&blocks,
-					&used,
-					&available,
-					use
-		);
-		
-		ResourceStat.disk_load = strtol(use, NULL, DEF_DECIMAL);
+		dprintf(ERROR, "disk load failed.\n");
+		return DEF_RET_NG;
 	}
 	
-	pclose(fp);
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ブロックデバイスI/O取得処理
+ * @note    /proc/diskstatsの前回との差分から，デバイス毎のIOPS・転送量・
+ *          平均所要時間・平均キュー長・稼働率を求める．
+ *          "   8       0 sda 1234 5 6789 100 ..."形式(主番号，副番号，デバイス名，
+ *          以降はenum diskstats_kindの順)．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ResDiskStats(void)
+{
+	static procfsFile file = COM_PROCFS_FILE("/proc/diskstats");
+	static char buf[DEF_RES_DISKSTATS_BUF_MAX];
+	uint64_t val[DISKSTATS_KIND_MAX];
+	const uint64_t *prev;
+	resDiskStat *disk;
+	procfsScan scan;
+	struct timespec ts;
+	const char *name;
+	uint64_t now;
+	uint64_t interval = 0;
+	uint64_t ios;
+	int slot;
+	int len;
+	int cnt;
 	
-	return ret;
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
+	{
+		dprintf(ERROR, "/proc/diskstats read failed.\n");
+		return DEF_RET_NG;
+	}
+	
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	if(ResDiskPrevTime != 0 && now > ResDiskPrevTime)
+	{
+		interval = now - ResDiskPrevTime;
+	}
+	ResDiskPrevTime = now;
+	
+	com_procfs_scan_init(&scan, buf, len);
+	do
+	{
+		//主番号，副番号を読み飛ばし，デバイス名
+		if(com_procfs_scan_skip(&scan, 2) != 2 || (len = com_procfs_scan_word(&scan, &name)) == 0)
+		{
+			continue;
+		}
+		slot = ResDiskSlot(name, len);
+		if(slot < 0)
+		{
+			continue;
+		}
+		for(cnt = 0; cnt < DISKSTATS_KIND_MAX && com_procfs_scan_u64(&scan, &val[cnt]) == 0; cnt++);
+		if(cnt < DISKSTATS_KIND_MAX)
+		{
+			continue;
+		}
+		
+		disk = &ResourceStat->disk[slot];
+		prev = ResDiskPrev[slot];
+		disk->inflight = (int32_t)val[DISKSTATS_KIND_IN_FLIGHT];
+		if(ResDiskSeen[slot] && interval > 0)
+		{
+			//回数・転送量(セクタは512byte)
+			disk->rd_iops = ResDiskRate(val[DISKSTATS_KIND_RD_IOS], prev[DISKSTATS_KIND_RD_IOS], 1000, interval);
+			disk->wr_iops = ResDiskRate(val[DISKSTATS_KIND_WR_IOS], prev[DISKSTATS_KIND_WR_IOS], 1000, interval);
+			disk->rd_kbps = ResDiskRate(val[DISKSTATS_KIND_RD_SECTORS], prev[DISKSTATS_KIND_RD_SECTORS], 1000, interval * 2);
+			disk->wr_kbps = ResDiskRate(val[DISKSTATS_KIND_WR_SECTORS], prev[DISKSTATS_KIND_WR_SECTORS], 1000, interval * 2);
+			
+			//1回あたりの所要時間[ms]→[us]
+			ios = val[DISKSTATS_KIND_RD_IOS] - prev[DISKSTATS_KIND_RD_IOS];
+			disk->rd_await = ResDiskRate(val[DISKSTATS_KIND_RD_TICKS], prev[DISKSTATS_KIND_RD_TICKS], 1000, ios);
+			ios = val[DISKSTATS_KIND_WR_IOS] - prev[DISKSTATS_KIND_WR_IOS];
+			disk->wr_await = ResDiskRate(val[DISKSTATS_KIND_WR_TICKS], prev[DISKSTATS_KIND_WR_TICKS], 1000, ios);
+			ios += val[DISKSTATS_KIND_RD_IOS] - prev[DISKSTATS_KIND_RD_IOS];
+			disk->svctm = ResDiskRate(val[DISKSTATS_KIND_IO_TICKS], prev[DISKSTATS_KIND_IO_TICKS], 1000, ios);
+			
+			//平均キュー長・稼働率(経過時間に対する割合)
+			disk->queue = ResDiskRate(val[DISKSTATS_KIND_QUEUE_TICKS], prev[DISKSTATS_KIND_QUEUE_TICKS], 100, interval);
+			disk->util = ResDiskRate(val[DISKSTATS_KIND_IO_TICKS], prev[DISKSTATS_KIND_IO_TICKS], 100, interval);
+			if(disk->util > 100)
+			{
+				disk->util = 100;
+			}
+		}
+		memcpy(ResDiskPrev[slot], val, sizeof(val));
+		ResDiskSeen[slot] = 1;
+	} while(com_procfs_scan_line(&scan));
+	
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ブロックデバイスの格納位置取得
+ * @note    設定ファイルにdeviceが無い場合は，ディスク全体(/sys/block配下)を
+ *          見つけた順に追加する．loop，ram，zramは対象外．
+ * @param   引数  : name	デバイス名
+ * @param   引数  : len		デバイス名の長さ
+ * @return  戻り値: 格納位置，-1:対象外
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ResDiskSlot(const char *name, int len)
+{
+	char path[64];
+	int slot;
+	
+	if(len >= DEF_RES_DISK_NAME_LEN)
+	{
+		return -1;
+	}
+	for(slot = 0; slot < ResourceStat->disk_num; slot++)
+	{
+		if(strncmp(ResourceStat->disk[slot].name, name, len) == 0 && ResourceStat->disk[slot].name[len] == '\0')
+		{
+			return slot;
+		}
+	}
+	
+	//自動で追加
+	if(!ResDiskAuto || ResourceStat->disk_num >= DEF_RES_DISK_MAX)
+	{
+		return -1;
+	}
+	if(strncmp(name, "loop", 4) == 0 || strncmp(name, "ram", 3) == 0 || strncmp(name, "zram", 4) == 0)
+	{
+		return -1;
+	}
+	snprintf(path, sizeof(path), "/sys/block/%.*s", len, name);
+	if(access(path, F_OK) != 0)
+	{
+		return -1;
+	}
+	slot = ResourceStat->disk_num++;
+	memcpy(ResourceStat->disk[slot].name, name, len);
+	ResourceStat->disk[slot].name[len] = '\0';
+	ResDiskSeen[slot] = 0;
+	dprintf(INFO, "disk[%d] = %s\n", slot, ResourceStat->disk[slot].name);
+	return slot;
+}
+
+/*============================================================================*/
+/*
+ * @brief   差分の比率計算
+ * @note    (curr - prev) * mul / divを求める．divが0または値が戻った場合は0．
+ * @param   引数  : curr	今回の累計値
+ * @param   引数  : prev	前回の累計値
+ * @param   引数  : mul		乗数
+ * @param   引数  : div		除数
+ * @return  戻り値: 比率
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int32_t ResDiskRate(uint64_t curr, uint64_t prev, uint64_t mul, uint64_t div)
+{
+	if(div == 0 || curr < prev)
+	{
+		return 0;
+	}
+	return (int32_t)((curr - prev) * mul / div);
 }
 
 
@@ -189,114 +400,806 @@ dprintf(ERROR, "mem load failed.\n");
  *                  
  * @return  戻り値: int
  * @date    2023/11/27 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 行位置ではなく項目名で取得するよう変更
  */
 /*============================================================================*/
 static int ResMemLoad(void)
 {
-	int ret = DEF_RET_OK;
-	double mem_stat[MEMINFO_KIND_MAX];
-	char str[DEF_STR_MAX];
-	int j;
-	FILE *fp;
+	static procfsFile file = COM_PROCFS_FILE("/proc/meminfo");
+	static char buf[DEF_RES_PROCBUF_MAX];
+	static const char *key[MEMINFO_KIND_MAX] = {
+		"MemTotal:", "MemFree:", "MemAvailable:", "Buffers:", "Cached:"
+	};
+	uint64_t mem_stat[MEMINFO_KIND_MAX] = { 0 };
+	procfsScan scan;
+	int found = 0;
+	int len;
 	
 	// /proc/meminfoを取得
-	fp = fopen("/proc/meminfo", "r");
-	if(fp == NULL)
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
 	{
-dprintf(ERROR, "mem load failed.\n");
-		ret = DEF_RET_NG;
+		dprintf(ERROR, "mem load failed.\n");
+		return DEF_RET_NG;
 	}
-	else
+	
+	//必要情報を取得
+	com_procfs_scan_init(&scan, buf, len);
+	do
 	{
-		//必要情報を取得
 		for(int i = 0; i < MEMINFO_KIND_MAX; i++)
 		{
-			fgets(str, sizeof(str), fp);
-			
-			j = 0;
-			while(!isdigit(str[j]))
+			if(com_procfs_scan_key(&scan, key[i]))
 			{
-				j++;
+				com_procfs_scan_u64(&scan, &mem_stat[i]);
+				found++;
+				break;
 			}
-			
-			mem_stat[i] = strtol(str + j, NULL, DEF_DECIMAL);
 		}
-		
-		//メモリ使用量を計算
-		ResourceStat.mem_load = (mem_stat[MEMINFO_KIND_TOTAL] - mem_stat[MEMINFO_KIND_FREE] 
-						- mem_stat[MEMINFO_KIND_BUF] - mem_stat[MEMINFO_KIND_CASHE]) * 100 / mem_stat[MEMINFO_KIND_TOTAL];
+	} while(found < MEMINFO_KIND_MAX && com_procfs_scan_line(&scan));
+	
+	if(mem_stat[MEMINFO_KIND_TOTAL] == 0)
+	{
+		dprintf(ERROR, "mem load failed. MemTotal not found.\n");
+		return DEF_RET_NG;
 	}
 	
-	fclose(fp);
+	//メモリ使用量を計算
+	ResourceStat->mem_load = (mem_stat[MEMINFO_KIND_TOTAL] - mem_stat[MEMINFO_KIND_FREE] 
+					- mem_stat[MEMINFO_KIND_BUF] - mem_stat[MEMINFO_KIND_CASHE]) * 100 / mem_stat[MEMINFO_KIND_TOTAL];
 	
-	return ret;
+	return DEF_RET_OK;
 }
 
 /*============================================================================*/
 /*
  * @brief   CPU負荷取得処理
  * @note    CPU負荷を取得する
+ *          /proc/statの行位置ではなくCPU番号で格納し，オフラインのCPUは負荷0とする．
  * @param   引数  : void
  *                  
  * @return  戻り値: int
  * @date    2023/11/27 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] ファイルを開いたまま読み込み，sscanfを使わないよう変更
+ *          2026/10/19 [0.0.3] CPU数・オンライン状態を動的に取得，64bitカウンタに変更
  */
 /*============================================================================*/
 static int ResCPULoad(void)
 {
-	int ret = DEF_RET_OK;
+	static procfsFile file = COM_PROCFS_FILE("/proc/stat");
+	static procfsFile online = COM_PROCFS_FILE(DEF_RES_CPU_ONLINE);
+	static char buf[DEF_RES_PROCBUF_MAX];
+	static linuxProcStat prev[DEF_RES_CPU_MAX + 1];
+	static uint8_t valid[DEF_RES_CPU_MAX + 1];
+	uint8_t mask[DEF_RES_CPU_MAX];
+	char list[DEF_STR_MAX];
+	linuxProcStat curr;
+	resCPUStat *cpu;
+	procfsScan scan;
+	uint64_t val[10];
+	uint64_t cpuno;
+	uint64_t total, prev_total;
+	uint64_t busy, prev_busy;
+	int num = ResourceStat->cpu_num;
+	int idx;
+	int len;
 	
-	static linuxProcStat prev[DEF_CPU_NUM + 1];
-	linuxProcStat curr[DEF_CPU_NUM + 1];
-	char buf[DEF_STR_MAX];
-	int total;
-	double idle_load;
-	FILE *fp;
+	//オンラインCPUを取得(取得できなければ全CPUオンラインとみなす)
+	if(com_procfs_read(&online, list, sizeof(list)) <= 0 || com_procfs_cpulist(list, mask, DEF_RES_CPU_MAX) < 0)
+	{
+		memset(mask, 1, sizeof(mask));
+	}
+	ResourceStat->cpu_online = 0;
+	ResourceStat->cpu[0].online = 1;
+	for(int i = 0; i < num; i++)
+	{
+		cpu = &ResourceStat->cpu[i + 1];
+		cpu->online = mask[i];
+		if(mask[i])
+		{
+			ResourceStat->cpu_online++;
+			continue;
+		}
+		//オフライン
+		cpu->load = 0;
+		valid[i + 1] = 0;
+		if(i + 1 <= DEF_CPU_NUM)
+		{
+			ResourceStat->cpu_load[i + 1] = 0;
+		}
+	}
 	
-	// /proc/statをオープン
-	fp = fopen("/proc/stat", "r");
-	if(fp == NULL)
+	// /proc/statを取得
+	len = com_procfs_read(&file, buf, sizeof(buf));
+	if(len <= 0)
 	{
-dprintf(ERROR, "cpu load failed.\n");
-		ret = DEF_RET_NG;
+		dprintf(ERROR, "cpu load failed.\n");
+		return DEF_RET_NG;
 	}
-	else
+	
+	//必要情報を取得("cpu"は全体，"cpuN"はCPU N)
+	com_procfs_scan_init(&scan, buf, len);
+	do
 	{
-		//必要情報を取得
-		for(int i = 0; i < (DEF_CPU_NUM + 1); i++)
-		{
-			fgets(buf, sizeof(buf), fp);
-			sscanf(buf, "%s %d %d %d %d %d %d %d %d %d %d",
-					curr[i].name,
-					&curr[i].user,
-					&curr[i].nice,
-					&curr[i].system,
-					&curr[i].idle,
-					&curr[i].iowait,
-					&curr[i].irq,
-					&curr[i].softirq,
-					&curr[i].steal,
-					&curr[i].guest,
-					&curr[i].guest_nice
-				);
+		if(!com_procfs_scan_key(&scan, "cpu"))
+		{
+			break;
+		}
+		idx = 0;
+		if(*scan.pos != ' ')
+		{
+			if(com_procfs_scan_u64(&scan, &cpuno) != 0 || cpuno >= (uint64_t)num)
+			{
+				continue;
+			}
+			idx = (int)cpuno + 1;
+		}
+		
+		memset(val, 0, sizeof(val));
+		for(int j = 0; j < 10; j++)
+		{
+			if(com_procfs_scan_u64(&scan, &val[j]) != 0)
+			{
+				break;
+			}
+		}
+		curr.user = val[0];
+		curr.nice = val[1];
+		curr.system = val[2];
+		curr.idle = val[3];
+		curr.iowait = val[4];
+		curr.irq = val[5];
+		curr.softirq = val[6];
+		curr.steal = val[7];
+		curr.guest = val[8];
+		curr.guest_nice = val[9];
+		
+		cpu = &ResourceStat->cpu[idx];
+		cpu->user = curr.user;
+		cpu->nice = curr.nice;
+		cpu->system = curr.system;
+		cpu->idle = curr.idle;
+		cpu->iowait = curr.iowait;
+		cpu->irq = curr.irq;
+		cpu->softirq = curr.softirq;
+		cpu->steal = curr.steal;
+		
+		//cpu負荷を計算(idle，iowait以外を使用中とする)
+		total = curr.user + curr.nice + curr.system + curr.idle + curr.iowait + curr.irq + curr.softirq + curr.steal;
+		busy = total - curr.idle - curr.iowait;
+		prev_total = prev[idx].user + prev[idx].nice + prev[idx].system + prev[idx].idle +
+					prev[idx].iowait + prev[idx].irq + prev[idx].softirq + prev[idx].steal;
+		prev_busy = prev_total - prev[idx].idle - prev[idx].iowait;
+		
+		if(valid[idx] && total > prev_total && busy >= prev_busy)
+		{
+			cpu->load = (int32_t)(((busy - prev_busy) * 100 + (total - prev_total) / 2) / (total - prev_total));
+			if(idx <= DEF_CPU_NUM)
+			{
+				ResourceStat->cpu_load[idx] = cpu->load;
+			}
+		}
+		prev[idx] = curr;
+		valid[idx] = 1;
+	} while(com_procfs_scan_line(&scan));
+	
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   CPU構成取得処理
+ * @note    実装CPU数を取得し，リソース共有メモリのサイズを決定する．
+ *          com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ * @param   引数  : void
+ *                  
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ResCPUInit(void)
+{
+	procfsFile file = COM_PROCFS_FILE(DEF_RES_CPU_POSSIBLE);
+	uint8_t mask[DEF_RES_CPU_MAX];
+	char list[DEF_STR_MAX];
+	int num = -1;
+	
+	if(ResourceStat != NULL)
+	{
+		return DEF_RET_OK;
+	}
+	
+	//実装CPU数を取得
+	if(com_procfs_read(&file, list, sizeof(list)) > 0)
+	{
+		num = com_procfs_cpulist(list, mask, DEF_RES_CPU_MAX);
+	}
+	com_procfs_close(&file);
+	if(num <= 0)
+	{
+		num = (int)sysconf(_SC_NPROCESSORS_CONF);
+		dprintf(WARN, "%s read failed. cpu num = %d\n", DEF_RES_CPU_POSSIBLE, num);
+	}
+	if(num <= 0)
+	{
+		num = DEF_CPU_NUM;
+	}
+	if(num > DEF_RES_CPU_MAX)
+	{
+		num = DEF_RES_CPU_MAX;
+	}
+	
+	ResourceStatSize = DEF_RES_STAT_SIZE(num);
+	ResourceStat = calloc(1, ResourceStatSize);
+	if(ResourceStat == NULL)
+	{
+		dprintf(ERROR, "calloc(%d) failed.\n", ResourceStatSize);
+		return DEF_RET_NG;
+	}
+	ResourceStat->cpu_num = num;
+	
+	//共有メモリサイズを設定
+	com_shmem_set_size(DEF_RES_SHMMNG_NAME, ResourceStatSize);
+	dprintf(INFO, "cpu num = %d, %s size = %d\n", num, DEF_RES_SHMMNG_NAME, ResourceStatSize);
+	
+	//温度・冷却・周波数監視，カーネル活動監視，ネットワーク監視，スケジューリング遅延監視，リソース履歴
+	if(ThermInit(num) != DEF_RET_OK || KstatInit(num) != DEF_RET_OK || NetInit() != DEF_RET_OK ||
+		SchedInit() != DEF_RET_OK || HistInit() != DEF_RET_OK)
+	{
+		return DEF_RET_NG;
+	}
+	return DEF_RET_OK;
+}
+
+
+/*============================================================================*/
+/*
+ * @brief   PSI取得処理
+ * @note    /proc/pressure/{cpu,memory,io}を取得する．
+ *          "some avg10=0.12 avg60=0.05 avg300=0.01 total=12345"形式(fullも同形式)．
+ * @param   引数  : void
+ *                  
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ResPSILoad(void)
+{
+	char buf[DEF_STR_MAX];
+	procfsScan scan;
+	resPSIStat *psi;
+	const char *word;
+	const char *eq;
+	uint64_t total;
+	int full;
+	int len;
+	int num = 0;
+	
+	for(int i = 0; i < RES_PSI_MAX; i++)
+	{
+		len = com_procfs_read(&ResPSIFile[i], buf, sizeof(buf));
+		if(len <= 0)
+		{
+			continue;
+		}
+		num++;
+		
+		psi = &ResourceStat->psi[i];
+		com_procfs_scan_init(&scan, buf, len);
+		do
+		{
+			if(com_procfs_scan_key(&scan, "some"))
+			{
+				full = 0;
+			}
+			else if(com_procfs_scan_key(&scan, "full"))
+			{
+				full = 1;
+			}
+			else
+			{
+				continue;
+			}
 			
-			//cpu負荷を計算
-			total = (curr[i].user - prev[i].user) +
-					(curr[i].nice - prev[i].nice) +
-					(curr[i].system - prev[i].system) +
-					(curr[i].idle - prev[i].idle);
-					
-			idle_load = ((double)curr[i].idle - (double)prev[i].idle) * 100 / (double)total;
-			ResourceStat.cpu_load[i] = 100 - idle_load;
-			prev[i] = curr[i];
+			while((len = com_procfs_scan_word(&scan, &word)) > 0)
+			{
+				eq = memchr(word, '=', len);
+				if(eq == NULL)
+				{
+					continue;
+				}
+				if(eq - word == 5 && memcmp(word, "avg10", 5) == 0)
+				{
+					*(full ? &psi->full_avg10 : &psi->some_avg10) = ResPSIPercent(eq + 1, word + len);
+				}
+				else if(eq - word == 5 && memcmp(word, "avg60", 5) == 0)
+				{
+					*(full ? &psi->full_avg60 : &psi->some_avg60) = ResPSIPercent(eq + 1, word + len);
+				}
+				else if(eq - word == 5 && memcmp(word, "total", 5) == 0)
+				{
+					total = 0;
+					for(const char *p = eq + 1; p < word + len && '0' <= *p && *p <= '9'; p++)
+					{
+						total = total * 10 + (uint64_t)(*p - '0');
+					}
+					*(full ? &psi->full_total : &psi->some_total) = total;
+				}
+			}
+		} while(com_procfs_scan_line(&scan));
+	}
+	
+	if(num == 0)
+	{
+		dprintf(ERROR, "psi load failed.\n");
+		return DEF_RET_NG;
+	}
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   PSI割合変換
+ * @note    "12.34"を1234に変換する(小数点以下2桁)．
+ * @param   引数  : str	先頭
+ * @param   引数  : end	終端
+ * @return  戻り値: 割合[1/100%]
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int32_t ResPSIPercent(const char *str, const char *end)
+{
+	int32_t value = 0;
+	int frac = -1;
+	
+	for(; str < end && frac < 2; str++)
+	{
+		if(*str == '.')
+		{
+			frac = 0;
+		}
+		else if('0' <= *str && *str <= '9')
+		{
+			value = value * 10 + (*str - '0');
+			if(frac >= 0)
+			{
+				frac++;
+			}
+		}
+		else
+		{
+			break;
 		}
 	}
+	//小数点以下が2桁未満の場合
+	for(frac = (frac < 0) ? 0 : frac; frac < 2; frac++)
+	{
+		value *= 10;
+	}
+	return value;
+}
+
+/*============================================================================*/
+/*
+ * @brief   PSIトリガ登録処理
+ * @note    設定ファイルの[psi]に記述したトリガ("some <停滞時間us> <窓us>")を登録する．
+ *          停滞が閾値を超えるとpoll()でPOLLPRIが通知される．
+ *          登録したトリガの種別(some/full)をpsi[].triggerに設定する(フェールセーフで判定に使う)．
+ * @param   引数  : void
+ *                  
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] トリガの種別を設定
+ */
+/*============================================================================*/
+static void ResPSIInit(void)
+{
+	char path[DEF_STR_MAX];
+	int fd;
+	
+	for(int i = 0; i < RES_PSI_MAX; i++)
+	{
+		if(ResPSITrigger[i][0] == '\0')
+		{
+			continue;
+		}
+		
+		snprintf(path, sizeof(path), DEF_RES_PSI_PATH "%s", ResPSIName[i]);
+		fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+		if(fd < 0)
+		{
+			dprintf(WARN, "open(%s) failed. errno=%d\n", path, errno);
+			continue;
+		}
+		//NUL終端まで書き込む
+		if(write(fd, ResPSITrigger[i], strlen(ResPSITrigger[i]) + 1) < 0)
+		{
+			dprintf(WARN, "psi trigger(%s: %s) failed. errno=%d\n", path, ResPSITrigger[i], errno);
+			close(fd);
+			continue;
+		}
+		ResPSITriggerFd[i] = fd;
+		ResourceStat->psi[i].trigger = (strncmp(ResPSITrigger[i], "full", 4) == 0) ? RES_PSI_TRIG_FULL : RES_PSI_TRIG_SOME;
+		dprintf(INFO, "psi trigger %s: %s\n", path, ResPSITrigger[i]);
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   PSIトリガ待ちスレッド
+ * @note    トリガのファイルディスクリプタをpoll()で待ち，発生したら監視周期を待たずに
+ *          PSIを取得して共有メモリに書き込む．
+ *          終了フラグはDEF_RES_PSI_WAIT毎に確認する．有効なトリガが無くなったら終了する．
+ * @param   引数  : arg	リソース共有メモリID(int*)
+ *                  
+ * @return  戻り値: void*
+ * @date    2026/10/19 [0.0.1] ResPSIPoll()(監視周期毎に待ち時間0でpoll)から変更
+ */
+/*============================================================================*/
+static void* ResPSIWait(void *arg)
+{
+	int id = *(int*)arg;
+	struct pollfd fds[RES_PSI_MAX];
+	int kind[RES_PSI_MAX];
+	int num;
+	int event;
 	
-	fclose(fp);
+	while(gComm_StopFlg == DEF_COMM_OFF)
+	{
+		num = 0;
+		for(int i = 0; i < RES_PSI_MAX; i++)
+		{
+			if(ResPSITriggerFd[i] >= 0)
+			{
+				fds[num].fd = ResPSITriggerFd[i];
+				fds[num].events = POLLPRI;
+				fds[num].revents = 0;
+				kind[num] = i;
+				num++;
+			}
+		}
+		if(num == 0)
+		{
+			break;
+		}
+		if(poll(fds, num, DEF_RES_PSI_WAIT) <= 0)
+		{
+			continue;
+		}
+		
+		event = 0;
+		pthread_mutex_lock(&ResourceStatMutex);
+		for(int i = 0; i < num; i++)
+		{
+			if(fds[i].revents & POLLERR)
+			{
+				//トリガが無効になった(cgroup削除等)
+				dprintf(WARN, "psi trigger(%s) error.\n", ResPSIName[kind[i]]);
+				close(ResPSITriggerFd[kind[i]]);
+				ResPSITriggerFd[kind[i]] = -1;
+				ResourceStat->psi[kind[i]].trigger = 0;
+				event++;
+			}
+			else if(fds[i].revents & POLLPRI)
+			{
+				ResourceStat->psi[kind[i]].events++;
+				TRACE_INSTANT("psi_event", kind[i]);
+				event++;
+			}
+		}
+		if(event > 0)
+		{
+			ResPSILoad();
+			com_shmem_write(id, ResourceStat, ResourceStatSize);
+			ResHistNew = 1;
+		}
+		pthread_mutex_unlock(&ResourceStatMutex);
+	}
 	
-	return ret;
+	return NULL;
+}
+
+/*============================================================================*/
+/*
+ * @brief   ディスク監視設定読み込み処理
+ * @note    [disk_load]のmount(使用量を監視するマウントポイント)と
+ *          device(I/Oを監視するブロックデバイス)を';'区切りで読み込む．
+ *          mountが無ければDEF_RES_DISK_PATH，deviceが無ければ自動で選ぶ．
+ * @param   引数  : file	設定ファイル
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ResDiskConf(GKeyFile *file)
+{
+	gchar **list;
+	gsize num = 0;
+	
+	ResourceStat->mount_num = 0;
+	list = g_key_file_get_string_list(file, "disk_load", "mount", &num, NULL);
+	for(gsize i = 0; list != NULL && i < num; i++)
+	{
+		if(ResourceStat->mount_num >= DEF_RES_MOUNT_MAX || strlen(list[i]) >= DEF_RES_MOUNT_PATH_LEN)
+		{
+			dprintf(WARN, "ignore mount point %s\n", list[i]);
+			continue;
+		}
+		snprintf(ResourceStat->mount[ResourceStat->mount_num++].path, DEF_RES_MOUNT_PATH_LEN, "%s", list[i]);
+	}
+	g_strfreev(list);
+	if(ResourceStat->mount_num == 0)
+	{
+		snprintf(ResourceStat->mount[0].path, DEF_RES_MOUNT_PATH_LEN, "%s", DEF_RES_DISK_PATH);
+		ResourceStat->mount_num = 1;
+	}
+	
+	ResourceStat->disk_num = 0;
+	list = g_key_file_get_string_list(file, "disk_load", "device", &num, NULL);
+	for(gsize i = 0; list != NULL && i < num; i++)
+	{
+		if(ResourceStat->disk_num >= DEF_RES_DISK_MAX || strlen(list[i]) >= DEF_RES_DISK_NAME_LEN)
+		{
+			dprintf(WARN, "ignore device %s\n", list[i]);
+			continue;
+		}
+		snprintf(ResourceStat->disk[ResourceStat->disk_num++].name, DEF_RES_DISK_NAME_LEN, "%s", list[i]);
+	}
+	g_strfreev(list);
+	ResDiskAuto = (ResourceStat->disk_num == 0) ? 1 : 0;
+}
+
+/*============================================================================*/
+/*
+ * @brief   適応周期設定読み込み処理
+ * @note    各種別のperiod_min，period_maxを読み込む．両方あれば適応周期とし，
+ *          periodを初期周期とする．変化量・閾値への近さの基準には
+ *          フェールセーフ設定ファイルの故障閾値を使い，無ければ値の最大値を使う．
+ *          PSIのフェールセーフはトリガの発生回数で判定するため，最大値(100%)を使う．
+ *          CPU負荷はCPU毎の閾値(CPULoad<n+2>，CPU.<n>，CPU.allの最も小さい値)に
+ *          対する割合で判定するため，基準値は100とする．
+ * @param   引数  : file	設定ファイル
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] PSIの基準値にフェールセーフの閾値を使わない
+ *          2026/10/19 [0.0.3] CPU負荷の閾値をCPU毎に読み込む
+ */
+/*============================================================================*/
+static void ResAdaptConf(GKeyFile *file)
+{
+	//基準値：フェールセーフのグループ名と，閾値が無い場合の最大値
+	static const char *fs_group[RES_KIND_PSI + 1] = { "CPULoad1", "MEM", "DISK", "THERM", NULL };
+	static const int32_t fs_scale[RES_KIND_PSI + 1] = { 100, 100, 100, 100000, 10000 };
+	GKeyFile *fs_file;
+	char group[DEF_STR_MAX];
+	int32_t thresh;
+	int32_t all;
+	int adapt = 0;
+	
+	for(int i = 0; i <= DEF_RES_CPU_MAX; i++)
+	{
+		ResAdaptCpuThresh[i] = fs_scale[RES_KIND_CPU_LOAD];
+	}
+	for(int i = 0; i < RES_KIND_MAX; i++)
+	{
+		ResourceInfo.period_min[i] = 0;
+		ResourceInfo.period_max[i] = 0;
+		ResourceInfo.next[i] = 0;
+		ResourceInfo.last[i] = INT32_MIN;
+		if(ResourceInfo.period[i] == DEF_PERIOD_MIN ||
+			!g_key_file_has_key(file, ConfSectionTble[i].item, "period_min", NULL) ||
+			!g_key_file_has_key(file, ConfSectionTble[i].item, "period_max", NULL))
+		{
+			continue;
+		}
+		if(i > RES_KIND_PSI)
+		{
+			dprintf(WARN, "[%s] adaptive period is not supported.\n", ConfSectionTble[i].item);
+			continue;
+		}
+		ResourceInfo.period_min[i] = g_key_file_get_integer(file, ConfSectionTble[i].item, "period_min", NULL);
+		ResourceInfo.period_max[i] = g_key_file_get_integer(file, ConfSectionTble[i].item, "period_max", NULL);
+		if(ResourceInfo.period_min[i] < DEF_MONIT_CYCLE || ResourceInfo.period_max[i] <= ResourceInfo.period_min[i] ||
+			ResourceInfo.period_min[i] % DEF_MONIT_CYCLE != 0 || ResourceInfo.period_max[i] % DEF_MONIT_CYCLE != 0)
+		{
+			dprintf(ERROR, "[%s] period_min/max failed. %d/%d\n", ConfSectionTble[i].item,
+				ResourceInfo.period_min[i], ResourceInfo.period_max[i]);
+			ResourceInfo.period_min[i] = 0;
+			ResourceInfo.period_max[i] = 0;
+			continue;
+		}
+		if(ResourceInfo.period[i] < ResourceInfo.period_min[i])
+		{
+			ResourceInfo.period[i] = ResourceInfo.period_min[i];
+		}
+		if(ResourceInfo.period[i] > ResourceInfo.period_max[i])
+		{
+			ResourceInfo.period[i] = ResourceInfo.period_max[i];
+		}
+		ResourceInfo.scale[i] = fs_scale[i];
+		adapt = 1;
+	}
+	if(!adapt)
+	{
+		return;
+	}
+	
+	//故障閾値
+	fs_file = g_key_file_new();
+	if(!g_key_file_load_from_file(fs_file, DEF_RES_FS_CONF, 0, NULL))
+	{
+		dprintf(WARN, "load %s failed. use full scale.\n", DEF_RES_FS_CONF);
+		g_key_file_free(fs_file);
+		return;
+	}
+	for(int i = 0; i <= RES_KIND_PSI; i++)
+	{
+		if(ResourceInfo.period_min[i] == 0 || fs_group[i] == NULL)
+		{
+			continue;
+		}
+		thresh = g_key_file_get_integer(fs_file, fs_group[i], "Thresh", NULL);
+		if(thresh > 0)
+		{
+			ResourceInfo.scale[i] = thresh;
+		}
+	}
+	
+	//CPU負荷：CPU毎の閾値(固定表のCPULoad<n+2>，CPU.<n>(無ければCPU.all)の小さい方)
+	if(ResourceInfo.period_min[RES_KIND_CPU_LOAD] != 0)
+	{
+		ResAdaptCpuThresh[0] = ResourceInfo.scale[RES_KIND_CPU_LOAD];
+		ResourceInfo.scale[RES_KIND_CPU_LOAD] = fs_scale[RES_KIND_CPU_LOAD];
+		all = g_key_file_get_integer(fs_file, "CPU.all", "Thresh", NULL);
+		for(int n = 0; n < DEF_RES_CPU_MAX; n++)
+		{
+			snprintf(group, sizeof(group), "CPU.%d", n);
+			thresh = g_key_file_has_group(fs_file, group) ? g_key_file_get_integer(fs_file, group, "Thresh", NULL) : all;
+			if(thresh > 0 && thresh < ResAdaptCpuThresh[n + 1])
+			{
+				ResAdaptCpuThresh[n + 1] = thresh;
+			}
+			if(n < DEF_CPU_NUM)
+			{
+				snprintf(group, sizeof(group), "CPULoad%d", n + 2);
+				thresh = g_key_file_get_integer(fs_file, group, "Thresh", NULL);
+				if(thresh > 0 && thresh < ResAdaptCpuThresh[n + 1])
+				{
+					ResAdaptCpuThresh[n + 1] = thresh;
+				}
+			}
+		}
+	}
+	g_key_file_free(fs_file);
+	
+	for(int i = 0; i <= RES_KIND_PSI; i++)
+	{
+		if(ResourceInfo.period_min[i] != 0)
+		{
+			dprintf(INFO, "[%s] adaptive period %d-%d ms, scale = %d\n", ConfSectionTble[i].item,
+				ResourceInfo.period_min[i], ResourceInfo.period_max[i], ResourceInfo.scale[i]);
+		}
+	}
+}
+
+/*============================================================================*/
+/*
+ * @brief   適応周期の監視値取得
+ * @param   引数  : kind	リソース種別
+ * @return  戻り値: 監視値(PSIは全種別のsome，fullの最大，
+ *                  CPU負荷は全体とオンラインのCPU毎の閾値に対する割合[%]の最大)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] CPU負荷をCPU毎の負荷と閾値で判定
+ */
+/*============================================================================*/
+static int32_t ResAdaptValue(int kind)
+{
+	int32_t value = 0;
+	
+	switch(kind)
+	{
+		case RES_KIND_CPU_LOAD:
+			for(int i = 0; i <= ResourceStat->cpu_num && i <= DEF_RES_CPU_MAX; i++)
+			{
+				if(i > 0 && !ResourceStat->cpu[i].online)
+				{
+					continue;
+				}
+				if(ResourceStat->cpu[i].load * 100 / ResAdaptCpuThresh[i] > value)
+				{
+					value = ResourceStat->cpu[i].load * 100 / ResAdaptCpuThresh[i];
+				}
+			}
+			break;
+		case RES_KIND_MEM_LOAD:
+			value = ResourceStat->mem_load;
+			break;
+		case RES_KIND_DISK_LOAD:
+			value = ResourceStat->disk_load;
+			break;
+		case RES_KIND_CPU_THERM:
+			value = ResourceStat->cpu_therm;
+			break;
+		case RES_KIND_PSI:
+			for(int i = 0; i < RES_PSI_MAX; i++)
+			{
+				if(ResourceStat->psi[i].some_avg10 > value)
+				{
+					value = ResourceStat->psi[i].some_avg10;
+				}
+				if(ResourceStat->psi[i].full_avg10 > value)
+				{
+					value = ResourceStat->psi[i].full_avg10;
+				}
+			}
+			break;
+		default:
+			break;
+	}
+	return value;
 }
 
+/*============================================================================*/
+/*
+ * @brief   適応周期の更新
+ * @note    閾値に近い，または急に変化した場合は周期を短くし，
+ *          値が安定している場合は周期を倍にする．
+ *          (近さ・変化量は基準値に対する割合で判定する)
+ * @param   引数  : kind	リソース種別
+ * @param   引数  : time	今回の取得時刻[ms]
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ResAdaptPeriod(int kind, uint64_t time)
+{
+	int32_t value;
+	int64_t near;
+	int64_t delta;
+	int period;
+	
+	if(ResourceInfo.period_min[kind] == 0)
+	{
+		return;
+	}
+	
+	value = ResAdaptValue(kind);
+	near = (int64_t)value * 100 / ResourceInfo.scale[kind];
+	delta = (ResourceInfo.last[kind] == INT32_MIN) ? 0 : (int64_t)value - ResourceInfo.last[kind];
+	delta = ((delta < 0) ? -delta : delta) * 100 / ResourceInfo.scale[kind];
+	ResourceInfo.last[kind] = value;
+	
+	period = ResourceInfo.period[kind];
+	if(near >= DEF_RES_ADAPT_NEAR_URGENT || delta >= DEF_RES_ADAPT_DELTA_URGENT)
+	{
+		period = ResourceInfo.period_min[kind];
+	}
+	else if(near >= DEF_RES_ADAPT_NEAR || delta >= DEF_RES_ADAPT_DELTA)
+	{
+		period /= 2;
+	}
+	else if(delta <= DEF_RES_ADAPT_STABLE)
+	{
+		period *= 2;
+	}
+	
+	//最小・最大の範囲で，監視周期の倍数にする
+	period -= period % DEF_MONIT_CYCLE;
+	if(period < ResourceInfo.period_min[kind])
+	{
+		period = ResourceInfo.period_min[kind];
+	}
+	if(period > ResourceInfo.period_max[kind])
+	{
+		period = ResourceInfo.period_max[kind];
+	}
+	if(period != ResourceInfo.period[kind])
+	{
+		dprintf(DEBUG, "[%s] period %d -> %d ms (value = %d)\n", ConfSectionTble[kind].item,
+			ResourceInfo.period[kind], period, value);
+		ResourceInfo.period[kind] = period;
+	}
+	ResourceInfo.next[kind] = time + period;
+}
 
 /*============================================================================*/
 /*
@@ -306,6 +1209,8 @@ dprintf(ERROR, "cpu load failed.\n");
  *                  
  * @return  戻り値: int
  * @date    2023/11/27 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] ディスク監視の対象(mount，device)を追加
+ *          2026/10/19 [0.0.3] 適応周期(period_min，period_max)を追加
  */
 /*============================================================================*/
 static int ResReadFile(char filename[])
@@ -343,6 +1248,11 @@ static int ResReadFile(char filename[])
 		//リソース監視周期を取得
 		for(int i = 0; i < RES_KIND_MAX; i++)
 		{
+			if(i >= RES_KIND_PSI && !g_key_file_has_group(file, ConfSectionTble[i].item))
+			{
+				ResourceInfo.period[i] = DEF_PERIOD_MIN;
+				continue;
+			}
 			if(0 == (tmp_value = g_key_file_get_integer(file, ConfSectionTble[i].item, "period", &err)) && (NULL != err))
 			{
 				dprintf(ERROR, "get prriod[%d] failed. %s\n", i, err->message);
@@ -360,6 +1270,23 @@ static int ResReadFile(char filename[])
 			}
 		}
 
+		//適応周期(period_min，period_max)
+		ResAdaptConf(file);
+
+		//使用量を監視するマウントポイント，I/Oを監視するブロックデバイス
+		ResDiskConf(file);
+
+		//PSIトリガ(キーが無ければ登録しない)
+		for(int i = 0; i < RES_PSI_MAX; i++)
+		{
+			char_tmp_value = g_key_file_get_string(file, DEF_RES_PSI_SECTION, ResPSIName[i], NULL);
+			if(char_tmp_value != NULL)
+			{
+				snprintf(ResPSITrigger[i], sizeof(ResPSITrigger[i]), "%s", (char*)char_tmp_value);
+				g_free(char_tmp_value);
+			}
+		}
+
 		//GNSS
 		if (g_uartGNSSRun == 1)
 		{
@@ -705,13 +1632,37 @@ static int ResReadFile(char filename[])
  *                  
  * @return  戻り値: void*
  * @date    2023/11/27 [0.0.1] 新規作成
+ *          2026/10/19 [0.0.2] 温度・冷却・周波数の監視(/thermal)を追加
+ *          2026/10/19 [0.0.3] PSIの監視とトリガを追加
+ *          2026/10/19 [0.0.4] カーネル活動の監視(/kstat)を追加
+ *          2026/10/19 [0.0.5] ネットワークインタフェースの監視(/netstat)を追加
+ *          2026/10/19 [0.0.6] リソース履歴(/reshist)を追加
+ *          2026/10/19 [0.0.7] 適応周期を追加(次回取得時刻で判定する)
+ *          2026/10/19 [0.0.8] スケジューリング遅延の監視(/schedstat)を追加
+ *          2026/10/19 [0.0.9] スレッド名を設定
+ *          2026/10/19 [0.0.10] PSIトリガを専用スレッドで待つ
+ *          2026/10/19 [0.0.11] リソース履歴は取得値の更新時のみ記録する
  */
 /*============================================================================*/
 void* ResMain(void* arg){
 	int ret;
 	int id;
-	int time = 0;
+	int therm_id;
+	int kstat_id;
+	int net_id;
+	int hist_id;
+	int sched_id;
+	int proc_id;
+	uint64_t time = 0;
+	static procStat proc;
+	pthread_t psi_thread;
+	int psi_run = 0;
 	
+	//CPU構成取得(通常はmainで共有メモリ生成前に実施済み)
+	if(ResCPUInit() == DEF_RET_NG){
+		pthread_exit(NULL);
+	}
+
 	//設定ファイル読み込み
 	ret = ResReadFile(arg);
 	if(ret == DEF_RET_NG){
@@ -732,6 +1683,49 @@ void* ResMain(void* arg){
                 dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_RES_SHMMNG_NAME);
 		pthread_exit(NULL);
 	}	
+	therm_id = com_shmem_open(DEF_THERM_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(therm_id == DEF_COM_SHMEM_FALSE){
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_THERM_SHMEM_NAME);
+	}
+	kstat_id = com_shmem_open(DEF_KSTAT_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(kstat_id == DEF_COM_SHMEM_FALSE){
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_KSTAT_SHMEM_NAME);
+	}
+	net_id = com_shmem_open(DEF_NET_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(net_id == DEF_COM_SHMEM_FALSE){
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_NET_SHMEM_NAME);
+	}
+	hist_id = com_shmem_open(DEF_HIST_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(hist_id == DEF_COM_SHMEM_FALSE){
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_HIST_SHMEM_NAME);
+	}
+	sched_id = com_shmem_open(DEF_SCHED_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if(sched_id == DEF_COM_SHMEM_FALSE){
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_SCHED_SHMEM_NAME);
+	}
+	proc_id = com_shmem_open(DEF_PROC_SHMMNG_NAME, SHM_KIND_PLATFORM);
+	if(proc_id == DEF_COM_SHMEM_FALSE){
+		dprintf(WARN, "com_shmem_open error. name = %s\n", DEF_PROC_SHMMNG_NAME);
+	}
+
+	//PSIトリガ登録
+	ResPSIInit();
+	for(int i = 0; i < RES_PSI_MAX; i++)
+	{
+		if(ResPSITriggerFd[i] >= 0)
+		{
+			psi_run = (pthread_create(&psi_thread, NULL, ResPSIWait, &id) == 0);
+			if(psi_run)
+			{
+				pthread_setname_np(psi_thread, "hjpf_psi");
+			}
+			else
+			{
+				dprintf(WARN, "pthread_create(ResPSIWait) error=%d\n", errno);
+			}
+			break;
+		}
+	}
 
 	// スレッド生成
 	for (int cnt = 0; cnt < sizeof(g_res_threadInfo) / sizeof(resThreadInfo); cnt++) 
@@ -744,6 +1738,10 @@ void* ResMain(void* arg){
 			{
 				dprintf(WARN, "pthread_create(%d) error=%d\n", cnt, errno);
 			}
+			else
+			{
+				pthread_setname_np(g_res_threadInfo[cnt].threadid, g_res_threadInfo[cnt].name);
+			}
 		}
 		else
 		{
@@ -755,10 +1753,12 @@ void* ResMain(void* arg){
 #if 1
 	while(gComm_StopFlg == DEF_COMM_OFF)
 	{
+		pthread_mutex_lock(&ResourceStatMutex);
 		for(int i = 0; i < RES_KIND_MAX; i++)
 		{
-			if(ResourceInfo.period[i] != DEF_PERIOD_MIN && time % ResourceInfo.period[i] == 0)
+			if(ResourceInfo.period[i] != DEF_PERIOD_MIN && time >= ResourceInfo.next[i])
 			{
+				ResourceInfo.next[i] = time + ResourceInfo.period[i];
 				switch(i)
 				{
 					case RES_KIND_CPU_LOAD:
@@ -772,7 +1772,60 @@ void* ResMain(void* arg){
 						break;
 					case RES_KIND_CPU_THERM:
 						ret = ResCPUTherm();
+						if(therm_id != DEF_COM_SHMEM_FALSE)
+						{
+							ThermUpdate(therm_id);
+						}
+						break;
+					case RES_KIND_PSI:
+						ret = ResPSILoad();
 						break;
+					case RES_KIND_KSTAT:
+						//専用の共有メモリに書き込む
+						if(kstat_id != DEF_COM_SHMEM_FALSE)
+						{
+							KstatUpdate(kstat_id);
+						}
+						continue;
+					case RES_KIND_NET:
+						//専用の共有メモリに書き込む
+						if(net_id != DEF_COM_SHMEM_FALSE)
+						{
+							NetUpdate(net_id);
+						}
+						continue;
+					case RES_KIND_SCHED:
+						//管理プロセスのプロセスIDはプロセス管理の共有メモリから取得する
+						memset(&proc, 0, sizeof(proc));
+						if(proc_id != DEF_COM_SHMEM_FALSE)
+						{
+							com_shmem_read(proc_id, &proc, sizeof(proc));
+						}
+						if(proc.num < 0 || proc.num > DEF_PROC_MAX)
+						{
+							proc.num = 0;
+						}
+						if(sched_id != DEF_COM_SHMEM_FALSE)
+						{
+							SchedUpdate(sched_id, proc.pid, proc.num);
+						}
+						continue;
+					case RES_KIND_HIST:
+						//専用の共有メモリに書き込む(段0の周期は最も短い取得周期)
+						if(hist_id != DEF_COM_SHMEM_FALSE && ResHistNew)
+						{
+							int32_t period = 0;
+							for(int k = 0; k <= RES_KIND_PSI; k++)
+							{
+								if(ResourceInfo.period[k] != DEF_PERIOD_MIN && (period == 0 || ResourceInfo.period[k] < period))
+								{
+									period = ResourceInfo.period[k];
+								}
+							}
+							HistUpdate(hist_id, ResourceStat, period);
+							ResHistNew = 0;
+						}
+						continue;
 					default:
 dprintf(ERROR, "cannot get resource data.\n");
 				}
@@ -780,25 +1833,43 @@ dprintf(ERROR, "cannot get resource data.\n");
 				if(ret == DEF_RET_OK)
 				{
 					//共有メモリに書き込み
-					com_shmem_write(id, &ResourceStat, sizeof(ResourceStat));		
+					com_shmem_write(id, ResourceStat, ResourceStatSize);		
+					ResHistNew = 1;
+					//適応周期
+					ResAdaptPeriod(i, time);
 				}
 #if DEF_RES_TEST			
 				for(int i = 0; i < 13; i++)
 				{
-					printf("cpu_load[%d] = %d\n", i, ResourceStat.cpu_load[i]);
+					printf("cpu_load[%d] = %d\n", i, ResourceStat->cpu_load[i]);
 				}
 
-				printf("mem_load = %d\n", ResourceStat.mem_load);
-				printf("disk_load = %d\n", ResourceStat.disk_load);
-				printf("cpu_therm = %d\n", ResourceStat.cpu_therm);
+				printf("mem_load = %d\n", ResourceStat->mem_load);
+				printf("disk_load = %d\n", ResourceStat->disk_load);
+				printf("cpu_therm = %d\n", ResourceStat->cpu_therm);
 #endif
 			}
 		}		
+		pthread_mutex_unlock(&ResourceStatMutex);
+		
 		com_mtimer(ENUM_TIMER_RES);
 		time += DEF_MONIT_CYCLE;
 	}
 #endif
 
+	if(psi_run)
+	{
+		pthread_join(psi_thread, NULL);
+	}
+	for(int i = 0; i < RES_PSI_MAX; i++)
+	{
+		if(ResPSITriggerFd[i] >= 0)
+		{
+			close(ResPSITriggerFd[i]);
+			ResPSITriggerFd[i] = -1;
+		}
+	}
+
 	//スレッド終了待ち
 	for (int cnt = 0; cnt < sizeof(g_res_threadInfo) / sizeof(resThreadInfo); cnt++) 
 	{
@@ -812,6 +1883,30 @@ dprintf(ERROR, "cannot get resource data.\n");
 		}
 	}
 	
+	if(therm_id != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(therm_id);
+	}
+	if(kstat_id != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(kstat_id);
+	}
+	if(net_id != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(net_id);
+	}
+	if(hist_id != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(hist_id);
+	}
+	if(sched_id != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(sched_id);
+	}
+	if(proc_id != DEF_COM_SHMEM_FALSE)
+	{
+		com_shmem_close(proc_id);
+	}
 	com_shmem_close(id);
 	pthread_exit(NULL);
 }
@@ -0,0 +1,335 @@
+/*============================================================================*/
+/*
+ * @file    schedstat.c
+ * @brief   スケジューリング遅延監視
+ * @note    /proc/<pid>/task/<tid>/schedstat("<実行時間ns> <実行待ち時間ns> <スライス数>")の
+ *          前回との差分から，1スライスあたりの実行待ち時間等を求める．
+ *          schedstatはスレッド毎に開いたままにし，終了したスレッドのみ閉じる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sched.h>
+#include <time.h>
+#include "com_shmem.h"
+#include "com_procfs.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "schedstat.h"
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static schedStat *SchedStat = NULL;		/* 今回の取得結果(共有メモリに書き込む) */
+static schedStat *SchedPrev = NULL;		/* 前回の取得結果 */
+static int *SchedFd = NULL;				/* SchedStatのスレッド毎のschedstat */
+static int *SchedPrevFd = NULL;			/* SchedPrevのスレッド毎のschedstat */
+static int SchedStatSize = 0;
+static uint64_t SchedPrevTime = 0;		/* 前回取得時刻[ms] */
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static void SchedTasks(int pid, int proc, uint64_t interval);
+static int SchedRead(int fd, uint64_t *val);
+static void SchedDelta(schedTask *task, const uint64_t *val, uint64_t interval);
+
+/*============================================================================*/
+/*
+ * @brief   スケジューリング遅延監視初期化処理
+ * @note    共有メモリのサイズを設定する．
+ *          com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ * @param   引数  : void
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int SchedInit(void)
+{
+	if(SchedStat != NULL)
+	{
+		return DEF_RET_OK;
+	}
+
+	SchedStatSize = DEF_SCHED_STAT_SIZE(DEF_SCHED_TASK_MAX);
+	SchedStat = calloc(1, SchedStatSize);
+	SchedPrev = calloc(1, SchedStatSize);
+	SchedFd = malloc(DEF_SCHED_TASK_MAX * sizeof(int));
+	SchedPrevFd = malloc(DEF_SCHED_TASK_MAX * sizeof(int));
+	if(SchedStat == NULL || SchedPrev == NULL || SchedFd == NULL || SchedPrevFd == NULL)
+	{
+		dprintf(ERROR, "calloc failed.\n");
+		return DEF_RET_NG;
+	}
+	SchedStat->task_max = DEF_SCHED_TASK_MAX;
+	SchedPrev->task_max = DEF_SCHED_TASK_MAX;
+
+	//共有メモリサイズを設定
+	com_shmem_set_size(DEF_SCHED_SHMEM_NAME, SchedStatSize);
+	dprintf(INFO, "%s size = %d\n", DEF_SCHED_SHMEM_NAME, SchedStatSize);
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   スケジューリング遅延監視処理
+ * @note    hjpfと管理プロセスの全スレッドを取得し，共有メモリに書き込む．
+ * @param   引数  : id	共有メモリID(DEF_SCHED_SHMEM_NAME)
+ * @param   引数  : pid	管理プロセスのプロセスID(process.confの順，0以下は未起動)
+ * @param   引数  : num	管理プロセス数
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int SchedUpdate(int id, const int *pid, int num)
+{
+	struct timespec ts;
+	uint64_t now;
+	uint64_t interval = 0;
+	schedStat *stat;
+	int *fd;
+
+	if(SchedStat == NULL)
+	{
+		return DEF_RET_NG;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+	if(SchedPrevTime != 0 && now > SchedPrevTime)
+	{
+		interval = now - SchedPrevTime;
+	}
+	SchedPrevTime = now;
+
+	//前回の結果と入れ替えて今回の結果を作る
+	stat = SchedPrev;
+	SchedPrev = SchedStat;
+	SchedStat = stat;
+	fd = SchedPrevFd;
+	SchedPrevFd = SchedFd;
+	SchedFd = fd;
+	SchedStat->task_num = 0;
+	SchedStat->interval = (int32_t)interval;
+
+	SchedTasks(getpid(), DEF_SCHED_SELF, interval);
+	for(int i = 0; i < num; i++)
+	{
+		if(pid[i] > 0)
+		{
+			SchedTasks(pid[i], i, interval);
+		}
+	}
+
+	//終了したスレッド
+	for(int i = 0; i < SchedPrev->task_num; i++)
+	{
+		if(SchedPrevFd[i] >= 0)
+		{
+			close(SchedPrevFd[i]);
+			SchedPrevFd[i] = -1;
+		}
+	}
+
+	//共有メモリに書き込み
+	return com_shmem_write(id, SchedStat, DEF_SCHED_STAT_SIZE(SchedStat->task_num));
+}
+
+/*============================================================================*/
+/*
+ * @brief   プロセスの全スレッド取得
+ * @param   引数  : pid			プロセスID
+ * @param   引数  : proc		process.confの順番(DEF_SCHED_SELF:hjpf)
+ * @param   引数  : interval	前回取得からの経過時間[ms](0:初回)
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void SchedTasks(int pid, int proc, uint64_t interval)
+{
+	char path[64];
+	uint64_t val[3];
+	struct sched_param param;
+	struct dirent *ent;
+	schedTask *task;
+	DIR *dir;
+	int slot;
+	int prev;
+	int tid;
+	int len;
+
+	snprintf(path, sizeof(path), "/proc/%d/task", pid);
+	dir = opendir(path);
+	if(dir == NULL)
+	{
+		return;
+	}
+	while((ent = readdir(dir)) != NULL)
+	{
+		if(ent->d_name[0] < '0' || ent->d_name[0] > '9')
+		{
+			continue;
+		}
+		if(SchedStat->task_num >= SchedStat->task_max)
+		{
+			dprintf(WARN, "too many thread. pid = %d\n", pid);
+			break;
+		}
+		tid = atoi(ent->d_name);
+		slot = SchedStat->task_num;
+		task = &SchedStat->task[slot];
+
+		//前回の結果(並びは大きく変わらないため同じ位置から探す)
+		for(prev = 0; prev < SchedPrev->task_num; prev++)
+		{
+			int idx = (slot + prev) % SchedPrev->task_num;
+			if(SchedPrev->task[idx].tid == tid && SchedPrevFd[idx] >= 0)
+			{
+				prev = idx;
+				break;
+			}
+		}
+		if(prev < SchedPrev->task_num)
+		{
+			*task = SchedPrev->task[prev];
+			SchedFd[slot] = SchedPrevFd[prev];
+			SchedPrevFd[prev] = -1;
+		}
+		else
+		{
+			prev = -1;
+			memset(task, 0, sizeof(*task));
+			task->pid = pid;
+			task->tid = tid;
+			snprintf(path, sizeof(path), "/proc/%d/task/%d/comm", pid, tid);
+			SchedFd[slot] = open(path, O_RDONLY | O_CLOEXEC);
+			if(SchedFd[slot] >= 0)
+			{
+				len = (int)read(SchedFd[slot], task->comm, sizeof(task->comm) - 1);
+				task->comm[(len > 0) ? len - 1 : 0] = '\0';	/* 末尾の改行 */
+				close(SchedFd[slot]);
+			}
+			snprintf(path, sizeof(path), "/proc/%d/task/%d/schedstat", pid, tid);
+			SchedFd[slot] = open(path, O_RDONLY | O_CLOEXEC);
+		}
+		task->proc = proc;
+
+		//実行時間，実行待ち時間，スライス数
+		if(SchedFd[slot] < 0 || SchedRead(SchedFd[slot], val) != DEF_RET_OK)
+		{
+			if(SchedFd[slot] >= 0)
+			{
+				close(SchedFd[slot]);
+			}
+			continue;
+		}
+		if(prev >= 0)
+		{
+			SchedDelta(task, val, interval);
+		}
+		task->run_ns = val[0];
+		task->wait_ns = val[1];
+		task->slices = val[2];
+
+		//ポリシー，優先度(process.confのSCHED_FIFO設定の確認用)
+		task->policy = sched_getscheduler(tid);
+		task->prio = (sched_getparam(tid, &param) == 0) ? param.sched_priority : 0;
+
+		SchedStat->task_num++;
+	}
+	closedir(dir);
+}
+
+/*============================================================================*/
+/*
+ * @brief   schedstat読み込み
+ * @param   引数  : fd	schedstatのファイルディスクリプタ
+ * @param   引数  : val	実行時間[ns]，実行待ち時間[ns]，スライス数
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int SchedRead(int fd, uint64_t *val)
+{
+	char buf[96];
+	procfsScan scan;
+	ssize_t len;
+
+	len = pread(fd, buf, sizeof(buf) - 1, 0);
+	if(len <= 0)
+	{
+		return DEF_RET_NG;
+	}
+	buf[len] = '\0';
+
+	com_procfs_scan_init(&scan, buf, (int)len);
+	for(int i = 0; i < 3; i++)
+	{
+		if(com_procfs_scan_u64(&scan, &val[i]) != 0)
+		{
+			return DEF_RET_NG;
+		}
+	}
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   前回からの差分計算
+ * @note    1スライスあたりの実行待ち時間をヒストグラムに加える(スライス数で重み付け)．
+ * @param   引数  : task		スレッド(前回値)
+ * @param   引数  : val			今回の実行時間[ns]，実行待ち時間[ns]，スライス数
+ * @param   引数  : interval	前回取得からの経過時間[ms]
+ * @return  戻り値: void
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void SchedDelta(schedTask *task, const uint64_t *val, uint64_t interval)
+{
+	uint64_t run;
+	uint64_t wait;
+	uint64_t slices;
+	uint64_t avg;
+	int bin;
+
+	task->wait_avg = 0;
+	task->slice_avg = 0;
+	task->run_pct = 0;
+	if(val[0] < task->run_ns || val[1] < task->wait_ns || val[2] <= task->slices)
+	{
+		return;
+	}
+	run = val[0] - task->run_ns;
+	wait = val[1] - task->wait_ns;
+	slices = val[2] - task->slices;
+
+	avg = wait / slices / 1000;
+	task->wait_avg = (int32_t)avg;
+	task->slice_avg = (int32_t)(run / slices / 1000);
+	if(interval > 0)
+	{
+		task->run_pct = (int32_t)(run / 10000 / interval);	/* run[ns] / (interval[ms] * 1000000) * 100 */
+	}
+	if(task->wait_avg > task->wait_max)
+	{
+		task->wait_max = task->wait_avg;
+	}
+
+	//ビンiは2^(i-1)～2^i[us](0は1us未満)
+	for(bin = 0; bin < DEF_SCHED_HIST_BIN - 1 && avg > 0; bin++)
+	{
+		avg >>= 1;
+	}
+	task->hist[bin] += (uint32_t)slices;
+}
@@ -0,0 +1,421 @@
+/*============================================================================*/
+/*
+ * @file    thermal.c
+ * @brief   温度・冷却・周波数監視
+ * @note    起動時に/sys/class/thermalのthermal zone，cooling deviceを列挙し，
+ *          周期毎に温度・冷却状態・CPU毎の周波数を取得して共有メモリに書き込む．
+ *          スロットリング(周波数上限の低下)は発生時にトレースとログに残す．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <dirent.h>
+#include <unistd.h>
+#include "com_shmem.h"
+#include "com_procfs.h"
+#include "com_trace.h"
+#include "debug.h"
+#include "hjpf.h"
+#include "thermal.h"
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _thermFile{				/* 周期毎に読み込むファイル */
+	procfsFile file;
+	char path[DEF_PROCFS_PATH_MAX];
+} thermFile;
+
+typedef struct _thermFreqFile{			/* CPU毎のcpufreqファイル */
+	thermFile cur;						/* scaling_cur_freq */
+	thermFile max;						/* scaling_max_freq */
+	thermFile hw_max;					/* cpuinfo_max_freq */
+} thermFreqFile;
+
+/*============================================================================*/
+/* global */
+/*============================================================================*/
+static thermalStat *ThermStat = NULL;
+static int ThermStatSize = 0;
+static thermFile *ThermZoneFile = NULL;		/* thermal_zoneN/temp */
+static thermFile *ThermCoolFile = NULL;		/* cooling_deviceN/cur_state */
+static thermFreqFile *ThermFreqFiles = NULL;
+
+/*============================================================================*/
+/* prototype */
+/*============================================================================*/
+static int ThermList(const char *prefix, int *index, int max);
+static int ThermCompare(const void *a, const void *b);
+static void ThermFileInit(thermFile *file, const char *format, ...);
+static int ThermReadOnce(thermFile *file, int64_t *value);
+static void ThermReadType(const char *path, char *type, int size);
+static int32_t ThermTrip(int zone);
+
+/*============================================================================*/
+/*
+ * @brief   温度監視初期化処理
+ * @note    thermal zone，cooling deviceを列挙し，共有メモリのサイズを決定する．
+ *          com_shmem_conf()の後，com_shmem_init()の前に呼び出すこと．
+ * @param   引数  : cpu_num	CPU数
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ThermInit(int cpu_num)
+{
+	int zone[DEF_THERM_ZONE_MAX];
+	int cool[DEF_THERM_COOL_MAX];
+	int zone_num;
+	int cool_num;
+	char path[DEF_PROCFS_PATH_MAX];
+	thermZone *tz;
+	thermCool *tc;
+	thermFreq *tf;
+	thermFile file;
+	int64_t value;
+
+	if(ThermStat != NULL)
+	{
+		return DEF_RET_OK;
+	}
+
+	zone_num = ThermList("thermal_zone", zone, DEF_THERM_ZONE_MAX);
+	cool_num = ThermList("cooling_device", cool, DEF_THERM_COOL_MAX);
+
+	ThermStatSize = DEF_THERM_STAT_SIZE(zone_num, cool_num, cpu_num);
+	ThermStat = calloc(1, ThermStatSize);
+	ThermZoneFile = calloc(zone_num + 1, sizeof(thermFile));
+	ThermCoolFile = calloc(cool_num + 1, sizeof(thermFile));
+	ThermFreqFiles = calloc(cpu_num + 1, sizeof(thermFreqFile));
+	if(ThermStat == NULL || ThermZoneFile == NULL || ThermCoolFile == NULL || ThermFreqFiles == NULL)
+	{
+		dprintf(ERROR, "calloc failed.\n");
+		return DEF_RET_NG;
+	}
+	ThermStat->zone_num = zone_num;
+	ThermStat->cool_num = cool_num;
+	ThermStat->cpu_num = cpu_num;
+
+	//thermal zone
+	tz = THERM_ZONE(ThermStat);
+	for(int i = 0; i < zone_num; i++)
+	{
+		snprintf(path, sizeof(path), DEF_THERM_SYSFS "/thermal_zone%d/type", zone[i]);
+		ThermReadType(path, tz[i].type, sizeof(tz[i].type));
+		tz[i].trip = ThermTrip(zone[i]);
+		tz[i].temp = INT32_MIN;
+		ThermFileInit(&ThermZoneFile[i], DEF_THERM_SYSFS "/thermal_zone%d/temp", zone[i]);
+	}
+
+	//cooling device
+	tc = THERM_COOL(ThermStat);
+	for(int i = 0; i < cool_num; i++)
+	{
+		snprintf(path, sizeof(path), DEF_THERM_SYSFS "/cooling_device%d/type", cool[i]);
+		ThermReadType(path, tc[i].type, sizeof(tc[i].type));
+		ThermFileInit(&file, DEF_THERM_SYSFS "/cooling_device%d/max_state", cool[i]);
+		if(ThermReadOnce(&file, &value) == 0)
+		{
+			tc[i].max = (int32_t)value;
+		}
+		ThermFileInit(&ThermCoolFile[i], DEF_THERM_SYSFS "/cooling_device%d/cur_state", cool[i]);
+	}
+
+	//cpufreq(オフラインのCPUは取得できるようになってから読む)
+	tf = THERM_FREQ(ThermStat);
+	for(int i = 0; i < cpu_num; i++)
+	{
+		ThermFileInit(&ThermFreqFiles[i].cur, DEF_THERM_CPUFREQ, i, "scaling_cur_freq");
+		ThermFileInit(&ThermFreqFiles[i].max, DEF_THERM_CPUFREQ, i, "scaling_max_freq");
+		ThermFileInit(&ThermFreqFiles[i].hw_max, DEF_THERM_CPUFREQ, i, "cpuinfo_max_freq");
+		if(access(ThermFreqFiles[i].hw_max.path, R_OK) == 0 && ThermReadOnce(&ThermFreqFiles[i].hw_max, &value) == 0)
+		{
+			tf[i].hw_max = (int32_t)value;
+		}
+	}
+
+	//共有メモリサイズを設定
+	com_shmem_set_size(DEF_THERM_SHMEM_NAME, ThermStatSize);
+	dprintf(INFO, "thermal zone = %d, cooling device = %d, %s size = %d\n",
+		zone_num, cool_num, DEF_THERM_SHMEM_NAME, ThermStatSize);
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   温度監視処理
+ * @note    温度・冷却状態・周波数を取得し，共有メモリに書き込む．
+ * @param   引数  : id	共有メモリID(DEF_THERM_SHMEM_NAME)
+ * @return  戻り値: int
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+int ThermUpdate(int id)
+{
+	thermZone *tz;
+	thermCool *tc;
+	thermFreq *tf;
+	int64_t value;
+	int throttled = 0;
+
+	if(ThermStat == NULL)
+	{
+		return DEF_RET_NG;
+	}
+
+	//温度
+	tz = THERM_ZONE(ThermStat);
+	for(int i = 0; i < ThermStat->zone_num; i++)
+	{
+		if(com_procfs_read_i64(&ThermZoneFile[i].file, &value) == 0)
+		{
+			tz[i].temp = (int32_t)value;
+		}
+		else
+		{
+			tz[i].temp = INT32_MIN;
+		}
+	}
+
+	//冷却状態
+	tc = THERM_COOL(ThermStat);
+	for(int i = 0; i < ThermStat->cool_num; i++)
+	{
+		if(com_procfs_read_i64(&ThermCoolFile[i].file, &value) != 0)
+		{
+			continue;
+		}
+		if((int32_t)value > tc[i].cur)
+		{
+			tc[i].count++;
+		}
+		tc[i].cur = (int32_t)value;
+	}
+
+	//周波数
+	tf = THERM_FREQ(ThermStat);
+	for(int i = 0; i < ThermStat->cpu_num; i++)
+	{
+		//オフラインのCPUはcpufreqが無いため，未オープン時は存在確認してから読む
+		if((ThermFreqFiles[i].cur.file.fd < 0 && access(ThermFreqFiles[i].cur.path, R_OK) != 0) ||
+			com_procfs_read_i64(&ThermFreqFiles[i].cur.file, &value) != 0)
+		{
+			//オフライン
+			tf[i].online = 0;
+			tf[i].cur = 0;
+			tf[i].throttled = 0;
+			com_procfs_close(&ThermFreqFiles[i].cur.file);
+			com_procfs_close(&ThermFreqFiles[i].max.file);
+			continue;
+		}
+		tf[i].online = 1;
+		tf[i].cur = (int32_t)value;
+		if(com_procfs_read_i64(&ThermFreqFiles[i].max.file, &value) == 0)
+		{
+			tf[i].max = (int32_t)value;
+		}
+		if(tf[i].hw_max == 0 && ThermReadOnce(&ThermFreqFiles[i].hw_max, &value) == 0)
+		{
+			tf[i].hw_max = (int32_t)value;
+		}
+
+		//スロットリング判定(上限がハードウェア上限より下がっている)
+		if(tf[i].hw_max > 0 && tf[i].max > 0 && tf[i].max < tf[i].hw_max)
+		{
+			if(!tf[i].throttled)
+			{
+				tf[i].count++;
+				TRACE_INSTANT("cpu_throttle", i);
+				dprintf(WARN, "cpu%d throttled. max = %d kHz (hw max = %d kHz)\n", i, tf[i].max, tf[i].hw_max);
+			}
+			tf[i].throttled = 1;
+			throttled++;
+		}
+		else
+		{
+			tf[i].throttled = 0;
+		}
+	}
+	ThermStat->throttled = throttled;
+	TRACE_COUNTER("cpu_throttled", throttled);
+
+	//共有メモリに書き込み
+	com_shmem_write(id, ThermStat, ThermStatSize);
+
+	return DEF_RET_OK;
+}
+
+/*============================================================================*/
+/*
+ * @brief   sysfsエントリ列挙
+ * @note    DEF_THERM_SYSFS配下の"prefixN"の番号Nを昇順で取得する．
+ * @param   引数  : prefix	エントリ名の接頭辞
+ * @param   引数  : index	番号の格納先
+ * @param   引数  : max		indexの要素数
+ * @return  戻り値: 取得数
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ThermList(const char *prefix, int *index, int max)
+{
+	DIR *dir;
+	struct dirent *ent;
+	size_t len = strlen(prefix);
+	char *end;
+	long no;
+	int num = 0;
+
+	dir = opendir(DEF_THERM_SYSFS);
+	if(dir == NULL)
+	{
+		dprintf(WARN, "opendir(%s) failed.\n", DEF_THERM_SYSFS);
+		return 0;
+	}
+	while((ent = readdir(dir)) != NULL)
+	{
+		if(strncmp(ent->d_name, prefix, len) != 0)
+		{
+			continue;
+		}
+		no = strtol(ent->d_name + len, &end, 10);
+		if(end == ent->d_name + len || *end != '\0' || no < 0)
+		{
+			continue;
+		}
+		if(num >= max)
+		{
+			dprintf(WARN, "too many %s. ignore %s\n", prefix, ent->d_name);
+			continue;
+		}
+		index[num++] = (int)no;
+	}
+	closedir(dir);
+
+	qsort(index, num, sizeof(int), ThermCompare);
+	return num;
+}
+
+/*============================================================================*/
+/*
+ * @brief   番号比較(qsort用)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ThermCompare(const void *a, const void *b)
+{
+	return *(const int *)a - *(const int *)b;
+}
+
+/*============================================================================*/
+/*
+ * @brief   読み込みファイル設定
+ * @param   引数  : file	ファイル
+ * @param   引数  : format	パス名の書式
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ThermFileInit(thermFile *file, const char *format, ...)
+{
+	va_list ap;
+
+	va_start(ap, format);
+	vsnprintf(file->path, sizeof(file->path), format, ap);
+	va_end(ap);
+	file->file.path = file->path;
+	file->file.fd = -1;
+}
+
+/*============================================================================*/
+/*
+ * @brief   数値ファイル読み込み(1回のみ)
+ * @note    読み込み後にクローズする．
+ * @param   引数  : file	ファイル
+ * @param   引数  : value	読み込んだ値
+ * @return  戻り値: 0:正常，-1:異常
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int ThermReadOnce(thermFile *file, int64_t *value)
+{
+	int ret;
+
+	ret = com_procfs_read_i64(&file->file, value);
+	com_procfs_close(&file->file);
+	return ret;
+}
+
+/*============================================================================*/
+/*
+ * @brief   種別名読み込み
+ * @note    末尾の改行を除いて格納する．読めなければ空文字とする．
+ * @param   引数  : path	typeファイル
+ * @param   引数  : type	格納先
+ * @param   引数  : size	格納先サイズ
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static void ThermReadType(const char *path, char *type, int size)
+{
+	procfsFile file = COM_PROCFS_FILE(path);
+	int len;
+
+	len = com_procfs_read(&file, type, size);
+	com_procfs_close(&file);
+	if(len < 0)
+	{
+		len = 0;
+	}
+	while(len > 0 && (type[len - 1] == '\n' || type[len - 1] == ' '))
+	{
+		len--;
+	}
+	type[len] = '\0';
+}
+
+/*============================================================================*/
+/*
+ * @brief   トリップ温度取得
+ * @note    passive/hot/criticalのトリップポイントのうち最も低い温度を返す．
+ * @param   引数  : zone	thermal zone番号
+ * @return  戻り値: トリップ温度[1/1000℃](無し:0)
+ * @date    2026/10/19 [0.0.1] 新規作成
+ */
+/*============================================================================*/
+static int32_t ThermTrip(int zone)
+{
+	char path[DEF_PROCFS_PATH_MAX];
+	char type[DEF_THERM_TYPE_LEN];
+	thermFile file;
+	int64_t value;
+	int32_t trip = 0;
+
+	for(int i = 0; i < DEF_THERM_TRIP_MAX; i++)
+	{
+		snprintf(path, sizeof(path), DEF_THERM_SYSFS "/thermal_zone%d/trip_point_%d_type", zone, i);
+		if(access(path, R_OK) != 0)
+		{
+			break;
+		}
+		ThermReadType(path, type, sizeof(type));
+		if(strcmp(type, "passive") != 0 && strcmp(type, "hot") != 0 && strcmp(type, "critical") != 0)
+		{
+			continue;
+		}
+		ThermFileInit(&file, DEF_THERM_SYSFS "/thermal_zone%d/trip_point_%d_temp", zone, i);
+		if(ThermReadOnce(&file, &value) == 0 && value > 0 && (trip == 0 || value < trip))
+		{
+			trip = (int32_t)value;
+		}
+	}
+
+	return trip;
+}
@@ -33,6 +33,9 @@
 /* ************************************************************************** */
 #define DEF_FS_ERR_MAX	(34)									/* エラーコード最大値（エラー一覧数） */									
 #define DEF_FS_SHMEM_NAME	"/failsafeinfo"						/* 共有メモリ名 */
+#define DEF_FS_EXT_SHMEM_NAME	"/failsafeext"					/* 拡張監視の共有メモリ名 */
+#define DEF_FS_EXT_MAX	(64)									/* 拡張監視の最大数 */
+#define DEF_FS_EXT_NAME_LEN	(32)								/* 拡張監視名の最大長(NUL含む) */
 
 //* ************************************************************************** */
 /* typedef 定義                                                               */
@@ -56,6 +59,19 @@ typedef struct{
 	int32_t				ecu;									/* ECU通信異常 */
 }failsafeInfo;
 
+/* 拡張監視情報(設定ファイルのグループ名で識別する監視項目) */
+typedef struct{
+	char				name[DEF_FS_EXT_NAME_LEN];				/* 監視名("THERM.CPU-therm"等) */
+	int32_t				value;									/* リソース値 */
+	int32_t				thresh;									/* 故障閾値 */
+	int32_t				level;									/* 故障レベル */
+}failsafeExtEntry;
+
+typedef struct{
+	int32_t				num;									/* 監視数 */
+	failsafeExtEntry	entry[DEF_FS_EXT_MAX];					/* 監視項目 */
+}failsafeExt;
+
 /* 故障管理一覧表 */
 typedef struct{
 	uint32_t		errcode;									/* エラーコード */
@@ -120,6 +136,7 @@ typedef enum{
 /* プロトタイプ宣言(公開関数)                                                 */
 /* ************************************************************************** */
 extern int32_t com_fs_getfail(uint32_t errcode);
+extern int32_t com_fs_getfail_ext(const char *name);
 
 
 #endif /* __COM_FS_H */
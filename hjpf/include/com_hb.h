@@ -0,0 +1,73 @@
+/*============================================================================*/
+/*
+ * @file    com_hb.h
+ * @brief   ハートビート
+ * @note    管理プロセスは周期処理毎にcom_hb_beat()を呼び出し，共有メモリ(/heartbeat)の
+ *          自プロセスの欄を更新する．hjpfはprocess.confのdeadline=以内に更新されない
+ *          プロセスを停止(ハング)とみなし，restart=に従って再起動する．
+ *          standby=1の待機インスタンスは初期化後にcom_hb_standby()で停止し，
+ *          稼働中のプロセスが終了した時点でhjpfがSIGCONTで再開させる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __COM_HB_H
+#define __COM_HB_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_HB_SHMEM_NAME	"/heartbeat"		/* 共有メモリ名 */
+#define DEF_HB_ENV			"HJPF_HEARTBEAT"	/* 欄番号を渡す環境変数 */
+#define DEF_HB_MAX			(128)				/* 欄の数(DEF_PROC_MAX) */
+#define DEF_HB_STANDBY_ENV	"HJPF_STANDBY"		/* 待機インスタンスに渡す環境変数 */
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+
+/*============================================================================*/
+/* struct */
+/*============================================================================*/
+typedef struct _hbEntry {		/* 管理プロセス毎の欄 */
+	uint64_t	count;			/* 更新回数(起動毎に0から) */
+	uint64_t	stamp;			/* 最終更新時刻[ns](CLOCK_MONOTONIC，0:未更新) */
+	int32_t		pid;			/* プロセスID(hjpfが書き込む) */
+	int32_t		deadline;		/* 更新期限[ms](hjpfが書き込む) */
+} hbEntry;
+
+typedef struct _hbStat {
+	int32_t		num;			/* 管理プロセス数 */
+	int32_t		reserve;
+	hbEntry		entry[DEF_HB_MAX];	/* process.confの順番 */
+} hbStat;
+
+/*============================================================================*/
+/* func */
+/*============================================================================*/
+
+/*============================================================================*/
+/* extern(val) */
+/*============================================================================*/
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int com_hb_init(void);
+extern int com_hb_beat(void);
+extern void com_hb_term(void);
+extern int com_hb_standby(void);
+
+/*============================================================================*/
+/* Macro */
+/*============================================================================*/
+
+#endif	/* __COM_HB_H */
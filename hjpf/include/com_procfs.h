@@ -0,0 +1,79 @@
+/*============================================================================*/
+/*
+ * @file    com_procfs.h
+ * @brief   procfs/sysfs読み込み
+ * @note    ファイルをオープンしたまま保持し，pread()で再読込する．
+ *          読み込んだ内容は呼び出し元のバッファ上でメモリ確保なしに解析する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __COM_PROCFS_H
+#define __COM_PROCFS_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_PROCFS_PATH_MAX		(128)	/* パス名の最大サイズ */
+
+/* 静的初期化子 */
+#define COM_PROCFS_FILE(path)	{ path, -1 }
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+
+/*============================================================================*/
+/* struct */
+/*============================================================================*/
+typedef struct _procfsFile {
+	const char	*path;			/* パス名 */
+	int			fd;				/* ファイルディスクリプタ(-1:未オープン) */
+} procfsFile;
+
+typedef struct _procfsScan {	/* 解析位置 */
+	const char	*pos;			/* 現在位置 */
+	const char	*eol;			/* 現在行の終端 */
+	const char	*end;			/* バッファ終端 */
+} procfsScan;
+
+/*============================================================================*/
+/* func */
+/*============================================================================*/
+
+/*============================================================================*/
+/* extern(val) */
+/*============================================================================*/
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int com_procfs_open(procfsFile *file, const char *path);
+extern int com_procfs_read(procfsFile *file, char *buf, int size);
+extern void com_procfs_close(procfsFile *file);
+extern int com_procfs_read_i64(procfsFile *file, int64_t *value);
+
+extern void com_procfs_scan_init(procfsScan *scan, const char *buf, int len);
+extern int com_procfs_scan_line(procfsScan *scan);
+extern int com_procfs_scan_key(procfsScan *scan, const char *key);
+extern int com_procfs_scan_word(procfsScan *scan, const char **word);
+extern int com_procfs_scan_skip(procfsScan *scan, int num);
+extern int com_procfs_scan_u64(procfsScan *scan, uint64_t *value);
+extern int com_procfs_scan_i64(procfsScan *scan, int64_t *value);
+
+extern int com_procfs_disk_usage(const char *path, int *percent);
+extern int com_procfs_cpulist(const char *str, uint8_t *mask, int max);
+
+/*============================================================================*/
+/* Macro */
+/*============================================================================*/
+
+#endif	/* __COM_PROCFS_H */
@@ -14,6 +14,7 @@
 /*============================================================================*/
 #include <semaphore.h>
 #include <stdint.h>
+#include <time.h>
 
 /*============================================================================*/
 /* typedef */
@@ -25,9 +26,12 @@
 #define	DEF_COM_SHMEM_FALSE		(-1)	/* エラー */
 #define	DEF_COM_SHMEM_TRUE		(0)		/* 正常終了 */
 #define DEF_COM_SHMEM_MODE		(0666)	/* 共有メモリオープンモード */
+#define DEF_COM_SHMEM_SEM_VALUE	(1)		/* セマフォ初期値(排他用) */
 #define DEF_COM_SHMEM_OFFSET	(0)		/* マッピングのオフセット */
 #define DEF_COM_SHMEM_PATH_MAX	(100)	/* 保存ファイル名の最大サイズ */
 #define DEF_COM_SHMEM_MAX		(128)	/* 共有メモリ数の最大値 */
+#define DEF_COM_SHMEM_LAT_BIN	(24)	/* 遅延ヒストグラムのビン数(ビンiは2^(i-1)～2^i[us]) */
+#define DEF_COM_SHMEM_TAIL_OFS(size)	(((size) + 7) & ~7)	/* 遅延情報の配置位置 */
 
 /*============================================================================*/
 /* enum */
@@ -54,7 +58,19 @@ typedef struct _shm_mng
 	enum shm_kind current;		/* カレント種別 */
 	void* address;			/* アドレス */
 	int32_t counter;		/* カウンタ */
+	uint64_t rdseq;			/* 最後に遅延を記録した書き込み番号 */
 } memoryInfo;
+
+/* 共有メモリ末尾に配置する遅延情報(セマフォで保護) */
+typedef struct _shm_latency
+{
+	uint64_t stamp;			/* デバイス到着時刻[ns](CLOCK_MONOTONIC，0:未設定) */
+	uint64_t seq;			/* 書き込み番号 */
+	uint64_t count;			/* 記録数 */
+	uint64_t sum;			/* 遅延合計[us] */
+	uint64_t max;			/* 遅延最大[us] */
+	uint32_t hist[DEF_COM_SHMEM_LAT_BIN];	/* 遅延ヒストグラム */
+} shmLatency;
 /*============================================================================*/
 /* func */
 /*============================================================================*/
@@ -73,6 +89,13 @@ int32_t com_shmem_read(int32_t, void*, int32_t);
 int32_t com_shmem_write(int32_t, void*, int32_t);
 void com_shmem_destroy(void);
 int32_t com_shmem_conf(char*);
+int32_t com_shmem_write_ts(int32_t, void*, int32_t, const struct timespec*);
+int32_t com_shmem_write_part(int32_t, int32_t, void*, int32_t);
+int32_t com_shmem_read_ts(int32_t, void*, int32_t, struct timespec*);
+int32_t com_shmem_latency(int32_t, shmLatency*, int32_t);
+uint64_t com_shmem_latency_pct(const shmLatency*, int32_t);
+int32_t com_shmem_set_size(char*, int32_t);
+int32_t com_shmem_get_size(int32_t);
 
 
 /*============================================================================*/
@@ -23,10 +23,18 @@
 /*============================================================================*/
 #define DEF_COMM_MSEC	(1000)
 #define DEF_COMM_TIMER_MAX	(128)
+#define DEF_CLOCK_SLOT_MAX	(256)					/* 仮想時刻でスリープできるタイマ数(全プロセス) */
+#define DEF_CLOCK_ENV		"HJPF_CLOCK"			/* 時刻源を指定する環境変数 */
+#define DEF_CLOCK_SIM		"sim"					/* 仮想時刻 */
+#define DEF_CLOCK_ENV_SIM	DEF_CLOCK_ENV "=" DEF_CLOCK_SIM	/* 管理プロセスに渡す環境変数 */
 
 /*============================================================================*/
 /* enum */
 /*============================================================================*/
+enum com_clock_kind {			/* 時刻源 */
+	COM_CLOCK_REAL = 0,			/* 実時刻(CLOCK_MONOTONIC) */
+	COM_CLOCK_SIM,				/* 仮想時刻(共有メモリ、テストドライバが進める) */
+};
 
 
 /*============================================================================*/
@@ -46,6 +54,12 @@
 /*============================================================================*/
 extern int com_timer_init(const int, int);
 extern int com_mtimer(const int);
+extern int com_timer_set_clock(const int);
+extern int com_timer_get_clock(void);
+extern int com_timer_clock_gettime(const clockid_t, struct timespec*);
+extern int com_timer_sim_advance(const struct timespec*);
+extern int com_timer_sim_step(struct timespec*);
+extern int com_timer_sim_wait(const int);
 
 /*============================================================================*/
 /* Macro */
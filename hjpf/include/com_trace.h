@@ -0,0 +1,81 @@
+/*============================================================================*/
+/*
+ * @file    com_trace.h
+ * @brief   トレース
+ * @note    処理区間・カウンタ・フローをスレッド毎のバッファに記録し、
+ *          Chrome trace形式(JSON)で出力する。
+ *          出力ファイルはchrome://tracingまたはPerfetto UIで表示できる。
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __COM_TRACE_H
+#define __COM_TRACE_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_TRACE_ENV			"HJPF_TRACE"	/* 出力ファイル(定義されていればトレース有効) */
+#define DEF_TRACE_THREAD_MAX	(64)			/* 同時に記録可能なスレッド数 */
+#define DEF_TRACE_EVENT_MAX		(16384)			/* スレッド毎の記録数(超えたら古いものから上書き) */
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum trace_type {				/* イベント種別 */
+	TRACE_TYPE_BEGIN = 'B',		/* 区間開始 */
+	TRACE_TYPE_END = 'E',		/* 区間終了 */
+	TRACE_TYPE_COUNTER = 'C',	/* カウンタ */
+	TRACE_TYPE_INSTANT = 'i',	/* 瞬間イベント */
+	TRACE_TYPE_FLOW_BEGIN = 's',/* フロー開始 */
+	TRACE_TYPE_FLOW_END = 'f',	/* フロー終了 */
+};
+
+/*============================================================================*/
+/* struct */
+/*============================================================================*/
+
+/*============================================================================*/
+/* func */
+/*============================================================================*/
+
+/*============================================================================*/
+/* extern(val) */
+/*============================================================================*/
+extern volatile int g_comTraceEnable;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int com_trace_start(const char *path);
+extern int com_trace_stop(void);
+extern int com_trace_dump(const char *path);
+extern void _com_trace(enum trace_type type, const char *name, int64_t value);
+
+/*============================================================================*/
+/* Macro */
+/*============================================================================*/
+/* nameは文字列リテラル等、静的領域の文字列を指定すること */
+#define TRACE_EVENT(type, name, value)	\
+	do {	\
+		if (g_comTraceEnable) {	\
+			_com_trace(type, name, value);	\
+		}	\
+	} while (0)
+
+#define TRACE_BEGIN(name)				TRACE_EVENT(TRACE_TYPE_BEGIN, name, 0)
+#define TRACE_END(name)					TRACE_EVENT(TRACE_TYPE_END, name, 0)
+#define TRACE_COUNTER(name, value)		TRACE_EVENT(TRACE_TYPE_COUNTER, name, value)
+#define TRACE_INSTANT(name, value)		TRACE_EVENT(TRACE_TYPE_INSTANT, name, value)
+#define TRACE_FLOW_BEGIN(name, id)		TRACE_EVENT(TRACE_TYPE_FLOW_BEGIN, name, id)
+#define TRACE_FLOW_END(name, id)		TRACE_EVENT(TRACE_TYPE_FLOW_END, name, id)
+
+#endif	/* __COM_TRACE_H */
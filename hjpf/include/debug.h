@@ -15,11 +15,31 @@
 /* Include */
 /*============================================================================*/
 #include <stdarg.h>
+#include <stdint.h>
 
 /*============================================================================*/
 /* Macro */
 /*============================================================================*/
 #define DLEVEL	"DLEVEL"
+#define DLOGFILE	"DLOGFILE"	// 非同期ログの出力先ファイル(未定義ならシスログ)
+
+// コンパイル時の最低ログレベル(これより詳細なdprintfは呼び出しごと除去される)
+// 例) CFLAGS=-DDEF_DLEVEL_MIN=3 でWARN以上のみ
+#ifndef DEF_DLEVEL_MIN
+#define DEF_DLEVEL_MIN	(5)
+#endif
+
+// 呼び出し箇所毎の出力上限[件/秒](超過分は抑止し、件数を後で出力)
+#ifndef DEF_DLOG_RATE_LIMIT
+#define DEF_DLOG_RATE_LIMIT	(10)
+#endif
+// FATAL・ERRORの呼び出し箇所毎の出力上限[件/秒](障害発生時の連続出力を残すため多めにする)
+#ifndef DEF_DLOG_RATE_LIMIT_ERROR
+#define DEF_DLOG_RATE_LIMIT_ERROR	(50)
+#endif
+
+#define DEF_DLEVEL_SHMEM_NAME	"/dlevel"	// モジュール別ログレベルの制御用共有メモリ
+#define DEF_DLEVEL_MODULE_MAX	(32)		// 制御用共有メモリのモジュール数
 
 #ifdef __DEBUG__
 
@@ -34,23 +54,81 @@ enum dlevel {
 	FATAL	= 1
 };
 
+enum dlog_module {				/* ログレベルを制御するモジュール */
+	DLOG_MOD_COMMON = 0,		/* 共通コンポーネント */
+	DLOG_MOD_MAIN,				/* hjpf.c */
+	DLOG_MOD_PROC,				/* process.c, proc*.c */
+	DLOG_MOD_RES,				/* resource.c, thermal.c等 */
+	DLOG_MOD_FAILSAFE,			/* failsafe.c */
+	DLOG_MOD_GNSS,				/* gnss.c */
+	DLOG_MOD_INS,				/* ins.c */
+	DLOG_MOD_IMU,				/* imu.c */
+	DLOG_MOD_ALTMT,				/* altmt.c */
+	DLOG_MOD_I2C,				/* i2c.c, bme680.c */
+	DLOG_MOD_PING,				/* ping.c */
+	DLOG_MOD_CAMERA,			/* camera.c */
+	DLOG_MOD_MAVLINK,			/* mavlink.c */
+	DLOG_MOD_OTHER,				/* その他 */
+	DLOG_MOD_MAX
+};
+
+/*============================================================================*/
+/* struct */
+/*============================================================================*/
+typedef struct _dlevelCtl {		/* 制御用共有メモリ(/dlevel) */
+	int32_t	level[DEF_DLEVEL_MODULE_MAX];	/* 0:既定値(環境変数DLEVEL)、1～5:ログレベル */
+} dlevelCtl;
+
+typedef struct _dlogSite {		/* dprintf呼び出し箇所毎の状態 */
+	int		module;				/* モジュール(-1:未解決) */
+	int		count;				/* 現在の1秒間の出力件数 */
+	long	window;				/* 現在の1秒間の開始時刻[s] */
+	int		suppressed;			/* 抑止件数 */
+} dlogSite;
+
+/*============================================================================*/
+/* extern(val) */
+/*============================================================================*/
+extern volatile int g_dlevel[DLOG_MOD_MAX];
+
 /*============================================================================*/
 /* extern(func) */
 /*============================================================================*/
 extern int _dprintf(enum dlevel dl, const char* file, int line, const char *fmt, ...);
+extern int debug_log_start(const char *path);
+extern int debug_log_stop(void);
+extern int _dlog_site_init(dlogSite *site, const char *file);
+extern int _dlog_ratelimit(dlogSite *site, int dl, const char *file, int line);
+extern int debug_module_find(const char *name);
+extern const char* debug_module_name(int module);
 
 /*============================================================================*/
 /* Macro */
 /*============================================================================*/
+#define DLOG_SITE_INIT	{ -1, 0, 0, 0 }
+
 #define dprintf(dl, ...)	\
-	_dprintf(dl, __FILE__, __LINE__, __VA_ARGS__)
+	do {	\
+		if ((int)(dl) <= DEF_DLEVEL_MIN) {	\
+			static dlogSite _dlogSite = DLOG_SITE_INIT;	\
+			if (_dlogSite.module < 0) {	\
+				_dlog_site_init(&_dlogSite, __FILE__);	\
+			}	\
+			if ((int)(dl) <= g_dlevel[_dlogSite.module] &&	\
+				_dlog_ratelimit(&_dlogSite, (dl), __FILE__, __LINE__)) {	\
+				_dprintf(dl, __FILE__, __LINE__, __VA_ARGS__);	\
+			}	\
+		}	\
+	} while (0)
 
 #else // __DEBUG__
 
 /*============================================================================*/
 /* Macro */
 /*============================================================================*/
-#define dprintf(dl, ...)
+#define dprintf(dl, ...)	do { } while (0)
+#define debug_log_start(path)	(0)
+#define debug_log_stop()	(0)
 
 #endif // __DEBUG__
 
@@ -40,6 +40,15 @@
 #define DEF_FS_SAFE		(0)										/* 無故障 */
 #define DEF_FS_FAIL_NOW	(1)										/* 現在故障 */
 #define DEF_FS_FAIL_PAST	(2)									/* 過去故障 */
+#define DEF_FS_EXT_THERM	"THERM."							/* 拡張監視:thermal zone温度(後ろに種別) */
+#define DEF_FS_EXT_THROTTLE	"THROTTLE"							/* 拡張監視:スロットリング中のCPU数 */
+#define DEF_FS_EXT_PSI		"PSI."								/* 拡張監視:PSI(後ろに<cpu|memory|io>.<some|full>) */
+#define DEF_FS_EXT_NET		"NET."								/* 拡張監視:ネットワーク(後ろに<インタフェース名>.<項目>) */
+#define DEF_FS_EXT_DISK		"DISK."								/* 拡張監視:ブロックデバイスI/O(後ろに<デバイス名>.<項目>) */
+#define DEF_FS_EXT_MOUNT	"MOUNT."							/* 拡張監視:マウントポイント使用量(後ろにマウントポイント) */
+#define DEF_FS_EXT_CPU		"CPU."								/* 拡張監視:CPU毎の負荷(後ろにCPU番号) */
+#define DEF_FS_EXT_CPU_ALL	"CPU.all"							/* 拡張監視:全CPUに同じ閾値を適用 */
+#define DEF_FS_EXT_THRESH_TRIP	(-1)							/* 閾値にトリップ温度を使う */
 
 /* ************************************************************************** */
 /* typedef 定義                                                               */
@@ -114,6 +123,7 @@ typedef struct{
 	int32_t*			thresh;									/* 故障閾値 */
 	int32_t*			resData;								/* リソース値 */
 	int32_t*			data;									/* 故障レベル */
+	const char*			confname;								/* 設定ファイルのグループ名 */
 //	int*				isstart;								
 }failsafeTable;
 
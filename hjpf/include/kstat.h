@@ -0,0 +1,90 @@
+/*============================================================================*/
+/*
+ * @file    kstat.h
+ * @brief   カーネル活動監視
+ * @note    コンテキストスイッチ，割り込み(IRQ毎・CPU毎)，ソフト割り込み(CPU毎)の
+ *          発生率を共有メモリ(/kstat)に書き込む．共有メモリのサイズは起動時の構成で決まる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __KSTAT_H
+#define __KSTAT_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_KSTAT_SHMEM_NAME "/kstat"		//カーネル活動共有メモリ名
+#define DEF_KSTAT_IRQ_MAX (512)				//監視するIRQ数の上限
+#define DEF_KSTAT_IRQ_SPARE (32)			//起動後に追加されるIRQ用の予備
+#define DEF_KSTAT_NAME_LEN (16)				//IRQ名("45"，"LOC"等)の最大長(NUL含む)
+#define DEF_KSTAT_DESC_LEN (48)				//IRQ説明(デバイス名等)の最大長(NUL含む)
+#define DEF_KSTAT_BUF_MAX (65536)			//interrupts読み込みバッファサイズ
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum kstat_softirq {					/* /proc/softirqsの種別 */
+	KSTAT_SOFTIRQ_HI = 0,
+	KSTAT_SOFTIRQ_TIMER,
+	KSTAT_SOFTIRQ_NET_TX,
+	KSTAT_SOFTIRQ_NET_RX,
+	KSTAT_SOFTIRQ_BLOCK,
+	KSTAT_SOFTIRQ_IRQ_POLL,
+	KSTAT_SOFTIRQ_TASKLET,
+	KSTAT_SOFTIRQ_SCHED,
+	KSTAT_SOFTIRQ_HRTIMER,
+	KSTAT_SOFTIRQ_RCU,
+	KSTAT_SOFTIRQ_MAX
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _kstatIrq{				/* IRQ */
+	char name[DEF_KSTAT_NAME_LEN];		/* IRQ名(/proc/interruptsの先頭列) */
+	char desc[DEF_KSTAT_DESC_LEN];		/* 説明(割り込みコントローラ，デバイス名等．長い場合は末尾) */
+	int32_t rate;						/* 全CPUの発生率[回/s] */
+	int32_t reserve;
+} kstatIrq;
+
+typedef struct _kernelStat{
+	int32_t cpu_num;					/* CPU数 */
+	int32_t irq_max;					/* IRQの格納可能数 */
+	int32_t irq_num;					/* IRQ数 */
+	int32_t interval;					/* 前回取得からの経過時間[ms](0:初回) */
+	int32_t ctxt_rate;					/* コンテキストスイッチ発生率[回/s] */
+	int32_t intr_rate;					/* 割り込み発生率(全IRQ)[回/s] */
+	int32_t softirq_rate;				/* ソフト割り込み発生率(全種別)[回/s] */
+	int32_t procs_running;				/* 実行可能タスク数 */
+	int32_t procs_blocked;				/* I/O待ちタスク数 */
+	int32_t reserve[3];
+	uint64_t ctxt;						/* コンテキストスイッチ回数(累計) */
+	uint64_t intr;						/* 割り込み回数(累計) */
+	uint8_t data[];						/* kstatIrq[irq_max]，int32_t[irq_max][cpu_num]，int32_t[KSTAT_SOFTIRQ_MAX][cpu_num]の順 */
+} kernelStat;
+
+/* IRQ一覧 */
+#define KSTAT_IRQ(st) ((kstatIrq *)(st)->data)
+/* IRQ irqのCPU毎の発生率[回/s] */
+#define KSTAT_IRQ_RATE(st, irq) \
+	((int32_t *)((st)->data + (st)->irq_max * sizeof(kstatIrq)) + (irq) * (st)->cpu_num)
+/* ソフト割り込みkind(enum kstat_softirq)のCPU毎の発生率[回/s] */
+#define KSTAT_SOFTIRQ_RATE(st, kind) \
+	((int32_t *)((st)->data + (st)->irq_max * sizeof(kstatIrq)) + ((st)->irq_max + (kind)) * (st)->cpu_num)
+
+/* 共有メモリサイズ */
+#define DEF_KSTAT_STAT_SIZE(irq, cpu) \
+	((int)(sizeof(kernelStat) + (irq) * sizeof(kstatIrq) + ((irq) + KSTAT_SOFTIRQ_MAX) * (cpu) * sizeof(int32_t)))
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int KstatInit(int cpu_num);
+extern int KstatUpdate(int id);
+
+#endif	/* __KSTAT_H */
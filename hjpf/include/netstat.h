@@ -0,0 +1,75 @@
+/*============================================================================*/
+/*
+ * @file    netstat.h
+ * @brief   ネットワークインタフェース監視
+ * @note    インタフェース毎の送受信量・エラー・破棄の発生率と，
+ *          無線インタフェースの信号強度・雑音・ビットレートを共有メモリ(/netstat)に書き込む．
+ *          共有メモリのサイズは起動時のインタフェース数で決まる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __NETSTAT_H
+#define __NETSTAT_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_NET_SHMEM_NAME "/netstat"		//ネットワーク共有メモリ名
+#define DEF_NET_IF_MAX (32)					//監視するインタフェース数の上限
+#define DEF_NET_IF_SPARE (8)				//起動後に追加されるインタフェース用の予備
+#define DEF_NET_NAME_LEN (16)				//インタフェース名の最大長(NUL含む，IFNAMSIZ)
+#define DEF_NET_BUF_MAX (8192)				//net/dev読み込みバッファサイズ
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _netIf{					/* インタフェース */
+	char name[DEF_NET_NAME_LEN];		/* インタフェース名 */
+	int32_t up;							/* 1:リンクアップ(IFF_UPかつIFF_RUNNING) */
+	int32_t wireless;					/* 1:無線インタフェース */
+	uint64_t rx_bytes;					/* 受信バイト数(累計) */
+	uint64_t tx_bytes;					/* 送信バイト数(累計) */
+	uint64_t rx_packets;				/* 受信パケット数(累計) */
+	uint64_t tx_packets;				/* 送信パケット数(累計) */
+	uint64_t rx_errors;					/* 受信エラー数(累計) */
+	uint64_t tx_errors;					/* 送信エラー数(累計) */
+	uint64_t rx_drop;					/* 受信破棄数(累計) */
+	uint64_t tx_drop;					/* 送信破棄数(累計) */
+	int64_t rx_bps;						/* 受信量[byte/s] */
+	int64_t tx_bps;						/* 送信量[byte/s] */
+	int32_t rx_pps;						/* 受信パケット数[個/s] */
+	int32_t tx_pps;						/* 送信パケット数[個/s] */
+	int32_t rx_err_ps;					/* 受信エラー[個/s] */
+	int32_t tx_err_ps;					/* 送信エラー[個/s] */
+	int32_t rx_drop_ps;					/* 受信破棄[個/s] */
+	int32_t tx_drop_ps;					/* 送信破棄[個/s] */
+	int32_t link;						/* 無線:リンク品質 */
+	int32_t level;						/* 無線:信号強度[dBm] */
+	int32_t noise;						/* 無線:雑音[dBm] */
+	int32_t bitrate;					/* 無線:ビットレート[kbit/s] */
+} netIf;
+
+typedef struct _netStat{
+	int32_t if_max;						/* インタフェースの格納可能数 */
+	int32_t if_num;						/* インタフェース数 */
+	int32_t interval;					/* 前回取得からの経過時間[ms](0:初回) */
+	int32_t reserve;
+	netIf ifs[];						/* インタフェース(if_max個) */
+} netStat;
+
+/* 共有メモリサイズ */
+#define DEF_NET_STAT_SIZE(num) ((int)(sizeof(netStat) + (num) * sizeof(netIf)))
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int NetInit(void);
+extern int NetUpdate(int id);
+extern const netIf* NetFind(const netStat *stat, const char *name);
+
+#endif	/* __NETSTAT_H */
@@ -0,0 +1,64 @@
+/*============================================================================*/
+/*
+ * @file    procacct.h
+ * @brief   プロセス毎のリソース使用量取得
+ * @note    管理プロセスの/proc/<pid>/stat，statm，io，smaps_rollupをオープンしたまま
+ *          保持し，前回との差分からCPU使用率・I/O量を求める．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __PROCACCT_H
+#define __PROCACCT_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+#include "com_procfs.h"
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_ACCT_PATH_LEN (40)				//"/proc/<pid>/smaps_rollup"の最大長
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum acct_file {						/* 読み込むファイル */
+	ACCT_FILE_STAT = 0,					//stat(utime，stime)
+	ACCT_FILE_STATM,					//statm(resident)
+	ACCT_FILE_IO,						//io(read_bytes，write_bytes)
+	ACCT_FILE_SMAPS,					//smaps_rollup(Pss)
+	ACCT_FILE_MAX
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procAcct{				/* プロセス毎の取得状態 */
+	int pid;							/* プロセスID(0:未オープン) */
+	procfsFile file[ACCT_FILE_MAX];		/* enum acct_file */
+	char path[ACCT_FILE_MAX][DEF_ACCT_PATH_LEN];
+	uint64_t ticks;						/* 前回のutime+stime[clock tick] */
+	uint64_t rd_bytes;					/* 前回のread_bytes */
+	uint64_t wr_bytes;					/* 前回のwrite_bytes */
+	uint64_t stamp;						/* 前回取得時刻[ms](0:初回) */
+} procAcct;
+
+typedef struct _procAcctValue{			/* 取得結果 */
+	float cpu;							/* CPU使用率(1CPU換算，topの%CPU相当)[%] */
+	float mem;							/* メモリ使用率(RSS/MemTotal，topの%MEM相当)[%] */
+	int32_t rss;						/* 常駐サイズ[kB] */
+	int32_t pss;						/* 比例配分サイズ[kB](-1:取得不可) */
+	int32_t rd_kbps;					/* ストレージ読み込み量[kB/s] */
+	int32_t wr_kbps;					/* ストレージ書き込み量[kB/s] */
+} procAcctValue;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ProcAcctOpen(procAcct *acct, int pid);
+extern int ProcAcctUpdate(procAcct *acct, procAcctValue *value);
+extern void ProcAcctClose(procAcct *acct);
+
+#endif	/* __PROCACCT_H */
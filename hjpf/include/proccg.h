@@ -0,0 +1,79 @@
+/*============================================================================*/
+/*
+ * @file    proccg.h
+ * @brief   管理プロセスのcgroup v2制御
+ * @note    process.confのグループ毎にDEF_CG_ROOT配下へ子cgroupを作成し，
+ *          cpu.max，cpu.weight，memory.high，memory.max，io.maxを設定する．
+ *          使用量はcpu.stat，memory.current，memory.eventsから取得する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __PROCCG_H
+#define __PROCCG_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+#include "com_procfs.h"
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_CG_MOUNT "/sys/fs/cgroup"		//cgroup v2のマウントポイント
+#define DEF_CG_ROOT DEF_CG_MOUNT "/hjpf"	//管理プロセスのcgroupの親
+#define DEF_CG_NAME_LEN (64)				//cgroup名(process.confのグループ名)の最大長
+#define DEF_CG_PATH_LEN (128)				//cgroupのディレクトリの最大長
+#define DEF_CG_FILE_LEN (32)				//cgroup配下のファイル名の最大長('/'，NUL含む)
+#define DEF_CG_VALUE_LEN (64)				//設定値の最大長
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum cg_file {							/* 読み込むファイル */
+	CG_FILE_CPU_STAT = 0,				//cpu.stat(usage_usec，throttled_usec)
+	CG_FILE_MEM_CURRENT,				//memory.current
+	CG_FILE_MEM_EVENTS,					//memory.events(high，max，oom_kill)
+	CG_FILE_MAX
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procCgConf{				/* process.confの設定(空文字列:設定しない) */
+	char cpu_max[DEF_CG_VALUE_LEN];		/* cpu.max("<quota> <period>"，"max <period>") */
+	int cpu_weight;						/* cpu.weight(1～10000，0:設定しない) */
+	char memory_high[DEF_CG_VALUE_LEN];	/* memory.high(バイト数，"64M"等) */
+	char memory_max[DEF_CG_VALUE_LEN];	/* memory.max */
+	char io_max[DEF_CG_VALUE_LEN];		/* io.max("<major>:<minor> rbps=… wbps=…") */
+} procCgConf;
+
+typedef struct _procCg{					/* 管理プロセス毎のcgroup */
+	char path[DEF_CG_PATH_LEN];			/* cgroupのディレクトリ(空:未作成) */
+	int procs_fd;						/* cgroup.procs(子プロセスが自身を登録する) */
+	procfsFile file[CG_FILE_MAX];		/* enum cg_file */
+	char file_path[CG_FILE_MAX][DEF_CG_PATH_LEN + DEF_CG_FILE_LEN];
+	int cpu_limit;						/* cpu.maxを設定済み(カーネルが制限する) */
+	int mem_limit;						/* memory.high/maxを設定済み(カーネルが制限する) */
+	uint64_t usage_usec;				/* 前回のusage_usec */
+	uint64_t throttled_usec;			/* 前回のthrottled_usec */
+	uint64_t stamp;						/* 前回取得時刻[ms](0:初回) */
+} procCg;
+
+typedef struct _procCgValue{			/* 取得結果 */
+	float cpu;							/* CPU使用率(1CPU換算)[%] */
+	float mem;							/* メモリ使用率(memory.current/MemTotal)[%] */
+	int32_t throttle;					/* cpu.maxによる抑制時間の割合[%] */
+	int32_t mem_events;					/* memory.high/max超過・OOM killの回数(累計) */
+} procCgValue;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ProcCgInit(void);
+extern int ProcCgCreate(procCg *cg, const char *name, const procCgConf *conf);
+extern int ProcCgAttach(procCg *cg);
+extern int ProcCgUpdate(procCg *cg, procCgValue *value);
+extern void ProcCgDestroy(procCg *cg);
+
+#endif	/* __PROCCG_H */
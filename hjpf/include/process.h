@@ -13,6 +13,10 @@
 /* include */
 /*============================================================================*/
 #include <stdio.h>
+#include "proccg.h"
+#include "procready.h"
+#include "procsched.h"
+#include "procperf.h"
 
 /*============================================================================*/
 /* define */
@@ -29,8 +33,6 @@
 #define DEF_MONIT_CYCLE (10)				//プロセス監視周期
 #define DEF_KILL_WAIT_CYCLE (100)			//プロセス終了待ち周期
 #define DEF_KILL_WAIT_NUM (10)				//プロセス終了待ち回数
-#define DEF_CPU_MIN (-1)					//設定パラメータcpuの最小値
-#define DEF_CPU_MAX (11)					//設定パラメータcpuの最大値
 #define DEF_PRIO_MIN (0)					//設定パラメータprioの最小値
 #define DEF_PRIO_MAX (99)					//設定パラメータprioの最大値
 #define DEF_PERIOD_MIN (0)					//設定パラメータperiodの最小値
@@ -42,18 +44,41 @@
 #define DEF_RESTART_WARN (1)				//プロセス再起動回数が1
 #define DEF_RESTART_FAIL (3)				//プロセス再起動回数が3(現在故障)
 #define DEF_CANCEL_RESTART_TIME (1000)		//プロセス再起動回数をリセットする経過時間のしきい値
+#define DEF_RESTART_BACKOFF_MAX (10000)		//再起動の待ち時間の上限[ms](periodから倍にする)
+#define DEF_RESTART_RETRY_TIME (60000)		//再起動をやめた後に再び起動するまでの時間[ms]
 #define DEF_PROC_SHMMNG_NAME "/procstat"	//プロセス管理の共有メモリ名
 #define DEF_TIMER_KIND_PROCESS (1)			//タイマID
 #define DEF_MAX_CPU_AND_MEM (3)				//CPUとメモリの使用上限をN回連続で超過した場合再起動
+#define DEF_REAP_WAIT (100)					//終了監視の待ち時間[ms](終了フラグの確認周期)
+#define DEF_REAP_EVENT_MAX (16)				//終了監視で1回に受け取るイベント数
+#define DEF_REAP_SIGNALFD (DEF_PROC_MAX)	//終了監視のイベント識別子:signalfd
+#define DEF_ENV_MAX (16)					//環境変数の最大数
+#define DEF_ENV_STR_MAX (128)				//環境変数の最大文字数("KEY=VALUE")
+#define DEF_RLIMIT_MAX (10)					//rlimitの最大数
+#define DEF_SPAWN_STACK (64 * 1024)			//起動時の子プロセスのスタックサイズ
+#define DEF_DEPEND_MAX (16)					//dependsの最大数
+#define DEF_READY_WARN_TIME (5000)			//起動完了待ちを警告する経過時間[ms]
+#define DEF_DEADLINE_MIN (0)				//設定パラメータdeadlineの最小値(0:ハートビートを監視しない)
+#define DEF_DEADLINE_INIT (10000)			//設定パラメータdeadline_initの既定値[ms]
+#define DEF_STANDBY_OFF (0)					//待機インスタンスなし
+#define DEF_STANDBY_ON (1)					//待機インスタンスあり
+#define DEF_STANDBY_WAIT_TIME (30000)		//待機インスタンスの初期化完了(停止)を待つ時間[ms]
+#define DEF_LOG_OFF (0)						//標準出力・標準エラー出力はhjpfの出力を引き継ぐ
+#define DEF_LOG_ON (1)						//標準出力・標準エラー出力をファイルに取り込む(既定)
 
 /*============================================================================*/
 /* typedef */
 /*============================================================================*/
+typedef struct _procRlimit		/* execve前に設定するrlimit */
+{
+	int resource;				/* RLIMIT_NOFILE等 */
+	unsigned long long value;	/* ソフト・ハード制限(RLIM_INFINITY:無制限) */
+} procRlimit;
+
 typedef struct _processInfo
 {
 	char cmd[DEF_CMD_MAX];
 	char top_cmd[DEF_CMD_MAX];
-	int cpu;
 	int prio;
 	int period;
 	int pid;
@@ -62,25 +87,91 @@ typedef struct _processInfo
 	int mem_rate;
 	int cnt_cpu;
 	int cnt_mem;
+	char name[DEF_CG_NAME_LEN];	/* グループ名 */
+	procCgConf cg;				/* cgroup設定 */
+	char env[DEF_ENV_MAX][DEF_ENV_STR_MAX];	/* 環境変数 */
+	int env_num;
+	procRlimit rlimit[DEF_RLIMIT_MAX];	/* rlimit */
+	int rlimit_num;
+	int depend[DEF_DEPEND_MAX];	/* 起動完了を待つプロセス(process.confの順番) */
+	int depend_num;
+	int state;					/* enum proc_state */
+	int ready_warn;				/* 起動完了待ちを警告済み */
+	procSched sched;			/* CPU割り当て・スケジューリングポリシー */
+	procSchedThread thread[DEF_PSCHED_THREAD_MAX];	/* スレッド毎の設定 */
+	int thread_num;
+	int deadline;				/* ハートビートの更新期限[ms](0:監視しない) */
+	int deadline_init;			/* 起動から初回のハートビートまでの期限[ms] */
+	int hb_kill;				/* ハートビート途絶で停止済み(再起動まで再判定しない) */
+	int standby;				/* 待機インスタンス(DEF_STANDBY_ON:あり) */
+	int log;					/* 標準出力・標準エラー出力の取り込み(DEF_LOG_ON:あり) */
 } processInfo;
 
+typedef struct _procSpawn		/* 子プロセスに渡す起動情報(CLONE_VMで親と共有) */
+{
+	int id;						/* process.confの順番 */
+	char *path;					/* 実行ファイル */
+	char **argv;
+	char **envp;
+	int err;					/* 失敗時のerrno(0:execve成功) */
+	const char *step;			/* 失敗した処理 */
+} procSpawn;
+
 typedef struct _procStat		/* プロセスの状態 */
 {
 	int num;
 	int stat[DEF_PROC_MAX];		/* 死活情報 */
 	float cpu[DEF_PROC_MAX];	/* CPU使用率 */
 	float mem[DEF_PROC_MAX];	/* Memory使用率 */
+	int pid[DEF_PROC_MAX];		/* プロセスID(未起動:-1) */
+	int rss[DEF_PROC_MAX];		/* 常駐サイズ[kB] */
+	int pss[DEF_PROC_MAX];		/* 比例配分サイズ[kB](-1:取得不可) */
+	int io_read[DEF_PROC_MAX];	/* ストレージ読み込み量[kB/s] */
+	int io_write[DEF_PROC_MAX];	/* ストレージ書き込み量[kB/s] */
+	int exit_code[DEF_PROC_MAX];	/* 前回終了時の終了コード(シグナルで終了:-1) */
+	int exit_signal[DEF_PROC_MAX];	/* 前回終了時のシグナル番号(0:シグナル以外) */
+	int throttle[DEF_PROC_MAX];	/* cgroupのcpu.maxによる抑制時間の割合[%] */
+	int mem_events[DEF_PROC_MAX];	/* cgroupのmemory.high/max超過・OOM killの回数 */
+	int start_ms[DEF_PROC_MAX];	/* 起動時刻[ms](プロセス管理開始から，未起動:-1) */
+	int ready_ms[DEF_PROC_MAX];	/* 起動完了時刻[ms](プロセス管理開始から，未完了:-1) */
+	int hang[DEF_PROC_MAX];		/* ハートビート途絶で停止した回数 */
+	int standby[DEF_PROC_MAX];	/* 切り替え待ちの待機インスタンスのプロセスID(-1:なし) */
+	int failover[DEF_PROC_MAX];	/* 待機インスタンスに切り替えた回数 */
+	int perf[PERF_EVENT_MAX][DEF_PROC_MAX];	/* perf_eventの1秒あたりの値(enum perf_event，取得不可:-1) */
+	int log_drop[DEF_PROC_MAX];	/* 標準出力・標準エラー出力の破棄量[byte](取り込みが間に合わない場合) */
 } procStat;
 
 typedef struct _processReStart
 {
-	int num;
-	int time;
+	int num;					/* 起動からDEF_CANCEL_RESTART_TIME以内に続けて終了した回数 */
+	int time;					/* 起動時刻[ms](プロセス管理開始から) */
+	int next;					/* 再起動する時刻[ms](プロセス管理開始から，-1:予定なし) */
+	int backoff;				/* 前回の再起動の待ち時間[ms](0:待ちなし) */
 } processReStart;
 
+typedef struct _procStandby		/* 待機インスタンス */
+{
+	int pid;					/* プロセスID(-1:なし) */
+	int state;					/* enum standby_state */
+	int start_ms;				/* 起動時刻[ms](プロセス管理開始から) */
+	int fail;					/* 連続して停止前に終了した回数(DEF_RESTART_FAIL以上:起動しない) */
+	procPerf perf;				/* perf_eventカウンタ(生成直後にオープンし，切り替え時に引き継ぐ) */
+} procStandby;
+
 /*============================================================================*/
 /* enum */
 /*============================================================================*/
+enum proc_state {				/* 起動状態 */
+	PROC_STATE_WAIT = 0,		//dependsの起動完了待ち
+	PROC_STATE_START,			//起動済み(ready=の条件待ち)
+	PROC_STATE_READY			//起動完了(再起動しても戻らない)
+};
+
+enum standby_state {			/* 待機インスタンスの状態 */
+	STANDBY_STATE_NONE = 0,		//なし
+	STANDBY_STATE_INIT,			//初期化中(com_hb_standby()での停止待ち)
+	STANDBY_STATE_READY			//停止済み(切り替え可能)
+};
 
 /*============================================================================*/
 /* struct */
@@ -0,0 +1,61 @@
+/*============================================================================*/
+/*
+ * @file    proclog.h
+ * @brief   管理プロセスの標準出力・標準エラー出力の取り込み
+ * @note    管理プロセス毎にパイプを作成して標準出力・標準エラー出力を接続し，
+ *          読み込みスレッド(epoll)が行頭に時刻を付けてリングバッファに格納する．
+ *          ファイルへの書き込みは別スレッドで行い，<DEF_PLOG_DIR>/<グループ名>.logを
+ *          DEF_PLOG_FILE_SIZE毎に.1，.2…と世代を切り替える．
+ *          リングバッファが満杯の場合は破棄して件数をログに残し，子プロセスを待たせない．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __PROCLOG_H
+#define __PROCLOG_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdatomic.h>
+#include <sys/types.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_PLOG_DIR "/tmp/hjpf"			//出力先ディレクトリ
+#define DEF_PLOG_PATH_LEN (128)				//出力先ファイルのパスの最大長
+#define DEF_PLOG_RING_SIZE (256 * 1024)		//リングバッファのサイズ[byte](2のべき乗)
+#define DEF_PLOG_PIPE_SIZE (256 * 1024)		//パイプのサイズ[byte](設定できない場合は既定のまま)
+#define DEF_PLOG_READ_SIZE (4096)			//1回に読み込むサイズ[byte]
+#define DEF_PLOG_FILE_SIZE (1024 * 1024)	//ファイルを切り替えるサイズ[byte]
+#define DEF_PLOG_FILE_NUM (4)				//ファイルの世代数(<名前>.log，.1～.3)
+#define DEF_PLOG_WAIT (100)					//読み込みの待ち時間[ms](終了フラグの確認周期)
+#define DEF_PLOG_WRITE_CYCLE (10)			//ファイルへの書き込み周期[ms]
+#define DEF_PLOG_EVENT_MAX (16)				//1回に受け取るイベント数
+#define DEF_PLOG_NICE (19)					//書き込みスレッドのnice値
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procLog{				/* 管理プロセス毎の取り込み状態 */
+	char path[DEF_PLOG_PATH_LEN];		/* 出力先ファイル */
+	int rfd;							/* パイプの読み込み側(-1:取り込まない) */
+	int wfd;							/* パイプの書き込み側(子プロセスの標準出力・標準エラー出力) */
+	int fd;								/* 出力先ファイル(-1:未オープン) */
+	off_t size;							/* 出力先ファイルのサイズ[byte] */
+	char *buf;							/* リングバッファ */
+	atomic_uint head;					/* 格納位置(読み込みスレッドのみ更新) */
+	atomic_uint tail;					/* 取り出し位置(書き込みスレッドのみ更新) */
+	int bol;							/* 次に格納するデータが行頭 */
+	unsigned int lost;					/* ログに残していない破棄量[byte] */
+	atomic_uint drop;					/* 破棄量の累計[byte] */
+} procLog;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ProcLogOpen(procLog *log, const char *name);
+extern int ProcLogStart(procLog *log, int num);
+extern void ProcLogTerm(procLog *log, int num);
+
+#endif	/* __PROCLOG_H */
@@ -0,0 +1,61 @@
+/*============================================================================*/
+/*
+ * @file    procperf.h
+ * @brief   プロセス毎のperf_eventカウンタ取得
+ * @note    管理プロセス毎にソフトウェアカウンタ(task-clock，context-switches，cpu-migrations，
+ *          page-faults，major-faults)と，PMUで使用できる場合はハードウェアカウンタ(cycles，
+ *          instructions，cache-misses)をオープンし，前回との差分から1秒あたりの値を求める．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __PROCPERF_H
+#define __PROCPERF_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_PERF_NONE (-1)					//取得不可(カウンタなし)
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum perf_event {						/* カウンタ(括弧内は1秒あたりの値の単位) */
+	PERF_EVENT_TASK_CLOCK = 0,			//task-clock(ms/s)
+	PERF_EVENT_CTX_SWITCH,				//context-switches(回/s)
+	PERF_EVENT_MIGRATION,				//cpu-migrations(回/s)
+	PERF_EVENT_FAULT,					//page-faults(回/s)
+	PERF_EVENT_MAJ_FAULT,				//major-faults(回/s)
+	PERF_EVENT_CYCLES,					//cycles(M/s，PMUのみ)
+	PERF_EVENT_INSTRUCTIONS,			//instructions(M/s，PMUのみ)
+	PERF_EVENT_CACHE_MISS,				//cache-misses(k/s，PMUのみ)
+	PERF_EVENT_MAX
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procPerf{				/* プロセス毎の取得状態 */
+	int pid;							/* プロセスID(0:未オープン) */
+	int fd[PERF_EVENT_MAX];				/* perf_eventのファイルディスクリプタ(-1:なし) */
+	uint64_t count[PERF_EVENT_MAX];		/* 前回の値(多重化時は補正後) */
+	uint64_t stamp;						/* 前回取得時刻[ns](0:初回) */
+} procPerf;
+
+typedef struct _procPerfValue{			/* 取得結果 */
+	int32_t rate[PERF_EVENT_MAX];		/* 1秒あたりの値(enum perf_event，DEF_PERF_NONE:取得不可) */
+} procPerfValue;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ProcPerfInit(void);
+extern int ProcPerfOpen(procPerf *perf, int pid);
+extern int ProcPerfUpdate(procPerf *perf, procPerfValue *value);
+extern void ProcPerfClose(procPerf *perf);
+
+#endif	/* __PROCPERF_H */
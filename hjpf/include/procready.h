@@ -0,0 +1,59 @@
+/*============================================================================*/
+/*
+ * @file    procready.h
+ * @brief   管理プロセスの起動完了判定
+ * @note    process.confのready=で指定した条件(共有メモリへの書き込み，ソケットの待ち受け，
+ *          通知メッセージ)で起動完了を判定し，depends=で待っているプロセスを起動する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __PROCREADY_H
+#define __PROCREADY_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_READY_ARG_LEN (108)				//ready=の引数の最大長(sun_pathの長さ)
+#define DEF_READY_NOTIFY_SOCKET "@hjpf/notify"	//通知メッセージの受信ソケット(先頭@:抽象名前空間)
+#define DEF_READY_NOTIFY_ENV "NOTIFY_SOCKET=" DEF_READY_NOTIFY_SOCKET	//管理プロセスに渡す環境変数
+#define DEF_READY_NOTIFY_MSG "READY=1"		//起動完了の通知メッセージ
+#define DEF_READY_NOTIFY_LEN (256)			//通知メッセージの最大長
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum ready_kind {						/* 起動完了の条件 */
+	READY_KIND_START = 0,				//start:起動した時点(既定)
+	READY_KIND_SHMEM,					//shmem:<共有メモリ名>:起動後に書き込まれた時点
+	READY_KIND_SOCKET,					//socket:<パス>:UNIXソケットに接続できた時点
+	READY_KIND_NOTIFY,					//notify:NOTIFY_SOCKETに"READY=1"を送信した時点
+	READY_KIND_MAX
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procReady{				/* 管理プロセス毎の起動完了条件 */
+	int kind;							/* enum ready_kind */
+	char arg[DEF_READY_ARG_LEN];		/* 共有メモリ名，ソケットのパス */
+	int shm_id;							/* READY_KIND_SHMEMの共有メモリID(未オープン:-1) */
+	uint64_t launch;					/* 起動時刻[ns](CLOCK_MONOTONIC) */
+	int notified;						/* READY_KIND_NOTIFYの通知受信済み */
+} procReady;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ProcReadyParse(procReady *ready, const char *str);
+extern int ProcReadyInit(void);
+extern void ProcReadyLaunch(procReady *ready);
+extern int ProcReadyPoll(procReady *ready);
+extern int ProcReadyNotify(int *pid, int max);
+extern void ProcReadyTerm(procReady *ready, int num);
+
+#endif	/* __PROCREADY_H */
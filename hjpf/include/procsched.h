@@ -0,0 +1,64 @@
+/*============================================================================*/
+/*
+ * @file    procsched.h
+ * @brief   管理プロセスのCPU割り当て・スケジューリングポリシー設定
+ * @note    process.confのcpu(CPUリスト，isolated，housekeeping)，policy(SCHED_DEADLINEを含む)，
+ *          thread(スレッド名毎のポリシー)を解析し，sched_setaffinity，sched_setattrで設定する．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __PROCSCHED_H
+#define __PROCSCHED_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_PSCHED_CPU_MAX (256)				//CPUリストで指定できるCPU番号の上限
+#define DEF_PSCHED_LIST_LEN (256)				//CPUリスト，threadの1項目の最大長
+#define DEF_PSCHED_COMM_LEN (16)				//スレッド名の最大長(TASK_COMM_LEN)
+#define DEF_PSCHED_THREAD_MAX (8)				//threadの最大数
+#define DEF_PSCHED_TID_MAX (64)					//設定済みスレッドの記録数
+#define DEF_PSCHED_DL_MIN (1024)				//SCHED_DEADLINEの実行時間の最小値[ns](カーネルの制限)
+#define DEF_PSCHED_CPU_ISOLATED "/sys/devices/system/cpu/isolated"	//isolcpusのCPU
+#define DEF_PSCHED_CPU_NOHZ "/sys/devices/system/cpu/nohz_full"	//nohz_fullのCPU
+#define DEF_PSCHED_CPU_ONLINE "/sys/devices/system/cpu/online"		//オンラインのCPU
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _procSched{				/* CPU割り当て・スケジューリングポリシー */
+	int policy;							/* SCHED_OTHER，SCHED_FIFO，SCHED_DEADLINE等 */
+	int prio;							/* sched_priority(SCHED_FIFO，SCHED_RR:1～99) */
+	uint64_t runtime;					/* SCHED_DEADLINEの周期毎の実行時間[ns] */
+	uint64_t deadline;					/* SCHED_DEADLINEの相対デッドライン[ns] */
+	uint64_t period;					/* SCHED_DEADLINEの周期[ns] */
+	int cpu_num;						/* cpusのCPU数(0:割り当てない) */
+	uint64_t cpus[DEF_PSCHED_CPU_MAX / 64];	/* 割り当てるCPU(ビットマスク) */
+} procSched;
+
+typedef struct _procSchedThread{		/* スレッド毎の設定(process.confのthread) */
+	char comm[DEF_PSCHED_COMM_LEN];		/* スレッド名(末尾*:前方一致) */
+	procSched sched;
+} procSchedThread;
+
+typedef struct _procSchedTask{			/* 設定済みスレッド(管理プロセス毎) */
+	int num;
+	int tid[DEF_PSCHED_TID_MAX];
+} procSchedTask;
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ProcSchedInit(void);
+extern int ProcSchedParseCpu(procSched *sched, const char *str);
+extern int ProcSchedParsePolicy(procSched *sched, const char *str, int prio, const uint64_t *dl);
+extern int ProcSchedParseThread(procSchedThread *thread, const char *str);
+extern int ProcSchedApply(int tid, const procSched *sched, const char **step);
+extern void ProcSchedThreads(int pid, const procSchedThread *thread, int num, procSchedTask *task);
+
+#endif	/* __PROCSCHED_H */
@@ -0,0 +1,85 @@
+/*============================================================================*/
+/*
+ * @file    reshist.h
+ * @brief   リソース履歴
+ * @note    リソース監視の値を複数の分解能のリングバッファ(最小・平均・最大)として
+ *          共有メモリ(/reshist)に保持する．読み込み側は1回の読み込みで傾向を得られる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __RESHIST_H
+#define __RESHIST_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+#include "resource.h"
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_HIST_SHMEM_NAME "/reshist"		//リソース履歴共有メモリ名
+#define DEF_HIST_LEVEL_MAX (3)				//分解能の段数
+#define DEF_HIST_L0_LEN (1000)				//段0の件数(周期は最も短い取得周期，1秒周期で約16分)
+#define DEF_HIST_L1_PERIOD (1000)			//段1の周期[ms]
+#define DEF_HIST_L1_LEN (600)				//段1の件数(10分)
+#define DEF_HIST_L2_PERIOD (60000)			//段2の周期[ms]
+#define DEF_HIST_L2_LEN (1440)				//段2の件数(24時間)
+
+/*============================================================================*/
+/* enum */
+/*============================================================================*/
+enum hist_kind {						/* 履歴を保持する項目 */
+	HIST_KIND_CPU = 0,					//CPU負荷(全体)[%]
+	HIST_KIND_MEM,						//メモリ使用[%]
+	HIST_KIND_DISK,						//ディスク使用量(最大)[%]
+	HIST_KIND_THERM,					//CPU温度[1/1000℃]
+	HIST_KIND_PSI_CPU,					//PSI cpu some(10秒平均)[1/100%]
+	HIST_KIND_PSI_MEM,					//PSI memory some(10秒平均)[1/100%]
+	HIST_KIND_PSI_IO,					//PSI io some(10秒平均)[1/100%]
+	HIST_KIND_DISK_UTIL,				//ブロックデバイス稼働率(最大)[%]
+	HIST_KIND_MAX
+};
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _histValue{				/* 1周期分の値 */
+	int32_t min;
+	int32_t avg;
+	int32_t max;
+} histValue;
+
+typedef struct _histRing{				/* 分解能毎のリングバッファ */
+	int32_t period;						/* 周期[ms] */
+	int32_t len;						/* 件数 */
+	int32_t head;						/* 次の書き込み位置 */
+	int32_t count;						/* 有効な件数(len以下) */
+	int32_t offset;						/* data[]での先頭位置(件数単位) */
+	int32_t reserve;
+	uint64_t stamp;						/* 最新の値の時刻[ms](CLOCK_MONOTONIC) */
+} histRing;
+
+typedef struct _resHist{
+	int32_t kind_num;					/* 項目数(HIST_KIND_MAX) */
+	int32_t level_num;					/* 分解能の段数 */
+	int32_t reserve[2];
+	histRing ring[DEF_HIST_LEVEL_MAX];	/* [0]:最も細かい分解能 */
+	histValue data[];					/* 段毎にhistValue[len][kind_num] */
+} resHist;
+
+/* 段levelのidx番目の値(histValue[kind_num]) */
+#define HIST_ENTRY(h, level, idx) ((h)->data + ((h)->ring[level].offset + (idx)) * (h)->kind_num)
+
+/* 共有メモリサイズ */
+#define DEF_HIST_SIZE \
+	((int)(sizeof(resHist) + (DEF_HIST_L0_LEN + DEF_HIST_L1_LEN + DEF_HIST_L2_LEN) * HIST_KIND_MAX * sizeof(histValue)))
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int HistInit(void);
+extern int HistUpdate(int id, const resourceStat *stat, int period);
+
+#endif	/* __RESHIST_H */
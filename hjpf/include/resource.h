@@ -13,19 +13,40 @@
 /* include */
 /*============================================================================*/
 #include <stdio.h>
+#include <stdint.h>
 
 /*============================================================================*/
 /* define */
 /*============================================================================*/
 #define DEF_RES_TEST (0)					//リソーステスト用
 #define DEF_STR_MAX (256)					//文字最大数
-#define DEF_CPU_NUM (12)					//CPU数
+#define DEF_CPU_NUM (12)					//CPU数(互換用の固定配列cpu_load[]のサイズ)
+#define DEF_RES_CPU_MAX (256)					//対応CPU数の上限
+#define DEF_RES_CPU_POSSIBLE "/sys/devices/system/cpu/possible"	//実装CPU一覧
+#define DEF_RES_CPU_ONLINE "/sys/devices/system/cpu/online"		//オンラインCPU一覧
 #define DEF_DECIMAL (10)					//数値変換時の基数
 #define DEF_PERIOD_MIN (0)					//収集周期の最小(監視しない)
 #define DEF_MONIT_CYCLE (10)				//監視周期
 #define DEF_RES_SHMMNG_NAME "/resstat"		//リソース共有メモリ名
 #define DEF_TIMER_KIND_RESOURCE (2)			//タイマID
 #define DEF_PING_MAX (10)
+#define DEF_RES_PROCBUF_MAX (4096)			//procfs読み込みバッファサイズ
+#define DEF_RES_DISK_PATH "/"				//ディスク使用量の対象(設定ファイルにmountが無い場合)
+#define DEF_RES_DISK_MAX (8)				//I/Oを監視するブロックデバイス数の上限
+#define DEF_RES_MOUNT_MAX (8)				//使用量を監視するマウントポイント数の上限
+#define DEF_RES_DISK_NAME_LEN (16)			//ブロックデバイス名の最大長(NUL含む)
+#define DEF_RES_MOUNT_PATH_LEN (32)			//マウントポイントの最大長(NUL含む)
+#define DEF_RES_DISKSTATS_BUF_MAX (16384)	//diskstats読み込みバッファサイズ
+#define DEF_RES_THERM_PATH "/sys/devices/virtual/thermal/thermal_zone0/temp"	//CPU温度
+#define DEF_RES_PSI_PATH "/proc/pressure/"	//PSI(Pressure Stall Information)
+#define DEF_RES_PSI_SECTION "psi"			//PSIの設定グループ名
+#define DEF_RES_PSI_WAIT (100)				//PSIトリガの待ち時間[ms](終了フラグの確認周期)
+#define DEF_RES_FS_CONF "failsafe.conf"		//適応周期で参照する故障閾値の設定ファイル(hjpf.cのスレッド表と同じ)
+#define DEF_RES_ADAPT_NEAR_URGENT (90)		//適応周期:閾値の90%以上で最小周期にする
+#define DEF_RES_ADAPT_DELTA_URGENT (10)		//適応周期:1回の変化が閾値の10%以上で最小周期にする
+#define DEF_RES_ADAPT_NEAR (70)				//適応周期:閾値の70%以上で周期を半分にする
+#define DEF_RES_ADAPT_DELTA (3)				//適応周期:1回の変化が閾値の3%以上で周期を半分にする
+#define DEF_RES_ADAPT_STABLE (1)			//適応周期:1回の変化が閾値の1%以下で周期を倍にする
 
 /*============================================================================*/
 /* enum */
@@ -35,9 +56,27 @@ enum res_kind {
 	RES_KIND_MEM_LOAD = 1,	
 	RES_KIND_DISK_LOAD = 2,
 	RES_KIND_CPU_THERM = 3,
+	RES_KIND_PSI = 4,					//以降は設定ファイルに無ければ監視しない
+	RES_KIND_KSTAT = 5,
+	RES_KIND_NET = 6,
+	RES_KIND_SCHED = 7,
+	RES_KIND_HIST = 8,					//他の種別の取得後に記録する(最後に置くこと)
 	RES_KIND_MAX
 };
 
+enum res_psi_kind {
+	RES_PSI_CPU = 0,
+	RES_PSI_MEMORY = 1,
+	RES_PSI_IO = 2,
+	RES_PSI_MAX
+};
+
+enum res_psi_trig {						//登録したPSIトリガの種別
+	RES_PSI_TRIG_NONE = 0,
+	RES_PSI_TRIG_SOME = 1,
+	RES_PSI_TRIG_FULL = 2
+};
+
 enum meminfo_kind{
 	MEMINFO_KIND_TOTAL = 0,
 	MEMINFO_KIND_FREE = 1,
@@ -47,32 +86,106 @@ enum meminfo_kind{
 	MEMINFO_KIND_MAX
 };
 
+enum diskstats_kind{					/* /proc/diskstatsのデバイス名以降の列 */
+	DISKSTATS_KIND_RD_IOS = 0,
+	DISKSTATS_KIND_RD_MERGES = 1,
+	DISKSTATS_KIND_RD_SECTORS = 2,
+	DISKSTATS_KIND_RD_TICKS = 3,		//[ms]
+	DISKSTATS_KIND_WR_IOS = 4,
+	DISKSTATS_KIND_WR_MERGES = 5,
+	DISKSTATS_KIND_WR_SECTORS = 6,
+	DISKSTATS_KIND_WR_TICKS = 7,		//[ms]
+	DISKSTATS_KIND_IN_FLIGHT = 8,
+	DISKSTATS_KIND_IO_TICKS = 9,		//[ms]
+	DISKSTATS_KIND_QUEUE_TICKS = 10,	//[ms]
+	DISKSTATS_KIND_MAX
+};
+
 /*============================================================================*/
 /* typedef */
 /*============================================================================*/
 typedef struct _resourceInfo{			/* リソース監視周期（リソース種別ごと） */
-	int period[RES_KIND_MAX];
+	int period[RES_KIND_MAX];			/* 現在の周期[ms] */
+	int period_min[RES_KIND_MAX];		/* 適応周期の最小[ms](0:固定周期) */
+	int period_max[RES_KIND_MAX];		/* 適応周期の最大[ms] */
+	int32_t scale[RES_KIND_MAX];		/* 適応周期の基準値(故障閾値，無ければ最大値) */
+	int32_t last[RES_KIND_MAX];			/* 適応周期の前回値 */
+	uint64_t next[RES_KIND_MAX];		/* 次回取得時刻[ms] */
 } resourceInfo;
 
+typedef struct _resCPUStat{				/* CPU毎の統計 */
+	int32_t online;						/* 1:オンライン，0:オフライン */
+	int32_t load;						/* CPU負荷[%] */
+	uint64_t user;						/* 以下，/proc/statの累積値[tick] */
+	uint64_t nice;
+	uint64_t system;
+	uint64_t idle;
+	uint64_t iowait;
+	uint64_t irq;
+	uint64_t softirq;
+	uint64_t steal;
+} resCPUStat;
+
+typedef struct _resPSIStat{				/* PSI(/proc/pressure/配下) */
+	int32_t some_avg10;					/* 一部のタスクが停滞した割合(10秒平均)[1/100%] */
+	int32_t some_avg60;					/* 同(60秒平均)[1/100%] */
+	int32_t full_avg10;					/* 全タスクが停滞した割合(10秒平均)[1/100%] */
+	int32_t full_avg60;					/* 同(60秒平均)[1/100%] */
+	uint64_t some_total;				/* 一部のタスクが停滞した累積時間[us] */
+	uint64_t full_total;				/* 全タスクが停滞した累積時間[us] */
+	uint32_t events;					/* トリガ発生回数(累計) */
+	int32_t trigger;					/* 登録済みトリガ([enum res_psi_trig]，0:未登録) */
+} resPSIStat;
+
+typedef struct _resDiskStat{			/* ブロックデバイス毎のI/O(/proc/diskstatsの差分) */
+	char name[DEF_RES_DISK_NAME_LEN];	/* デバイス名 */
+	int32_t rd_iops;					/* 読み込み回数[回/s] */
+	int32_t wr_iops;					/* 書き込み回数[回/s] */
+	int32_t rd_kbps;					/* 読み込み量[KiB/s] */
+	int32_t wr_kbps;					/* 書き込み量[KiB/s] */
+	int32_t rd_await;					/* 読み込み1回の平均所要時間(待ち含む)[us] */
+	int32_t wr_await;					/* 書き込み1回の平均所要時間(待ち含む)[us] */
+	int32_t svctm;						/* 1回の平均サービス時間[us] */
+	int32_t queue;						/* 平均キュー長[1/100] */
+	int32_t util;						/* 稼働率[%] */
+	int32_t inflight;					/* 処理中のI/O数 */
+} resDiskStat;
+
+typedef struct _resMountStat{			/* マウントポイント毎の使用量 */
+	char path[DEF_RES_MOUNT_PATH_LEN];	/* マウントポイント */
+	int32_t usage;						/* 使用量[%](-1:取得失敗) */
+	int32_t reserve;
+} resMountStat;
+
 typedef struct _resourceStat{
-	int cpu_load[DEF_CPU_NUM + 1];		/* CPU負荷 */
+	int cpu_load[DEF_CPU_NUM + 1];		/* CPU負荷(互換用，[0]:全体，[n]:CPU n-1) */
 	int mem_load;						/* メモリ使用 */
-	int disk_load;						/* ディスク使用量[%] */
+	int disk_load;						/* ディスク使用量[%](全マウントポイントの最大) */
 	int cpu_therm;						/* CPU温度[1/1000℃] */
+	int cpu_num;						/* CPU数(実装数) */
+	int cpu_online;						/* オンラインCPU数 */
+	resPSIStat psi[RES_PSI_MAX];		/* PSI([enum res_psi_kind]) */
+	int32_t disk_num;					/* ブロックデバイス数 */
+	int32_t mount_num;					/* マウントポイント数 */
+	resDiskStat disk[DEF_RES_DISK_MAX];	/* ブロックデバイス毎のI/O */
+	resMountStat mount[DEF_RES_MOUNT_MAX];	/* マウントポイント毎の使用量 */
+	resCPUStat cpu[];					/* CPU毎の統計([0]:全体，[n]:CPU n-1，cpu_num+1個) */
 } resourceStat;
 
+/* CPU数nの共有メモリサイズ */
+#define DEF_RES_STAT_SIZE(n) ((int)(sizeof(resourceStat) + ((n) + 1) * sizeof(resCPUStat)))
+
 typedef struct _linuxProcStat{
-	char name[DEF_STR_MAX];
-	int user;
-	int nice;
-	int system;
-	int idle;
-	int iowait;
-	int irq;
-	int softirq;
-	int steal;
-	int guest;
-	int guest_nice;
+	uint64_t user;
+	uint64_t nice;
+	uint64_t system;
+	uint64_t idle;
+	uint64_t iowait;
+	uint64_t irq;
+	uint64_t softirq;
+	uint64_t steal;
+	uint64_t guest;
+	uint64_t guest_nice;
 } linuxProcStat;
 
 typedef struct _confSectionTbl{
@@ -118,6 +231,7 @@ typedef struct _resThreadInfo {
 	void		*arg;
 	pthread_t	threadid;
 	int			*isStart;
+	const char	*name;		/* スレッド名(15文字以内) */
 } resThreadInfo;
 
 /*============================================================================*/
@@ -136,6 +250,7 @@ typedef struct _resThreadInfo {
 /* extern(func) */
 /*============================================================================*/
 extern void* ResMain(void* arg);
+extern int ResCPUInit(void);
 extern int com_serial_open(char *devname, int BaudRate);
 extern void com_serial_close(int fd);
 extern char *strtoks(char *s1, const char *s2);
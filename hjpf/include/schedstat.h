@@ -0,0 +1,66 @@
+/*============================================================================*/
+/*
+ * @file    schedstat.h
+ * @brief   スケジューリング遅延監視
+ * @note    hjpfのスレッドと管理プロセス(process.conf)のスレッド毎に，
+ *          実行待ち時間・実行時間・タイムスライス数(/proc/<pid>/task/<tid>/schedstat)を
+ *          取得し，実行待ち時間のヒストグラムを共有メモリ(/schedstat)に書き込む．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __SCHEDSTAT_H
+#define __SCHEDSTAT_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_SCHED_SHMEM_NAME "/schedstat"	//スケジューリング遅延共有メモリ名
+#define DEF_SCHED_TASK_MAX (256)			//監視するスレッド数の上限
+#define DEF_SCHED_COMM_LEN (16)				//スレッド名の最大長(NUL含む，TASK_COMM_LEN)
+#define DEF_SCHED_HIST_BIN (24)				//待ち時間ヒストグラムのビン数(ビンiは2^(i-1)～2^i[us])
+#define DEF_SCHED_SELF (-1)					//procの値:hjpf自身のスレッド
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _schedTask{				/* スレッド */
+	int32_t pid;						/* プロセスID */
+	int32_t tid;						/* スレッドID */
+	char comm[DEF_SCHED_COMM_LEN];		/* スレッド名 */
+	int32_t proc;						/* process.confの順番(DEF_SCHED_SELF:hjpf) */
+	int32_t policy;						/* スケジューリングポリシー(SCHED_FIFO等) */
+	int32_t prio;						/* リアルタイム優先度 */
+	int32_t run_pct;					/* 実行時間の割合[%] */
+	uint64_t run_ns;					/* 実行時間(累計)[ns] */
+	uint64_t wait_ns;					/* 実行待ち時間(累計)[ns] */
+	uint64_t slices;					/* タイムスライス数(累計) */
+	int32_t wait_avg;					/* 1スライスあたりの実行待ち時間(前回から)[us] */
+	int32_t wait_max;					/* wait_avgの最大[us] */
+	int32_t slice_avg;					/* 1スライスあたりの実行時間(前回から)[us] */
+	int32_t reserve;
+	uint32_t hist[DEF_SCHED_HIST_BIN];	/* 実行待ち時間のヒストグラム(前回からのwait_avgのビンにスライス数を加算) */
+} schedTask;
+
+typedef struct _schedStat{
+	int32_t task_max;					/* スレッドの格納可能数 */
+	int32_t task_num;					/* スレッド数 */
+	int32_t interval;					/* 前回取得からの経過時間[ms](0:初回) */
+	int32_t reserve;
+	schedTask task[];					/* スレッド(task_max個) */
+} schedStat;
+
+/* 共有メモリサイズ */
+#define DEF_SCHED_STAT_SIZE(num) ((int)(sizeof(schedStat) + (num) * sizeof(schedTask)))
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int SchedInit(void);
+extern int SchedUpdate(int id, const int *pid, int num);
+
+#endif	/* __SCHEDSTAT_H */
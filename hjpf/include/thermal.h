@@ -0,0 +1,77 @@
+/*============================================================================*/
+/*
+ * @file    thermal.h
+ * @brief   温度・冷却・周波数監視
+ * @note    全thermal zone，cooling device，CPU毎のcpufreqを監視し，
+ *          共有メモリ(/thermal)に書き込む．共有メモリのサイズは起動時の構成で決まる．
+ * @date    2026/10/19
+ */
+/*============================================================================*/
+#ifndef __THERMAL_H
+#define __THERMAL_H
+
+/*============================================================================*/
+/* include */
+/*============================================================================*/
+#include <stdint.h>
+
+/*============================================================================*/
+/* define */
+/*============================================================================*/
+#define DEF_THERM_SHMEM_NAME "/thermal"				//温度監視共有メモリ名
+#define DEF_THERM_SYSFS "/sys/class/thermal"		//thermal zone/cooling device
+#define DEF_THERM_CPUFREQ "/sys/devices/system/cpu/cpu%d/cpufreq/%s"	//cpufreq
+#define DEF_THERM_ZONE_MAX (32)						//監視するthermal zone数の上限
+#define DEF_THERM_COOL_MAX (32)						//監視するcooling device数の上限
+#define DEF_THERM_TRIP_MAX (16)						//参照するトリップポイント数の上限
+#define DEF_THERM_TYPE_LEN (24)						//種別名の最大長(NUL含む)
+
+/*============================================================================*/
+/* typedef */
+/*============================================================================*/
+typedef struct _thermZone{				/* thermal zone */
+	char type[DEF_THERM_TYPE_LEN];		/* 種別("CPU-therm"等) */
+	int32_t temp;						/* 温度[1/1000℃](取得失敗時はINT32_MIN) */
+	int32_t trip;						/* 最も低いpassive/hot/criticalトリップ温度[1/1000℃](無し:0) */
+} thermZone;
+
+typedef struct _thermCool{				/* cooling device */
+	char type[DEF_THERM_TYPE_LEN];		/* 種別("thermal-fan-est"等) */
+	int32_t cur;						/* 現在の冷却状態 */
+	int32_t max;						/* 最大の冷却状態 */
+	uint32_t count;						/* 冷却状態が上がった回数(累計) */
+} thermCool;
+
+typedef struct _thermFreq{				/* CPU毎の周波数 */
+	int32_t online;						/* 1:取得できた，0:オフライン等で取得できない */
+	int32_t cur;						/* 現在の周波数[kHz] */
+	int32_t max;						/* 現在の上限(scaling_max_freq)[kHz] */
+	int32_t hw_max;						/* ハードウェア上限(cpuinfo_max_freq)[kHz] */
+	int32_t throttled;					/* 1:上限がハードウェア上限より下がっている */
+	uint32_t count;						/* スロットリング開始回数(累計) */
+} thermFreq;
+
+typedef struct _thermalStat{
+	int32_t zone_num;					/* thermal zone数 */
+	int32_t cool_num;					/* cooling device数 */
+	int32_t cpu_num;					/* CPU数 */
+	int32_t throttled;					/* スロットリング中のCPU数 */
+	uint8_t data[];						/* thermZone[zone_num]，thermCool[cool_num]，thermFreq[cpu_num]の順 */
+} thermalStat;
+
+/* 各配列の先頭 */
+#define THERM_ZONE(st) ((thermZone *)(st)->data)
+#define THERM_COOL(st) ((thermCool *)((st)->data + (st)->zone_num * sizeof(thermZone)))
+#define THERM_FREQ(st) ((thermFreq *)((st)->data + (st)->zone_num * sizeof(thermZone) + (st)->cool_num * sizeof(thermCool)))
+
+/* 共有メモリサイズ */
+#define DEF_THERM_STAT_SIZE(zone, cool, cpu) \
+	((int)(sizeof(thermalStat) + (zone) * sizeof(thermZone) + (cool) * sizeof(thermCool) + (cpu) * sizeof(thermFreq)))
+
+/*============================================================================*/
+/* extern(func) */
+/*============================================================================*/
+extern int ThermInit(int cpu_num);
+extern int ThermUpdate(int id);
+
+#endif	/* __THERMAL_H */
@@ -4,7 +4,9 @@ import configparser
 import mmap
 import struct
 import numpy as np
+import signal
 import syslog
+import time
 from enum import Enum
 
 class ShmemKind(Enum):	# 種別
@@ -17,6 +19,29 @@ class ProcStat:
 	stat = [i for i in range(128)]
 	cpu = [i for i in range(128)]
 	mem = [i for i in range(128)]
+	pid = [i for i in range(128)]
+	rss = [i for i in range(128)]
+	pss = [i for i in range(128)]
+	io_read = [i for i in range(128)]
+	io_write = [i for i in range(128)]
+	exit_code = [i for i in range(128)]
+	exit_signal = [i for i in range(128)]
+	throttle = [i for i in range(128)]
+	mem_events = [i for i in range(128)]
+	start_ms = [i for i in range(128)]
+	ready_ms = [i for i in range(128)]
+	hang = [i for i in range(128)]
+	standby = [i for i in range(128)]
+	failover = [i for i in range(128)]
+	perf_task_clock = [i for i in range(128)]
+	perf_ctx_switch = [i for i in range(128)]
+	perf_migration = [i for i in range(128)]
+	perf_fault = [i for i in range(128)]
+	perf_maj_fault = [i for i in range(128)]
+	perf_cycles = [i for i in range(128)]
+	perf_instructions = [i for i in range(128)]
+	perf_cache_miss = [i for i in range(128)]
+	log_drop = [i for i in range(128)]
 
 	def fromByte(self, bytes):	#バイトを整数に変換
 		pos = 0
@@ -38,6 +63,28 @@ class ProcStat:
 		for i in range(self.num):
 			self.mem[i] = struct.unpack('<f', bytes[pos:pos+4])[0]
 			pos+=4
+
+		#プロセスID(未起動:-1)
+		pos = 1540
+		for i in range(self.num):
+			self.pid[i] = int.from_bytes(bytes[pos:pos+4], byteorder='little', signed=True)
+			pos+=4
+
+		#常駐サイズ，比例配分サイズ[kB]，I/O量[kB/s]，前回終了時の終了コード・シグナル，cgroupの抑制，
+		#起動・起動完了時刻[ms](未起動・未完了:-1)，ハートビート途絶で停止した回数，
+		#待機インスタンスのプロセスID(なし:-1)，切り替え回数，
+		#perf_eventの1秒あたりの値(task-clock[ms/s]，cycles・instructions[M/s]，cache-misses[k/s]，他[回/s]，取得不可:-1)，
+		#標準出力・標準エラー出力の破棄量[byte]
+		for name, pos in (('rss', 2052), ('pss', 2564), ('io_read', 3076), ('io_write', 3588),
+				('exit_code', 4100), ('exit_signal', 4612), ('throttle', 5124), ('mem_events', 5636),
+				('start_ms', 6148), ('ready_ms', 6660), ('hang', 7172), ('standby', 7684), ('failover', 8196),
+				('perf_task_clock', 8708), ('perf_ctx_switch', 9220), ('perf_migration', 9732), ('perf_fault', 10244),
+				('perf_maj_fault', 10756), ('perf_cycles', 11268), ('perf_instructions', 11780), ('perf_cache_miss', 12292),
+				('log_drop', 12804)):
+			values = getattr(self, name)
+			for i in range(self.num):
+				values[i] = int.from_bytes(bytes[pos:pos+4], byteorder='little', signed=True)
+				pos+=4
 		
 	def toByte(self):
 		#プロセス数
@@ -53,6 +100,16 @@ class ProcStat:
 		for i in range(128):
 			byte += struct.pack('<f', self.mem)
 
+		for i in range(128):
+			byte += self.pid[i].to_bytes(4, byteorder='little', signed=True)
+
+		for values in (self.rss, self.pss, self.io_read, self.io_write, self.exit_code, self.exit_signal,
+				self.throttle, self.mem_events, self.start_ms, self.ready_ms, self.hang, self.standby, self.failover,
+				self.perf_task_clock, self.perf_ctx_switch, self.perf_migration, self.perf_fault,
+				self.perf_maj_fault, self.perf_cycles, self.perf_instructions, self.perf_cache_miss, self.log_drop):
+			for i in range(128):
+				byte += values[i].to_bytes(4, byteorder='little', signed=True)
+
 		return byte
 
 class ResStat:
@@ -61,6 +118,12 @@ class ResStat:
 	disk_load = 0
 	cpu_therm = 0
 	cpu_num = 12
+	cpu_total = 0
+	cpu_online = 0
+	psi = []
+	disk = []
+	mount = []
+	cpu = []
 
 	def fromByte(self, bytes):
 		pos = 0
@@ -79,6 +142,68 @@ class ResStat:
 		self.cpu_therm = int.from_bytes(bytes[pos:pos+4], byteorder='little')
 		pos+=4
 
+		#CPU数(旧形式の共有メモリには無い)
+		if len(bytes) < pos + 8:
+			return
+		self.cpu_total = int.from_bytes(bytes[pos:pos+4], byteorder='little')
+		pos+=4
+		self.cpu_online = int.from_bytes(bytes[pos:pos+4], byteorder='little')
+		pos+=4
+
+		#PSI(cpu,memory,io，割合は1/100%，累積時間はus)
+		self.psi = []
+		for i in range(3):
+			stat = {}
+			stat['some_avg10'] = int.from_bytes(bytes[pos:pos+4], byteorder='little', signed=True)
+			stat['some_avg60'] = int.from_bytes(bytes[pos+4:pos+8], byteorder='little', signed=True)
+			stat['full_avg10'] = int.from_bytes(bytes[pos+8:pos+12], byteorder='little', signed=True)
+			stat['full_avg60'] = int.from_bytes(bytes[pos+12:pos+16], byteorder='little', signed=True)
+			stat['some_total'] = int.from_bytes(bytes[pos+16:pos+24], byteorder='little')
+			stat['full_total'] = int.from_bytes(bytes[pos+24:pos+32], byteorder='little')
+			stat['events'] = int.from_bytes(bytes[pos+32:pos+36], byteorder='little')
+			stat['trigger'] = int.from_bytes(bytes[pos+36:pos+40], byteorder='little', signed=True)
+			self.psi.append(stat)
+			pos += 40
+
+		#ブロックデバイス毎のI/O(8個)，マウントポイント毎の使用量(8個)
+		disk_num = int.from_bytes(bytes[pos:pos+4], byteorder='little')
+		mount_num = int.from_bytes(bytes[pos+4:pos+8], byteorder='little')
+		pos += 8
+		self.disk = []
+		for i in range(8):
+			if i < disk_num:
+				stat = {}
+				stat['name'] = bytes[pos:pos+16].split(b'\0')[0].decode()
+				p = pos + 16
+				for key in ['rd_iops', 'wr_iops', 'rd_kbps', 'wr_kbps', 'rd_await', 'wr_await', 'svctm', 'queue', 'util', 'inflight']:
+					stat[key] = int.from_bytes(bytes[p:p+4], byteorder='little', signed=True)
+					p += 4
+				self.disk.append(stat)
+			pos += 56
+		self.mount = []
+		for i in range(8):
+			if i < mount_num:
+				stat = {}
+				stat['path'] = bytes[pos:pos+32].split(b'\0')[0].decode()
+				stat['usage'] = int.from_bytes(bytes[pos+32:pos+36], byteorder='little', signed=True)
+				self.mount.append(stat)
+			pos += 40
+
+		#CPU毎の統計([0]:全体，online,load,user,nice,system,idle,iowait,irq,softirq,steal)
+		self.cpu = []
+		for i in range(self.cpu_total + 1):
+			if len(bytes) < pos + 72:
+				break
+			stat = {}
+			stat['online'] = int.from_bytes(bytes[pos:pos+4], byteorder='little')
+			stat['load'] = int.from_bytes(bytes[pos+4:pos+8], byteorder='little')
+			p = pos + 8
+			for key in ['user', 'nice', 'system', 'idle', 'iowait', 'irq', 'softirq', 'steal']:
+				stat[key] = int.from_bytes(bytes[p:p+8], byteorder='little')
+				p += 8
+			self.cpu.append(stat)
+			pos += 72
+
 	def toByte(self):
 		byte = bytes()
 		#CPU使用率
@@ -684,13 +809,55 @@ class FailsafeInfo():
 
 		return byte
 
+class ResHist():
+	#項目(reshist.hのenum hist_kind)
+	KIND = ['cpu', 'mem', 'disk', 'therm', 'psi_cpu', 'psi_mem', 'psi_io', 'disk_util']
+	ring = []
+	data = b''
+	kind_num = 0
+
+	def fromByte(self, bytes):
+		pos = 0
+		self.kind_num = int.from_bytes(bytes[pos:pos+4], byteorder='little')
+		level_num = int.from_bytes(bytes[pos+4:pos+8], byteorder='little')
+		pos += 16
+
+		#段毎のリングバッファ(period,len,head,count,offset,stamp)
+		self.ring = []
+		for i in range(level_num):
+			ring = {}
+			p = pos
+			for key in ['period', 'len', 'head', 'count', 'offset', 'reserve']:
+				ring[key] = int.from_bytes(bytes[p:p+4], byteorder='little', signed=True)
+				p += 4
+			ring['stamp'] = int.from_bytes(bytes[p:p+8], byteorder='little')
+			self.ring.append(ring)
+			pos += 32
+		self.data = bytes[pos:]
+
+	def series(self, level, kind):
+		#古い順の(min,avg,max)の一覧
+		ring = self.ring[level]
+		k = self.KIND.index(kind) if isinstance(kind, str) else kind
+		values = []
+		for i in range(ring['count']):
+			idx = (ring['head'] - ring['count'] + i) % ring['len']
+			p = ((ring['offset'] + idx) * self.kind_num + k) * 12
+			values.append(struct.unpack('<iii', self.data[p:p+12]))
+		return values
+
 class Shmem:
+	LATENCY_SIZE = 136			# 末尾の遅延情報のサイズ
+	LATENCY_BIN = 24			# 遅延ヒストグラムのビン数(ビンiは2^(i-1)～2^i[us])
+
 	dictConf = {}
 	shm = None					# 共有メモリ
+	sem = None					# セマフォ
 	size = 0
 	kind = ShmemKind.NONE
 	current = ShmemKind.NONE
 	mm = None					# アドレス
+	rdseq = 0					# 最後に遅延を記録した書き込み番号
 
 	def __init__(self, configfile):
 		config = configparser.ConfigParser()
@@ -732,6 +899,17 @@ class Shmem:
 			self.shm = None
 			return False
 
+		# 生成側でサイズを変更した場合(/resstat等)は実サイズを使う(末尾136バイトは遅延情報)
+		if self.shm.size > ((self.size + 7) & ~7) + self.LATENCY_SIZE:
+			self.size = self.shm.size - self.LATENCY_SIZE
+
+		# 遅延情報はセマフォで保護されている(無ければ遅延を記録しない)
+		try:
+			self.sem = ipc.Semaphore(name)
+		except:
+			self.sem = None
+		self.rdseq = 0
+
 		self.current = kind
 		
 		return True
@@ -745,7 +923,12 @@ class Shmem:
 			self.shm.close_fd()
 			self.shm = None
 
+		if self.sem is not None:
+			self.sem.close()
+			self.sem = None
+
 	def read(self):
+		# 遅延は記録しない(記録する場合はread_tsを使う)
 		if self.shm is None:
 			message = (str)(self.shm) + ' is none'
 			syslog.syslog(message)
@@ -758,6 +941,39 @@ class Shmem:
 			#print(self.size)
 			return self.mm.read(self.size)
 
+	def read_ts(self):
+		# データとデータ到着時刻[ns](CLOCK_MONOTONIC，未設定:0)を返し，新しいデータなら遅延をヒストグラムに記録する
+		# (C側のcom_shmem_read_tsに相当．com_shmem_read/readは記録しない)
+		if self.shm is None:
+			message = (str)(self.shm) + ' is none'
+			syslog.syslog(message)
+
+			return None, 0
+
+		if self.sem is None:
+			self.mm.seek(0)
+			return self.mm.read(self.size), 0
+
+		self.sem.acquire()
+		try:
+			# 先頭にシーク
+			self.mm.seek(0)
+			# 共有メモリ読み込み
+			bytes = self.mm.read(self.size)
+
+			pos = self.shm.size - self.LATENCY_SIZE
+			stamp, seq, count, total, peak = struct.unpack('<QQQQQ', self.mm[pos:pos+40])
+			if stamp != 0 and seq != self.rdseq:
+				age = max(time.monotonic_ns() - stamp, 0) // 1000
+				hist = pos + 40 + min(age.bit_length(), self.LATENCY_BIN - 1) * 4
+				self.mm[hist:hist+4] = struct.pack('<I', (struct.unpack('<I', self.mm[hist:hist+4])[0] + 1) & 0xffffffff)
+				self.mm[pos+16:pos+40] = struct.pack('<QQQ', count + 1, total + age, max(peak, age))
+				self.rdseq = seq
+		finally:
+			self.sem.release()
+
+		return bytes, stamp
+
 	def write(self, bytes):
 		if self.shm is None:
 			message = self.shm + ' is none'
@@ -772,7 +988,69 @@ class Shmem:
 				print(self.kind, self.current)
 				return None
 			else:
-				# 先頭にシーク
-				self.mm.seek(0)
-				# 共有メモリ書き込み
-				return self.mm.write(bytes)
+				# セマフォがあれば獲得して書き込む(C側のcom_shmem_writeと排他する)
+				if self.sem is not None:
+					self.sem.acquire()
+				try:
+					# 先頭にシーク
+					self.mm.seek(0)
+					# 共有メモリ書き込み
+					return self.mm.write(bytes)
+				finally:
+					if self.sem is not None:
+						self.sem.release()
+
+class Heartbeat:	# ハートビート(process.confでdeadlineを指定してhjpfから起動した場合のみ有効)
+	slot = -1					# 欄番号
+	count = 0					# 更新回数
+
+	def __init__(self, shm):
+		self.shm = shm
+
+	def open(self):
+		slot = os.environ.get('HJPF_HEARTBEAT')
+		if slot is None:
+			return False
+
+		if not self.shm.open('/heartbeat', ShmemKind.USER):
+			return False
+
+		self.slot = int(slot)
+		self.count = 0
+		return True
+
+	def beat(self):
+		if self.slot < 0:
+			return False
+
+		# 更新回数，最終更新時刻[ns](CLOCK_MONOTONIC)のみ書き込む(先頭8バイトはプロセス数，欄は24バイト)
+		# hjpfが途中の値を読まないよう，Shmem.writeと同じくセマフォを獲得して書き込む
+		self.count += 1
+		if self.shm.sem is not None:
+			self.shm.sem.acquire()
+		try:
+			self.shm.mm.seek(8 + self.slot * 24)
+			self.shm.mm.write(struct.pack('<QQ', self.count, time.monotonic_ns()))
+		finally:
+			if self.shm.sem is not None:
+				self.shm.sem.release()
+		return True
+
+	def standby(self):
+		# 待機インスタンス(process.confでstandby=1)の場合は停止し，hjpfが切り替えるまで戻らない
+		if os.environ.get('HJPF_STANDBY') is None:
+			return False
+
+		while True:
+			os.kill(os.getpid(), signal.SIGSTOP)
+			if self.slot < 0:
+				break
+
+			# hjpfが欄のプロセスIDを自プロセスに書き換えてから再開させる
+			self.shm.mm.seek(8 + self.slot * 24 + 16)
+			if int.from_bytes(self.shm.mm.read(4), byteorder='little', signed=True) == os.getpid():
+				break
+
+		del os.environ['HJPF_STANDBY']
+		self.count = 0
+		return True
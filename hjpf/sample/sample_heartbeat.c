@@ -0,0 +1,32 @@
+#include <stdio.h>
+#include "com_shmem.h"
+#include "com_timer.h"
+#include "com_hb.h"
+
+int main(void)
+{
+    //設定ファイルの読込
+    com_shmem_conf("../hjpf/memory.conf");
+
+    //タイマ初期設定
+    com_timer_init(10, 100);
+
+    //ハートビート開始(process.confでdeadlineを指定してhjpfから起動した場合のみ有効)
+    com_hb_init();
+
+    //待機インスタンス(process.confでstandby=1)の場合は切り替えまで停止
+    com_hb_standby();
+
+    while(1)
+    {
+        //処理
+        printf("sample\n");
+
+        //ハートビート更新(deadline以内に更新しない場合はhjpfが停止・再起動する)
+        com_hb_beat();
+
+        //スリープ
+        com_mtimer(10);
+    }
+    return 0;
+}
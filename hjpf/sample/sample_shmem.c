@@ -2,6 +2,7 @@
 #include <string.h>
 #include "com_shmem.h"
 #include "resource.h"
+#include "ins.h"
 
 //書き込み用サンプル構造体
 typedef struct _structSample{
@@ -32,6 +33,29 @@ void read_sample()
     com_shmem_close(id);
 }
 
+void read_ts_sample()
+{
+    int id;
+    STR_INS_INFO InsInfo;
+    struct timespec arrival;
+    shmLatency lat;
+
+    //共有メモリオープン
+    id = com_shmem_open(DEF_INS_SHMEM_NAME, SHM_KIND_USER);
+
+    //共有メモリ読込(データ到着からの経過時間を遅延ヒストグラムに記録)
+    com_shmem_read_ts(id, &InsInfo, sizeof(InsInfo), &arrival);
+    printf("ins arrival = %ld.%09ld\n", (long)arrival.tv_sec, arrival.tv_nsec);
+
+    //遅延情報の取得
+    com_shmem_latency(id, &lat, 0);
+    printf("ins latency count = %llu, p99 < %lluus\n",
+        (unsigned long long)lat.count, (unsigned long long)com_shmem_latency_pct(&lat, 99));
+
+    //共有メモリクローズ
+    com_shmem_close(id);
+}
+
 void write_sample()
 {
     int id;
@@ -57,6 +81,7 @@ int main(void)
     com_shmem_conf("../hjpf/memory.conf");
 
     read_sample();
+    read_ts_sample();
     write_sample();
     
     return 0;
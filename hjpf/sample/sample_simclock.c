@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <pthread.h>
+#include "com_shmem.h"
+#include "com_timer.h"
+
+#define SAMPLE_TIMER_FAST	10
+#define SAMPLE_TIMER_SLOW	11
+
+//周期処理スレッド
+void* sample_thread(void* arg)
+{
+    int id = *(int*)arg;
+    struct timespec now;
+
+    //タイマ初期設定(10ms/25ms周期)
+    com_timer_init(id, (id == SAMPLE_TIMER_FAST) ? 10 : 25);
+
+    while(1)
+    {
+        //スリープ
+        com_mtimer(id);
+
+        //処理(仮想時刻を表示)
+        com_timer_clock_gettime(CLOCK_MONOTONIC, &now);
+        printf("timer %d : %ld.%03ld\n", id, now.tv_sec, now.tv_nsec / 1000000);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t thread[2];
+    int id[2] = {SAMPLE_TIMER_FAST, SAMPLE_TIMER_SLOW};
+
+    //設定ファイルの読込
+    com_shmem_conf("../hjpf/memory.conf");
+
+    //仮想時刻に切替(com_timer_init前に行う)
+    //仮想時刻は共有メモリ(/simclock)にあり、HJPF_CLOCK=simで起動した
+    //hjpfと管理プロセスも同じ時刻で動作する(このプロセスが時刻を進める)
+    com_timer_set_clock(COM_CLOCK_SIM);
+
+    pthread_create(&thread[0], NULL, sample_thread, &id[0]);
+    pthread_create(&thread[1], NULL, sample_thread, &id[1]);
+
+    //30分相当を実時間によらず実行
+    for (int i = 0; i < 30 * 60 * 100; i++)
+    {
+        //全スレッドがスリープするまで待ち、次の起床時刻まで進める
+        com_timer_sim_wait(2);
+        com_timer_sim_step(NULL);
+    }
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/com_shmem.h"
+#include "debug.h"
+
+//モジュール別ログレベルの参照/変更
+//  dlevel                   : 現在値を表示
+//  dlevel <module> <level>  : ログレベルを変更(0:既定値 1:FATAL～5:DEBUG)
+//  dlevel all <level>       : 全モジュールのログレベルを変更
+
+int main(int argc, char *argv[])
+{
+	int id;
+	int module;
+	int level;
+	dlevelCtl ctl;
+
+	com_shmem_conf("../hjpf/memory.conf");
+
+	id = com_shmem_open(DEF_DLEVEL_SHMEM_NAME, SHM_KIND_USER);
+	if (id == DEF_COM_SHMEM_FALSE)
+	{
+		printf("%s com_shmem_open() error\n", DEF_DLEVEL_SHMEM_NAME);
+		return -1;
+	}
+	com_shmem_read(id, &ctl, sizeof(ctl));
+
+	if (argc == 3)
+	{
+		level = atoi(argv[2]);
+		if (level < 0 || DEBUG < level)
+		{
+			printf("level must be 0-%d\n", DEBUG);
+			com_shmem_close(id);
+			return -1;
+		}
+
+		module = debug_module_find(argv[1]);
+		for (int cnt = 0; cnt < DLOG_MOD_MAX; cnt++)
+		{
+			if (module == cnt || (module < 0 && strcmp(argv[1], "all") == 0))
+			{
+				ctl.level[cnt] = level;
+			}
+		}
+		com_shmem_write(id, &ctl, sizeof(ctl));
+	}
+
+	for (int cnt = 0; cnt < DLOG_MOD_MAX; cnt++)
+	{
+		printf("%-8s = %d\n", debug_module_name(cnt), ctl.level[cnt]);
+	}
+
+	com_shmem_close(id);
+	return 0;
+}
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include "../include/com_shmem.h"
 #include "process.h"
@@ -13,6 +14,11 @@
 #include "com_fs.h"
 #include "camera.h"
 #include "mavlink.h"
+#include "thermal.h"
+#include "kstat.h"
+#include "netstat.h"
+#include "reshist.h"
+#include "schedstat.h"
 
 //gcc -Include -c -o mem_read.o mem_read.c
 //gcc -o mem_read mem_read.o ../common/com_shmem.o ../debug/debug.o -lpthread -lrt
@@ -96,27 +102,289 @@ int main(void)
 	for(int i = 0; i < ProcStat.num; i++){
 		printf("proc mem[%d] = %f\n", i, ProcStat.mem[i]);
 	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc pid[%d] = %d\n", i, ProcStat.pid[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc rss[%d] = %d kB pss = %d kB io = %d/%d kB/s\n", i, ProcStat.rss[i], ProcStat.pss[i],
+			ProcStat.io_read[i], ProcStat.io_write[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc exit[%d] code = %d signal = %d\n", i, ProcStat.exit_code[i], ProcStat.exit_signal[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc cgroup[%d] throttle = %d %% mem events = %d\n", i, ProcStat.throttle[i], ProcStat.mem_events[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc boot[%d] start = %d ms ready = %d ms\n", i, ProcStat.start_ms[i], ProcStat.ready_ms[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc hang[%d] = %d\n", i, ProcStat.hang[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc standby[%d] pid = %d failover = %d\n", i, ProcStat.standby[i], ProcStat.failover[i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc perf[%d] task-clock = %d ms/s cs = %d/s migrations = %d/s faults = %d/s major = %d/s\n", i,
+			ProcStat.perf[PERF_EVENT_TASK_CLOCK][i], ProcStat.perf[PERF_EVENT_CTX_SWITCH][i],
+			ProcStat.perf[PERF_EVENT_MIGRATION][i], ProcStat.perf[PERF_EVENT_FAULT][i], ProcStat.perf[PERF_EVENT_MAJ_FAULT][i]);
+		printf("proc perf[%d] cycles = %d M/s instructions = %d M/s cache-misses = %d k/s\n", i,
+			ProcStat.perf[PERF_EVENT_CYCLES][i], ProcStat.perf[PERF_EVENT_INSTRUCTIONS][i], ProcStat.perf[PERF_EVENT_CACHE_MISS][i]);
+	}
+
+	for(int i = 0; i < ProcStat.num; i++){
+		printf("proc log_drop[%d] = %d byte\n", i, ProcStat.log_drop[i]);
+	}
 	com_shmem_close(id);
 	printf("\n");
 #endif
 
 /* リソース管理 */
 #if 1
-	resourceStat ResStat;
+	resourceStat *ResStat;
+	int size;
 	id = com_shmem_open("/resstat", SHM_KIND_PLATFORM);
 	if (id == DEF_COM_SHMEM_FALSE) {
 		printf("/resstat com_shmem_open() error\n");
 		return -1;
 	}
 	
-	com_shmem_read(id, &ResStat, sizeof(ResStat));
+	//サイズはCPU数によって変わる
+	size = com_shmem_get_size(id);
+	ResStat = calloc(1, size);
+	if (ResStat == NULL) {
+		printf("/resstat calloc(%d) error\n", size);
+		return -1;
+	}
+	com_shmem_read(id, ResStat, size);
 	for(int i = 0; i < 13; i++)
 	{
-		printf("cpu_load[%d] = %d\n", i, ResStat.cpu_load[i]);
+		printf("cpu_load[%d] = %d\n", i, ResStat->cpu_load[i]);
 	}
-	printf("mem_load = %d\n", ResStat.mem_load);
-	printf("disk_load = %d\n", ResStat.disk_load);
-	printf("cpu_therm = %d\n", ResStat.cpu_therm);
+	printf("mem_load = %d\n", ResStat->mem_load);
+	printf("disk_load = %d\n", ResStat->disk_load);
+	printf("cpu_therm = %d\n", ResStat->cpu_therm);
+	if (size >= DEF_RES_STAT_SIZE(ResStat->cpu_num))
+	{
+		for(int i = 0; i < RES_PSI_MAX; i++)
+		{
+			printf("psi[%d] some = %d.%02d%% full = %d.%02d%% events = %u trigger = %d\n", i,
+				ResStat->psi[i].some_avg10 / 100, ResStat->psi[i].some_avg10 % 100,
+				ResStat->psi[i].full_avg10 / 100, ResStat->psi[i].full_avg10 % 100,
+				ResStat->psi[i].events, ResStat->psi[i].trigger);
+		}
+		for(int i = 0; i < ResStat->mount_num && i < DEF_RES_MOUNT_MAX; i++)
+		{
+			printf("mount %s usage = %d%%\n", ResStat->mount[i].path, ResStat->mount[i].usage);
+		}
+		for(int i = 0; i < ResStat->disk_num && i < DEF_RES_DISK_MAX; i++)
+		{
+			resDiskStat *Disk = &ResStat->disk[i];
+			printf("disk %s r = %d/s %d KiB/s %d us w = %d/s %d KiB/s %d us svctm = %d us queue = %d.%02d util = %d%% inflight = %d\n",
+				Disk->name, Disk->rd_iops, Disk->rd_kbps, Disk->rd_await, Disk->wr_iops, Disk->wr_kbps, Disk->wr_await,
+				Disk->svctm, Disk->queue / 100, Disk->queue % 100, Disk->util, Disk->inflight);
+		}
+		printf("cpu_num = %d, cpu_online = %d\n", ResStat->cpu_num, ResStat->cpu_online);
+		for(int i = 0; i <= ResStat->cpu_num; i++)
+		{
+			printf("cpu[%d] online = %d load = %d idle = %llu iowait = %llu\n", i - 1,
+				ResStat->cpu[i].online, ResStat->cpu[i].load,
+				(unsigned long long)ResStat->cpu[i].idle, (unsigned long long)ResStat->cpu[i].iowait);
+		}
+	}
+	free(ResStat);
+	com_shmem_close(id);
+	printf("\n");
+#endif
+
+/* 温度・冷却・周波数 */
+#if 1
+	thermalStat *Therm;
+	id = com_shmem_open(DEF_THERM_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if (id == DEF_COM_SHMEM_FALSE) {
+		printf("%s com_shmem_open() error\n", DEF_THERM_SHMEM_NAME);
+		return -1;
+	}
+	size = com_shmem_get_size(id);
+	Therm = calloc(1, size);
+	if (Therm == NULL) {
+		printf("%s calloc(%d) error\n", DEF_THERM_SHMEM_NAME, size);
+		return -1;
+	}
+	com_shmem_read(id, Therm, size);
+	if (size >= DEF_THERM_STAT_SIZE(Therm->zone_num, Therm->cool_num, Therm->cpu_num))
+	{
+		for(int i = 0; i < Therm->zone_num; i++)
+		{
+			printf("zone %s temp = %d trip = %d\n", THERM_ZONE(Therm)[i].type, THERM_ZONE(Therm)[i].temp, THERM_ZONE(Therm)[i].trip);
+		}
+		for(int i = 0; i < Therm->cool_num; i++)
+		{
+			printf("cooling %s state = %d/%d count = %u\n", THERM_COOL(Therm)[i].type,
+				THERM_COOL(Therm)[i].cur, THERM_COOL(Therm)[i].max, THERM_COOL(Therm)[i].count);
+		}
+		for(int i = 0; i < Therm->cpu_num; i++)
+		{
+			printf("cpu%d freq = %d max = %d/%d throttle = %d count = %u\n", i, THERM_FREQ(Therm)[i].cur,
+				THERM_FREQ(Therm)[i].max, THERM_FREQ(Therm)[i].hw_max, THERM_FREQ(Therm)[i].throttled, THERM_FREQ(Therm)[i].count);
+		}
+		printf("throttled = %d\n", Therm->throttled);
+	}
+	free(Therm);
+	com_shmem_close(id);
+	printf("\n");
+#endif
+
+/* カーネル活動(発生しているIRQのみ表示) */
+#if 1
+	kernelStat *Kstat;
+	id = com_shmem_open(DEF_KSTAT_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if (id == DEF_COM_SHMEM_FALSE) {
+		printf("%s com_shmem_open() error\n", DEF_KSTAT_SHMEM_NAME);
+		return -1;
+	}
+	size = com_shmem_get_size(id);
+	Kstat = calloc(1, size);
+	if (Kstat == NULL) {
+		printf("%s calloc(%d) error\n", DEF_KSTAT_SHMEM_NAME, size);
+		return -1;
+	}
+	com_shmem_read(id, Kstat, size);
+	if (size >= DEF_KSTAT_STAT_SIZE(Kstat->irq_max, Kstat->cpu_num))
+	{
+		printf("ctxt = %d/s intr = %d/s softirq = %d/s running = %d blocked = %d\n", Kstat->ctxt_rate,
+			Kstat->intr_rate, Kstat->softirq_rate, Kstat->procs_running, Kstat->procs_blocked);
+		for(int i = 0; i < Kstat->irq_num; i++)
+		{
+			if (KSTAT_IRQ(Kstat)[i].rate == 0)
+			{
+				continue;
+			}
+			printf("irq %s %d/s [%s]:", KSTAT_IRQ(Kstat)[i].name, KSTAT_IRQ(Kstat)[i].rate, KSTAT_IRQ(Kstat)[i].desc);
+			for(int cpu = 0; cpu < Kstat->cpu_num; cpu++)
+			{
+				printf(" %d", KSTAT_IRQ_RATE(Kstat, i)[cpu]);
+			}
+			printf("\n");
+		}
+	}
+	free(Kstat);
+	com_shmem_close(id);
+	printf("\n");
+#endif
+
+/* ネットワークインタフェース */
+#if 1
+	netStat *Net;
+	id = com_shmem_open(DEF_NET_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if (id == DEF_COM_SHMEM_FALSE) {
+		printf("%s com_shmem_open() error\n", DEF_NET_SHMEM_NAME);
+		return -1;
+	}
+	size = com_shmem_get_size(id);
+	Net = calloc(1, size);
+	if (Net == NULL) {
+		printf("%s calloc(%d) error\n", DEF_NET_SHMEM_NAME, size);
+		return -1;
+	}
+	com_shmem_read(id, Net, size);
+	if (size >= DEF_NET_STAT_SIZE(Net->if_max))
+	{
+		for(int i = 0; i < Net->if_num && i < Net->if_max; i++)
+		{
+			netIf *If = &Net->ifs[i];
+			printf("%s up = %d rx = %ld B/s %d pkt/s tx = %ld B/s %d pkt/s err = %d/%d drop = %d/%d",
+				If->name, If->up, (long)If->rx_bps, If->rx_pps, (long)If->tx_bps, If->tx_pps,
+				If->rx_err_ps, If->tx_err_ps, If->rx_drop_ps, If->tx_drop_ps);
+			if (If->wireless)
+			{
+				printf(" link = %d level = %d dBm noise = %d dBm rate = %d kbit/s",
+					If->link, If->level, If->noise, If->bitrate);
+			}
+			printf("\n");
+		}
+	}
+	free(Net);
+	com_shmem_close(id);
+	printf("\n");
+#endif
+
+/* スケジューリング遅延 */
+#if 1
+	schedStat *Sched;
+	id = com_shmem_open(DEF_SCHED_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if (id == DEF_COM_SHMEM_FALSE) {
+		printf("%s com_shmem_open() error\n", DEF_SCHED_SHMEM_NAME);
+		return -1;
+	}
+	size = com_shmem_get_size(id);
+	Sched = calloc(1, size);
+	if (Sched == NULL) {
+		printf("%s calloc(%d) error\n", DEF_SCHED_SHMEM_NAME, size);
+		return -1;
+	}
+	com_shmem_read(id, Sched, size);
+	if (size >= DEF_SCHED_STAT_SIZE(Sched->task_max))
+	{
+		for(int i = 0; i < Sched->task_num && i < Sched->task_max; i++)
+		{
+			schedTask *Task = &Sched->task[i];
+			printf("[%d] %d/%d %s policy = %d prio = %d run = %d %% wait = %d us (max %d us) slice = %d us hist =",
+				Task->proc, Task->pid, Task->tid, Task->comm, Task->policy, Task->prio,
+				Task->run_pct, Task->wait_avg, Task->wait_max, Task->slice_avg);
+			for(int bin = 0; bin < DEF_SCHED_HIST_BIN; bin++)
+			{
+				printf(" %u", Task->hist[bin]);
+			}
+			printf("\n");
+		}
+	}
+	free(Sched);
+	com_shmem_close(id);
+	printf("\n");
+#endif
+
+/* リソース履歴(各段の最新値) */
+#if 1
+	resHist *Hist;
+	id = com_shmem_open(DEF_HIST_SHMEM_NAME, SHM_KIND_PLATFORM);
+	if (id == DEF_COM_SHMEM_FALSE) {
+		printf("%s com_shmem_open() error\n", DEF_HIST_SHMEM_NAME);
+		return -1;
+	}
+	size = com_shmem_get_size(id);
+	Hist = calloc(1, size);
+	if (Hist == NULL) {
+		printf("%s calloc(%d) error\n", DEF_HIST_SHMEM_NAME, size);
+		return -1;
+	}
+	com_shmem_read(id, Hist, size);
+	if ((size >= DEF_HIST_SIZE) && (Hist->kind_num == HIST_KIND_MAX))
+	{
+		for(int level = 0; level < Hist->level_num && level < DEF_HIST_LEVEL_MAX; level++)
+		{
+			histRing *Ring = &Hist->ring[level];
+			printf("hist[%d] period = %d ms count = %d/%d", level, Ring->period, Ring->count, Ring->len);
+			if (Ring->count > 0)
+			{
+				histValue *Value = HIST_ENTRY(Hist, level, (Ring->head + Ring->len - 1) % Ring->len);
+				for(int kind = 0; kind < HIST_KIND_MAX; kind++)
+				{
+					printf(" %d/%d/%d", Value[kind].min, Value[kind].avg, Value[kind].max);
+				}
+			}
+			printf("\n");
+		}
+	}
+	free(Hist);
 	com_shmem_close(id);
 	printf("\n");
 #endif
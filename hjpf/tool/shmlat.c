@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/com_shmem.h"
+#include "gnss.h"
+#include "ins.h"
+#include "imu.h"
+#include "altmt.h"
+#include "i2c.h"
+
+//共有メモリ毎のデータ遅延(デバイス到着～読み込み)の表示
+//  shmlat                   : センサ系共有メモリの遅延を表示
+//  shmlat <name>...         : 指定した共有メモリの遅延を表示
+//  shmlat -r <name>...      : 表示後に遅延ヒストグラムをクリア
+
+static void print_latency(char *name, int reset)
+{
+	int id;
+	shmLatency lat;
+
+	id = com_shmem_open(name, SHM_KIND_USER);
+	if (id == DEF_COM_SHMEM_FALSE)
+	{
+		printf("%s com_shmem_open() error\n", name);
+		return;
+	}
+
+	if (com_shmem_latency(id, &lat, reset) == DEF_COM_SHMEM_FALSE)
+	{
+		printf("%s com_shmem_latency() error\n", name);
+		com_shmem_close(id);
+		return;
+	}
+
+	printf("%-14s seq=%llu count=%llu", name, (unsigned long long)lat.seq, (unsigned long long)lat.count);
+	if (lat.count > 0)
+	{
+		printf(" avg=%lluus p50<%lluus p99<%lluus max=%lluus",
+			(unsigned long long)(lat.sum / lat.count),
+			(unsigned long long)com_shmem_latency_pct(&lat, 50),
+			(unsigned long long)com_shmem_latency_pct(&lat, 99),
+			(unsigned long long)lat.max);
+	}
+	printf("\n");
+
+	for (int cnt = 0; cnt < DEF_COM_SHMEM_LAT_BIN; cnt++)
+	{
+		if (lat.hist[cnt] == 0)
+		{
+			continue;
+		}
+		if (cnt == 0)
+		{
+			printf("  %10s <%9uus : %u\n", "", 1, lat.hist[cnt]);
+		}
+		else
+		{
+			printf("  %9uus -%9uus : %u\n", 1U << (cnt - 1), 1U << cnt, lat.hist[cnt]);
+		}
+	}
+
+	com_shmem_close(id);
+}
+
+int main(int argc, char *argv[])
+{
+	char *defname[] = {DEF_GNSS_SHMEM_NAME, DEF_INS_SHMEM_NAME, DEF_IMU_SHMEM_NAME,
+		DEF_ALTMT_SHMEM_NAME, DEF_HMC_SHMEM_NAME, DEF_BME_SHMEM_NAME};
+	int reset = 0;
+	int pos = 1;
+
+	com_shmem_conf("../hjpf/memory.conf");
+
+	if (argc > 1 && strcmp(argv[1], "-r") == 0)
+	{
+		reset = 1;
+		pos++;
+	}
+
+	if (pos >= argc)
+	{
+		for (int cnt = 0; cnt < (int)(sizeof(defname) / sizeof(defname[0])); cnt++)
+		{
+			print_latency(defname[cnt], reset);
+		}
+	}
+	for (; pos < argc; pos++)
+	{
+		print_latency(argv[pos], reset);
+	}
+
+	return 0;
+}